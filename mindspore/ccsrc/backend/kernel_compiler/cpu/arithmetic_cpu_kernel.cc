@@ -18,6 +18,7 @@
 #include <map>
 #include "backend/kernel_compiler/cpu/arithmetic_cpu_kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
+#include "backend/kernel_compiler/cpu/elementwise_broadcast_impl.h"
 #include "nnacl/fp32/power_fp32.h"
 
 namespace mindspore {
@@ -35,234 +36,89 @@ void ArithmeticCPUKernel<T>::AssignAdd(T *input1, const T *input2, T *out) {
 
 template <typename T>
 void ArithmeticCPUKernel<T>::Add(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      out[i] = input1[iter.GetInputPosA()] + input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  BroadcastElementwise(broadcast_plan_, input1, input2, out, AddFunc());
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::Sub(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  if (output_size_ > MAX_SUB_SERIAL_SIZE) {
-    auto task = [&](size_t start, size_t end) {
-      auto iter = base_iter;
-      iter.SetPos(start);
-      for (size_t i = start; i < end; i++) {
-        out[i] = input1[iter.GetInputPosA()] - input2[iter.GetInputPosB()];
-        iter.GenNextPos();
-      }
-    };
-    CPUKernelUtils::ParallelFor(task, output_size_);
-  } else {
-    base_iter.SetPos(0);
-    for (size_t i = 0; i < output_size_; i++) {
-      out[i] = input1[base_iter.GetInputPosA()] - input2[base_iter.GetInputPosB()];
-      base_iter.GenNextPos();
-    }
-  }
+  BroadcastElementwise(broadcast_plan_, input1, input2, out, SubFunc(), MAX_SUB_SERIAL_SIZE);
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::Mul(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      out[i] = input1[iter.GetInputPosA()] * input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  BroadcastElementwise(broadcast_plan_, input1, input2, out, MulFunc());
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::RealDiv(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto dividend = input1[iter.GetInputPosA()];
-      auto divisor = input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-      auto zero = (T)0;
-      if (divisor == zero) {
-        if (dividend == zero) {
-          out[i] = std::numeric_limits<T>::quiet_NaN();
-          continue;
-        }
-        if (std::numeric_limits<T>::has_infinity) {
-          out[i] = dividend > zero ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
-        } else {
-          out[i] = dividend > zero ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
-        }
-        continue;
-      }
-      out[i] = dividend / divisor;
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  BroadcastElementwise(broadcast_plan_, input1, input2, out, DivFunc());
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::Div(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto dividend = input1[iter.GetInputPosA()];
-      auto divisor = input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-      auto zero = (T)0;
-      if (divisor == zero) {
-        if (dividend == zero) {
-          out[i] = std::numeric_limits<T>::quiet_NaN();
-          continue;
-        }
-        if (std::numeric_limits<T>::has_infinity) {
-          out[i] = dividend > zero ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
-        } else {
-          out[i] = dividend > zero ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
-        }
-        continue;
-      }
-      out[i] = dividend / divisor;
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  RealDiv(input1, input2, out);
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::FloorDiv(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto dividend = input1[iter.GetInputPosA()];
-      auto divisor = input2[iter.GetInputPosB()];
-      iter.GenNextPos();
-      auto zero = (T)0;
-      if (divisor == zero) {
-        if (dividend == zero) {
-          out[i] = std::numeric_limits<T>::quiet_NaN();
-          continue;
-        }
-        if (std::numeric_limits<T>::has_infinity) {
-          out[i] = dividend > zero ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
-        } else {
-          out[i] = dividend > zero ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
-        }
-        continue;
-      }
-      out[i] = (T)floor(static_cast<double>(dividend) / static_cast<double>(divisor));
+  auto op = [](const T &dividend, const T &divisor) {
+    auto zero = (T)0;
+    if (divisor == zero) {
+      return DivideByZero(dividend);
     }
+    return (T)floor(static_cast<double>(dividend) / static_cast<double>(divisor));
   };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  BroadcastElementwise(broadcast_plan_, input1, input2, out, op);
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::Mod(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto x = static_cast<double>(input1[iter.GetInputPosA()]);
-      auto y = static_cast<double>(input2[iter.GetInputPosB()]);
-      iter.GenNextPos();
-      auto data_div = x / y;
-      auto data_div_min = data_div < 0.0 ? data_div : 0.0;
-      auto data_div_max = data_div > 0.0 ? data_div : 0.0;
-      auto data_div_max_floor = floor(data_div_max);
-      auto data_div_min_ceil = ceil(data_div_min);
-      auto data_div_res = data_div_max_floor + data_div_min_ceil;
-      out[i] = static_cast<T>(x - data_div_res * y);
-    }
+  auto op = [](const T &input_x, const T &input_y) {
+    auto x = static_cast<double>(input_x);
+    auto y = static_cast<double>(input_y);
+    auto data_div = x / y;
+    auto data_div_min = data_div < 0.0 ? data_div : 0.0;
+    auto data_div_max = data_div > 0.0 ? data_div : 0.0;
+    auto data_div_max_floor = floor(data_div_max);
+    auto data_div_min_ceil = ceil(data_div_min);
+    auto data_div_res = data_div_max_floor + data_div_min_ceil;
+    return static_cast<T>(x - data_div_res * y);
   };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  BroadcastElementwise(broadcast_plan_, input1, input2, out, op);
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::FloorMod(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      auto x = static_cast<double>(input1[iter.GetInputPosA()]);
-      auto y = static_cast<double>(input2[iter.GetInputPosB()]);
-      iter.GenNextPos();
-      auto res = x - floor(x / y) * y;
-      out[i] = static_cast<T>((std::abs(res) > 1e-9) && ((res < 0.0) != (y < 0.0)) ? res + y : res);
-    }
+  auto op = [](const T &input_x, const T &input_y) {
+    auto x = static_cast<double>(input_x);
+    auto y = static_cast<double>(input_y);
+    auto res = x - floor(x / y) * y;
+    return static_cast<T>((std::abs(res) > 1e-9) && ((res < 0.0) != (y < 0.0)) ? res + y : res);
   };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  BroadcastElementwise(broadcast_plan_, input1, input2, out, op);
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::Pow(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  if (output_size_ > MAX_POW_SERIAL_SIZE) {
-    auto task = [&](size_t start, size_t end) {
-      auto iter = base_iter;
-      iter.SetPos(start);
-      for (size_t i = start; i < end; i++) {
-        auto x = static_cast<double>(input1[iter.GetInputPosA()]);
-        auto y = static_cast<double>(input2[iter.GetInputPosB()]);
-        out[i] = static_cast<T>(std::pow(x, y));
-        iter.GenNextPos();
-      }
-    };
-    CPUKernelUtils::ParallelFor(task, output_size_);
-  } else {
-    base_iter.SetPos(0);
-    for (size_t i = 0; i < output_size_; i++) {
-      auto sx = static_cast<double>(input1[base_iter.GetInputPosA()]);
-      auto sy = static_cast<double>(input2[base_iter.GetInputPosB()]);
-      out[i] = static_cast<T>(std::pow(sx, sy));
-      base_iter.GenNextPos();
-    }
-  }
+  auto op = [](const T &x, const T &y) {
+    return static_cast<T>(std::pow(static_cast<double>(x), static_cast<double>(y)));
+  };
+  BroadcastElementwise(broadcast_plan_, input1, input2, out, op, MAX_POW_SERIAL_SIZE);
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::SquaredDifference(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      T diff = input1[iter.GetInputPosA()] - input2[iter.GetInputPosB()];
-      out[i] = diff * diff;
-      iter.GenNextPos();
-    }
+  auto op = [](const T &x, const T &y) {
+    T diff = x - y;
+    return static_cast<T>(diff * diff);
   };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  BroadcastElementwise(broadcast_plan_, input1, input2, out, op);
 }
 
 template <typename T>
 void ArithmeticCPUKernel<T>::Atan2(const T *input1, const T *input2, T *out) {
-  BroadcastIterator base_iter(input_shape1_, input_shape2_, output_shape_);
-  auto task = [&](size_t start, size_t end) {
-    auto iter = base_iter;
-    iter.SetPos(start);
-    for (size_t i = start; i < end; i++) {
-      out[i] =
-        (T)atan2(static_cast<double>(input1[iter.GetInputPosA()]), static_cast<double>(input2[iter.GetInputPosB()]));
-      iter.GenNextPos();
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, output_size_);
+  auto op = [](const T &x, const T &y) { return (T)atan2(static_cast<double>(x), static_cast<double>(y)); };
+  BroadcastElementwise(broadcast_plan_, input1, input2, out, op);
 }
 
 static const std::map<std::string, OperateType> kArithmeticBinOpTypeMap = {
@@ -312,6 +168,7 @@ void ArithmeticCPUKernel<T>::InitKernel(const CNodePtr &kernel_node) {
   CPUKernelUtils::GetElementNumEveryDim(input_shape1_, &input_element_num1_);
   CPUKernelUtils::GetElementNumEveryDim(input_shape2_, &input_element_num2_);
   CPUKernelUtils::GetElementNumEveryDim(output_shape_, &output_element_num_);
+  broadcast_plan_ = BroadcastRowPlan(input_shape1_, input_shape2_, output_shape_);
   dtype_ = AnfAlgo::GetInputDeviceDataType(kernel_node, 0);
   if (dtype_ != AnfAlgo::GetInputDeviceDataType(kernel_node, 1)) {
     MS_LOG(EXCEPTION) << "Input0 and input1 must has the same data type";
@@ -56,6 +56,7 @@ class ArithmeticCPUKernel : public CPUKernel {
   std::vector<size_t> input_element_num2_;
   std::vector<size_t> output_shape_;
   std::vector<size_t> output_element_num_;
+  BroadcastRowPlan broadcast_plan_;
   size_t output_size_;
   OperateType operate_type_{ADD};
   TypeId dtype_{kTypeUnknown};
@@ -19,6 +19,7 @@
 #include <thread>
 #include <map>
 #include "backend/kernel_compiler/cpu/arithmetic_self_cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/elementwise_broadcast_impl.h"
 #include "runtime/device/cpu/cpu_device_address.h"
 
 namespace mindspore {
@@ -26,48 +27,28 @@ namespace kernel {
 namespace {
 template <typename T>
 void Square(const T *in, T *out, size_t size) {
-  auto task = [&in, &out](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      out[i] = in[i] * in[i];
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, size);
+  UnaryElementwise(in, out, size, [](const T &x) { return static_cast<T>(x * x); });
 }
 
 template <typename T>
 void Sign(const T *in, T *out, size_t size) {
-  auto task = [&in, &out](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      if (in[i] < 0) {
-        out[i] = -1;
-      } else if (in[i] > 0) {
-        out[i] = 1;
-      } else {
-        out[i] = 0;
-      }
+  auto op = [](const T &x) {
+    if (x < 0) {
+      return static_cast<T>(-1);
     }
+    return x > 0 ? static_cast<T>(1) : static_cast<T>(0);
   };
-  CPUKernelUtils::ParallelFor(task, size);
+  UnaryElementwise(in, out, size, op);
 }
 
 template <typename T>
 void Neg(const T *in, T *out, size_t size) {
-  auto task = [&in, &out](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      out[i] = -in[i];
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, size);
+  UnaryElementwise(in, out, size, [](const T &x) { return static_cast<T>(-x); });
 }
 
 template <typename T>
 void LogicalNot(const T *in, T *out, size_t size) {
-  auto task = [&in, &out](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      out[i] = !in[i];
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, size);
+  UnaryElementwise(in, out, size, [](const T &x) { return static_cast<T>(!x); });
 }
 
 template <typename T>
@@ -92,165 +73,87 @@ void ZerosLike(const T *, T *out, size_t size) {
 
 template <typename T>
 void Floor(const T *in, T *out, size_t size) {
-  auto task = [&in, &out](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      out[i] = static_cast<T>(floor(in[i]));
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, size);
+  UnaryElementwise(in, out, size, [](const T &x) { return static_cast<T>(floor(x)); });
 }
 
 template <typename T>
 void Rint(const T *in, T *out, size_t size) {
-  auto task = [&](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      out[i] = static_cast<T>(rint(in[i]));
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, size);
+  UnaryElementwise(in, out, size, [](const T &x) { return static_cast<T>(rint(x)); });
 }
 
 template <typename T>
 void Round(const T *in, T *out, size_t size) {
-  auto task = [&](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      out[i] = static_cast<T>(nearbyint(in[i]));
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, size);
+  UnaryElementwise(in, out, size, [](const T &x) { return static_cast<T>(nearbyint(x)); });
 }
 
 template <typename T>
 void Reciprocal(const T *in, T *out, size_t size) {
-  auto task = [&in, &out](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      out[i] = static_cast<T>(1.0 / in[i]);
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, size);
+  UnaryElementwise(in, out, size, [](const T &x) { return static_cast<T>(1.0 / x); });
 }
 
 template <typename T>
 void Gelu(const T *in, T *out, size_t size) {
-  auto task = [&in, &out](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      T x = in[i];
-      auto double_x = static_cast<T>(x);
-      T tanh_res = static_cast<T>(std::tanh(0.7978845608 * (double_x + 0.044715 * double_x * double_x * double_x)));
-      out[i] = x * (static_cast<T>(1.0) + tanh_res) / static_cast<T>(2.0);
-    }
+  auto op = [](const T &x) {
+    auto double_x = static_cast<T>(x);
+    T tanh_res = static_cast<T>(std::tanh(0.7978845608 * (double_x + 0.044715 * double_x * double_x * double_x)));
+    return static_cast<T>(x * (static_cast<T>(1.0) + tanh_res) / static_cast<T>(2.0));
   };
-  CPUKernelUtils::ParallelFor(task, size);
+  UnaryElementwise(in, out, size, op);
 }
 
 template <typename T>
 void Asin(const T *in, T *out, size_t size) {
-  auto task = [&in, &out](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      out[i] = static_cast<T>(asin(static_cast<double>(in[i])));
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, size);
+  UnaryElementwise(in, out, size, [](const T &x) { return static_cast<T>(asin(static_cast<double>(x))); });
 }
 
 template <typename T>
 void ACos(const T *in, T *out, size_t size) {
-  auto task = [&in, &out](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      out[i] = static_cast<T>(acos(static_cast<double>(in[i])));
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, size);
+  UnaryElementwise(in, out, size, [](const T &x) { return static_cast<T>(acos(static_cast<double>(x))); });
 }
 
 template <typename T>
 void Atan(const T *in, T *out, size_t size) {
-  auto task = [&in, &out](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      out[i] = static_cast<T>(atan(static_cast<double>(in[i])));
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, size);
+  UnaryElementwise(in, out, size, [](const T &x) { return static_cast<T>(atan(static_cast<double>(x))); });
 }
 
 template <typename T>
 void Sin(const T *in, T *out, size_t size) {
-  auto task = [&in, &out](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      out[i] = static_cast<T>(sin(static_cast<double>(in[i])));
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, size);
+  UnaryElementwise(in, out, size, [](const T &x) { return static_cast<T>(sin(static_cast<double>(x))); });
 }
 
 template <typename T>
 void Cos(const T *in, T *out, size_t size) {
-  auto task = [&in, &out](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      out[i] = static_cast<T>(cos(static_cast<double>(in[i])));
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, size);
+  UnaryElementwise(in, out, size, [](const T &x) { return static_cast<T>(cos(static_cast<double>(x))); });
 }
 
 template <typename T>
 void Tan(const T *in, T *out, size_t size) {
-  auto task = [&in, &out](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      out[i] = static_cast<T>(tan(static_cast<double>(in[i])));
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, size);
+  UnaryElementwise(in, out, size, [](const T &x) { return static_cast<T>(tan(static_cast<double>(x))); });
 }
 
 template <typename T>
 void Sinh(const T *in, T *out, size_t size) {
-  auto task = [&in, &out](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      out[i] = static_cast<T>(sinh(static_cast<double>(in[i])));
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, size);
+  UnaryElementwise(in, out, size, [](const T &x) { return static_cast<T>(sinh(static_cast<double>(x))); });
 }
 
 template <typename T>
 void Cosh(const T *in, T *out, size_t size) {
-  auto task = [&in, &out](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      out[i] = static_cast<T>(cosh(static_cast<double>(in[i])));
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, size);
+  UnaryElementwise(in, out, size, [](const T &x) { return static_cast<T>(cosh(static_cast<double>(x))); });
 }
 
 template <typename T>
 void Asinh(const T *in, T *out, size_t size) {
-  auto task = [&in, &out](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      out[i] = static_cast<T>(asinh(static_cast<double>(in[i])));
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, size);
+  UnaryElementwise(in, out, size, [](const T &x) { return static_cast<T>(asinh(static_cast<double>(x))); });
 }
 
 template <typename T>
 void Acosh(const T *in, T *out, size_t size) {
-  auto task = [&in, &out](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      out[i] = static_cast<T>(acosh(static_cast<double>(in[i])));
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, size);
+  UnaryElementwise(in, out, size, [](const T &x) { return static_cast<T>(acosh(static_cast<double>(x))); });
 }
 
 template <typename T>
 void Atanh(const T *in, T *out, size_t size) {
-  auto task = [&in, &out](size_t start, size_t end) {
-    for (size_t i = start; i < end; i++) {
-      out[i] = static_cast<T>(atanh(static_cast<double>(in[i])));
-    }
-  };
-  CPUKernelUtils::ParallelFor(task, size);
+  UnaryElementwise(in, out, size, [](const T &x) { return static_cast<T>(atanh(static_cast<double>(x))); });
 }
 
 template <typename T>
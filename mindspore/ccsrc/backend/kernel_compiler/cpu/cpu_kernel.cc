@@ -193,6 +193,67 @@ void BroadcastIterator::InitStrides() {
                  [](const auto &a, const auto &b) { return b == 1 ? 0 : a; });
 }
 
+BroadcastRowPlan::BroadcastRowPlan(std::vector<size_t> input_shape_a, std::vector<size_t> input_shape_b,
+                                   std::vector<size_t> output_shape) {
+  // Scalars may be given as shape [] or [1], so align all shapes to the highest rank.
+  size_t dimension = std::max({input_shape_a.size(), input_shape_b.size(), output_shape.size()});
+  (void)input_shape_a.insert(input_shape_a.begin(), dimension - input_shape_a.size(), 1);
+  (void)input_shape_b.insert(input_shape_b.begin(), dimension - input_shape_b.size(), 1);
+  (void)output_shape.insert(output_shape.begin(), dimension - output_shape.size(), 1);
+  output_size_ = std::accumulate(output_shape.begin(), output_shape.end(), size_t(1), std::multiplies<size_t>());
+
+  // Merge adjacent axes with the same broadcast pattern, axes of size 1 do not affect the layout.
+  std::vector<size_t> shape;
+  std::vector<bool> full_a;
+  std::vector<bool> full_b;
+  for (size_t i = 0; i < dimension; ++i) {
+    if (output_shape[i] == 1) {
+      continue;
+    }
+    bool is_full_a = input_shape_a[i] != 1;
+    bool is_full_b = input_shape_b[i] != 1;
+    if (!shape.empty() && full_a.back() == is_full_a && full_b.back() == is_full_b) {
+      shape.back() *= output_shape[i];
+    } else {
+      shape.push_back(output_shape[i]);
+      full_a.push_back(is_full_a);
+      full_b.push_back(is_full_b);
+    }
+  }
+  if (shape.empty()) {
+    return;
+  }
+
+  row_size_ = shape.back();
+  row_step_a_ = full_a.back() ? 1 : 0;
+  row_step_b_ = full_b.back() ? 1 : 0;
+  size_t stride_a = full_a.back() ? row_size_ : 1;
+  size_t stride_b = full_b.back() ? row_size_ : 1;
+  size_t row_dimension = shape.size() - 1;
+  row_shape_.assign(shape.begin(), shape.begin() + row_dimension);
+  row_strides_a_.resize(row_dimension);
+  row_strides_b_.resize(row_dimension);
+  for (size_t i = row_dimension; i > 0; --i) {
+    row_strides_a_[i - 1] = full_a[i - 1] ? stride_a : 0;
+    row_strides_b_[i - 1] = full_b[i - 1] ? stride_b : 0;
+    stride_a *= full_a[i - 1] ? shape[i - 1] : 1;
+    stride_b *= full_b[i - 1] ? shape[i - 1] : 1;
+  }
+}
+
+void BroadcastRowPlan::GetRowPos(size_t row, size_t *pos_a, size_t *pos_b) const {
+  MS_EXCEPTION_IF_NULL(pos_a);
+  MS_EXCEPTION_IF_NULL(pos_b);
+  *pos_a = 0;
+  *pos_b = 0;
+  for (size_t i = row_shape_.size(); i > 0 && row != 0; --i) {
+    size_t coordinate = row % row_shape_[i - 1];
+    *pos_a += coordinate * row_strides_a_[i - 1];
+    *pos_b += coordinate * row_strides_b_[i - 1];
+    row /= row_shape_[i - 1];
+  }
+}
+
 TransposeIterator::TransposeIterator(std::vector<size_t> output_shape, std::vector<size_t> axes,
                                      const std::vector<size_t> &input_shape)
     : shape_(std::move(output_shape)), axes_(std::move(axes)) {
@@ -182,6 +182,31 @@ class BroadcastIterator {
   int output_dimension_{0};
 };
 
+// Collapses the broadcast of two inputs into rows of the output, so that every row reads each input either
+// contiguously (step 1) or as a repeated scalar (step 0). Adjacent axes which broadcast the same way are merged,
+// which turns the common same-shape, scalar, row and column broadcast cases into a few long rows.
+class BroadcastRowPlan {
+ public:
+  BroadcastRowPlan() = default;
+  BroadcastRowPlan(std::vector<size_t> input_shape_a, std::vector<size_t> input_shape_b,
+                   std::vector<size_t> output_shape);
+  ~BroadcastRowPlan() = default;
+  inline size_t output_size() const { return output_size_; }
+  inline size_t row_size() const { return row_size_; }
+  inline size_t row_step_a() const { return row_step_a_; }
+  inline size_t row_step_b() const { return row_step_b_; }
+  void GetRowPos(size_t row, size_t *pos_a, size_t *pos_b) const;
+
+ private:
+  size_t output_size_{0};
+  size_t row_size_{1};
+  size_t row_step_a_{1};
+  size_t row_step_b_{1};
+  std::vector<size_t> row_shape_;
+  std::vector<size_t> row_strides_a_;
+  std::vector<size_t> row_strides_b_;
+};
+
 class TransposeIterator {
  public:
   TransposeIterator(std::vector<size_t> output_shape, std::vector<size_t> axes, const std::vector<size_t> &input_shape);
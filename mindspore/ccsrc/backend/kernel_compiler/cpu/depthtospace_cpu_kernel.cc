@@ -22,6 +22,10 @@
 
 namespace mindspore {
 namespace kernel {
+namespace {
+constexpr size_t kDepthToSpaceInputDims = 4;
+}  // namespace
+
 template <typename T>
 void DepthToSpaceCPUKernel<T>::InitKernel(const CNodePtr &kernel_node) {
   MS_EXCEPTION_IF_NULL(kernel_node);
@@ -29,48 +33,27 @@ void DepthToSpaceCPUKernel<T>::InitKernel(const CNodePtr &kernel_node) {
   input_shape_ = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
   output_shape_ = AnfAlgo::GetOutputDeviceShape(kernel_node, 0);
   block_size_ = AnfAlgo::GetNodeAttr<int64_t>(kernel_node, "block_size");
+  if (input_shape_.size() != kDepthToSpaceInputDims || block_size_ == 0) {
+    MS_LOG(EXCEPTION) << "DepthToSpace needs a 4D input and a positive block size, but got input shape "
+                      << input_shape_ << " and block size " << block_size_;
+  }
+  // The input channel c_in = (bh * block_size + bw) * c_out + c, so the NCHW input is viewed as
+  // [N, bh, bw, C, H, W] and transposed to the output layout [N, C, H, bh, W, bw].
+  std::vector<size_t> view_shape = {input_shape_[kIndex0], block_size_, block_size_,
+                                    input_shape_[kIndex1] / (block_size_ * block_size_), input_shape_[kIndex2],
+                                    input_shape_[kIndex3]};
+  transpose_plan_ = common::TransposePlan(view_shape, {0, 3, 4, 1, 5, 2}, sizeof(T));
 }
 
 template <typename T>
 bool DepthToSpaceCPUKernel<T>::Launch(const std::vector<kernel::AddressPtr> &inputs,
                                       const std::vector<kernel::AddressPtr> & /*workspace*/,
                                       const std::vector<kernel::AddressPtr> &outputs) {
-  auto input_addr = reinterpret_cast<T *>(inputs[0]->addr);
-  auto output_addr = reinterpret_cast<T *>(outputs[0]->addr);
-  size_t size = IntToSize(inputs[0]->size / sizeof(T));
-  std::vector<size_t> input_shape = input_shape_;
-  std::vector<size_t> output_shape = output_shape_;
-  size_t block_size = block_size_;
-  size_t input_dimension = input_shape.size();
-  size_t output_strides[3] = {1, 1, 1};
-
-  for (size_t i = input_dimension - 1; i >= 1; --i) {
-    for (size_t j = 0; j < i; ++j) {
-      output_strides[j] *= output_shape[i];
-    }
+  if (inputs.empty() || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "DepthToSpace needs one input and one output, but got " << inputs.size() << " inputs and "
+                      << outputs.size() << " outputs.";
   }
-
-  auto task = [&, input_addr, output_addr](size_t start, size_t end) {
-    std::vector<size_t> output_pos_array(input_dimension, 0);
-    for (size_t i = start; i < end; ++i) {
-      size_t tmp_pos = i;
-      for (size_t j = 0; j < input_dimension - 1; ++j) {
-        output_pos_array[j] = tmp_pos / output_strides[j];
-        tmp_pos %= output_strides[j];
-      }
-      output_pos_array.back() = tmp_pos;
-      size_t input_pos = output_pos_array[0];
-      input_pos =
-        (input_pos * input_shape[1]) +
-        (output_pos_array[1] +
-         (block_size * (output_pos_array[2] % block_size) + output_pos_array[3] % block_size) * output_shape[1]);
-      input_pos = (input_pos * input_shape[2]) + (output_pos_array[2] / block_size);
-      input_pos = (input_pos * input_shape[3]) + (output_pos_array[3] / block_size);
-      output_addr[i] = input_addr[input_pos];
-    }
-  };
-
-  CPUKernelUtils::ParallelFor(task, size);
+  transpose_plan_.Run(inputs[0]->addr, outputs[0]->addr);
   return true;
 }
 
@@ -21,6 +21,7 @@
 
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "common/transpose.h"
 namespace mindspore {
 namespace kernel {
 template <typename T>
@@ -38,6 +39,7 @@ class DepthToSpaceCPUKernel : public CPUKernel {
   std::vector<size_t> input_shape_;
   std::vector<size_t> output_shape_;
   size_t block_size_;
+  common::TransposePlan transpose_plan_;
 };
 
 MS_REG_CPU_KERNEL_T(
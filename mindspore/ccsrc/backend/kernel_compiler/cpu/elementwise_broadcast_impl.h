@@ -0,0 +1,169 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_ELEMENTWISE_BROADCAST_IMPL_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_ELEMENTWISE_BROADCAST_IMPL_H_
+#include <algorithm>
+#include <limits>
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/nnacl/fp32/add_fp32.h"
+#include "backend/kernel_compiler/cpu/nnacl/fp32/sub_fp32.h"
+#include "backend/kernel_compiler/cpu/nnacl/fp32/mul_fp32.h"
+
+namespace mindspore {
+namespace kernel {
+struct AddFunc {
+  template <typename T>
+  T operator()(const T &x, const T &y) const {
+    return x + y;
+  }
+};
+
+struct SubFunc {
+  template <typename T>
+  T operator()(const T &x, const T &y) const {
+    return x - y;
+  }
+};
+
+struct MulFunc {
+  template <typename T>
+  T operator()(const T &x, const T &y) const {
+    return x * y;
+  }
+};
+
+// The result of dividing by zero: nan for zero, and the infinity of the sign of the dividend otherwise, or the limit
+// of T if it has no infinity.
+template <typename T>
+T DivideByZero(const T &dividend) {
+  auto zero = (T)0;
+  if (dividend == zero) {
+    return std::numeric_limits<T>::quiet_NaN();
+  }
+  if (std::numeric_limits<T>::has_infinity) {
+    return dividend > zero ? std::numeric_limits<T>::infinity() : -std::numeric_limits<T>::infinity();
+  }
+  return dividend > zero ? std::numeric_limits<T>::max() : std::numeric_limits<T>::min();
+}
+
+struct DivFunc {
+  template <typename T>
+  T operator()(const T &x, const T &y) const {
+    if (y == (T)0) {
+      return DivideByZero(x);
+    }
+    return static_cast<T>(x / y);
+  }
+};
+
+// Computes one output row of a binary elementwise op. A step of 1 reads the input contiguously and a step of 0
+// repeats its first element. The loops are kept free of index arithmetic so that the compiler can vectorize them.
+template <typename T, typename S, typename Op>
+struct BinaryRowImpl {
+  static void Run(const T *in0, size_t step0, const T *in1, size_t step1, S *out, size_t size, const Op &op) {
+    if (step0 == 1 && step1 == 1) {
+      for (size_t i = 0; i < size; ++i) {
+        out[i] = op(in0[i], in1[i]);
+      }
+    } else if (step0 == 1) {
+      const T y = in1[0];
+      for (size_t i = 0; i < size; ++i) {
+        out[i] = op(in0[i], y);
+      }
+    } else if (step1 == 1) {
+      const T x = in0[0];
+      for (size_t i = 0; i < size; ++i) {
+        out[i] = op(x, in1[i]);
+      }
+    } else {
+      std::fill(out, out + size, static_cast<S>(op(in0[0], in1[0])));
+    }
+  }
+};
+
+// Rows of float add, sub and mul go to the nnacl SIMD routines, integer rows are left to the compiler.
+#define NNACL_BINARY_ROW_IMPL(type, op, element_func, element_opt_func)                                         \
+  template <>                                                                                                 \
+  struct BinaryRowImpl<type, type, op> {                                                                      \
+    static void Run(const type *in0, size_t step0, const type *in1, size_t step1, type *out, size_t size,     \
+                    const op &func) {                                                                         \
+      if (step0 == 0 && step1 == 0) {                                                                         \
+        std::fill(out, out + size, func(in0[0], in1[0]));                                                    \
+        return;                                                                                               \
+      }                                                                                                       \
+      if (step0 == 1 && step1 == 1) {                                                                         \
+        (void)element_func(in0, in1, out, SizeToInt(size));                                                   \
+        return;                                                                                               \
+      }                                                                                                       \
+      ArithmeticParameter param{};                                                                            \
+      param.in_elements_num0_ = step0 == 0 ? 1 : SizeToInt(size);                                             \
+      param.in_elements_num1_ = step1 == 0 ? 1 : SizeToInt(size);                                             \
+      (void)element_opt_func(in0, in1, out, SizeToInt(size), &param);                                         \
+    }                                                                                                         \
+  };
+
+NNACL_BINARY_ROW_IMPL(float, AddFunc, ElementAdd, ElementOptAdd)
+NNACL_BINARY_ROW_IMPL(float, SubFunc, ElementSub, ElementOptSub)
+NNACL_BINARY_ROW_IMPL(float, MulFunc, ElementMul, ElementOptMul)
+#undef NNACL_BINARY_ROW_IMPL
+
+// Runs a binary elementwise op over the rows of a broadcast plan. Outputs no larger than serial_size are computed
+// on the calling thread, which avoids the thread pool overhead for small or cheap ops.
+template <typename T, typename S, typename Op>
+void BroadcastElementwise(const BroadcastRowPlan &plan, const T *in0, const T *in1, S *out, const Op &op,
+                          size_t serial_size = 0) {
+  size_t output_size = plan.output_size();
+  if (output_size == 0) {
+    return;
+  }
+  size_t row_size = plan.row_size();
+  size_t step0 = plan.row_step_a();
+  size_t step1 = plan.row_step_b();
+  auto task = [&](size_t start, size_t end) {
+    size_t row = start / row_size;
+    size_t col = start % row_size;
+    while (start < end) {
+      size_t size = std::min(row_size - col, end - start);
+      size_t pos0 = 0;
+      size_t pos1 = 0;
+      plan.GetRowPos(row, &pos0, &pos1);
+      BinaryRowImpl<T, S, Op>::Run(in0 + pos0 + col * step0, step0, in1 + pos1 + col * step1, step1, out + start,
+                                   size, op);
+      start += size;
+      col = 0;
+      ++row;
+    }
+  };
+  if (output_size <= serial_size) {
+    task(0, output_size);
+  } else {
+    CPUKernelUtils::ParallelFor(task, output_size);
+  }
+}
+
+template <typename T, typename S, typename Op>
+void UnaryElementwise(const T *in, S *out, size_t size, const Op &op) {
+  auto task = [&](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      out[i] = op(in[i]);
+    }
+  };
+  CPUKernelUtils::ParallelFor(task, size);
+}
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_ELEMENTWISE_BROADCAST_IMPL_H_
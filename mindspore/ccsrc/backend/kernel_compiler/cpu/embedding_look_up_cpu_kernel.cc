@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <thread>
+#include <algorithm>
 #include <string>
 #include "backend/kernel_compiler/cpu/embedding_look_up_cpu_kernel.h"
 #include "runtime/device/cpu/cpu_device_address.h"
@@ -23,24 +24,27 @@
 namespace mindspore {
 namespace kernel {
 namespace {
+// How many indices ahead of the row being copied the table is prefetched.
+constexpr size_t kRowPrefetchDistance = 8;
+
 template <typename T>
 void LookUpTableTask(const float *input_addr, const T *indices_addr, float *output_addr, size_t indices_lens,
                      size_t outer_dim_size, T offset, size_t first_dim_size) {
-  auto type_size = sizeof(float);
-  size_t lens = outer_dim_size * type_size;
+  // The rows are gathered at random from a table usually much larger than the cache, so each row is requested a few
+  // indices before it is copied. The output is exactly indices_lens rows, which needs no check per row.
   for (size_t i = 0; i < indices_lens; ++i) {
-    T index = indices_addr[i] - offset;
-    if (index >= 0 && index < SizeToInt(first_dim_size)) {
-      size_t pos = static_cast<size_t>(index) * outer_dim_size;
-      auto ret = memcpy_s(output_addr, (indices_lens - i) * lens, input_addr + pos, lens);
-      if (ret != EOK) {
-        MS_LOG(EXCEPTION) << "LookUpTable task memcpy failed.";
+    if (i + kRowPrefetchDistance < indices_lens) {
+      T next_index = indices_addr[i + kRowPrefetchDistance] - offset;
+      if (next_index >= 0 && next_index < SizeToLong(first_dim_size)) {
+        __builtin_prefetch(input_addr + static_cast<size_t>(next_index) * outer_dim_size);
       }
+    }
+    T index = indices_addr[i] - offset;
+    if (index >= 0 && index < SizeToLong(first_dim_size)) {
+      const float *row = input_addr + static_cast<size_t>(index) * outer_dim_size;
+      std::copy(row, row + outer_dim_size, output_addr);
     } else {
-      auto ret = memset_s(output_addr, (indices_lens - i) * lens, 0, lens);
-      if (ret != EOK) {
-        MS_LOG(EXCEPTION) << "LookUpTable task memset failed.";
-      }
+      std::fill(output_addr, output_addr + outer_dim_size, 0.0f);
     }
     output_addr += outer_dim_size;
   }
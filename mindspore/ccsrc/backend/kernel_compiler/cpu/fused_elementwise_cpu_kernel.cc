@@ -0,0 +1,252 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "backend/kernel_compiler/cpu/fused_elementwise_cpu_kernel.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <numeric>
+#include "backend/kernel_compiler/cpu/elementwise_broadcast_impl.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace kernel {
+namespace {
+constexpr size_t kFusedBlockSize = 512;
+constexpr size_t kUnaryInputNum = 1;
+constexpr size_t kBinaryInputNum = 2;
+
+struct MaximumFunc {
+  float operator()(const float &x, const float &y) const { return x > y ? x : y; }
+};
+
+struct MinimumFunc {
+  float operator()(const float &x, const float &y) const { return x < y ? x : y; }
+};
+
+struct PowFunc {
+  float operator()(const float &x, const float &y) const {
+    return static_cast<float>(std::pow(static_cast<double>(x), static_cast<double>(y)));
+  }
+};
+
+struct NegFunc {
+  float operator()(const float &x) const { return -x; }
+};
+
+struct SquareFunc {
+  float operator()(const float &x) const { return x * x; }
+};
+
+struct SqrtFunc {
+  float operator()(const float &x) const { return std::sqrt(x); }
+};
+
+struct RsqrtFunc {
+  float operator()(const float &x) const { return 1.0f / std::sqrt(x); }
+};
+
+struct ExpFunc {
+  float operator()(const float &x) const { return std::exp(x); }
+};
+
+struct LogFunc {
+  float operator()(const float &x) const { return std::log(x); }
+};
+
+struct TanhFunc {
+  float operator()(const float &x) const { return std::tanh(x); }
+};
+
+struct SigmoidFunc {
+  float operator()(const float &x) const { return 1.0f / (1.0f + std::exp(-x)); }
+};
+
+struct ReluFunc {
+  float operator()(const float &x) const { return x > 0.0f ? x : 0.0f; }
+};
+
+struct ReciprocalFunc {
+  float operator()(const float &x) const { return 1.0f / x; }
+};
+
+struct AbsFunc {
+  float operator()(const float &x) const { return std::fabs(x); }
+};
+
+template <typename Op>
+void BinaryFusedOp(const float *in0, size_t step0, const float *in1, size_t step1, float *out, size_t size) {
+  BinaryRowImpl<float, float, Op>::Run(in0, step0, in1, step1, out, size, Op());
+}
+
+template <typename Op>
+void UnaryFusedOp(const float *in0, size_t step0, const float *, size_t, float *out, size_t size) {
+  Op op;
+  if (step0 == 0) {
+    std::fill(out, out + size, op(in0[0]));
+    return;
+  }
+  for (size_t i = 0; i < size; ++i) {
+    out[i] = op(in0[i]);
+  }
+}
+
+struct FusedOpInfo {
+  FusedOpFunc func;
+  size_t input_num;
+};
+
+const std::map<std::string, FusedOpInfo> &GetFusedOpInfoMap() {
+  static const std::map<std::string, FusedOpInfo> fused_op_info_map = {
+    {prim::kPrimAdd->name(), {BinaryFusedOp<AddFunc>, kBinaryInputNum}},
+    {prim::kPrimSub->name(), {BinaryFusedOp<SubFunc>, kBinaryInputNum}},
+    {prim::kPrimMul->name(), {BinaryFusedOp<MulFunc>, kBinaryInputNum}},
+    {prim::kPrimRealDiv->name(), {BinaryFusedOp<DivFunc>, kBinaryInputNum}},
+    {prim::kPrimDiv->name(), {BinaryFusedOp<DivFunc>, kBinaryInputNum}},
+    {prim::kPrimMaximum->name(), {BinaryFusedOp<MaximumFunc>, kBinaryInputNum}},
+    {prim::kPrimMinimum->name(), {BinaryFusedOp<MinimumFunc>, kBinaryInputNum}},
+    {prim::kPrimPow->name(), {BinaryFusedOp<PowFunc>, kBinaryInputNum}},
+    {prim::kPrimNeg->name(), {UnaryFusedOp<NegFunc>, kUnaryInputNum}},
+    {prim::kPrimSquare->name(), {UnaryFusedOp<SquareFunc>, kUnaryInputNum}},
+    {prim::kPrimSqrt->name(), {UnaryFusedOp<SqrtFunc>, kUnaryInputNum}},
+    {prim::kPrimRsqrt->name(), {UnaryFusedOp<RsqrtFunc>, kUnaryInputNum}},
+    {prim::kPrimExp->name(), {UnaryFusedOp<ExpFunc>, kUnaryInputNum}},
+    {prim::kPrimLog->name(), {UnaryFusedOp<LogFunc>, kUnaryInputNum}},
+    {prim::kPrimTanh->name(), {UnaryFusedOp<TanhFunc>, kUnaryInputNum}},
+    {prim::kPrimSigmoid->name(), {UnaryFusedOp<SigmoidFunc>, kUnaryInputNum}},
+    {prim::kPrimRelu->name(), {UnaryFusedOp<ReluFunc>, kUnaryInputNum}},
+    {prim::kPrimReciprocal->name(), {UnaryFusedOp<ReciprocalFunc>, kUnaryInputNum}},
+    {prim::kPrimAbs->name(), {UnaryFusedOp<AbsFunc>, kUnaryInputNum}}};
+  return fused_op_info_map;
+}
+}  // namespace
+
+bool FusedElementwiseCPUKernel::IsSupportedOp(const std::string &op_name) {
+  return GetFusedOpInfoMap().count(op_name) != 0;
+}
+
+size_t FusedElementwiseCPUKernel::GetOpInputNum(const std::string &op_name) {
+  auto iter = GetFusedOpInfoMap().find(op_name);
+  if (iter == GetFusedOpInfoMap().end()) {
+    MS_LOG(EXCEPTION) << "Op " << op_name << " can not be fused into FusedElementwise.";
+  }
+  return iter->second.input_num;
+}
+
+void FusedElementwiseCPUKernel::InitKernel(const CNodePtr &kernel_node) {
+  MS_EXCEPTION_IF_NULL(kernel_node);
+  auto op_names = AnfAlgo::GetNodeAttr<std::vector<std::string>>(kernel_node, kAttrFusedOpNames);
+  auto op_inputs = AnfAlgo::GetNodeAttr<std::vector<int64_t>>(kernel_node, kAttrFusedOpInputs);
+  auto output_shape = AnfAlgo::GetOutputInferShape(kernel_node, 0);
+  output_size_ = std::accumulate(output_shape.begin(), output_shape.end(), size_t(1), std::multiplies<size_t>());
+
+  size_t input_num = AnfAlgo::GetInputTensorNum(kernel_node);
+  scalar_inputs_.clear();
+  for (size_t i = 0; i < input_num; ++i) {
+    auto input_shape = AnfAlgo::GetPrevNodeOutputInferShape(kernel_node, i);
+    size_t input_size =
+      std::accumulate(input_shape.begin(), input_shape.end(), size_t(1), std::multiplies<size_t>());
+    if (input_size != 1 && input_size != output_size_) {
+      MS_LOG(EXCEPTION) << "FusedElementwise input " << i << " with shape " << input_shape
+                        << " is neither a scalar nor of the output shape " << output_shape;
+    }
+    scalar_inputs_.push_back(input_size == 1);
+  }
+
+  InitFusedOps(op_names, op_inputs, input_num);
+}
+
+void FusedElementwiseCPUKernel::InitFusedOps(const std::vector<std::string> &op_names,
+                                             const std::vector<int64_t> &op_inputs, size_t input_num) {
+  ops_.clear();
+  size_t pos = 0;
+  for (const auto &op_name : op_names) {
+    FusedOp op;
+    size_t op_input_num = GetOpInputNum(op_name);
+    op.func = GetFusedOpInfoMap().at(op_name).func;
+    if (pos + op_input_num > op_inputs.size()) {
+      MS_LOG(EXCEPTION) << "The inputs of fused op " << op_name << " are missing in " << kAttrFusedOpInputs;
+    }
+    for (size_t i = 0; i < op_input_num; ++i, ++pos) {
+      int64_t index = op_inputs[pos];
+      if (index >= SizeToLong(input_num) || -index > SizeToLong(ops_.size())) {
+        MS_LOG(EXCEPTION) << "Fused op " << op_name << " has invalid input index " << index;
+      }
+      op.inputs.push_back(index);
+    }
+    ops_.push_back(op);
+  }
+  if (ops_.empty() || pos != op_inputs.size()) {
+    MS_LOG(EXCEPTION) << "The fused ops and their inputs mismatch.";
+  }
+}
+
+const float *FusedElementwiseCPUKernel::GetOperand(const std::vector<const float *> &inputs, int64_t index,
+                                                   size_t start, const float *buffer, size_t *step) const {
+  if (index >= 0) {
+    auto input_index = LongToSize(index);
+    if (scalar_inputs_[input_index]) {
+      *step = 0;
+      return inputs[input_index];
+    }
+    *step = 1;
+    return inputs[input_index] + start;
+  }
+  *step = 1;
+  return buffer + LongToSize(-index - 1) * kFusedBlockSize;
+}
+
+void FusedElementwiseCPUKernel::ComputeBlock(const std::vector<const float *> &inputs, float *output, size_t start,
+                                             size_t size, float *buffer) const {
+  for (size_t i = 0; i < ops_.size(); ++i) {
+    const auto &op = ops_[i];
+    size_t step0 = 0;
+    size_t step1 = 0;
+    const float *in0 = GetOperand(inputs, op.inputs[0], start, buffer, &step0);
+    const float *in1 = op.inputs.size() > 1 ? GetOperand(inputs, op.inputs[1], start, buffer, &step1) : in0;
+    // The last op writes the kernel output, the others keep their results in the block buffer.
+    float *out = (i + 1 == ops_.size()) ? output + start : buffer + i * kFusedBlockSize;
+    op.func(in0, step0, in1, step1, out, size);
+  }
+}
+
+bool FusedElementwiseCPUKernel::Launch(const std::vector<kernel::AddressPtr> &inputs,
+                                       const std::vector<kernel::AddressPtr> &,
+                                       const std::vector<kernel::AddressPtr> &outputs) {
+  if (inputs.size() != scalar_inputs_.size() || outputs.empty()) {
+    MS_LOG(EXCEPTION) << "FusedElementwise needs " << scalar_inputs_.size() << " inputs and one output, but got "
+                      << inputs.size() << " inputs and " << outputs.size() << " outputs.";
+  }
+  std::vector<const float *> input_addrs;
+  for (const auto &input : inputs) {
+    input_addrs.push_back(reinterpret_cast<const float *>(input->addr));
+  }
+  auto output_addr = reinterpret_cast<float *>(outputs[0]->addr);
+  if (output_size_ == 0) {
+    return true;
+  }
+  auto task = [&](size_t start, size_t end) {
+    std::vector<float> buffer(ops_.size() * kFusedBlockSize);
+    for (size_t block_start = start; block_start < end; block_start += kFusedBlockSize) {
+      size_t block_size = std::min(kFusedBlockSize, end - block_start);
+      ComputeBlock(input_addrs, output_addr, block_start, block_size, buffer.data());
+    }
+  };
+  CPUKernelUtils::ParallelFor(task, output_size_);
+  return true;
+}
+}  // namespace kernel
+}  // namespace mindspore
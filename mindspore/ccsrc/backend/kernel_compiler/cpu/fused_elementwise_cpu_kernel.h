@@ -0,0 +1,71 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_FUSED_ELEMENTWISE_CPU_KERNEL_H_
+#define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_FUSED_ELEMENTWISE_CPU_KERNEL_H_
+#include <memory>
+#include <string>
+#include <vector>
+#include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+
+namespace mindspore {
+namespace kernel {
+// Computes one block of a fused op. A step of 0 means the operand is a scalar, unary ops ignore the second operand.
+using FusedOpFunc = void (*)(const float *in0, size_t step0, const float *in1, size_t step1, float *out, size_t size);
+
+// Executes a chain of float32 elementwise ops, clustered by the CPU elementwise fusion pass, as a single loop.
+// The output is processed in blocks small enough for the intermediate results of every op to stay in cache, so
+// only the final result is written to memory.
+class FusedElementwiseCPUKernel : public CPUKernel {
+ public:
+  FusedElementwiseCPUKernel() = default;
+  ~FusedElementwiseCPUKernel() override = default;
+
+  void InitKernel(const CNodePtr &kernel_node) override;
+
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs) override;
+
+  static bool IsSupportedOp(const std::string &op_name);
+  static size_t GetOpInputNum(const std::string &op_name);
+
+ private:
+  struct FusedOp {
+    FusedOpFunc func{nullptr};
+    // A non-negative index refers to a kernel input and index -k refers to the result of the (k-1)th op.
+    std::vector<int64_t> inputs;
+  };
+
+  void InitFusedOps(const std::vector<std::string> &op_names, const std::vector<int64_t> &op_inputs,
+                    size_t input_num);
+  void ComputeBlock(const std::vector<const float *> &inputs, float *output, size_t start, size_t size,
+                    float *buffer) const;
+  const float *GetOperand(const std::vector<const float *> &inputs, int64_t index, size_t start, const float *buffer,
+                          size_t *step) const;
+
+  std::vector<FusedOp> ops_;
+  std::vector<bool> scalar_inputs_;
+  size_t output_size_{0};
+};
+
+MS_REG_CPU_KERNEL(
+  FusedElementwise,
+  KernelAttr().SetAllSameAttr(true).AddInputAttr(kNumberTypeFloat32).AddOutputAttr(kNumberTypeFloat32),
+  FusedElementwiseCPUKernel);
+}  // namespace kernel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_FUSED_ELEMENTWISE_CPU_KERNEL_H_
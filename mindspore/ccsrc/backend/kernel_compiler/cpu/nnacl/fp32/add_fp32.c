@@ -254,6 +254,32 @@ int ElementAdd(const float *in0, const float *in1, float *out, int size) {
   return NNACL_OK;
 }
 
+int ElementAddDivScalar(const float *in0, const float *in1, float divisor, float *out, int size) {
+  int index = 0;
+#ifdef ENABLE_AVX
+  MS_FLOAT32X8 divisor_8 = MS_MOV256_F32(divisor);
+  for (; index <= size - C8NUM; index += C8NUM) {
+    MS_FLOAT32X8 vin0 = MS_LD256_F32(in0 + index);
+    MS_FLOAT32X8 vin1 = MS_LD256_F32(in1 + index);
+    MS_FLOAT32X8 vout = MS_ADD256_F32(vin0, MS_DIV256_F32(vin1, divisor_8));
+    MS_ST256_F32(out + index, vout);
+  }
+#endif
+#if defined(ENABLE_NEON) || defined(ENABLE_SSE)
+  MS_FLOAT32X4 divisor_4 = MS_MOVQ_F32(divisor);
+  for (; index <= size - C4NUM; index += C4NUM) {
+    MS_FLOAT32X4 vin0 = MS_LDQ_F32(in0 + index);
+    MS_FLOAT32X4 vin1 = MS_LDQ_F32(in1 + index);
+    MS_FLOAT32X4 vout = MS_ADDQ_F32(vin0, MS_DIVQ_F32(vin1, divisor_4));
+    MS_STQ_F32(out + index, vout);
+  }
+#endif
+  for (; index < size; index++) {
+    out[index] = in0[index] + in1[index] / divisor;
+  }
+  return NNACL_OK;
+}
+
 int ElementAddRelu(const float *in0, const float *in1, float *out, int size) {
   int index = 0;
 #ifdef ENABLE_AVX
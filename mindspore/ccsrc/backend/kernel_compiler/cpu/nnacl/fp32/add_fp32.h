@@ -28,6 +28,7 @@ extern "C" {
 #endif
 
 int ElementAdd(const float *in0, const float *in1, float *out, int size);
+int ElementAddDivScalar(const float *in0, const float *in1, float divisor, float *out, int size);
 int ElementAddRelu(const float *in0, const float *in1, float *out, int size);
 int ElementAddRelu6(const float *in0, const float *in1, float *out, int size);
 int ElementAddInt(const int *in0, const int *in1, int *out, int size);
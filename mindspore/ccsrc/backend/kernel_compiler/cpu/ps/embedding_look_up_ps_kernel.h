@@ -40,6 +40,8 @@ class EmbeddingLookUpPSKernel : public EmbeddingLookUpCPUKernel, public PServerK
   const std::vector<size_t> &input_sizes() const override;
   const std::vector<size_t> &output_sizes() const override;
   const std::vector<size_t> &workspace_sizes() const override;
+  // The id of the first row of the local shard of the table.
+  int64_t offset() const { return offset_; }
 
  private:
   std::vector<size_t> input_shape_;
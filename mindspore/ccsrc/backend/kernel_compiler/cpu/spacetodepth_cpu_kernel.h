@@ -20,6 +20,7 @@
 
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "common/transpose.h"
 namespace mindspore {
 namespace kernel {
 template <typename T>
@@ -37,6 +38,7 @@ class SpaceToDepthCPUKernel : public CPUKernel {
   std::vector<size_t> input_shape_;
   std::vector<size_t> output_shape_;
   size_t block_size_;
+  common::TransposePlan transpose_plan_;
 };
 
 MS_REG_CPU_KERNEL_T(
@@ -18,11 +18,11 @@
 
 #include <vector>
 #include <memory>
-#include <unordered_map>
 #include <algorithm>
 #include <utility>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
+#include "backend/kernel_compiler/cpu/nnacl/fp32/add_fp32.h"
 #include "common/thread_pool.h"
 namespace mindspore {
 namespace kernel {
@@ -66,14 +66,6 @@ struct MultiThreadComputeParams {
 template <typename T>
 using MultiThreadComputeFunc = std::function<void(MultiThreadComputeParams<T> *param, size_t start, size_t end)>;
 
-template <typename T>
-struct BucketSparseGradient {
-  float *value_;
-  T *indices_;
-  T *global_indices_;
-  size_t indices_size_;
-};
-
 template <typename T>
 struct MultiThreadReduceSparseGradientParam {
   SparseGradient<T> *input_grad_{nullptr};
@@ -85,11 +77,81 @@ struct MultiThreadReduceSparseGradientParam {
   bool use_sort_reduce_{false};
 };
 
+// The bookkeeping of BucketReduceSparseGradient. Every calling thread keeps one and reuses it across launches, so
+// a training step does not allocate once the sizes of its gradients have been seen.
+struct BucketReduceWorkspace {
+  // Entry i * thread_num + j first counts the indices of segment i falling into bucket j, then holds the position
+  // where segment i writes its next index of bucket j.
+  std::vector<size_t> segment_bucket_offsets_;
+  // The first index of every segment in the input and of every bucket in the output, plus the total at the end.
+  std::vector<size_t> segment_offsets_;
+  std::vector<size_t> bucket_offsets_;
+  // The number of unique indices of every bucket once it is reduced.
+  std::vector<size_t> unique_sizes_;
+  std::vector<common::Task> tasks_;
+};
+
+// Maps the indices of a bucket to their rows in the reduced bucket. Every pool thread keeps its own table. The slots
+// are stamped with the reduce that filled them, so that the table never needs to be cleared between buckets.
+template <typename T>
+class BucketIndexTable {
+ public:
+  void Reset(size_t indices_size) {
+    size_t bits = kMinCapacityBits;
+    while ((size_t(1) << bits) < indices_size * 2) {
+      ++bits;
+    }
+    size_t capacity = size_t(1) << bits;
+    if (capacity > stamps_.size()) {
+      keys_.resize(capacity);
+      rows_.resize(capacity);
+      stamps_.assign(capacity, 0);
+      stamp_ = 0;
+    }
+    mask_ = capacity - 1;
+    shift_ = kHashBits - bits;
+    if (++stamp_ == 0) {
+      std::fill(stamps_.begin(), stamps_.end(), 0);
+      stamp_ = 1;
+    }
+  }
+
+  // Returns the row of index, which is new_row if the index has not been seen since the last reset.
+  size_t FindOrInsert(T index, size_t new_row) {
+    // The indices of a bucket share their remainder modulo the bucket number, so they are scrambled before probing.
+    size_t slot = static_cast<size_t>((static_cast<uint64_t>(index) * kHashMultiplier) >> shift_);
+    while (stamps_[slot] == stamp_) {
+      if (keys_[slot] == index) {
+        return rows_[slot];
+      }
+      slot = (slot + 1) & mask_;
+    }
+    stamps_[slot] = stamp_;
+    keys_[slot] = index;
+    rows_[slot] = new_row;
+    return new_row;
+  }
+
+ private:
+  static constexpr size_t kMinCapacityBits = 6;
+  static constexpr size_t kHashBits = 64;
+  static constexpr uint64_t kHashMultiplier = 0x9E3779B97F4A7C15ULL;
+  std::vector<T> keys_;
+  std::vector<size_t> rows_;
+  std::vector<uint32_t> stamps_;
+  uint32_t stamp_{0};
+  size_t mask_{0};
+  size_t shift_{kHashBits};
+};
+
 class SparseOptimizerCPUKernel : public CPUKernel {
  public:
   SparseOptimizerCPUKernel() = default;
   ~SparseOptimizerCPUKernel() override = default;
 
+  // Sums the gradient rows sharing an index. The indices are spread over one bucket per thread by their value, every
+  // bucket is then deduplicated and reduced in a single pass over its rows. The unique indices are output bucket by
+  // bucket, in order of first appearance or sorted within a bucket if use_sort_reduce_ is set.
   template <typename T>
   static void BucketReduceSparseGradient(const ReduceSparseGradientParam<T> &param) {
     MS_LOG(DEBUG) << "Start";
@@ -101,17 +163,11 @@ class SparseOptimizerCPUKernel : public CPUKernel {
     MultiThreadReduceSparseGradientParam<T> multi_thread_param(
       {param.input_grad_, param.workspace_grad_, param.output_grad_, param.max_index_, param.value_stride_, thread_num,
        param.use_sort_reduce_});
-    std::vector<std::shared_ptr<SparseGradient<T>>> segments;
-    std::vector<std::shared_ptr<std::vector<size_t>>> segment_bucket_sizes;
-    SplitAndCalculateSegmentBucketSize(multi_thread_param, &segments, &segment_bucket_sizes);
-
-    std::vector<std::shared_ptr<BucketSparseGradient<T>>> buckets;
-    GatherSegmentIndicesToOutputBucket(multi_thread_param, segments, segment_bucket_sizes, &buckets);
-
-    std::vector<std::shared_ptr<SparseGradient<T>>> reduced_buckets;
-    ReduceBucketSparseGradientToWorkspace(multi_thread_param, buckets, &reduced_buckets);
-
-    MergeReduceSparseGradient(multi_thread_param, reduced_buckets);
+    static thread_local BucketReduceWorkspace workspace;
+    SplitAndCalculateSegmentBucketSize(multi_thread_param, &workspace);
+    GatherSegmentIndicesToOutputBucket(multi_thread_param, &workspace);
+    ReduceBucketSparseGradientToWorkspace(multi_thread_param, &workspace);
+    MergeReduceSparseGradient(multi_thread_param, &workspace);
     MS_LOG(DEBUG) << "End";
   }
 
@@ -137,301 +193,215 @@ class SparseOptimizerCPUKernel : public CPUKernel {
   }
 
  private:
-  template <typename T>
-  static void CalculateEachBucketSize(const std::shared_ptr<SparseGradient<T>> &sparse_grad, size_t max_index,
-                                      std::vector<size_t> *each_bucket_size) {
-    MS_LOG(DEBUG) << "Start";
-    MS_EXCEPTION_IF_NULL(sparse_grad);
-    MS_EXCEPTION_IF_NULL(sparse_grad->indices_);
-    MS_EXCEPTION_IF_NULL(each_bucket_size);
-    size_t bucket_num = each_bucket_size->size();
-    for (size_t i = 0; i < sparse_grad->indices_size_; ++i) {
-      T index = sparse_grad->indices_[i];
-      if (index >= 0 && LongToSize(index) < max_index) {
-        auto bucket_id = index % bucket_num;
-        each_bucket_size->at(bucket_id)++;
-      }
+  // How many rows ahead of the one being reduced the gradient is prefetched.
+  static constexpr size_t kRowPrefetchDistance = 8;
+
+  // Runs func(i) for every thread i of the reduce, the tasks only capture a reference and an index so that they fit
+  // in the storage of the task functions.
+  template <typename T, typename Func>
+  static void RunBucketTasks(const MultiThreadReduceSparseGradientParam<T> &param, BucketReduceWorkspace *workspace,
+                             const Func &func) {
+    auto &tasks = workspace->tasks_;
+    tasks.clear();
+    for (size_t i = 0; i < param.thread_num_; ++i) {
+      tasks.emplace_back([&func, i]() {
+        func(i);
+        return common::SUCCESS;
+      });
     }
-    MS_LOG(DEBUG) << "End";
+    common::ThreadPool::GetInstance().SyncRun(tasks);
   }
 
   template <typename T>
-  static void SplitAndCalculateSegmentBucketSize(
-    const MultiThreadReduceSparseGradientParam<T> &param, std::vector<std::shared_ptr<SparseGradient<T>>> *segments_ptr,
-    std::vector<std::shared_ptr<std::vector<size_t>>> *segment_bucket_sizes_ptr) {
+  static void SplitAndCalculateSegmentBucketSize(const MultiThreadReduceSparseGradientParam<T> &param,
+                                                 BucketReduceWorkspace *workspace) {
     MS_EXCEPTION_IF_NULL(param.input_grad_);
-    MS_EXCEPTION_IF_NULL(segment_bucket_sizes_ptr);
-    MS_EXCEPTION_IF_NULL(segments_ptr);
-    auto &segments = *segments_ptr;
-    auto &segment_bucket_sizes = *segment_bucket_sizes_ptr;
-    auto input_grad = param.input_grad_;
+    MS_EXCEPTION_IF_NULL(param.input_grad_->indices_);
+    MS_EXCEPTION_IF_NULL(workspace);
     if (param.thread_num_ < 1) {
       MS_EXCEPTION(ArgumentError) << "Input param thread num must > 0!";
     }
-    size_t thread_indices_size = input_grad->indices_size_ / param.thread_num_;
-    size_t left_indices_size = input_grad->indices_size_ % param.thread_num_;
-    std::vector<common::Task> tasks;
-    tasks.reserve(param.thread_num_);
-    segments.reserve(param.thread_num_);
-
-    size_t current_indices_offset = 0;
-    for (size_t i = 0; i < param.thread_num_; ++i) {
-      segment_bucket_sizes.emplace_back(std::make_shared<std::vector<size_t>>(param.thread_num_, 0));
-      size_t indices_size = thread_indices_size;
-      if (i < left_indices_size) {
-        indices_size += 1;
-      }
-      segments.emplace_back(std::make_shared<SparseGradient<T>>());
-      segments[i]->value_ = input_grad->value_ + current_indices_offset * param.value_stride_;
-      segments[i]->indices_ = input_grad->indices_ + current_indices_offset;
-      segments[i]->indices_size_ = indices_size;
-      auto task = [&segments, &param, &segment_bucket_sizes, i]() {
-        CalculateEachBucketSize<T>(segments[i], param.max_index_, segment_bucket_sizes[i].get());
-        return common::SUCCESS;
-      };
-      tasks.emplace_back(task);
-      current_indices_offset += indices_size;
+    size_t thread_num = param.thread_num_;
+    auto input_grad = param.input_grad_;
+    size_t thread_indices_size = input_grad->indices_size_ / thread_num;
+    size_t left_indices_size = input_grad->indices_size_ % thread_num;
+    auto &segment_offsets = workspace->segment_offsets_;
+    segment_offsets.resize(thread_num + 1);
+    segment_offsets[0] = 0;
+    for (size_t i = 0; i < thread_num; ++i) {
+      segment_offsets[i + 1] = segment_offsets[i] + thread_indices_size + (i < left_indices_size ? 1 : 0);
     }
-    common::ThreadPool::GetInstance().SyncRun(tasks);
-  }
-
-  template <typename T>
-  static void CopySegmentIndicesToBucket(const MultiThreadReduceSparseGradientParam<T> &param,
-                                         const std::shared_ptr<SparseGradient<T>> &segment, size_t bucket_offset,
-                                         const std::vector<std::shared_ptr<BucketSparseGradient<T>>> &buckets) {
-    MS_LOG(DEBUG) << "Start";
-    MS_EXCEPTION_IF_NULL(segment);
-    MS_EXCEPTION_IF_NULL(segment->indices_);
-    std::vector<size_t> bucket_data_num(param.thread_num_, 0);
-    for (size_t i = 0; i < segment->indices_size_; ++i) {
-      T index = segment->indices_[i];
-      if (index >= 0 && LongToSize(index) < param.max_index_) {
-        auto bucket_id = index % param.thread_num_;
-        auto bucket_index = bucket_data_num[bucket_id];
-        buckets[bucket_id]->indices_[bucket_index] = index;
-        buckets[bucket_id]->global_indices_[bucket_index] = bucket_offset + i;
-        bucket_data_num[bucket_id]++;
+    auto &segment_bucket_sizes = workspace->segment_bucket_offsets_;
+    segment_bucket_sizes.assign(thread_num * thread_num, 0);
+    auto count = [&param, &segment_offsets, &segment_bucket_sizes, thread_num](size_t i) {
+      size_t *bucket_sizes = segment_bucket_sizes.data() + i * thread_num;
+      const T *indices = param.input_grad_->indices_;
+      for (size_t k = segment_offsets[i]; k < segment_offsets[i + 1]; ++k) {
+        T index = indices[k];
+        if (index >= 0 && LongToSize(index) < param.max_index_) {
+          bucket_sizes[LongToSize(index) % thread_num]++;
+        }
       }
-    }
-    MS_LOG(DEBUG) << "End";
+    };
+    RunBucketTasks(param, workspace, count);
   }
 
+  // Writes the indices of every bucket to the output and their positions in the input to the workspace.
   template <typename T>
-  static void GatherSegmentIndicesToOutputBucket(
-    const MultiThreadReduceSparseGradientParam<T> &param,
-    const std::vector<std::shared_ptr<SparseGradient<T>>> &segments,
-    const std::vector<std::shared_ptr<std::vector<size_t>>> &segment_bucket_sizes,
-    std::vector<std::shared_ptr<BucketSparseGradient<T>>> *buckets_ptr) {
+  static void GatherSegmentIndicesToOutputBucket(const MultiThreadReduceSparseGradientParam<T> &param,
+                                                 BucketReduceWorkspace *workspace) {
     MS_EXCEPTION_IF_NULL(param.output_grad_);
     MS_EXCEPTION_IF_NULL(param.output_grad_->value_);
     MS_EXCEPTION_IF_NULL(param.output_grad_->indices_);
-    MS_EXCEPTION_IF_NULL(buckets_ptr);
-    auto &buckets = *buckets_ptr;
+    MS_EXCEPTION_IF_NULL(param.workspace_grad_);
+    MS_EXCEPTION_IF_NULL(param.workspace_grad_->indices_);
     size_t thread_num = param.thread_num_;
-    if (thread_num != segment_bucket_sizes.size()) {
-      MS_EXCEPTION(ArgumentError) << "Input param thread num not equal to segment size!";
-    }
-    std::vector<size_t> bucket_data_size(thread_num, 0);
-    for (size_t i = 0; i < thread_num; ++i) {
-      for (size_t j = 0; j < thread_num; ++j) {
-        bucket_data_size[j] += segment_bucket_sizes[i]->at(j);
+    auto &segment_bucket_offsets = workspace->segment_bucket_offsets_;
+    auto &bucket_offsets = workspace->bucket_offsets_;
+    bucket_offsets.resize(thread_num + 1);
+    size_t offset = 0;
+    for (size_t j = 0; j < thread_num; ++j) {
+      bucket_offsets[j] = offset;
+      for (size_t i = 0; i < thread_num; ++i) {
+        size_t size = segment_bucket_offsets[i * thread_num + j];
+        segment_bucket_offsets[i * thread_num + j] = offset;
+        offset += size;
       }
     }
-    size_t current_indices_offset = 0;
-    for (size_t i = 0; i < thread_num; ++i) {
-      buckets.emplace_back(std::make_shared<BucketSparseGradient<T>>());
-      buckets[i]->value_ = param.output_grad_->value_ + current_indices_offset * param.value_stride_;
-      buckets[i]->indices_ = param.output_grad_->indices_ + current_indices_offset;
-      buckets[i]->global_indices_ = param.workspace_grad_->indices_ + current_indices_offset;
-      buckets[i]->indices_size_ = bucket_data_size[i];
-      current_indices_offset += bucket_data_size[i];
+    bucket_offsets[thread_num] = offset;
+    if (offset > param.output_grad_->indices_size_ || offset > param.workspace_grad_->indices_size_) {
+      MS_LOG(EXCEPTION) << "The output and workspace of the sparse gradient reduce can hold "
+                        << param.output_grad_->indices_size_ << " and " << param.workspace_grad_->indices_size_
+                        << " indices, but " << offset << " indices are valid.";
     }
-    std::vector<size_t> tmp_bucket_data_size(thread_num, 0);
-    std::vector<std::vector<std::shared_ptr<BucketSparseGradient<T>>>> each_thread_buckets;
-    for (size_t i = 0; i < thread_num; ++i) {
-      std::vector<std::shared_ptr<BucketSparseGradient<T>>> thread_buckets;
-      for (size_t j = 0; j < thread_num; ++j) {
-        thread_buckets.emplace_back(std::make_shared<BucketSparseGradient<T>>());
-        thread_buckets[j]->indices_ = buckets[j]->indices_ + tmp_bucket_data_size[j];
-        thread_buckets[j]->global_indices_ = buckets[j]->global_indices_ + tmp_bucket_data_size[j];
-        thread_buckets[j]->value_ = buckets[j]->value_ + tmp_bucket_data_size[j] * param.value_stride_;
-        thread_buckets[j]->indices_size_ = segment_bucket_sizes[i]->at(j);
-        tmp_bucket_data_size[j] += segment_bucket_sizes[i]->at(j);
+    const auto &segment_offsets = workspace->segment_offsets_;
+    auto scatter = [&param, &segment_offsets, &segment_bucket_offsets, thread_num](size_t i) {
+      size_t *positions = segment_bucket_offsets.data() + i * thread_num;
+      const T *indices = param.input_grad_->indices_;
+      T *bucket_indices = param.output_grad_->indices_;
+      T *global_indices = param.workspace_grad_->indices_;
+      for (size_t k = segment_offsets[i]; k < segment_offsets[i + 1]; ++k) {
+        T index = indices[k];
+        if (index >= 0 && LongToSize(index) < param.max_index_) {
+          size_t position = positions[LongToSize(index) % thread_num]++;
+          bucket_indices[position] = index;
+          global_indices[position] = static_cast<T>(k);
+        }
       }
-      each_thread_buckets.emplace_back(thread_buckets);
-    }
-    std::vector<common::Task> tasks;
-    tasks.reserve(thread_num);
-    current_indices_offset = 0;
-    for (size_t i = 0; i < thread_num; ++i) {
-      auto task = [&param, &segments, &each_thread_buckets, i, current_indices_offset]() {
-        CopySegmentIndicesToBucket<T>(param, segments[i], current_indices_offset, each_thread_buckets[i]);
-        return common::SUCCESS;
-      };
-      tasks.emplace_back(task);
-      current_indices_offset += segments[i]->indices_size_;
-    }
-    common::ThreadPool::GetInstance().SyncRun(tasks);
+    };
+    RunBucketTasks(param, workspace, scatter);
   }
 
+  // Reduces the rows of bucket [start, end) into the workspace at start, in order of first appearance. The row of
+  // each input is gathered as the unique index it belongs to is found, so the gradient is read once.
   template <typename T>
-  static void SortAndReduceBucketSparseGradient(const MultiThreadReduceSparseGradientParam<T> &param,
-                                                const std::shared_ptr<BucketSparseGradient<T>> &bucket,
-                                                const std::shared_ptr<SparseGradient<T>> &reduced_bucket) {
-    MS_LOG(DEBUG) << "Start";
-    MS_EXCEPTION_IF_NULL(bucket);
-    MS_EXCEPTION_IF_NULL(bucket->value_);
-    MS_EXCEPTION_IF_NULL(bucket->indices_);
-    MS_EXCEPTION_IF_NULL(reduced_bucket);
-    MS_EXCEPTION_IF_NULL(reduced_bucket->value_);
-    MS_EXCEPTION_IF_NULL(reduced_bucket->indices_);
-    std::vector<std::pair<T, T>> sorted_indices;
-    sorted_indices.reserve(bucket->indices_size_);
-    for (size_t i = 0; i < bucket->indices_size_; ++i) {
-      T index = bucket->indices_[i];
-      T global_index = bucket->global_indices_[i];
-      sorted_indices.emplace_back(std::pair<T, T>(index, global_index));
-    }
-    std::sort(sorted_indices.begin(), sorted_indices.end());
-
-    float *global_value = param.input_grad_->value_;
-    size_t unique_indices_size = 0;
-    size_t max_length = reduced_bucket->indices_size_ * param.value_stride_;
-    T last_index{0};
-    size_t value_offset{0};
-    for (size_t i = 0; i < sorted_indices.size(); ++i) {
-      T index = sorted_indices[i].first;
-      T global_index = sorted_indices[i].second;
-      T global_value_offset = global_index * param.value_stride_;
-      if (i == 0 || index != last_index) {
-        if (i != 0) {
-          unique_indices_size++;
-        }
-        reduced_bucket->indices_[unique_indices_size] = index;
-        value_offset = unique_indices_size * param.value_stride_;
-        auto ret_code = memcpy_s(reduced_bucket->value_ + value_offset, (max_length - value_offset) * sizeof(float),
-                                 global_value + global_value_offset, param.value_stride_ * sizeof(float));
-        if (ret_code != EOK) {
-          MS_LOG(EXCEPTION) << "Failed to copy data!";
-        }
+  static size_t ReduceBucketSparseGradient(const MultiThreadReduceSparseGradientParam<T> &param, size_t start,
+                                           size_t end) {
+    static thread_local BucketIndexTable<T> table;
+    table.Reset(end - start);
+    size_t stride = param.value_stride_;
+    const float *global_value = param.input_grad_->value_;
+    const T *bucket_indices = param.output_grad_->indices_ + start;
+    const T *global_indices = param.workspace_grad_->indices_ + start;
+    T *reduced_indices = param.workspace_grad_->indices_ + start;
+    float *reduced_value = param.workspace_grad_->value_ + start * stride;
+    size_t size = end - start;
+    size_t unique_size = 0;
+    for (size_t i = 0; i < size; ++i) {
+      if (i + kRowPrefetchDistance < size) {
+        __builtin_prefetch(global_value + LongToSize(global_indices[i + kRowPrefetchDistance]) * stride);
+      }
+      T index = bucket_indices[i];
+      const float *row = global_value + LongToSize(global_indices[i]) * stride;
+      size_t reduced_row = table.FindOrInsert(index, unique_size);
+      if (reduced_row == unique_size) {
+        // The reduced rows never overtake the inputs, so the position of this row has been read already.
+        reduced_indices[unique_size++] = index;
+        std::copy(row, row + stride, reduced_value + reduced_row * stride);
       } else {
-        for (size_t j = 0; j < param.value_stride_; ++j) {
-          reduced_bucket->value_[value_offset + j] += global_value[global_value_offset + j];
-        }
+        float *reduced = reduced_value + reduced_row * stride;
+        (void)ElementAdd(reduced, row, reduced, SizeToInt(stride));
       }
-      last_index = index;
     }
-    reduced_bucket->indices_size_ = unique_indices_size;
-    MS_LOG(DEBUG) << "End";
+    return unique_size;
   }
 
   template <typename T>
-  static void ReduceBucketSparseGradient(const MultiThreadReduceSparseGradientParam<T> &param,
-                                         const std::shared_ptr<BucketSparseGradient<T>> &bucket,
-                                         const std::shared_ptr<SparseGradient<T>> &reduced_bucket) {
-    MS_LOG(DEBUG) << "Start";
-    MS_EXCEPTION_IF_NULL(bucket);
-    MS_EXCEPTION_IF_NULL(bucket->value_);
-    MS_EXCEPTION_IF_NULL(bucket->indices_);
-    MS_EXCEPTION_IF_NULL(reduced_bucket);
-    MS_EXCEPTION_IF_NULL(reduced_bucket->value_);
-    MS_EXCEPTION_IF_NULL(reduced_bucket->indices_);
+  static size_t SortAndReduceBucketSparseGradient(const MultiThreadReduceSparseGradientParam<T> &param, size_t start,
+                                                  size_t end) {
+    static thread_local std::vector<std::pair<T, T>> sorted_indices;
+    size_t stride = param.value_stride_;
+    const float *global_value = param.input_grad_->value_;
+    const T *bucket_indices = param.output_grad_->indices_ + start;
+    const T *global_indices = param.workspace_grad_->indices_ + start;
+    size_t size = end - start;
+    sorted_indices.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+      sorted_indices[i] = std::make_pair(bucket_indices[i], global_indices[i]);
+    }
+    std::sort(sorted_indices.begin(), sorted_indices.end());
 
-    float *global_value = param.input_grad_->value_;
-    std::unordered_map<T, size_t> index_map;
-    size_t unique_indices_size = 0;
-    size_t max_length = reduced_bucket->indices_size_ * param.value_stride_;
-    for (size_t i = 0; i < bucket->indices_size_; ++i) {
-      T index = bucket->indices_[i];
-      T global_index = bucket->global_indices_[i];
-      auto iter = index_map.find(index);
-      if (iter == index_map.end()) {
-        reduced_bucket->indices_[unique_indices_size] = index;
-        size_t start_index = unique_indices_size * param.value_stride_;
-        index_map[index] = start_index;
-        auto ret_code =
-          memcpy_s(reduced_bucket->value_ + start_index, (max_length - start_index) * sizeof(float),
-                   global_value + global_index * param.value_stride_, param.value_stride_ * sizeof(float));
-        if (ret_code != EOK) {
-          MS_LOG(EXCEPTION) << "Failed to copy data!";
-        }
-        unique_indices_size++;
+    T *reduced_indices = param.workspace_grad_->indices_ + start;
+    float *reduced_value = param.workspace_grad_->value_ + start * stride;
+    size_t unique_size = 0;
+    for (size_t i = 0; i < size; ++i) {
+      if (i + kRowPrefetchDistance < size) {
+        __builtin_prefetch(global_value + LongToSize(sorted_indices[i + kRowPrefetchDistance].second) * stride);
+      }
+      T index = sorted_indices[i].first;
+      const float *row = global_value + LongToSize(sorted_indices[i].second) * stride;
+      if (unique_size == 0 || reduced_indices[unique_size - 1] != index) {
+        reduced_indices[unique_size] = index;
+        std::copy(row, row + stride, reduced_value + unique_size * stride);
+        unique_size++;
       } else {
-        size_t start_index = iter->second;
-        size_t end_index = start_index + param.value_stride_;
-        for (size_t j = start_index, k = global_index * param.value_stride_; j < end_index; ++j, ++k) {
-          reduced_bucket->value_[j] += global_value[k];
-        }
+        float *reduced = reduced_value + (unique_size - 1) * stride;
+        (void)ElementAdd(reduced, row, reduced, SizeToInt(stride));
       }
     }
-    reduced_bucket->indices_size_ = unique_indices_size;
-    MS_LOG(DEBUG) << "End";
+    return unique_size;
   }
 
   template <typename T>
-  static void ReduceBucketSparseGradientToWorkspace(
-    const MultiThreadReduceSparseGradientParam<T> &param,
-    const std::vector<std::shared_ptr<BucketSparseGradient<T>>> &buckets,
-    std::vector<std::shared_ptr<SparseGradient<T>>> *reduced_buckets_ptr) {
-    MS_EXCEPTION_IF_NULL(param.workspace_grad_);
+  static void ReduceBucketSparseGradientToWorkspace(const MultiThreadReduceSparseGradientParam<T> &param,
+                                                    BucketReduceWorkspace *workspace) {
+    MS_EXCEPTION_IF_NULL(param.input_grad_->value_);
     MS_EXCEPTION_IF_NULL(param.workspace_grad_->value_);
-    MS_EXCEPTION_IF_NULL(param.workspace_grad_->indices_);
-    MS_EXCEPTION_IF_NULL(reduced_buckets_ptr);
-    auto &reduced_buckets = *reduced_buckets_ptr;
-    size_t thread_num = buckets.size();
-    std::vector<common::Task> tasks;
-    tasks.reserve(thread_num);
-
-    size_t current_indices_offset = 0;
-    for (size_t i = 0; i < thread_num; ++i) {
-      reduced_buckets.emplace_back(std::make_shared<SparseGradient<T>>());
-      reduced_buckets[i]->value_ = param.workspace_grad_->value_ + current_indices_offset * param.value_stride_;
-      reduced_buckets[i]->indices_ = param.workspace_grad_->indices_ + current_indices_offset;
-      reduced_buckets[i]->indices_size_ = buckets[i]->indices_size_;
-      auto task = [&param, &buckets, &reduced_buckets, i]() {
-        if (param.use_sort_reduce_) {
-          SortAndReduceBucketSparseGradient<T>(param, buckets[i], reduced_buckets[i]);
-        } else {
-          ReduceBucketSparseGradient<T>(param, buckets[i], reduced_buckets[i]);
-        }
-        return common::SUCCESS;
-      };
-      tasks.emplace_back(task);
-      current_indices_offset += buckets[i]->indices_size_;
-    }
-    common::ThreadPool::GetInstance().SyncRun(tasks);
+    const auto &bucket_offsets = workspace->bucket_offsets_;
+    auto &unique_sizes = workspace->unique_sizes_;
+    unique_sizes.assign(param.thread_num_, 0);
+    auto reduce = [&param, &bucket_offsets, &unique_sizes](size_t i) {
+      if (param.use_sort_reduce_) {
+        unique_sizes[i] = SortAndReduceBucketSparseGradient<T>(param, bucket_offsets[i], bucket_offsets[i + 1]);
+      } else {
+        unique_sizes[i] = ReduceBucketSparseGradient<T>(param, bucket_offsets[i], bucket_offsets[i + 1]);
+      }
+    };
+    RunBucketTasks(param, workspace, reduce);
   }
 
+  // Packs the reduced buckets into the output, every thread moving one bucket.
   template <typename T>
   static void MergeReduceSparseGradient(const MultiThreadReduceSparseGradientParam<T> &param,
-                                        const std::vector<std::shared_ptr<SparseGradient<T>>> &reduced_buckets) {
-    MS_EXCEPTION_IF_NULL(param.output_grad_);
+                                        BucketReduceWorkspace *workspace) {
     auto output_grad = param.output_grad_;
-    MS_EXCEPTION_IF_NULL(output_grad->value_);
-    MS_EXCEPTION_IF_NULL(output_grad->indices_);
-    size_t stride_data_size = param.value_stride_ * sizeof(float);
-    size_t unique_indices_size = 0;
-    for (size_t i = 0; i < reduced_buckets.size(); ++i) {
-      auto &bucket = reduced_buckets[i];
-      MS_EXCEPTION_IF_NULL(bucket);
-      if (bucket->indices_size_ == 0) {
-        continue;
-      }
-      auto ret_code = memcpy_s(output_grad->value_ + unique_indices_size * param.value_stride_,
-                               (output_grad->indices_size_ - unique_indices_size) * stride_data_size, bucket->value_,
-                               bucket->indices_size_ * stride_data_size);
-      if (ret_code != EOK) {
-        MS_LOG(EXCEPTION) << "Failed to copy data!";
-      }
-      ret_code = memcpy_s(output_grad->indices_ + unique_indices_size,
-                          (output_grad->indices_size_ - unique_indices_size) * sizeof(T), bucket->indices_,
-                          bucket->indices_size_ * sizeof(T));
-      if (ret_code != EOK) {
-        MS_LOG(EXCEPTION) << "Failed to copy data!";
-      }
-      unique_indices_size += bucket->indices_size_;
+    const auto &bucket_offsets = workspace->bucket_offsets_;
+    const auto &unique_sizes = workspace->unique_sizes_;
+    // The segment offsets are not needed anymore and receive the position of every bucket in the output.
+    auto &output_offsets = workspace->segment_offsets_;
+    output_offsets[0] = 0;
+    for (size_t i = 0; i < param.thread_num_; ++i) {
+      output_offsets[i + 1] = output_offsets[i] + unique_sizes[i];
     }
-    output_grad->indices_size_ = unique_indices_size;
+    auto merge = [&param, &bucket_offsets, &unique_sizes, &output_offsets](size_t i) {
+      size_t stride = param.value_stride_;
+      const T *indices = param.workspace_grad_->indices_ + bucket_offsets[i];
+      const float *value = param.workspace_grad_->value_ + bucket_offsets[i] * stride;
+      std::copy(indices, indices + unique_sizes[i], param.output_grad_->indices_ + output_offsets[i]);
+      std::copy(value, value + unique_sizes[i] * stride, param.output_grad_->value_ + output_offsets[i] * stride);
+    };
+    RunBucketTasks(param, workspace, merge);
+    output_grad->indices_size_ = output_offsets[param.thread_num_];
   }
 
  protected:
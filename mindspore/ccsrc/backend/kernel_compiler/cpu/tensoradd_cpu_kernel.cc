@@ -16,6 +16,7 @@
 #include "backend/kernel_compiler/cpu/tensoradd_cpu_kernel.h"
 #include <functional>
 #include <vector>
+#include "backend/kernel_compiler/cpu/elementwise_broadcast_impl.h"
 
 namespace mindspore {
 namespace kernel {
@@ -26,6 +27,7 @@ void TensorAddCPUKernel<T>::InitKernel(const CNodePtr &kernel_node) {
   input_shape_a_ = AnfAlgo::GetInputDeviceShape(kernel_node, 0);
   input_shape_b_ = AnfAlgo::GetInputDeviceShape(kernel_node, 1);
   output_shape_ = AnfAlgo::GetOutputDeviceShape(kernel_node, 0);
+  broadcast_plan_ = BroadcastRowPlan(input_shape_a_, input_shape_b_, output_shape_);
 }
 
 template <typename T>
@@ -35,26 +37,7 @@ bool TensorAddCPUKernel<T>::Launch(const std::vector<kernel::AddressPtr> &inputs
   T *input_addr_a = reinterpret_cast<T *>(inputs[0]->addr);
   T *input_addr_b = reinterpret_cast<T *>(inputs[1]->addr);
   T *output_addr = reinterpret_cast<T *>(outputs[0]->addr);
-  size_t output_size = outputs[0]->size / sizeof(T);
-  if (input_shape_a_ == input_shape_b_) {
-    auto task = [output_addr, input_addr_a, input_addr_b](size_t start, size_t end) {
-      for (size_t i = start; i < end; ++i) {
-        output_addr[i] = input_addr_a[i] + input_addr_b[i];
-      }
-    };
-    CPUKernelUtils::ParallelFor(task, output_size);
-  } else {  // Broadcast
-    BroadcastIterator base_iter(input_shape_a_, input_shape_b_, output_shape_);
-    auto task = [&base_iter, output_addr, input_addr_a, input_addr_b](size_t start, size_t end) {
-      auto iter = base_iter;
-      iter.SetPos(start);
-      for (size_t i = start; i < end; ++i) {
-        output_addr[i] = input_addr_a[iter.GetInputPosA()] + input_addr_b[iter.GetInputPosB()];
-        iter.GenNextPos();
-      }
-    };
-    CPUKernelUtils::ParallelFor(task, output_size);
-  }
+  BroadcastElementwise(broadcast_plan_, input_addr_a, input_addr_b, output_addr, AddFunc());
   return true;
 }
 }  // namespace kernel
@@ -38,6 +38,7 @@ class TensorAddCPUKernel : public CPUKernel {
   std::vector<size_t> input_shape_a_;
   std::vector<size_t> input_shape_b_;
   std::vector<size_t> output_shape_;
+  BroadcastRowPlan broadcast_plan_;
 };
 
 MS_REG_CPU_KERNEL_T(Add, KernelAttr(), TensorAddCPUKernel, int32_t);
@@ -16,12 +16,11 @@
 #ifndef MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_TRANSPOSE_CPU_KERNEL_H_
 #define MINDSPORE_CCSRC_BACKEND_KERNEL_COMPILER_CPU_TRANSPOSE_CPU_KERNEL_H_
 #include <vector>
-#include <unordered_map>
 #include <memory>
 #include <string>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
-#include "nnacl/base/transpose_base.h"
+#include "common/transpose.h"
 
 namespace mindspore {
 namespace kernel {
@@ -36,21 +35,11 @@ class TransposeCPUFwdKernel : public CPUKernel {
               const std::vector<AddressPtr> &outputs) override;
 
  private:
-  template <typename T>
-  void LaunchKernel(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &outputs);
-
-  template <typename T>
-  void ParallelRun(const T *input_addr, T *output_addr, const int *output_shape, size_t count);
-
-  TransposeParameter transpose_param_;
   std::vector<size_t> input_shape_;
   std::vector<size_t> output_shape_;
   std::vector<size_t> axes_;
   TypeId dtype_{kTypeUnknown};
-  using TypeKernel =
-    std::function<void(TransposeCPUFwdKernel *, const std::vector<AddressPtr> &, const std::vector<AddressPtr> &)>;
-  std::unordered_map<TypeId, TypeKernel> launch_map_;
-  TypeKernel launch_func_;
+  common::TransposePlan transpose_plan_;
 };
 MS_REG_CPU_KERNEL(Transpose, KernelAttr(), TransposeCPUFwdKernel);
 }  // namespace kernel
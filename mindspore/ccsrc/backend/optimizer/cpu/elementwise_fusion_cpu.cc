@@ -0,0 +1,193 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "backend/optimizer/cpu/elementwise_fusion_cpu.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
+#include "backend/kernel_compiler/cpu/fused_elementwise_cpu_kernel.h"
+#include "backend/kernel_compiler/kernel_build_info.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "utils/context/graph_kernel_flags.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+constexpr size_t kMinFusedOpNum = 2;
+constexpr size_t kMaxFusedOpNum = 32;
+
+size_t ShapeSize(const std::vector<size_t> &shape) {
+  return std::accumulate(shape.begin(), shape.end(), size_t(1), std::multiplies<size_t>());
+}
+
+void SetFusedNodeBuildInfo(const CNodePtr &node, size_t input_num) {
+  kernel::KernelBuildInfo::KernelBuildInfoBuilder builder;
+  builder.SetInputsFormat(std::vector<std::string>(input_num, kOpFormat_DEFAULT));
+  builder.SetInputsDeviceType(std::vector<TypeId>(input_num, kNumberTypeFloat32));
+  builder.SetOutputsFormat({kOpFormat_DEFAULT});
+  builder.SetOutputsDeviceType({kNumberTypeFloat32});
+  builder.SetKernelType(UNKNOWN_KERNEL_TYPE);
+  AnfAlgo::SetSelectKernelBuildInfo(builder.Build(), node.get());
+}
+
+CNodePtr CreateFusedNode(const FuncGraphPtr &graph, const std::vector<AnfNodePtr> &cluster) {
+  std::vector<AnfNodePtr> fused_inputs;
+  std::unordered_map<AnfNodePtr, int64_t> input_index;
+  std::unordered_map<AnfNodePtr, int64_t> op_index;
+  std::vector<std::string> op_names;
+  std::vector<int64_t> op_inputs;
+  for (size_t i = 0; i < cluster.size(); ++i) {
+    auto cnode = cluster[i]->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(cnode);
+    op_names.push_back(AnfAlgo::GetCNodeName(cnode));
+    for (size_t j = 1; j < cnode->size(); ++j) {
+      const auto &input = cnode->input(j);
+      auto iter = op_index.find(input);
+      if (iter != op_index.end()) {
+        op_inputs.push_back(-iter->second - 1);
+        continue;
+      }
+      if (input_index.count(input) == 0) {
+        input_index[input] = SizeToLong(fused_inputs.size());
+        fused_inputs.push_back(input);
+      }
+      op_inputs.push_back(input_index[input]);
+    }
+    op_index[cluster[i]] = SizeToLong(i);
+  }
+
+  std::vector<AnfNodePtr> new_inputs = {NewValueNode(std::make_shared<Primitive>(kFusedElementwiseOpName))};
+  (void)new_inputs.insert(new_inputs.end(), fused_inputs.begin(), fused_inputs.end());
+  auto fused_node = graph->NewCNode(new_inputs);
+  MS_EXCEPTION_IF_NULL(fused_node);
+  const auto &root = cluster.back();
+  fused_node->set_abstract(root->abstract());
+  fused_node->set_scope(root->scope());
+  AnfAlgo::SetNodeAttr(kAttrFusedOpNames, MakeValue(op_names), fused_node);
+  AnfAlgo::SetNodeAttr(kAttrFusedOpInputs, MakeValue(op_inputs), fused_node);
+  SetFusedNodeBuildInfo(fused_node, fused_inputs.size());
+  return fused_node;
+}
+}  // namespace
+
+bool ElementwiseFusionCPU::IsFusible(const AnfNodePtr &node) const {
+  if (!AnfAlgo::IsRealCNodeKernel(node)) {
+    return false;
+  }
+  auto op_name = AnfAlgo::GetCNodeName(node);
+  if (!kernel::FusedElementwiseCPUKernel::IsSupportedOp(op_name) ||
+      std::find(disable_ops_.begin(), disable_ops_.end(), op_name) != disable_ops_.end()) {
+    return false;
+  }
+  if (!enable_ops_only_.empty() &&
+      std::find(enable_ops_only_.begin(), enable_ops_only_.end(), op_name) == enable_ops_only_.end()) {
+    return false;
+  }
+  auto cnode = node->cast<CNodePtr>();
+  MS_EXCEPTION_IF_NULL(cnode);
+  size_t input_num = AnfAlgo::GetInputTensorNum(cnode);
+  if (input_num != kernel::FusedElementwiseCPUKernel::GetOpInputNum(op_name) || cnode->size() != input_num + 1 ||
+      AnfAlgo::GetOutputTensorNum(cnode) != 1 || AnfAlgo::IsDynamicShape(cnode)) {
+    return false;
+  }
+  if (AnfAlgo::GetOutputDeviceDataType(cnode, 0) != kNumberTypeFloat32 ||
+      AnfAlgo::GetOutputFormat(cnode, 0) != kOpFormat_DEFAULT) {
+    return false;
+  }
+  // Every input must be a scalar or have as many elements as the output, so that no real broadcast is needed.
+  size_t output_size = ShapeSize(AnfAlgo::GetOutputInferShape(cnode, 0));
+  if (output_size == 0) {
+    return false;
+  }
+  for (size_t i = 0; i < input_num; ++i) {
+    if (AnfAlgo::GetInputDeviceDataType(cnode, i) != kNumberTypeFloat32 ||
+        AnfAlgo::GetInputFormat(cnode, i) != kOpFormat_DEFAULT) {
+      return false;
+    }
+    size_t input_size = ShapeSize(AnfAlgo::GetPrevNodeOutputInferShape(cnode, i));
+    if (input_size != 1 && input_size != output_size) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ElementwiseFusionCPU::Run(const FuncGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto manager = graph->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  const auto &flags = context::GraphKernelFlags::GetInstance();
+  enable_ops_only_ = flags.enable_cluster_ops_only;
+  disable_ops_ = flags.disable_cluster_ops;
+
+  std::vector<AnfNodePtr> node_list = TopoSort(graph->get_return());
+  std::unordered_map<AnfNodePtr, size_t> topo_index;
+  for (size_t i = 0; i < node_list.size(); ++i) {
+    topo_index[node_list[i]] = i;
+  }
+  const auto &node_users = manager->node_users();
+  std::unordered_set<AnfNodePtr> fused_nodes;
+  bool changed = false;
+  // Visit the consumers first, so that each cluster grows from its output towards its inputs.
+  for (auto iter = node_list.rbegin(); iter != node_list.rend(); ++iter) {
+    const auto &root = *iter;
+    if (fused_nodes.count(root) != 0 || !IsFusible(root)) {
+      continue;
+    }
+    size_t output_size = ShapeSize(AnfAlgo::GetOutputInferShape(root, 0));
+    std::vector<AnfNodePtr> cluster = {root};
+    std::unordered_set<AnfNodePtr> cluster_set = {root};
+    for (size_t i = 0; i < cluster.size() && cluster.size() < kMaxFusedOpNum; ++i) {
+      auto cnode = cluster[i]->cast<CNodePtr>();
+      for (size_t j = 1; j < cnode->size() && cluster.size() < kMaxFusedOpNum; ++j) {
+        const auto &input = cnode->input(j);
+        if (cluster_set.count(input) != 0 || fused_nodes.count(input) != 0 || !IsFusible(input) ||
+            ShapeSize(AnfAlgo::GetOutputInferShape(input, 0)) != output_size) {
+          continue;
+        }
+        // An intermediate result can only be dropped when all its users are inside the cluster.
+        auto users_iter = node_users.find(input);
+        if (users_iter == node_users.end() ||
+            !std::all_of(users_iter->second.begin(), users_iter->second.end(),
+                         [&cluster_set](const auto &user) { return cluster_set.count(user.first) != 0; })) {
+          continue;
+        }
+        cluster.push_back(input);
+        (void)cluster_set.insert(input);
+      }
+    }
+    if (cluster.size() < kMinFusedOpNum) {
+      continue;
+    }
+
+    std::sort(cluster.begin(), cluster.end(),
+              [&topo_index](const AnfNodePtr &a, const AnfNodePtr &b) { return topo_index[a] < topo_index[b]; });
+    auto fused_node = CreateFusedNode(graph, cluster);
+    MS_LOG(INFO) << "Fuse " << cluster.size() << " elementwise ops into " << fused_node->fullname_with_scope()
+                 << ", output node: " << root->fullname_with_scope();
+    (void)manager->Replace(root, fused_node);
+    fused_nodes.insert(cluster.begin(), cluster.end());
+    changed = true;
+  }
+  return changed;
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,44 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_ELEMENTWISE_FUSION_CPU_H
+#define MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_ELEMENTWISE_FUSION_CPU_H
+
+#include <string>
+#include <vector>
+#include "backend/optimizer/common/optimizer.h"
+#include "ir/anf.h"
+
+namespace mindspore {
+namespace opt {
+// Clusters chains of float32 elementwise kernels into FusedElementwise nodes, which the CPU backend runs as a single
+// loop without writing the intermediate tensors to memory. A node joins the cluster of its only user, so every
+// cluster is a tree with one output and the fusion can not create cycles.
+class ElementwiseFusionCPU : public Pass {
+ public:
+  explicit ElementwiseFusionCPU(const std::string &name) : Pass("elementwise_fusion_cpu") {}
+  ~ElementwiseFusionCPU() override = default;
+  bool Run(const FuncGraphPtr &graph) override;
+
+ private:
+  bool IsFusible(const AnfNodePtr &node) const;
+  std::vector<std::string> enable_ops_only_;
+  std::vector<std::string> disable_ops_;
+};
+}  // namespace opt
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_BACKEND_OPTIMIZER_CPU_ELEMENTWISE_FUSION_CPU_H
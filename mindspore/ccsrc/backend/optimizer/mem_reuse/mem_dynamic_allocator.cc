@@ -15,24 +15,157 @@
  */
 
 #include "backend/optimizer/mem_reuse/mem_dynamic_allocator.h"
+#include <unordered_map>
 #include "utils/ms_utils.h"
 #include "utils/convert_utils.h"
 #include "utils/log_adapter.h"
 
 namespace mindspore {
 namespace device {
+namespace {
+// The empty, erased and being inserted slot keys of the size record, which can't be device addresses.
+constexpr uintptr_t kEmptyRecordKey = 0;
+constexpr uintptr_t kErasedRecordKey = 1;
+constexpr uintptr_t kBusyRecordKey = 2;
+
+// The living memory pools by the pool id, for returning the thread memory caches when the threads exit.
+std::mutex &MemPoolRegistryMutex() {
+  static auto *registry_mutex = new std::mutex();
+  return *registry_mutex;
+}
+
+std::unordered_map<size_t, DynamicMemPoolBestFit *> &MemPoolRegistry() {
+  static auto *registry = new std::unordered_map<size_t, DynamicMemPoolBestFit *>();
+  return *registry;
+}
+}  // namespace
+
+size_t ThreadMemCacheRecord::SlotIndex(uintptr_t key, size_t probe) {
+  // Fibonacci hashing spreads the memory bufs of the same offset in different memory blocks.
+  constexpr uint64_t kHashMultiplier = 0x9E3779B97F4A7C15ULL;
+  return (static_cast<size_t>((static_cast<uint64_t>(key) * kHashMultiplier) >> 32) + probe) &
+         (THREAD_MEM_CACHE_RECORD_CAPACITY - 1);
+}
+
+bool ThreadMemCacheRecord::Insert(const DeviceMemPtr &device_addr, size_t size) {
+  auto key = reinterpret_cast<uintptr_t>(device_addr);
+  for (size_t probe = 0; probe < THREAD_MEM_CACHE_RECORD_MAX_PROBE; ++probe) {
+    auto &slot = slots_[SlotIndex(key, probe)];
+    auto slot_key = slot.key_.load(std::memory_order_relaxed);
+    if (slot_key != kEmptyRecordKey && slot_key != kErasedRecordKey) {
+      continue;
+    }
+    // Reserve the slot first, so the finder never sees the key without its size.
+    if (slot.key_.compare_exchange_strong(slot_key, kBusyRecordKey, std::memory_order_acquire)) {
+      slot.size_.store(size, std::memory_order_relaxed);
+      slot.key_.store(key, std::memory_order_release);
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t ThreadMemCacheRecord::Find(const DeviceMemPtr &device_addr) const {
+  auto key = reinterpret_cast<uintptr_t>(device_addr);
+  for (size_t probe = 0; probe < THREAD_MEM_CACHE_RECORD_MAX_PROBE; ++probe) {
+    const auto &slot = slots_[SlotIndex(key, probe)];
+    auto slot_key = slot.key_.load(std::memory_order_acquire);
+    if (slot_key == key) {
+      return slot.size_.load(std::memory_order_relaxed);
+    }
+    // The slot before the inserted one is never empty again, so the empty slot ends the probe.
+    if (slot_key == kEmptyRecordKey) {
+      return 0;
+    }
+  }
+  return 0;
+}
+
+void ThreadMemCacheRecord::Erase(const DeviceMemPtr &device_addr) {
+  auto key = reinterpret_cast<uintptr_t>(device_addr);
+  for (size_t probe = 0; probe < THREAD_MEM_CACHE_RECORD_MAX_PROBE; ++probe) {
+    auto &slot = slots_[SlotIndex(key, probe)];
+    auto slot_key = slot.key_.load(std::memory_order_acquire);
+    if (slot_key == key) {
+      slot.key_.store(kErasedRecordKey, std::memory_order_release);
+      return;
+    }
+    if (slot_key == kEmptyRecordKey) {
+      return;
+    }
+  }
+}
+
+void ThreadMemCacheRecord::Clear() {
+  for (size_t i = 0; i < THREAD_MEM_CACHE_RECORD_CAPACITY; ++i) {
+    slots_[i].key_.store(kEmptyRecordKey, std::memory_order_relaxed);
+  }
+}
+
+class DynamicMemPoolBestFit::ThreadMemCacheHolder {
+ public:
+  ThreadMemCacheHolder() = default;
+  ~ThreadMemCacheHolder() {
+    std::lock_guard<std::mutex> locker(MemPoolRegistryMutex());
+    auto &registry = MemPoolRegistry();
+    for (auto &iter : mem_caches_) {
+      // The memory pool may be destroyed before the thread exits.
+      auto pool_iter = registry.find(iter.first);
+      if (pool_iter != registry.end()) {
+        pool_iter->second->ReturnExitedThreadMemCache(iter.second);
+      }
+    }
+  }
+  // The thread memory caches of current thread by the pool id.
+  std::unordered_map<size_t, ThreadMemCachePtr> mem_caches_;
+};
+
+std::atomic<size_t> DynamicMemPoolBestFit::pool_id_counter_{0};
+
+DynamicMemPoolBestFit::DynamicMemPoolBestFit() : pool_id_(pool_id_counter_++) {
+  std::lock_guard<std::mutex> locker(MemPoolRegistryMutex());
+  MemPoolRegistry()[pool_id_] = this;
+}
+
 DynamicMemPoolBestFit::~DynamicMemPoolBestFit() {
+  {
+    std::lock_guard<std::mutex> locker(MemPoolRegistryMutex());
+    (void)MemPoolRegistry().erase(pool_id_);
+  }
   global_mem_block_list_.clear();
   global_idle_mem_buf_map_.clear();
 }
 
 DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size) {
   size_t align_size = AlignMemorySize(size);
+  if (!IsThreadMemCacheable(align_size)) {
+    return AllocTensorMemFromPool(align_size);
+  }
+  // The fast path: pop the memory buf from the size class bin of current thread without any lock, its size record is
+  // kept while it is cached.
+  DeviceMemPtr device_addr = AllocFromThreadMemCache(align_size);
+  if (device_addr != nullptr) {
+    return device_addr;
+  }
+  device_addr = AllocTensorMemFromPool(align_size);
+  // The memory buf without the size record is freed to the global memory pool directly.
+  if (device_addr != nullptr) {
+    (void)thread_mem_cache_record_.Insert(device_addr, align_size);
+  }
+  return device_addr;
+}
+
+DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMemFromPool(size_t size) {
   std::lock_guard<std::mutex> locker(mutex_);
   // Find the idle memory buf by tensor size, if not find, then add new memory block and memory buf.
-  DeviceMemPtr device_addr = FindIdleMemBuf(align_size);
+  DeviceMemPtr device_addr = FindIdleMemBuf(size);
   if (!device_addr) {
-    device_addr = AddMemBlockAndMemBuf(align_size);
+    device_addr = AddMemBlockAndMemBuf(size);
+  }
+  // Combine the thread cached memory bufs lazily when the memory is not enough, and find the idle memory buf again.
+  if (!device_addr && thread_cached_mem_statistics_ > 0) {
+    ReclaimThreadMemCaches();
+    device_addr = FindIdleMemBuf(size);
   }
   return device_addr;
 }
@@ -40,8 +173,8 @@ DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size) {
 std::vector<DeviceMemPtr> DynamicMemPoolBestFit::AllocContinuousTensorMem(size_t total_size,
                                                                           std::vector<size_t> size_list) {
   std::vector<DeviceMemPtr> device_addr_list;
-  // Pre-alloc the one whole piece memory.
-  auto device_addr = AllocTensorMem(total_size);
+  // Pre-alloc the one whole piece memory, which can't come from the thread memory cache because it will be divided.
+  auto device_addr = AllocTensorMemFromPool(AlignMemorySize(total_size));
   if (!device_addr) {
     return device_addr_list;
   }
@@ -95,10 +228,7 @@ DeviceMemPtr DynamicMemPoolBestFit::FindIdleMemBuf(size_t size) {
       DivideMemBuf(size, mem_buf);
     }
     // Memory statistics
-    total_used_mem_statistics_ += mem_buf->size_;
-    if (total_used_mem_statistics_ > used_mem_peak_statistics_) {
-      used_mem_peak_statistics_ = total_used_mem_statistics_;
-    }
+    IncreaseUsedMemStatistics(mem_buf->size_);
     return mem_buf->device_addr_;
   }
   return nullptr;
@@ -133,10 +263,7 @@ DeviceMemPtr DynamicMemPoolBestFit::AddMemBlockAndMemBuf(size_t size) {
   }
   // Memory statistics
   total_mem_statistics_ += real_alloc_size;
-  total_used_mem_statistics_ += mem_buf->size_;
-  if (total_used_mem_statistics_ > used_mem_peak_statistics_) {
-    used_mem_peak_statistics_ = total_used_mem_statistics_;
-  }
+  IncreaseUsedMemStatistics(mem_buf->size_);
   return mem_buf->device_addr_;
 }
 
@@ -191,9 +318,32 @@ DynamicMemBlockPtr DynamicMemPoolBestFit::FindMemBlock(const DeviceMemPtr &devic
   return nullptr;
 }
 
+void DynamicMemPoolBestFit::IncreaseUsedMemStatistics(size_t size) {
+  size_t used_size = (total_used_mem_statistics_ += size);
+  size_t peak_size = used_mem_peak_statistics_;
+  while (used_size > peak_size && !used_mem_peak_statistics_.compare_exchange_weak(peak_size, used_size)) {
+  }
+}
+
 void DynamicMemPoolBestFit::FreeTensorMem(const DeviceMemPtr &device_addr) {
   MS_EXCEPTION_IF_NULL(device_addr);
+  size_t align_size = 0;
+  if (enable_thread_mem_cache_) {
+    // Only the memory buf alloc by the cacheable path has the size record.
+    align_size = thread_mem_cache_record_.Find(device_addr);
+    if (align_size != 0 && FreeToThreadMemCache(device_addr, align_size)) {
+      return;
+    }
+  }
   std::lock_guard<std::mutex> locker(mutex_);
+  if (align_size != 0) {
+    thread_mem_cache_record_.Erase(device_addr);
+  }
+  FreeTensorMemToPool(device_addr);
+}
+
+void DynamicMemPoolBestFit::FreeTensorMemToPool(const DeviceMemPtr &device_addr) {
+  MS_EXCEPTION_IF_NULL(device_addr);
   auto mem_block = FindMemBlock(device_addr);
   if (mem_block == nullptr) {
     // May be destroy the memory pool first, then destroy the address, so this is normal case.
@@ -268,9 +418,30 @@ void DynamicMemPoolBestFit::EraseIdleMemBuf(size_t size, const DeviceMemPtr &dev
 }
 
 void DynamicMemPoolBestFit::ReleaseDeviceRes() {
+  auto fragment_info = fragment_mem_statistics();
   std::lock_guard<std::mutex> locker(mutex_);
   MS_LOG(INFO) << "The dynamic memory pool total size is " << total_mem_statistics_ << ", total used size is "
-               << total_used_mem_statistics_ << ", used peak size is " << used_mem_peak_statistics_ << ".";
+               << total_used_mem_statistics_ << ", used peak size is " << used_mem_peak_statistics_
+               << ", thread cached size is " << fragment_info.thread_cached_mem_size_ << ", idle size is "
+               << fragment_info.idle_mem_size_ << ", idle mem_buf counts is " << fragment_info.idle_mem_buf_count_
+               << ", largest idle mem_buf size is " << fragment_info.largest_idle_mem_buf_size_
+               << ", fragmentation ratio is " << fragment_info.fragmentation_ratio_ << ".";
+  // The cached memory bufs will be invalid after the device memory released, so the thread memory caches are cleared
+  // but still registered, because the thread local storage may hold them.
+  for (auto &mem_cache : thread_mem_cache_list_) {
+    MS_EXCEPTION_IF_NULL(mem_cache);
+    // The owner thread holds the cache only for a few instructions.
+    while (mem_cache->in_use_.test_and_set(std::memory_order_acquire)) {
+      std::this_thread::yield();
+    }
+    for (auto &bin : mem_cache->size_class_bins_) {
+      bin.clear();
+    }
+    mem_cache->cached_size_ = 0;
+    mem_cache->in_use_.clear(std::memory_order_release);
+  }
+  thread_mem_cache_record_.Clear();
+  thread_cached_mem_statistics_ = 0;
   for (auto iter = global_mem_block_list_.begin(); iter != global_mem_block_list_.end(); ++iter) {
     auto device_addr = (*iter)->device_addr();
     if (device_addr != nullptr) {
@@ -324,7 +495,7 @@ void DynamicMemPoolBestFit::DumpDynamicMemPoolInfo() {
   }
   // Dump the memory statistical info
   MS_LOG(INFO) << "Total allocated memory[" << total_mem << "], used memory[" << total_used_mem << "], idle memory["
-               << total_idle_mem1 << "].";
+               << total_idle_mem1 << "], thread cached memory[" << thread_cached_mem_statistics_ << "].";
   if (total_idle_mem1 != total_idle_mem2) {
     MS_LOG(ERROR) << "Check error: the idle memory in the mem_block is not equal the global idle memory.";
   }
@@ -333,5 +504,149 @@ void DynamicMemPoolBestFit::DumpDynamicMemPoolInfo() {
   }
   MS_LOG(INFO) << "Finish dump dynamic memory pool info.";
 }
+
+DynamicMemFragmentInfo DynamicMemPoolBestFit::fragment_mem_statistics() {
+  std::lock_guard<std::mutex> locker(mutex_);
+  DynamicMemFragmentInfo fragment_info;
+  fragment_info.thread_cached_mem_size_ = thread_cached_mem_statistics_;
+  fragment_info.idle_mem_buf_count_ = global_idle_mem_buf_map_.size();
+  if (!global_idle_mem_buf_map_.empty()) {
+    fragment_info.largest_idle_mem_buf_size_ = global_idle_mem_buf_map_.rbegin()->first;
+  }
+  // The thread cached memory bufs are recorded as used memory buf in the memory block.
+  size_t used_size = total_used_mem_statistics_ + thread_cached_mem_statistics_;
+  fragment_info.idle_mem_size_ = total_mem_statistics_ > used_size ? total_mem_statistics_ - used_size : 0;
+  if (fragment_info.idle_mem_size_ != 0) {
+    fragment_info.fragmentation_ratio_ =
+      1.0f - static_cast<float>(fragment_info.largest_idle_mem_buf_size_) / fragment_info.idle_mem_size_;
+  }
+  return fragment_info;
+}
+
+bool DynamicMemPoolBestFit::IsThreadMemCacheable(size_t size) const {
+  return enable_thread_mem_cache_ && (size <= THREAD_MEM_CACHE_MAX_BUF_SIZE) && (size % DYNAMIC_MEM_ALIGN_SIZE == 0);
+}
+
+ThreadMemCachePtr DynamicMemPoolBestFit::GetThreadMemCache() {
+  // The key is the pool id rather than the pool address, to avoid hitting the cache of destroyed memory pool.
+  thread_local ThreadMemCacheHolder holder;
+  auto iter = holder.mem_caches_.find(pool_id_);
+  if (iter != holder.mem_caches_.end()) {
+    return iter->second;
+  }
+  auto mem_cache = std::make_shared<ThreadMemCache>();
+  mem_cache->size_class_bins_.resize(THREAD_MEM_CACHE_MAX_BUF_SIZE / DYNAMIC_MEM_ALIGN_SIZE);
+  {
+    std::lock_guard<std::mutex> locker(mutex_);
+    thread_mem_cache_list_.emplace_back(mem_cache);
+  }
+  (void)holder.mem_caches_.emplace(pool_id_, mem_cache);
+  return mem_cache;
+}
+
+DeviceMemPtr DynamicMemPoolBestFit::AllocFromThreadMemCache(size_t size) {
+  auto mem_cache = GetThreadMemCache();
+  MS_EXCEPTION_IF_NULL(mem_cache);
+  // The memory pool is reclaiming the cache, alloc from the global memory pool instead.
+  if (mem_cache->in_use_.test_and_set(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  DeviceMemPtr device_addr = nullptr;
+  auto &bin = mem_cache->size_class_bins_[size / DYNAMIC_MEM_ALIGN_SIZE - 1];
+  if (!bin.empty()) {
+    device_addr = bin.back();
+    bin.pop_back();
+    mem_cache->cached_size_ -= size;
+    thread_cached_mem_statistics_ -= size;
+    IncreaseUsedMemStatistics(size);
+  }
+  mem_cache->in_use_.clear(std::memory_order_release);
+  return device_addr;
+}
+
+bool DynamicMemPoolBestFit::FreeToThreadMemCache(const DeviceMemPtr &device_addr, size_t size) {
+  auto mem_cache = GetThreadMemCache();
+  MS_EXCEPTION_IF_NULL(mem_cache);
+  if (mem_cache->in_use_.test_and_set(std::memory_order_acquire)) {
+    return false;
+  }
+  std::vector<std::pair<DeviceMemPtr, size_t>> overflow_mem_bufs;
+  auto &bin = mem_cache->size_class_bins_[size / DYNAMIC_MEM_ALIGN_SIZE - 1];
+  bin.emplace_back(device_addr);
+  mem_cache->cached_size_ += size;
+  total_used_mem_statistics_ -= size;
+  thread_cached_mem_statistics_ += size;
+  // Flush the older half of the bin when the bin or the whole thread memory cache overflows.
+  if (bin.size() > THREAD_MEM_CACHE_BIN_CAPACITY || mem_cache->cached_size_ > THREAD_MEM_CACHE_MAX_TOTAL_SIZE) {
+    size_t flush_count = (bin.size() + 1) / 2;
+    for (size_t i = 0; i < flush_count; ++i) {
+      overflow_mem_bufs.emplace_back(bin[i], size);
+    }
+    (void)bin.erase(bin.begin(), bin.begin() + SizeToLong(flush_count));
+    mem_cache->cached_size_ -= flush_count * size;
+  }
+  mem_cache->in_use_.clear(std::memory_order_release);
+  if (!overflow_mem_bufs.empty()) {
+    std::lock_guard<std::mutex> locker(mutex_);
+    ReturnThreadCachedMemBuf(overflow_mem_bufs);
+  }
+  return true;
+}
+
+void DynamicMemPoolBestFit::ReturnThreadCachedMemBuf(const std::vector<std::pair<DeviceMemPtr, size_t>> &mem_bufs) {
+  for (const auto &mem_buf : mem_bufs) {
+    // The cached memory buf is recorded as used in the memory block, so it is freed as used memory buf.
+    thread_cached_mem_statistics_ -= mem_buf.second;
+    total_used_mem_statistics_ += mem_buf.second;
+    thread_mem_cache_record_.Erase(mem_buf.first);
+    FreeTensorMemToPool(mem_buf.first);
+  }
+}
+
+void DynamicMemPoolBestFit::DrainThreadMemCache(const ThreadMemCachePtr &mem_cache,
+                                                std::vector<std::pair<DeviceMemPtr, size_t>> *mem_bufs) {
+  MS_EXCEPTION_IF_NULL(mem_cache);
+  MS_EXCEPTION_IF_NULL(mem_bufs);
+  for (size_t i = 0; i < mem_cache->size_class_bins_.size(); ++i) {
+    size_t size = (i + 1) * DYNAMIC_MEM_ALIGN_SIZE;
+    for (auto &device_addr : mem_cache->size_class_bins_[i]) {
+      mem_bufs->emplace_back(device_addr, size);
+    }
+    mem_cache->size_class_bins_[i].clear();
+  }
+  mem_cache->cached_size_ = 0;
+}
+
+void DynamicMemPoolBestFit::ReclaimThreadMemCaches() {
+  std::vector<std::pair<DeviceMemPtr, size_t>> cached_mem_bufs;
+  for (auto &mem_cache : thread_mem_cache_list_) {
+    MS_EXCEPTION_IF_NULL(mem_cache);
+    // Skip the cache in use by its owner thread rather than waiting for it.
+    if (mem_cache->in_use_.test_and_set(std::memory_order_acquire)) {
+      continue;
+    }
+    DrainThreadMemCache(mem_cache, &cached_mem_bufs);
+    mem_cache->in_use_.clear(std::memory_order_release);
+  }
+  MS_LOG(INFO) << "Reclaim the thread cached mem_buf counts[" << cached_mem_bufs.size() << "].";
+  ReturnThreadCachedMemBuf(cached_mem_bufs);
+}
+
+void DynamicMemPoolBestFit::ReturnExitedThreadMemCache(const ThreadMemCachePtr &mem_cache) {
+  MS_EXCEPTION_IF_NULL(mem_cache);
+  std::lock_guard<std::mutex> locker(mutex_);
+  // The memory pool may be reclaiming the cache.
+  while (mem_cache->in_use_.test_and_set(std::memory_order_acquire)) {
+    std::this_thread::yield();
+  }
+  std::vector<std::pair<DeviceMemPtr, size_t>> cached_mem_bufs;
+  DrainThreadMemCache(mem_cache, &cached_mem_bufs);
+  mem_cache->in_use_.clear(std::memory_order_release);
+  ReturnThreadCachedMemBuf(cached_mem_bufs);
+  auto iter = std::find(thread_mem_cache_list_.begin(), thread_mem_cache_list_.end(), mem_cache);
+  if (iter != thread_mem_cache_list_.end()) {
+    (void)thread_mem_cache_list_.erase(iter);
+  }
+}
 }  // namespace device
 }  // namespace mindspore
@@ -24,6 +24,8 @@
 #include <utility>
 #include <thread>
 #include <mutex>
+#include <atomic>
+#include <cstdint>
 
 namespace mindspore {
 namespace device {
@@ -38,6 +40,21 @@ static const size_t DYNAMIC_MEM_ALIGN_SIZE = 512;
 // The minimum unit size (1G) of memory block used for dynamic extend.
 static const size_t DYNAMIC_MEM_ALLOC_UNIT_SIZE = 1024 << 20;
 
+// The maximum aligned size (256K) of memory buf which can be cached in the thread memory cache.
+static const size_t THREAD_MEM_CACHE_MAX_BUF_SIZE = 256 << 10;
+
+// The maximum count of memory buf cached in one size class bin of the thread memory cache.
+static const size_t THREAD_MEM_CACHE_BIN_CAPACITY = 32;
+
+// The maximum total size (32M) of memory buf cached in one thread memory cache.
+static const size_t THREAD_MEM_CACHE_MAX_TOTAL_SIZE = 32 << 20;
+
+// The slot number of the size record of the cacheable memory buf, the memory buf beyond it is not cached.
+static const size_t THREAD_MEM_CACHE_RECORD_CAPACITY = 1 << 16;
+
+// The maximum probe count in the size record of the cacheable memory buf.
+static const size_t THREAD_MEM_CACHE_RECORD_MAX_PROBE = 64;
+
 // The Comparator of device address from small to large.
 struct DeviceAddrCmp {
   bool operator()(const DeviceMemPtr &addr1, const DeviceMemPtr &addr2) const { return addr1 < addr2; }
@@ -74,10 +91,55 @@ class DynamicMemBlock {
 };
 using DynamicMemBlockPtr = std::shared_ptr<DynamicMemBlock>;
 
+// Thread memory cache holds the freed small memory bufs of one thread, which are arranged in bins by the size class
+// (the aligned size). The cached memory bufs keep used status in the memory block, and they are combined lazily when
+// the bin overflows, the memory pool runs out of memory or the thread exits.
+struct ThreadMemCache {
+  // Set by the owner thread while it uses the cache, and by the memory pool while it reclaims the cache. Neither side
+  // waits for the other: the owner thread turns to the global memory pool, and the memory pool skips the cache.
+  std::atomic_flag in_use_ = ATOMIC_FLAG_INIT;
+  std::vector<std::vector<DeviceMemPtr>> size_class_bins_;
+  size_t cached_size_{0};
+};
+using ThreadMemCachePtr = std::shared_ptr<ThreadMemCache>;
+
+// The lock-free record of the aligned size of the cacheable memory buf, from it is alloced until it returns to the
+// global memory pool. It is an open addressing table by device address, and the erased slot is reused by insertion.
+class ThreadMemCacheRecord {
+ public:
+  ThreadMemCacheRecord() : slots_(new Slot[THREAD_MEM_CACHE_RECORD_CAPACITY]) {}
+  ~ThreadMemCacheRecord() = default;
+  // Return false if there is no free slot within the maximum probe count.
+  bool Insert(const DeviceMemPtr &device_addr, size_t size);
+  // Return the aligned size of the memory buf, 0 if it is not recorded.
+  size_t Find(const DeviceMemPtr &device_addr) const;
+  void Erase(const DeviceMemPtr &device_addr);
+  // Clear all the records, which can't run concurrently with the other interfaces.
+  void Clear();
+
+ private:
+  struct Slot {
+    std::atomic<uintptr_t> key_{0};
+    std::atomic<size_t> size_{0};
+  };
+  static size_t SlotIndex(uintptr_t key, size_t probe);
+  std::unique_ptr<Slot[]> slots_;
+};
+
+// The fragmentation statistics information of dynamic memory pool.
+struct DynamicMemFragmentInfo {
+  size_t idle_mem_size_{0};
+  size_t idle_mem_buf_count_{0};
+  size_t largest_idle_mem_buf_size_{0};
+  size_t thread_cached_mem_size_{0};
+  // The ratio of idle memory which can't be used by the largest alloc, 0 means no fragmentation.
+  float fragmentation_ratio_{0};
+};
+
 // The main class of dynamic memory pool.
 class DynamicMemPoolBestFit {
  public:
-  DynamicMemPoolBestFit() = default;
+  DynamicMemPoolBestFit();
   virtual ~DynamicMemPoolBestFit();
   // The main program entry of memory alloc.
   DeviceMemPtr AllocTensorMem(size_t size);
@@ -104,6 +166,8 @@ class DynamicMemPoolBestFit {
   size_t total_mem_statistics() const { return total_mem_statistics_; }
   size_t used_mem_statistics() const { return total_used_mem_statistics_; }
   size_t used_mem_peak_statistics() const { return used_mem_peak_statistics_; }
+  size_t thread_cached_mem_statistics() const { return thread_cached_mem_statistics_; }
+  DynamicMemFragmentInfo fragment_mem_statistics();
 
   // The related interface of device memory real operation, needs override by device type.
   virtual size_t AllocDeviceMem(size_t size, DeviceMemPtr *addr) = 0;
@@ -116,8 +180,36 @@ class DynamicMemPoolBestFit {
   virtual size_t AlignMemorySize(size_t size) const;
   // Calculate memory block required alloc size when adding the memory block.
   virtual size_t CalMemBlockAllocSize(size_t size);
+  // Enable the thread memory cache of small memory bufs, which is suitable for the multi-thread kernel launch.
+  void set_enable_thread_mem_cache(bool enable) { enable_thread_mem_cache_ = enable; }
 
  private:
+  // Alloc and free the memory buf in the global memory pool, which is protected by the global mutex.
+  DeviceMemPtr AllocTensorMemFromPool(size_t size);
+  void FreeTensorMemToPool(const DeviceMemPtr &device_addr);
+
+  // Judge whether the memory buf of aligned size can be cached in the thread memory cache.
+  bool IsThreadMemCacheable(size_t size) const;
+  // The thread local holder of the thread memory caches, which returns them to the memory pools when the thread exits.
+  class ThreadMemCacheHolder;
+  // Get the thread memory cache of current thread, create it when first use.
+  ThreadMemCachePtr GetThreadMemCache();
+  // Alloc the memory buf from the size class bin of current thread memory cache, return nullptr if the bin is empty.
+  DeviceMemPtr AllocFromThreadMemCache(size_t size);
+  // Free the memory buf to the size class bin of current thread memory cache, and flush the overflow bufs to pool.
+  // Return false if the cache is being reclaimed by the memory pool.
+  bool FreeToThreadMemCache(const DeviceMemPtr &device_addr, size_t size);
+  // Return the cached memory bufs to the global memory pool and combine them, needs hold the global mutex.
+  void ReturnThreadCachedMemBuf(const std::vector<std::pair<DeviceMemPtr, size_t>> &mem_bufs);
+  // Take all the memory bufs out of the thread memory cache, needs hold its in_use_ flag.
+  void DrainThreadMemCache(const ThreadMemCachePtr &mem_cache, std::vector<std::pair<DeviceMemPtr, size_t>> *mem_bufs);
+  // Reclaim the thread memory caches not in use to the global memory pool, needs hold the global mutex.
+  void ReclaimThreadMemCaches();
+  // Return the thread memory cache of the exited thread to the global memory pool and unregister it.
+  void ReturnExitedThreadMemCache(const ThreadMemCachePtr &mem_cache);
+  // Update the used memory statistics and the peak.
+  void IncreaseUsedMemStatistics(size_t size);
+
   // Find the idle memory buf by aligned size when memory alloc.
   DeviceMemPtr FindIdleMemBuf(size_t size);
   // Add the memory block and memory buf when memory alloc not find the idle memory buf.
@@ -143,14 +235,23 @@ class DynamicMemPoolBestFit {
 
   // The related memory statistics information.
   size_t total_mem_statistics_{0};
-  size_t total_used_mem_statistics_{0};
-  size_t used_mem_peak_statistics_{0};
+  std::atomic<size_t> total_used_mem_statistics_{0};
+  std::atomic<size_t> used_mem_peak_statistics_{0};
+  std::atomic<size_t> thread_cached_mem_statistics_{0};
 
   // The minimum memory unit size.
   size_t mem_alloc_unit_size_{DYNAMIC_MEM_ALLOC_UNIT_SIZE};
 
   // Support multi-thread.
   std::mutex mutex_;
+
+  // The thread memory caches of all the threads which have used this memory pool.
+  bool enable_thread_mem_cache_{false};
+  std::vector<ThreadMemCachePtr> thread_mem_cache_list_;
+  ThreadMemCacheRecord thread_mem_cache_record_;
+  // The unique id of memory pool, which is the key of thread memory cache in the thread local storage.
+  size_t pool_id_;
+  static std::atomic<size_t> pool_id_counter_;
 };
 }  // namespace device
 }  // namespace mindspore
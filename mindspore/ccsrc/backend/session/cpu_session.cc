@@ -16,11 +16,14 @@
 
 #include "backend/session/cpu_session.h"
 #include <algorithm>
+#include <functional>
+#include <numeric>
 #include <sstream>
 #include <exception>
 #include "ir/anf.h"
 #include "utils/ms_utils.h"
 #include "utils/trace_base.h"
+#include "utils/context/graph_kernel_flags.h"
 #include "backend/session/anf_runtime_algorithm.h"
 #include "runtime/device/kernel_runtime.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
@@ -29,11 +32,13 @@
 #include "backend/optimizer/common/pass_manager.h"
 #include "backend/optimizer/cpu/insert_cast_cpu.h"
 #include "backend/optimizer/cpu/insert_format_transform_op.h"
+#include "backend/optimizer/cpu/elementwise_fusion_cpu.h"
 #include "backend/optimizer/pass/replace_node_by_proxy.h"
 #include "backend/optimizer/pass/erase_visit_attr.h"
 #include "debug/anf_ir_dump.h"
 #include "debug/dump_proto.h"
 #include "debug/data_dump/dump_json_parser.h"
+#include "profiler/device/cpu/cpu_profiling.h"
 #if (ENABLE_CPU && !_WIN32)
 #include "ps/util.h"
 #include "ps/ps_context.h"
@@ -90,6 +95,9 @@ void CPUSession::Optimize(const std::shared_ptr<KernelGraph> &kernel_graph) {
   }
 #endif
   pm->AddPass(std::make_shared<opt::InsertFormatTransformOpCPU>("insert_format_transform_op_cpu"));
+  if (context::GraphKernelFlags::GetInstance().IsEnableGraphKernel()) {
+    pm->AddPass(std::make_shared<opt::ElementwiseFusionCPU>("elementwise_fusion_cpu"));
+  }
   optimizer->AddPassManager(pm);
   (void)optimizer->Optimize(kernel_graph);
   kernel_graph->SetExecOrderByDefault();
@@ -224,7 +232,137 @@ void CPUSession::BuildOpImpl(const OpRunInfo &op_run_info, const GraphInfo &grap
   Optimize(kernel_graph);
   BuildKernel(kernel_graph.get());
   ProcessCast(kernel_graph);
+  // Remove reorder after PS feature finish adapting push/pull in auto_monad.
+  auto execution_order = kernel_graph->execution_order();
+  Reorder(&execution_order);
+  kernel_graph->set_execution_order(execution_order);
   run_op_graphs_[graph_info] = kernel_graph;
+  CacheSingleOpLaunchInfo(graph_info, kernel_graph);
+}
+
+void CPUSession::CacheSingleOpLaunchInfo(const GraphInfo &graph_info,
+                                         const std::shared_ptr<KernelGraph> &kernel_graph) {
+  MS_EXCEPTION_IF_NULL(kernel_graph);
+  const auto &execution_order = kernel_graph->execution_order();
+  if (execution_order.size() != 1) {
+    return;
+  }
+  SingleOpLaunchInfo info;
+  info.kernel = execution_order[0];
+  MS_EXCEPTION_IF_NULL(info.kernel);
+  if (AnfAlgo::IsDynamicShape(info.kernel)) {
+    return;
+  }
+  info.kernel_mod = AnfAlgo::GetKernelMod(info.kernel);
+  MS_EXCEPTION_IF_NULL(info.kernel_mod);
+  // The kernel reads the parameters of the graph in order, which are bound to the input tensors without a copy.
+  const auto &graph_inputs = kernel_graph->inputs();
+  size_t input_num = AnfAlgo::GetInputTensorNum(info.kernel);
+  const auto &input_sizes = info.kernel_mod->GetInputSizeList();
+  if (graph_inputs.size() != input_num || input_sizes.size() != input_num) {
+    return;
+  }
+  for (size_t i = 0; i < input_num; ++i) {
+    auto input = AnfAlgo::GetPrevNodeOutput(info.kernel, i);
+    auto param = input.first->cast<ParameterPtr>();
+    if (input.first != graph_inputs[i] || input.second != 0 || param == nullptr || HasAbstractMonad(param) ||
+        AnfAlgo::IsParameterWeight(param) ||
+        GetTypeByte(TypeIdToType(AnfAlgo::GetOutputInferDataType(param, 0))) !=
+          GetTypeByte(TypeIdToType(AnfAlgo::GetOutputDeviceDataType(param, 0)))) {
+      return;
+    }
+  }
+  info.input_sizes = input_sizes;
+  // The outputs of the graph are the outputs of the kernel in order, which are written to new tensors.
+  auto graph_outputs = kernel_graph->outputs();
+  const auto &output_sizes = info.kernel_mod->GetOutputSizeList();
+  if (graph_outputs.size() != AnfAlgo::GetOutputTensorNum(info.kernel) || output_sizes.size() != graph_outputs.size()) {
+    return;
+  }
+  for (size_t i = 0; i < graph_outputs.size(); ++i) {
+    auto output = AnfAlgo::VisitKernelWithReturnType(graph_outputs[i], 0, false);
+    auto type = AnfAlgo::GetOutputInferDataType(info.kernel, i);
+    auto shape = AnfAlgo::GetOutputInferShape(info.kernel, i);
+    size_t size =
+      std::accumulate(shape.begin(), shape.end(), GetTypeByte(TypeIdToType(type)), std::multiplies<size_t>());
+    if (output.first != info.kernel || output.second != i || kernel_graph->IsInternalOutput(info.kernel, i) ||
+        type != AnfAlgo::GetOutputDeviceDataType(info.kernel, i) || size != output_sizes[i]) {
+      return;
+    }
+    info.output_types.push_back(type);
+    (void)info.output_shapes.emplace_back(shape.begin(), shape.end());
+  }
+  for (auto size : info.kernel_mod->GetWorkspaceSizeList()) {
+    info.workspaces.emplace_back(size);
+  }
+  single_op_launch_infos_[graph_info] = std::move(info);
+}
+
+bool CPUSession::IsHostDataReady(const tensor::TensorPtr &tensor) {
+  MS_EXCEPTION_IF_NULL(tensor);
+  if (tensor->NeedWait()) {
+    return false;
+  }
+  auto device_address = tensor->device_address();
+  if (device_address == nullptr) {
+    return true;
+  }
+  return !tensor->NeedSyncDeviceToHost() && !tensor->NeedSyncDeviceToHostImmediately() &&
+         device_address->GetMutablePtr() == tensor->data_c();
+}
+
+bool CPUSession::LaunchSingleOp(const GraphInfo &graph_info, const std::vector<tensor::TensorPtr> &input_tensors,
+                                VectorRef *outputs) {
+  MS_EXCEPTION_IF_NULL(outputs);
+  auto iter = single_op_launch_infos_.find(graph_info);
+  if (iter == single_op_launch_infos_.end()) {
+    return false;
+  }
+  auto profiler_inst = profiler::cpu::CPUProfiler::GetInstance();
+  MS_EXCEPTION_IF_NULL(profiler_inst);
+  if (profiler_inst->GetEnableFlag() || DumpJsonParser::GetInstance().GetIterDumpFlag()) {
+    return false;
+  }
+  auto &info = iter->second;
+  if (input_tensors.size() != info.input_sizes.size()) {
+    return false;
+  }
+  std::vector<kernel::AddressPtr> kernel_inputs;
+  for (size_t i = 0; i < input_tensors.size(); ++i) {
+    MS_EXCEPTION_IF_NULL(input_tensors[i]);
+    if (LongToSize(input_tensors[i]->data().nbytes()) != info.input_sizes[i]) {
+      return false;
+    }
+    // The kernel reads the host data of the input, so the runtime path syncs the inputs whose data is elsewhere.
+    if (!IsHostDataReady(input_tensors[i])) {
+      return false;
+    }
+    kernel_inputs.push_back(std::make_shared<kernel::Address>(input_tensors[i]->data_c(), info.input_sizes[i]));
+  }
+  std::vector<kernel::AddressPtr> kernel_workspaces;
+  for (auto &workspace : info.workspaces) {
+    kernel_workspaces.push_back(std::make_shared<kernel::Address>(workspace.data(), workspace.size()));
+  }
+  std::vector<tensor::TensorPtr> output_tensors;
+  std::vector<kernel::AddressPtr> kernel_outputs;
+  for (size_t i = 0; i < info.output_types.size(); ++i) {
+    auto tensor = std::make_shared<tensor::Tensor>(info.output_types[i], info.output_shapes[i]);
+    kernel_outputs.push_back(std::make_shared<kernel::Address>(tensor->data_c(), LongToSize(tensor->data().nbytes())));
+    output_tensors.push_back(tensor);
+  }
+  bool ret = true;
+  try {
+    ret = info.kernel_mod->Launch(kernel_inputs, kernel_workspaces, kernel_outputs, nullptr);
+  } catch (std::exception &e) {
+    MS_LOG(EXCEPTION) << e.what() << "\nTrace:" << trace::DumpSourceLines(info.kernel);
+  }
+  if (!ret) {
+    MS_LOG(EXCEPTION) << "Launch kernel failed. Trace:" << trace::DumpSourceLines(info.kernel);
+  }
+  for (auto &tensor : output_tensors) {
+    outputs->push_back(tensor);
+  }
+  return true;
 }
 
 void CPUSession::SetOutputFlags(const VectorRef &base_ref) {
@@ -260,15 +398,13 @@ void CPUSession::RunOpImpl(const GraphInfo &graph_info, OpRunInfo *op_run_info,
   MS_EXCEPTION_IF_NULL(op_run_info);
   BuildOpImpl(*op_run_info, graph_info, *input_tensors, tensors_mask);
   EraseValueNodeTensor(tensors_mask, input_tensors);
+  if (!op_run_info->is_dynamic_shape && LaunchSingleOp(graph_info, *input_tensors, outputs)) {
+    return;
+  }
 
   auto kernel_graph = run_op_graphs_[graph_info];
   MS_EXCEPTION_IF_NULL(kernel_graph);
 
-  // Remove reorder after PS feature finish adapting push/pull in auto_monad.
-  auto execution_order = kernel_graph->execution_order();
-  Reorder(&execution_order);
-  kernel_graph->set_execution_order(execution_order);
-
   // runtime init
   if (!runtime_.Init()) {
     MS_LOG(EXCEPTION) << "Kernel runtime init error.";
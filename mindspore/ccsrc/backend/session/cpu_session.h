@@ -18,6 +18,7 @@
 #include <string>
 #include <memory>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include "backend/session/session_basic.h"
 #include "backend/session/kernel_graph.h"
@@ -52,6 +53,24 @@ class CPUSession : public SessionBasic {
                      const std::vector<tensor::TensorPtr> &inputs_const) const override;
 
  private:
+  // The launch of a single op graph whose only kernel reads the inputs of the graph and writes its outputs. The op
+  // is run again by launching the kernel on the memory of the tensors, without assigning and binding the addresses
+  // of the graph.
+  struct SingleOpLaunchInfo {
+    CNodePtr kernel;
+    kernel::KernelMod *kernel_mod{nullptr};
+    std::vector<size_t> input_sizes;
+    std::vector<TypeId> output_types;
+    std::vector<ShapeVector> output_shapes;
+    std::vector<std::vector<uint8_t>> workspaces;
+  };
+
+  void CacheSingleOpLaunchInfo(const GraphInfo &graph_info, const std::shared_ptr<KernelGraph> &kernel_graph);
+  bool LaunchSingleOp(const GraphInfo &graph_info, const std::vector<tensor::TensorPtr> &input_tensors,
+                      VectorRef *outputs);
+  // Whether the data of the tensor is on the host memory, which is not the case when it is pending or held by a device
+  // address of other memory.
+  static bool IsHostDataReady(const tensor::TensorPtr &tensor);
   void Reorder(std::vector<CNodePtr> *node_list);
   void ProcessCast(const std::shared_ptr<KernelGraph> &kernel_graph);
   void SetKernelInfo(const KernelGraph *kernel_graph);
@@ -59,6 +78,7 @@ class CPUSession : public SessionBasic {
   void SetOutputFlags(const VectorRef &base_ref);
   void UpdateDynamicOutputShape(const std::map<tensor::TensorPtr, KernelWithIndex> &tensor_to_node);
   device::cpu::CPUKernelRuntime runtime_;
+  std::unordered_map<GraphInfo, SingleOpLaunchInfo> single_op_launch_infos_;
 };
 MS_REG_SESSION(kCPUDevice, CPUSession);
 }  // namespace session
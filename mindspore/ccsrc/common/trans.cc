@@ -22,6 +22,7 @@
 #include "backend/session/anf_runtime_algorithm.h"
 #include "backend/kernel_compiler/kernel.h"
 #include "backend/kernel_compiler/tbe/tbe_dynaminc_shape_util.h"
+#include "common/transpose.h"
 #include "runtime/device/convert_tensor_utils.h"
 #include "utils/convert_utils.h"
 #include "utils/log_adapter.h"
@@ -805,26 +806,16 @@ bool NchwTo4D(const FormatArgs &args, void *result) {
     MS_LOG(ERROR) << "Check args failed.";
     return false;
   }
-  auto n = args.host_shape[kN];
-  auto c = args.host_shape[kC];
-  auto h = args.host_shape[kH];
-  auto w = args.host_shape[kW];
-  for (size_t ni = 0; ni < n; ni++) {
-    for (size_t ci = 0; ci < c; ci++) {
-      for (size_t hi = 0; hi < h; hi++) {
-        for (size_t wi = 0; wi < w; wi++) {
-          auto src_idx = ni * c * h * w + ci * h * w + hi * w + wi;
-          auto dst_idx = 0;
-          if (args.device_format == kOpFormat_NHWC) {
-            dst_idx = ni * h * w * c + hi * w * c + wi * c + ci;
-          } else if (args.device_format == kOpFormat_HWCN) {
-            dst_idx = hi * w * c * n + wi * c * n + ci * n + ni;
-          }
-          SetData(size, false, src_idx, dst_idx, args, result);
-        }
-      }
-    }
+  std::vector<size_t> perm;
+  if (args.device_format == kOpFormat_NHWC) {
+    perm = {kN, kH, kW, kC};
+  } else if (args.device_format == kOpFormat_HWCN) {
+    perm = {kH, kW, kC, kN};
+  } else {
+    MS_LOG(ERROR) << "Trans format from nchw to " << args.device_format << " is not supported.";
+    return false;
   }
+  common::TransposePlan(args.host_shape, perm, size).Run(args.data, result);
   return true;
 }
 
@@ -841,22 +832,19 @@ bool ToNchw(const FormatArgs &args, void *result) {
   auto c = args.host_shape[kC];
   auto h = args.host_shape[kH];
   auto w = args.host_shape[kW];
-  for (size_t ni = 0; ni < n; ni++) {
-    for (size_t ci = 0; ci < c; ci++) {
-      for (size_t hi = 0; hi < h; hi++) {
-        for (size_t wi = 0; wi < w; wi++) {
-          auto dst_idx = ni * c * h * w + ci * h * w + hi * w + wi;
-          auto src_idx = 0;
-          if (args.device_format == kOpFormat_NHWC) {
-            src_idx = ni * h * w * c + hi * w * c + wi * c + ci;
-          } else if (args.device_format == kOpFormat_HWCN) {
-            src_idx = hi * w * c * n + wi * c * n + ci * n + ni;
-          }
-          SetData(size, false, src_idx, dst_idx, args, result);
-        }
-      }
-    }
+  std::vector<size_t> device_shape;
+  std::vector<size_t> perm;
+  if (args.device_format == kOpFormat_NHWC) {
+    device_shape = {n, h, w, c};
+    perm = {0, 3, 1, 2};
+  } else if (args.device_format == kOpFormat_HWCN) {
+    device_shape = {h, w, c, n};
+    perm = {3, 2, 0, 1};
+  } else {
+    MS_LOG(ERROR) << "Trans format from " << args.device_format << " to nchw is not supported.";
+    return false;
   }
+  common::TransposePlan(device_shape, perm, size).Run(args.data, result);
   return true;
 }
 
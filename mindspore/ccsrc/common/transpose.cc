@@ -0,0 +1,335 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/transpose.h"
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+#include "common/thread_pool.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace common {
+namespace {
+constexpr size_t kTileSize = 8;
+// Transposes smaller than this many bytes run on the calling thread.
+constexpr size_t kParallelMinBytes = 64 * 1024;
+
+void ParallelRun(const std::function<void(size_t, size_t)> &task, size_t count, size_t bytes) {
+  size_t thread_num = ThreadPool::GetInstance().GetSyncRunThreadNum();
+  if (bytes < kParallelMinBytes || thread_num <= 1 || count <= 1) {
+    task(0, count);
+    return;
+  }
+  thread_num = std::min(thread_num, count);
+  size_t once_compute_size = (count + thread_num - 1) / thread_num;
+  std::vector<Task> tasks;
+  for (size_t start = 0; start < count; start += once_compute_size) {
+    size_t end = std::min(start + once_compute_size, count);
+    tasks.emplace_back([&task, start, end]() {
+      task(start, end);
+      return SUCCESS;
+    });
+  }
+  (void)ThreadPool::GetInstance().SyncRun(tasks);
+}
+
+// dst[j * dst_stride + i] = src[i * src_stride + j] for a full kTileSize x kTileSize tile.
+template <typename T>
+inline void TransposeTile(const T *src, size_t src_stride, T *dst, size_t dst_stride) {
+  for (size_t i = 0; i < kTileSize; ++i) {
+    for (size_t j = 0; j < kTileSize; ++j) {
+      dst[j * dst_stride + i] = src[i * src_stride + j];
+    }
+  }
+}
+
+#if defined(__AVX__)
+template <>
+inline void TransposeTile<uint32_t>(const uint32_t *src, size_t src_stride, uint32_t *dst, size_t dst_stride) {
+  auto src_ptr = reinterpret_cast<const float *>(src);
+  auto dst_ptr = reinterpret_cast<float *>(dst);
+  __m256 r0 = _mm256_loadu_ps(src_ptr);
+  __m256 r1 = _mm256_loadu_ps(src_ptr + src_stride);
+  __m256 r2 = _mm256_loadu_ps(src_ptr + 2 * src_stride);
+  __m256 r3 = _mm256_loadu_ps(src_ptr + 3 * src_stride);
+  __m256 r4 = _mm256_loadu_ps(src_ptr + 4 * src_stride);
+  __m256 r5 = _mm256_loadu_ps(src_ptr + 5 * src_stride);
+  __m256 r6 = _mm256_loadu_ps(src_ptr + 6 * src_stride);
+  __m256 r7 = _mm256_loadu_ps(src_ptr + 7 * src_stride);
+  __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+  __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+  __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+  __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+  __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+  __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+  __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+  __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+  r0 = _mm256_shuffle_ps(t0, t2, 0x44);
+  r1 = _mm256_shuffle_ps(t0, t2, 0xEE);
+  r2 = _mm256_shuffle_ps(t1, t3, 0x44);
+  r3 = _mm256_shuffle_ps(t1, t3, 0xEE);
+  r4 = _mm256_shuffle_ps(t4, t6, 0x44);
+  r5 = _mm256_shuffle_ps(t4, t6, 0xEE);
+  r6 = _mm256_shuffle_ps(t5, t7, 0x44);
+  r7 = _mm256_shuffle_ps(t5, t7, 0xEE);
+  _mm256_storeu_ps(dst_ptr, _mm256_permute2f128_ps(r0, r4, 0x20));
+  _mm256_storeu_ps(dst_ptr + dst_stride, _mm256_permute2f128_ps(r1, r5, 0x20));
+  _mm256_storeu_ps(dst_ptr + 2 * dst_stride, _mm256_permute2f128_ps(r2, r6, 0x20));
+  _mm256_storeu_ps(dst_ptr + 3 * dst_stride, _mm256_permute2f128_ps(r3, r7, 0x20));
+  _mm256_storeu_ps(dst_ptr + 4 * dst_stride, _mm256_permute2f128_ps(r0, r4, 0x31));
+  _mm256_storeu_ps(dst_ptr + 5 * dst_stride, _mm256_permute2f128_ps(r1, r5, 0x31));
+  _mm256_storeu_ps(dst_ptr + 6 * dst_stride, _mm256_permute2f128_ps(r2, r6, 0x31));
+  _mm256_storeu_ps(dst_ptr + 7 * dst_stride, _mm256_permute2f128_ps(r3, r7, 0x31));
+}
+#elif defined(__SSE2__) || defined(__ARM_NEON)
+inline void Transpose4x4(const uint32_t *src, size_t src_stride, uint32_t *dst, size_t dst_stride) {
+#if defined(__SSE2__)
+  auto src_ptr = reinterpret_cast<const float *>(src);
+  auto dst_ptr = reinterpret_cast<float *>(dst);
+  __m128 r0 = _mm_loadu_ps(src_ptr);
+  __m128 r1 = _mm_loadu_ps(src_ptr + src_stride);
+  __m128 r2 = _mm_loadu_ps(src_ptr + 2 * src_stride);
+  __m128 r3 = _mm_loadu_ps(src_ptr + 3 * src_stride);
+  _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+  _mm_storeu_ps(dst_ptr, r0);
+  _mm_storeu_ps(dst_ptr + dst_stride, r1);
+  _mm_storeu_ps(dst_ptr + 2 * dst_stride, r2);
+  _mm_storeu_ps(dst_ptr + 3 * dst_stride, r3);
+#else
+  uint32x4x2_t t01 = vtrnq_u32(vld1q_u32(src), vld1q_u32(src + src_stride));
+  uint32x4x2_t t23 = vtrnq_u32(vld1q_u32(src + 2 * src_stride), vld1q_u32(src + 3 * src_stride));
+  vst1q_u32(dst, vcombine_u32(vget_low_u32(t01.val[0]), vget_low_u32(t23.val[0])));
+  vst1q_u32(dst + dst_stride, vcombine_u32(vget_low_u32(t01.val[1]), vget_low_u32(t23.val[1])));
+  vst1q_u32(dst + 2 * dst_stride, vcombine_u32(vget_high_u32(t01.val[0]), vget_high_u32(t23.val[0])));
+  vst1q_u32(dst + 3 * dst_stride, vcombine_u32(vget_high_u32(t01.val[1]), vget_high_u32(t23.val[1])));
+#endif
+}
+
+template <>
+inline void TransposeTile<uint32_t>(const uint32_t *src, size_t src_stride, uint32_t *dst, size_t dst_stride) {
+  constexpr size_t kHalf = kTileSize / 2;
+  Transpose4x4(src, src_stride, dst, dst_stride);
+  Transpose4x4(src + kHalf, src_stride, dst + kHalf * dst_stride, dst_stride);
+  Transpose4x4(src + kHalf * src_stride, src_stride, dst + kHalf, dst_stride);
+  Transpose4x4(src + kHalf * src_stride + kHalf, src_stride, dst + kHalf * dst_stride + kHalf, dst_stride);
+}
+#endif
+
+template <typename T>
+inline void TransposeEdge(const T *src, size_t src_stride, T *dst, size_t dst_stride, size_t rows, size_t cols) {
+  for (size_t j = 0; j < cols; ++j) {
+    for (size_t i = 0; i < rows; ++i) {
+      dst[j * dst_stride + i] = src[i * src_stride + j];
+    }
+  }
+}
+}  // namespace
+
+TransposePlan::TransposePlan(const std::vector<size_t> &input_shape, const std::vector<size_t> &perm,
+                             size_t elem_size)
+    : elem_size_(elem_size) {
+  if (elem_size != sizeof(uint8_t) && elem_size != sizeof(uint16_t) && elem_size != sizeof(uint32_t) &&
+      elem_size != sizeof(uint64_t)) {
+    MS_LOG(EXCEPTION) << "Transpose does not support elements of " << elem_size << " bytes.";
+  }
+  if (perm.size() != input_shape.size()) {
+    MS_LOG(EXCEPTION) << "The size of perm " << perm << " should be equal to the rank of shape " << input_shape;
+  }
+  std::vector<bool> used(perm.size(), false);
+  for (auto axis : perm) {
+    if (axis >= perm.size() || used[axis]) {
+      MS_LOG(EXCEPTION) << "The perm " << perm << " is not a permutation of the " << perm.size() << " axes.";
+    }
+    used[axis] = true;
+  }
+  data_size_ = std::accumulate(input_shape.begin(), input_shape.end(), size_t(1), std::multiplies<size_t>());
+  Simplify(input_shape, perm);
+
+  size_t rank = shape_.size();
+  std::vector<size_t> input_strides(rank, 1);
+  std::vector<size_t> output_strides(rank, 1);
+  for (size_t i = rank; i > 1; --i) {
+    input_strides[i - 2] = input_strides[i - 1] * shape_[i - 1];
+    output_strides[i - 2] = output_strides[i - 1] * shape_[perm_[i - 1]];
+  }
+  // Stride of every input axis in the output.
+  std::vector<size_t> axis_output_strides(rank, 1);
+  for (size_t i = 0; i < rank; ++i) {
+    axis_output_strides[perm_[i]] = output_strides[i];
+  }
+
+  tiled_ = rank > 1 && perm_.back() != rank - 1;
+  size_t row_axis = tiled_ ? perm_.back() : rank;
+  size_t col_axis = rank > 0 ? rank - 1 : 0;
+  for (size_t i = 0; i < rank; ++i) {
+    size_t axis = perm_[i];
+    if (axis == row_axis || axis == col_axis) {
+      continue;
+    }
+    outer_shape_.push_back(shape_[axis]);
+    outer_input_strides_.push_back(input_strides[axis]);
+    outer_output_strides_.push_back(axis_output_strides[axis]);
+  }
+  outer_size_ = std::accumulate(outer_shape_.begin(), outer_shape_.end(), size_t(1), std::multiplies<size_t>());
+  if (tiled_) {
+    row_size_ = shape_[row_axis];
+    col_size_ = shape_[col_axis];
+    input_row_stride_ = input_strides[row_axis];
+    output_row_stride_ = axis_output_strides[col_axis];
+  } else {
+    row_size_ = rank > 0 ? shape_[col_axis] : data_size_;
+  }
+}
+
+void TransposePlan::Simplify(const std::vector<size_t> &input_shape, const std::vector<size_t> &perm) {
+  // Drop the axes of size 1, they do not move any data.
+  std::vector<size_t> new_axis(input_shape.size(), 0);
+  std::vector<size_t> shape;
+  for (size_t i = 0; i < input_shape.size(); ++i) {
+    new_axis[i] = shape.size();
+    if (input_shape[i] != 1) {
+      shape.push_back(input_shape[i]);
+    }
+  }
+  std::vector<size_t> order;
+  for (auto axis : perm) {
+    if (input_shape[axis] != 1) {
+      order.push_back(new_axis[axis]);
+    }
+  }
+  // Merge the runs of consecutive input axes in the output order, each run is numbered by its first input axis.
+  std::vector<size_t> run_head(shape.size(), 0);
+  std::vector<bool> is_head(shape.size(), false);
+  for (size_t i = 0; i < order.size(); ++i) {
+    if (i > 0 && order[i] == order[i - 1] + 1) {
+      run_head[order[i]] = run_head[order[i - 1]];
+    } else {
+      run_head[order[i]] = order[i];
+      is_head[order[i]] = true;
+    }
+  }
+  std::vector<size_t> merged_axis(shape.size(), 0);
+  shape_.clear();
+  for (size_t i = 0; i < shape.size(); ++i) {
+    if (is_head[i]) {
+      merged_axis[i] = shape_.size();
+      shape_.push_back(shape[i]);
+    } else {
+      shape_.back() *= shape[i];
+    }
+  }
+  perm_.clear();
+  for (auto axis : order) {
+    if (is_head[axis]) {
+      perm_.push_back(merged_axis[axis]);
+    }
+  }
+}
+
+void TransposePlan::GetOuterOffset(size_t index, size_t *input_offset, size_t *output_offset) const {
+  *input_offset = 0;
+  *output_offset = 0;
+  for (size_t i = outer_shape_.size(); i > 0; --i) {
+    size_t pos = index % outer_shape_[i - 1];
+    index /= outer_shape_[i - 1];
+    *input_offset += pos * outer_input_strides_[i - 1];
+    *output_offset += pos * outer_output_strides_[i - 1];
+  }
+}
+
+template <typename T>
+void TransposePlan::RunRows(const T *input, T *output) const {
+  auto task = [this, input, output](size_t start, size_t end) {
+    for (size_t i = start; i < end; ++i) {
+      size_t input_offset = 0;
+      size_t output_offset = 0;
+      GetOuterOffset(i, &input_offset, &output_offset);
+      std::copy(input + input_offset, input + input_offset + row_size_, output + output_offset);
+    }
+  };
+  ParallelRun(task, outer_size_, data_size_ * sizeof(T));
+}
+
+template <typename T>
+void TransposePlan::RunTiles(const T *input, T *output) const {
+  size_t tile_rows = (row_size_ + kTileSize - 1) / kTileSize;
+  auto task = [this, input, output, tile_rows](size_t start, size_t end) {
+    for (size_t unit = start; unit < end; ++unit) {
+      size_t input_offset = 0;
+      size_t output_offset = 0;
+      GetOuterOffset(unit / tile_rows, &input_offset, &output_offset);
+      size_t row = (unit % tile_rows) * kTileSize;
+      size_t rows = std::min(kTileSize, row_size_ - row);
+      const T *src = input + input_offset + row * input_row_stride_;
+      T *dst = output + output_offset + row;
+      size_t col = 0;
+      if (rows == kTileSize) {
+        for (; col + kTileSize <= col_size_; col += kTileSize) {
+          TransposeTile(src + col, input_row_stride_, dst + col * output_row_stride_, output_row_stride_);
+        }
+      }
+      if (col < col_size_) {
+        TransposeEdge(src + col, input_row_stride_, dst + col * output_row_stride_, output_row_stride_, rows,
+                      col_size_ - col);
+      }
+    }
+  };
+  ParallelRun(task, outer_size_ * tile_rows, data_size_ * sizeof(T));
+}
+
+template <typename T>
+void TransposePlan::RunImpl(const void *input, void *output) const {
+  auto input_addr = static_cast<const T *>(input);
+  auto output_addr = static_cast<T *>(output);
+  if (tiled_) {
+    RunTiles(input_addr, output_addr);
+  } else {
+    RunRows(input_addr, output_addr);
+  }
+}
+
+void TransposePlan::Run(const void *input, void *output) const {
+  if (data_size_ == 0) {
+    return;
+  }
+  MS_EXCEPTION_IF_NULL(input);
+  MS_EXCEPTION_IF_NULL(output);
+  switch (elem_size_) {
+    case sizeof(uint8_t):
+      RunImpl<uint8_t>(input, output);
+      break;
+    case sizeof(uint16_t):
+      RunImpl<uint16_t>(input, output);
+      break;
+    case sizeof(uint32_t):
+      RunImpl<uint32_t>(input, output);
+      break;
+    case sizeof(uint64_t):
+      RunImpl<uint64_t>(input, output);
+      break;
+    default:
+      MS_LOG(EXCEPTION) << "The transpose plan is not initialized.";
+  }
+}
+}  // namespace common
+}  // namespace mindspore
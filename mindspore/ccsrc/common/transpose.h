@@ -0,0 +1,72 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_COMMON_TRANSPOSE_H_
+#define MINDSPORE_CCSRC_COMMON_TRANSPOSE_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace mindspore {
+namespace common {
+// Moves the data of a tensor into the layout given by perm, the output axis i being the input axis perm[i].
+// Axes of size 1 are dropped and axes that stay adjacent in the output are merged when the plan is built. If the
+// innermost axis keeps its place the data is copied row by row, otherwise it is moved in square tiles so that both
+// the reads and the writes touch a few cache lines only. Elements of 1, 2, 4 or 8 bytes are supported.
+class TransposePlan {
+ public:
+  TransposePlan() = default;
+  TransposePlan(const std::vector<size_t> &input_shape, const std::vector<size_t> &perm, size_t elem_size);
+  ~TransposePlan() = default;
+
+  void Run(const void *input, void *output) const;
+
+  size_t data_size() const { return data_size_; }
+  const std::vector<size_t> &shape() const { return shape_; }
+  const std::vector<size_t> &perm() const { return perm_; }
+
+ private:
+  void Simplify(const std::vector<size_t> &input_shape, const std::vector<size_t> &perm);
+  void GetOuterOffset(size_t index, size_t *input_offset, size_t *output_offset) const;
+  template <typename T>
+  void RunRows(const T *input, T *output) const;
+  template <typename T>
+  void RunTiles(const T *input, T *output) const;
+  template <typename T>
+  void RunImpl(const void *input, void *output) const;
+
+  size_t elem_size_{0};
+  size_t data_size_{0};
+  // The simplified input shape and permutation.
+  std::vector<size_t> shape_;
+  std::vector<size_t> perm_;
+  // The axes iterated outside of a row or a tile, in output order.
+  std::vector<size_t> outer_shape_;
+  std::vector<size_t> outer_input_strides_;
+  std::vector<size_t> outer_output_strides_;
+  size_t outer_size_{1};
+  // Without tiling every outer index copies a row of row_size_ elements. With tiling every outer index transposes a
+  // row_size_ x col_size_ matrix, whose rows are strided in the input and whose columns are strided in the output.
+  bool tiled_{false};
+  size_t row_size_{0};
+  size_t col_size_{0};
+  size_t input_row_stride_{0};
+  size_t output_row_stride_{0};
+};
+}  // namespace common
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_COMMON_TRANSPOSE_H_
@@ -15,6 +15,10 @@
  */
 
 #include "fl/armour/cipher/cipher_reconstruct.h"
+#include <algorithm>
+#include <atomic>
+#include "common/thread_pool.h"
+#include "backend/kernel_compiler/cpu/nnacl/fp32/add_fp32.h"
 #include "fl/server/common.h"
 #include "fl/armour/secure_protocol/random.h"
 #include "fl/armour/secure_protocol/key_agreement.h"
@@ -22,78 +26,141 @@
 
 namespace mindspore {
 namespace armour {
+namespace {
+// The noise mask expanded from a seed: the secret of a client, or the key it shares with a peer if peer is set.
+struct MaskJob {
+  size_t secret_index;
+  const std::string *peer;
+  float scale;
+};
+}  // namespace
+
+bool CipherReconStruct::CombineSecrets(const std::vector<const std::vector<clientshare_str> *> &client_shares,
+                                       size_t thread_num, std::vector<std::vector<char>> *secrets) {
+#ifdef _WIN32
+  MS_LOG(ERROR) << "Unsupported feature in Windows platform.";
+  return false;
+#else
+  secrets->assign(client_shares.size(), std::vector<char>(SECRET_MAX_LEN, 0));
+  if (client_shares.empty()) {
+    return true;
+  }
+  std::atomic_bool succeeded = true;
+  thread_num = std::max(std::min(thread_num, client_shares.size()), static_cast<size_t>(1));
+  std::vector<common::Task> tasks;
+  for (size_t thread_index = 0; thread_index < thread_num; ++thread_index) {
+    tasks.emplace_back([&, thread_index]() {
+      std::vector<Share *> shares_tmp;
+      if (!MallocShares(&shares_tmp, cipher_init_->secrets_minnums_)) {
+        MS_LOG(ERROR) << "Reconstruct malloc shares_tmp invalid.";
+        succeeded = false;
+        return common::FAIL;
+      }
+      mpz_t prime;
+      mpz_init(prime);
+      mpz_import(prime, PRIME_MAX_LEN, 1, 1, 0, 0, cipher_init_->GetPublicParams()->prime);
+      SecretSharing combine(prime);
+      for (size_t i = thread_index; i < client_shares.size(); i += thread_num) {
+        const std::vector<clientshare_str> &shares = *client_shares[i];
+        for (size_t j = 0; j < cipher_init_->secrets_minnums_; ++j) {
+          shares_tmp[j]->index = shares[j].index;
+          shares_tmp[j]->len = shares[j].share.size();
+          if (memcpy_s(shares_tmp[j]->data, SHARE_MAX_SIZE, shares[j].share.data(), shares_tmp[j]->len) != 0) {
+            MS_LOG(ERROR) << "shares_tmp copy failed";
+            succeeded = false;
+          }
+        }
+        size_t length;
+        if (combine.Combine(static_cast<int>(cipher_init_->secrets_minnums_), shares_tmp, (*secrets)[i].data(),
+                            &length) < 0) {
+          succeeded = false;
+        }
+      }
+      mpz_clear(prime);
+      DeleteShares(&shares_tmp);
+      return common::SUCCESS;
+    });
+  }
+  common::ThreadPool::GetInstance().SyncRun(tasks);
+  return succeeded;
+#endif
+}
+
 bool CipherReconStruct::CombineMask(
-  std::vector<Share *> *shares_tmp, std::map<std::string, std::vector<float>> *client_keys,
   const std::vector<std::string> &clients_share_list,
   const std::map<std::string, std::vector<std::vector<unsigned char>>> &record_public_keys,
   const std::map<std::string, std::vector<clientshare_str>> &reconstruct_secret_list,
-  const std::vector<string> &client_list) {
-  bool retcode = true;
+  const std::vector<string> &client_list, size_t thread_num, std::vector<float> *noise) {
 #ifdef _WIN32
   MS_LOG(ERROR) << "Unsupported feature in Windows platform.";
-  retcode = false;
+  return false;
 #else
+  std::vector<const std::string *> fl_ids;
+  std::vector<const std::vector<clientshare_str> *> client_shares;
   for (auto iter = reconstruct_secret_list.begin(); iter != reconstruct_secret_list.end(); ++iter) {
-    // define flag_share: judge we need b or s
-    bool flag_share = true;
-    const std::string fl_id = iter->first;
-    std::vector<std::string>::const_iterator ptr = client_list.begin();
-    for (; ptr < client_list.end(); ++ptr) {
-      if (*ptr == fl_id) {
-        flag_share = false;
-        break;
-      }
+    if (iter->second.size() >= cipher_init_->secrets_minnums_) {
+      fl_ids.push_back(&iter->first);
+      client_shares.push_back(&iter->second);
     }
-    MS_LOG(INFO) << "fl_id_src : " << fl_id;
-    mpz_t prime;
-    mpz_init(prime);
-    auto publicparam_ = CipherInit::GetInstance().GetPublicParams();
-    mpz_import(prime, PRIME_MAX_LEN, 1, 1, 0, 0, publicparam_->prime);
-    if (iter->second.size() >= cipher_init_->secrets_minnums_) {  // combine private key seed.
-      MS_LOG(INFO) << "start assign secrets shares to public shares ";
-      for (int i = 0; i < static_cast<int>(cipher_init_->secrets_minnums_); ++i) {
-        shares_tmp->at(i)->index = (iter->second)[i].index;
-        shares_tmp->at(i)->len = (iter->second)[i].share.size();
-        if (memcpy_s(shares_tmp->at(i)->data, shares_tmp->at(i)->len, (iter->second)[i].share.data(),
-                     shares_tmp->at(i)->len) != 0) {
-          MS_LOG(ERROR) << "shares_tmp copy failed";
-          retcode = false;
-        }
-        MS_LOG(INFO) << "fl_id_des : " << (iter->second)[i].fl_id;
-        std::string print_share_data(reinterpret_cast<const char *>(shares_tmp->at(i)->data), shares_tmp->at(i)->len);
-      }
-      MS_LOG(INFO) << "end assign secrets shares to public shares ";
+  }
+  std::vector<std::vector<char>> secrets;
+  bool retcode = CombineSecrets(client_shares, thread_num, &secrets);
+  MS_LOG(INFO) << "combine secrets shares of " << secrets.size() << " clients, result: " << retcode;
 
-      size_t length;
-      char secret[SECRET_MAX_LEN] = {0};
-      SecretSharing combine(prime);
-      if (combine.Combine(static_cast<int>(cipher_init_->secrets_minnums_), *shares_tmp, secret, &length) < 0)
-        retcode = false;
-      length = SECRET_MAX_LEN;
-      MS_LOG(INFO) << "combine secrets shares Success.";
+  // The clients which uploaded their model are masked by their own secret b, the others are masked by the keys s_uv
+  // they share with the other clients, whose masks remain after the aggregation.
+  std::vector<MaskJob> jobs;
+  for (size_t i = 0; i < fl_ids.size(); ++i) {
+    const std::string &fl_id = *fl_ids[i];
+    if (std::find(client_list.begin(), client_list.end(), fl_id) != client_list.end()) {
+      jobs.push_back({i, nullptr, -1.0});
+      continue;
+    }
+    for (const auto &peer : clients_share_list) {
+      if (peer != fl_id) {
+        jobs.push_back({i, &peer, GetSymbol(fl_id, peer) ? 1.0f : -1.0f});
+      }
+    }
+  }
 
-      if (flag_share) {
-        MS_LOG(INFO) << "start get complete s_uv.";
-        std::vector<float> noise(cipher_init_->featuremap_, 0.0);
-        if (GetSuvNoise(clients_share_list, record_public_keys, fl_id, &noise, secret, length) == false)
-          retcode = false;
-        client_keys->insert(std::pair<std::string, std::vector<float>>(fl_id, noise));
-        MS_LOG(INFO) << " fl_id : " << fl_id;
-        MS_LOG(INFO) << "end get complete s_uv.";
-      } else {
-        std::vector<float> noise;
-        if (Random::RandomAESCTR(&noise, cipher_init_->featuremap_, (const unsigned char *)secret, SECRET_MAX_LEN) < 0)
-          retcode = false;
-        for (size_t index_noise = 0; index_noise < cipher_init_->featuremap_; index_noise++) {
-          noise[index_noise] *= -1;
+  // Every thread sums up the masks of its jobs, the sums of the threads are added at the end.
+  size_t featuremap = cipher_init_->featuremap_;
+  thread_num = std::max(std::min(thread_num, jobs.size()), static_cast<size_t>(1));
+  std::vector<std::vector<float>> thread_noises(thread_num, std::vector<float>(featuremap, 0.0));
+  std::atomic_bool succeeded = retcode;
+  std::vector<common::Task> tasks;
+  for (size_t thread_index = 0; thread_index < thread_num; ++thread_index) {
+    tasks.emplace_back([&, thread_index]() {
+      float *thread_noise = thread_noises[thread_index].data();
+      for (size_t i = thread_index; i < jobs.size(); i += thread_num) {
+        const MaskJob &job = jobs[i];
+        auto secret = reinterpret_cast<unsigned char *>(secrets[job.secret_index].data());
+        unsigned char shared_key[SECRET_MAX_LEN] = {0};
+        if (job.peer != nullptr) {
+          auto public_keys = record_public_keys.find(*job.peer);
+          if (public_keys == record_public_keys.end() || public_keys->second.size() < 2 ||
+              !GetSharedKey(secret, public_keys->second[1], shared_key)) {
+            MS_LOG(ERROR) << "Get the key shared with " << *job.peer << " failed";
+            succeeded = false;
+            continue;
+          }
+          secret = shared_key;
+        }
+        if (Random::AddRandomAESCTR(job.scale, secret, SECRET_MAX_LEN, featuremap, thread_noise) < 0) {
+          MS_LOG(ERROR) << "AddRandomAESCTR failed";
+          succeeded = false;
         }
-        client_keys->insert(std::pair<std::string, std::vector<float>>(fl_id, noise));
-        MS_LOG(INFO) << " fl_id : " << fl_id;
       }
-    }
+      return common::SUCCESS;
+    });
+  }
+  common::ThreadPool::GetInstance().SyncRun(tasks);
+  for (size_t i = 1; i < thread_num; ++i) {
+    (void)ElementAdd(thread_noises[0].data(), thread_noises[i].data(), thread_noises[0].data(), SizeToInt(featuremap));
   }
+  *noise = std::move(thread_noises[0]);
+  return succeeded;
 #endif
-  return retcode;
 }
 
 bool CipherReconStruct::ReconstructSecretsGenNoise(const std::vector<string> &client_list) {
@@ -120,30 +187,16 @@ bool CipherReconStruct::ReconstructSecretsGenNoise(const std::vector<string> &cl
 
   std::map<std::string, std::vector<clientshare_str>> reconstruct_secret_list;
   ConvertSharesToShares(reconstruct_secret_list_ori, &reconstruct_secret_list);
-  std::vector<Share *> shares_tmp;
-  if (MallocShares(&shares_tmp, cipher_init_->secrets_minnums_) == false) {
-    MS_LOG(ERROR) << "Reconstruct malloc shares_tmp invalid.";
-    return false;
-  }
   MS_LOG(INFO) << "Reconstruct client list: ";
   std::vector<std::string>::const_iterator ptr_tmp = client_list.begin();
   for (; ptr_tmp < client_list.end(); ++ptr_tmp) {
     MS_LOG(INFO) << *ptr_tmp;
   }
   MS_LOG(INFO) << "Reconstruct secrets shares: ";
-  std::map<std::string, std::vector<float>> client_keys;
-
-  retcode = CombineMask(&shares_tmp, &client_keys, clients_share_list, record_public_keys, reconstruct_secret_list,
-                        client_list);
-
-  DeleteShares(&shares_tmp);
+  std::vector<float> noise;
+  retcode = CombineMask(clients_share_list, record_public_keys, reconstruct_secret_list, client_list,
+                        common::ThreadPool::GetInstance().GetSyncRunThreadNum(), &noise);
   if (retcode) {
-    std::vector<float> noise;
-    if (GetNoiseMasksSum(&noise, client_keys) == false) {
-      MS_LOG(ERROR) << " GetNoiseMasksSum failed";
-      return false;
-    }
-    client_keys.clear();
     MS_LOG(INFO) << " ReconstructSecretsGenNoise updata noise to server";
 
     if (cipher_init_->cipher_meta_storage_.UpdateClientNoiseToServer(fl::server::kCtxClientNoises, noise) == false)
@@ -260,23 +313,6 @@ bool CipherReconStruct::ReconstructSecrets(const int cur_iterator, const std::st
   }
 }
 
-bool CipherReconStruct::GetNoiseMasksSum(std::vector<float> *result,
-                                         const std::map<std::string, std::vector<float>> &client_keys) {
-  std::vector<float> sum(cipher_init_->featuremap_, 0.0);
-  for (auto iter = client_keys.begin(); iter != client_keys.end(); iter++) {
-    if (iter->second.size() != cipher_init_->featuremap_) {
-      return false;
-    }
-    for (size_t i = 0; i < cipher_init_->featuremap_; i++) {
-      sum[i] += iter->second[i];
-    }
-  }
-  for (size_t i = 0; i < cipher_init_->featuremap_; i++) {
-    result->push_back(sum[i]);
-  }
-  return true;
-}
-
 void CipherReconStruct::ClearReconstructSecrets() {
   MS_LOG(INFO) << "CipherReconStruct::ClearReconstructSecrets START";
   fl::server::DistributedMetadataStore::GetInstance().ResetMetadata(fl::server::kCtxReconstructClientList);
@@ -300,56 +336,32 @@ void CipherReconStruct::BuildReconstructSecretsRsp(std::shared_ptr<fl::server::F
   return;
 }
 
-bool CipherReconStruct::GetSuvNoise(
-  const std::vector<std::string> &clients_share_list,
-  const std::map<std::string, std::vector<std::vector<unsigned char>>> &record_public_keys, const string &fl_id,
-  std::vector<float> *noise, char *secret, int length) {
-  for (auto p_key = clients_share_list.begin(); p_key != clients_share_list.end(); ++p_key) {
-    if (*p_key != fl_id) {
-      PrivateKey *privKey1 = KeyAgreement::FromPrivateBytes((unsigned char *)secret, length);
-      if (privKey1 == NULL) {
-        MS_LOG(ERROR) << "create privKey1 failed\n";
-        return false;
-      }
-      std::vector<unsigned char> public_key = record_public_keys.at(*p_key)[1];
-      PublicKey *pubKey1 = KeyAgreement::FromPublicBytes(public_key.data(), public_key.size());
-      if (pubKey1 == NULL) {
-        MS_LOG(ERROR) << "create pubKey1 failed\n";
-        return false;
-      }
-      MS_LOG(INFO) << "fl_id : " << fl_id << "other id : " << *p_key;
-      unsigned char secret1[SECRET_MAX_LEN] = {0};
-      unsigned char salt[SECRET_MAX_LEN] = {0};
-      if (KeyAgreement::ComputeSharedKey(privKey1, pubKey1, SECRET_MAX_LEN, salt, SECRET_MAX_LEN, secret1) < 0) {
-        MS_LOG(ERROR) << "ComputeSharedKey failed\n";
-        return false;
-      }
-
-      std::vector<float> noise_tmp;
-      if (Random::RandomAESCTR(&noise_tmp, cipher_init_->featuremap_, (const unsigned char *)secret1, SECRET_MAX_LEN) <
-          0) {
-        MS_LOG(ERROR) << "RandomAESCTR failed\n";
-        return false;
-      }
-      bool symbol_noise = GetSymbol(fl_id, *p_key);
-      size_t index = 0;
-      size_t size_noise = noise_tmp.size();
-      if (symbol_noise == false) {
-        for (; index < size_noise; ++index) {
-          noise_tmp[index] = noise_tmp[index] * -1;
-          noise->at(index) += noise_tmp[index];
-        }
-      } else {
-        for (; index < size_noise; ++index) {
-          noise->at(index) += noise_tmp[index];
-        }
-      }
-      for (int i = 0; i < 5; i++) {
-        MS_LOG(INFO) << "index " << i << " : " << noise_tmp[i];
-      }
-    }
+bool CipherReconStruct::GetSharedKey(unsigned char *secret, const std::vector<unsigned char> &peer_public_key,
+                                     unsigned char *shared_key) {
+#ifdef _WIN32
+  MS_LOG(ERROR) << "Unsupported feature in Windows platform.";
+  return false;
+#else
+  std::unique_ptr<PrivateKey> private_key(KeyAgreement::FromPrivateBytes(secret, SECRET_MAX_LEN));
+  if (private_key == nullptr) {
+    MS_LOG(ERROR) << "create privKey1 failed";
+    return false;
+  }
+  std::vector<unsigned char> public_key_bytes = peer_public_key;
+  std::unique_ptr<PublicKey> public_key(
+    KeyAgreement::FromPublicBytes(public_key_bytes.data(), static_cast<int>(public_key_bytes.size())));
+  if (public_key == nullptr) {
+    MS_LOG(ERROR) << "create pubKey1 failed";
+    return false;
+  }
+  unsigned char salt[SECRET_MAX_LEN] = {0};
+  if (KeyAgreement::ComputeSharedKey(private_key.get(), public_key.get(), SECRET_MAX_LEN, salt, SECRET_MAX_LEN,
+                                     shared_key) < 0) {
+    MS_LOG(ERROR) << "ComputeSharedKey failed";
+    return false;
   }
   return true;
+#endif
 }
 
 bool CipherReconStruct::GetSymbol(const std::string &str1, const std::string &str2) {
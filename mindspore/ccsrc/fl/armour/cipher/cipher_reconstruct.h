@@ -58,10 +58,9 @@ class CipherReconStruct {
   CipherInit *cipher_init_;  // the parameter of the secure aggregation
   // get mask symbol by comparing str1 and str2.
   bool GetSymbol(const std::string &str1, const std::string &str2);
-  // get suv noise by computing shares result.
-  bool GetSuvNoise(const std::vector<std::string> &clients_share_list,
-                   const std::map<std::string, std::vector<std::vector<unsigned char>>> &record_public_keys,
-                   const string &fl_id, std::vector<float> *noise, char *secret, int length);
+  // compute the key s_uv shared by the client of secret and its peer from the private key of the client.
+  bool GetSharedKey(unsigned char *secret, const std::vector<unsigned char> &peer_public_key,
+                    unsigned char *shared_key);
   // malloc shares.
   bool MallocShares(std::vector<Share *> *shares_tmp, int shares_size);
   // delete shares.
@@ -71,15 +70,14 @@ class CipherReconStruct {
                              std::map<std::string, std::vector<clientshare_str>> *des);
   // generate noise from shares.
   bool ReconstructSecretsGenNoise(const std::vector<string> &client_list);
-  // get noise masks sum.
-  bool GetNoiseMasksSum(std::vector<float> *result, const std::map<std::string, std::vector<float>> &client_keys);
-
-  // combine noise mask.
-  bool CombineMask(std::vector<Share *> *shares_tmp, std::map<std::string, std::vector<float>> *client_keys,
-                   const std::vector<std::string> &clients_share_list,
+  // reconstruct the secrets of the clients from their shares on thread_num threads.
+  bool CombineSecrets(const std::vector<const std::vector<clientshare_str> *> &client_shares, size_t thread_num,
+                      std::vector<std::vector<char>> *secrets);
+  // combine noise mask: expand the masks of all clients from their secrets on thread_num threads and sum them up.
+  bool CombineMask(const std::vector<std::string> &clients_share_list,
                    const std::map<std::string, std::vector<std::vector<unsigned char>>> &record_public_keys,
                    const std::map<std::string, std::vector<clientshare_str>> &reconstruct_secret_list,
-                   const std::vector<string> &client_list);
+                   const std::vector<string> &client_list, size_t thread_num, std::vector<float> *noise);
 };
 }  // namespace armour
 }  // namespace mindspore
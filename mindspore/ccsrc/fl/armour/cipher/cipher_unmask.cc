@@ -15,6 +15,7 @@
  */
 
 #include "fl/armour/cipher/cipher_unmask.h"
+#include "backend/kernel_compiler/cpu/nnacl/fp32/add_fp32.h"
 #include "fl/server/common.h"
 #include "fl/server/local_meta_store.h"
 #include "fl/armour/cipher/cipher_meta_storage.h"
@@ -33,14 +34,17 @@ bool CipherUnmask::UnMask(const std::map<std::string, AddressPtr> &data) {
   }
 
   size_t data_size = fl::server::LocalMetaStore::GetInstance().value<size_t>(fl::server::kCtxFedAvgTotalDataSize);
-  int sum_size = 0;
+  size_t sum_size = 0;
   for (auto iter = data.begin(); iter != data.end(); ++iter) {
-    int size_data = iter->second->size / sizeof(float);
+    size_t size_data = iter->second->size / sizeof(float);
     float *in_data = reinterpret_cast<float *>(iter->second->addr);
     MS_LOG(INFO) << " weight name : " << iter->first;
-    for (int i = 0; i < size_data; ++i) {
-      in_data[i] = in_data[i] + noise[i + sum_size] / data_size;
+    if (sum_size + size_data > noise.size()) {
+      MS_LOG(ERROR) << "The weights are larger than the noise of size " << noise.size();
+      return false;
     }
+    (void)ElementAddDivScalar(in_data, noise.data() + sum_size, static_cast<float>(data_size), in_data,
+                              SizeToInt(size_data));
     sum_size += size_data;
     for (size_t i = 0; i < data.size(); ++i) {
       MS_LOG(INFO) << " index : " << i << " in_data unmask: " << in_data[i] * data_size;
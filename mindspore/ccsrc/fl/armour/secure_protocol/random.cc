@@ -15,9 +15,19 @@
  */
 
 #include "fl/armour/secure_protocol/random.h"
+#include <algorithm>
+#include "backend/kernel_compiler/cpu/nnacl/base/cast_base.h"
+#include "backend/kernel_compiler/cpu/nnacl/fp32/add_fp32.h"
 
 namespace mindspore {
 namespace armour {
+namespace {
+// The number of int32 values of the key stream generated at a time.
+constexpr size_t kKeyStreamBlockSize = 4096;
+constexpr int kSeedLen128 = 16;
+constexpr int kSeedLen256 = 32;
+}  // namespace
+
 Random::Random(size_t init_seed) { generator.seed(init_seed); }
 
 Random::~Random() {}
@@ -33,6 +43,11 @@ int Random::RandomAESCTR(std::vector<float> *noise, int noise_len, const unsigne
   return -1;
 }
 
+int Random::AddRandomAESCTR(float scale, const unsigned char *seed, int seed_len, size_t noise_len, float *noise) {
+  MS_LOG(ERROR) << "Unsupported feature in Windows platform.";
+  return -1;
+}
+
 #else
 int Random::GetRandomBytes(unsigned char *secret, int num_bytes) {
   int retval = RAND_priv_bytes(secret, num_bytes);
@@ -40,25 +55,58 @@ int Random::GetRandomBytes(unsigned char *secret, int num_bytes) {
 }
 
 int Random::RandomAESCTR(std::vector<float> *noise, int noise_len, const unsigned char *seed, int seed_len) {
-  if (seed_len != 16 && seed_len != 32) {
+  if (noise_len < 0) {
+    MS_LOG(ERROR) << "noise length must not be negative!";
+    return -1;
+  }
+  size_t offset = noise->size();
+  noise->resize(offset + noise_len, 0.0);
+  return AddRandomAESCTR(1.0, seed, seed_len, noise_len, noise->data() + offset);
+}
+
+int Random::AddRandomAESCTR(float scale, const unsigned char *seed, int seed_len, size_t noise_len, float *noise) {
+  const EVP_CIPHER *cipher = nullptr;
+  if (seed_len == kSeedLen128) {
+    cipher = EVP_aes_128_ctr();
+  } else if (seed_len == kSeedLen256) {
+    cipher = EVP_aes_256_ctr();
+  } else {
     MS_LOG(ERROR) << "seed length must be 16 or 32!";
     return -1;
   }
-  int size = noise_len * sizeof(int);
-  std::vector<unsigned char> data(size, 0);
-  std::vector<unsigned char> encrypt_data(size, 0);
-  std::vector<unsigned char> ivec(INIT_VEC_SIZE, 0);
-  int encrypt_len = 0;
-  AESEncrypt encrypt(seed, seed_len, ivec.data(), INIT_VEC_SIZE, AES_CTR);
-  if (encrypt.EncryptData(data.data(), size, encrypt_data.data(), &encrypt_len) != 0) {
-    MS_LOG(ERROR) << "call encryptData fail!";
+  EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+  if (ctx == nullptr) {
+    MS_LOG(ERROR) << "EVP_CIPHER_CTX_new fail!";
+    return -1;
+  }
+  unsigned char ivec[INIT_VEC_SIZE] = {0};
+  if (EVP_EncryptInit_ex(ctx, cipher, nullptr, seed, ivec) != 1) {
+    MS_LOG(ERROR) << "EVP_EncryptInit_ex CTR fail!";
+    EVP_CIPHER_CTX_free(ctx);
     return -1;
   }
 
-  for (int i = 0; i < noise_len; i++) {
-    auto value = *(reinterpret_cast<int32_t *>(encrypt_data.data()) + i);
-    noise->emplace_back(static_cast<float>(value) / INT32_MAX);
+  // The key stream is the encryption of zeros, it is produced in place in the block. The values are divided by
+  // INT32_MAX / scale, which is exactly INT32_MAX for the scale 1 of RandomAESCTR.
+  int32_t block[kKeyStreamBlockSize];
+  float values[kKeyStreamBlockSize];
+  const float divisor = static_cast<float>(INT32_MAX) / scale;
+  for (size_t start = 0; start < noise_len; start += kKeyStreamBlockSize) {
+    size_t block_len = std::min(kKeyStreamBlockSize, noise_len - start);
+    auto block_bytes = reinterpret_cast<unsigned char *>(block);
+    int block_bytes_len = static_cast<int>(block_len * sizeof(int32_t));
+    std::fill(block, block + block_len, 0);
+    int out_len = 0;
+    if (EVP_EncryptUpdate(ctx, block_bytes, &out_len, block_bytes, block_bytes_len) != 1 ||
+        out_len != block_bytes_len) {
+      MS_LOG(ERROR) << "EVP_EncryptUpdate fail!";
+      EVP_CIPHER_CTX_free(ctx);
+      return -1;
+    }
+    Int32ToFloat32(block, values, static_cast<int>(block_len));
+    (void)ElementAddDivScalar(noise + start, values, divisor, noise + start, static_cast<int>(block_len));
   }
+  EVP_CIPHER_CTX_free(ctx);
   return 0;
 }
 #endif
@@ -38,6 +38,10 @@ class Random {
 
   static int RandomAESCTR(std::vector<float> *noise, int noise_len, const unsigned char *seed, int seed_len);
 
+  // Expands the seed into noise_len floats with AES-CTR like RandomAESCTR, and adds them multiplied by scale to noise.
+  // The key stream is generated block by block with one cipher context, so no buffer of the size of noise is needed.
+  static int AddRandomAESCTR(float scale, const unsigned char *seed, int seed_len, size_t noise_len, float *noise);
+
  private:
   std::default_random_engine generator;
 };
@@ -15,35 +15,46 @@
  */
 
 #include "fl/server/consistent_hash_ring.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
 
 namespace mindspore {
 namespace fl {
 namespace server {
+namespace {
+// The rounds of adjusting the virtual node numbers to the loads of the servers in Rebalance.
+constexpr size_t kMaxRebalanceRounds = 16;
+// The ring is balanced when the load of every server is at most this ratio of the average load.
+constexpr double kBalancedLoadRatio = 1.1;
+// The virtual node number of a server changes at most by this factor in one round, and stays within this factor
+// squared of the default virtual node number.
+constexpr double kMaxVirtualNodeNumRatio = 2.0;
+}  // namespace
+
 bool ConsistentHashRing::Insert(uint32_t rank) {
-  for (uint32_t i = 0; i < virtual_node_num_; i++) {
-    std::string physical_node_hash_key = std::to_string(rank) + "#" + std::to_string(i);
-    size_t hash_value = std::hash<std::string>()(physical_node_hash_key);
-    MS_LOG(DEBUG) << "Insert virtual node " << physical_node_hash_key << " for node " << rank << ", hash value is "
-                  << hash_value;
-    if (ring_.count(hash_value) != 0) {
-      MS_LOG(INFO) << "Virtual node " << physical_node_hash_key << " is already mapped to the ring.";
-      continue;
-    }
-    ring_[hash_value] = rank;
+  if (rank_virtual_node_nums_.count(rank) != 0) {
+    MS_LOG(INFO) << "Node " << rank << " is already mapped to the ring.";
+    return true;
   }
+  rank_virtual_node_nums_[rank] = virtual_node_num_;
+  InsertVirtualNodes(rank, virtual_node_num_);
   return true;
 }
 
 bool ConsistentHashRing::Erase(uint32_t rank) {
   for (auto iterator = ring_.begin(); iterator != ring_.end();) {
     if (iterator->second == rank) {
-      ring_.erase(iterator++);
+      iterator = ring_.erase(iterator);
+    } else {
+      ++iterator;
     }
   }
+  (void)rank_virtual_node_nums_.erase(rank);
   return true;
 }
 
-uint32_t ConsistentHashRing::Find(const std::string &key) {
+uint32_t ConsistentHashRing::Find(const std::string &key) const {
   size_t hash_value = std::hash<std::string>()(key);
   auto iterator = ring_.lower_bound(hash_value);
   if (iterator == ring_.end()) {
@@ -52,6 +63,96 @@ uint32_t ConsistentHashRing::Find(const std::string &key) {
   }
   return iterator->second;
 }
+
+std::map<uint32_t, uint64_t> ConsistentHashRing::Rebalance(const std::map<std::string, uint64_t> &key_loads) {
+  if (ring_.empty()) {
+    return {};
+  }
+  std::vector<std::pair<size_t, uint64_t>> key_hash_loads;
+  uint64_t total_load = 0;
+  for (const auto &key_load : key_loads) {
+    key_hash_loads.emplace_back(std::hash<std::string>()(key_load.first), key_load.second);
+    total_load += key_load.second;
+  }
+  double average_load = static_cast<double>(total_load) / rank_virtual_node_nums_.size();
+  auto max_load_of = [](const std::map<uint32_t, uint64_t> &rank_loads) {
+    uint64_t max_load = 0;
+    for (const auto &rank_load : rank_loads) {
+      max_load = std::max(max_load, rank_load.second);
+    }
+    return max_load;
+  };
+
+  std::map<uint32_t, uint64_t> rank_loads = GetRankLoads(key_hash_loads);
+  std::map<uint32_t, uint32_t> best_virtual_node_nums = rank_virtual_node_nums_;
+  uint64_t best_max_load = max_load_of(rank_loads);
+  double min_virtual_node_num = std::max(1.0, virtual_node_num_ / (kMaxVirtualNodeNumRatio * kMaxVirtualNodeNumRatio));
+  double max_virtual_node_num = virtual_node_num_ * kMaxVirtualNodeNumRatio * kMaxVirtualNodeNumRatio;
+  for (size_t round = 0; round < kMaxRebalanceRounds; round++) {
+    if (best_max_load <= average_load * kBalancedLoadRatio) {
+      break;
+    }
+    // The busy servers give up virtual nodes and the idle ones take more, in proportion to their loads.
+    for (auto &rank_virtual_node_num : rank_virtual_node_nums_) {
+      uint64_t load = rank_loads[rank_virtual_node_num.first];
+      double ratio = load == 0 ? kMaxVirtualNodeNumRatio : average_load / load;
+      ratio = std::min(std::max(ratio, 1.0 / kMaxVirtualNodeNumRatio), kMaxVirtualNodeNumRatio);
+      double virtual_node_num = std::round(rank_virtual_node_num.second * ratio);
+      rank_virtual_node_num.second =
+        static_cast<uint32_t>(std::min(std::max(virtual_node_num, min_virtual_node_num), max_virtual_node_num));
+    }
+    ring_.clear();
+    for (const auto &rank_virtual_node_num : rank_virtual_node_nums_) {
+      InsertVirtualNodes(rank_virtual_node_num.first, rank_virtual_node_num.second);
+    }
+    rank_loads = GetRankLoads(key_hash_loads);
+    uint64_t max_load = max_load_of(rank_loads);
+    if (max_load < best_max_load) {
+      best_max_load = max_load;
+      best_virtual_node_nums = rank_virtual_node_nums_;
+    }
+  }
+
+  if (best_virtual_node_nums != rank_virtual_node_nums_) {
+    rank_virtual_node_nums_ = best_virtual_node_nums;
+    ring_.clear();
+    for (const auto &rank_virtual_node_num : rank_virtual_node_nums_) {
+      InsertVirtualNodes(rank_virtual_node_num.first, rank_virtual_node_num.second);
+    }
+    rank_loads = GetRankLoads(key_hash_loads);
+  }
+  return rank_loads;
+}
+
+void ConsistentHashRing::InsertVirtualNodes(uint32_t rank, uint32_t virtual_node_num) {
+  for (uint32_t i = 0; i < virtual_node_num; i++) {
+    std::string physical_node_hash_key = std::to_string(rank) + "#" + std::to_string(i);
+    size_t hash_value = std::hash<std::string>()(physical_node_hash_key);
+    MS_LOG(DEBUG) << "Insert virtual node " << physical_node_hash_key << " for node " << rank << ", hash value is "
+                  << hash_value;
+    if (ring_.count(hash_value) != 0) {
+      MS_LOG(INFO) << "Virtual node " << physical_node_hash_key << " is already mapped to the ring.";
+      continue;
+    }
+    ring_[hash_value] = rank;
+  }
+}
+
+std::map<uint32_t, uint64_t> ConsistentHashRing::GetRankLoads(
+  const std::vector<std::pair<size_t, uint64_t>> &key_hash_loads) const {
+  std::map<uint32_t, uint64_t> rank_loads;
+  for (const auto &rank_virtual_node_num : rank_virtual_node_nums_) {
+    rank_loads[rank_virtual_node_num.first] = 0;
+  }
+  for (const auto &key_hash_load : key_hash_loads) {
+    auto iterator = ring_.lower_bound(key_hash_load.first);
+    if (iterator == ring_.end()) {
+      iterator = ring_.begin();
+    }
+    rank_loads[iterator->second] += key_hash_load.second;
+  }
+  return rank_loads;
+}
 }  // namespace server
 }  // namespace fl
 }  // namespace mindspore
@@ -19,6 +19,8 @@
 
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 #include "utils/log_adapter.h"
 
 namespace mindspore {
@@ -49,14 +51,27 @@ class ConsistentHashRing {
   bool Erase(uint32_t rank);
 
   // Find the physical server node's rank according to the metadata's key.
-  uint32_t Find(const std::string &key);
+  uint32_t Find(const std::string &key) const;
+
+  // Hashing spreads the keys evenly, but not their loads: a few hot keys may end up on the same server. Rebalance
+  // changes the virtual node number of each server so that the servers own keys of about the same total load, and
+  // returns the load of each server. The result only depends on the keys, their loads and the servers in the ring, so
+  // servers given the same loads build the same ring without communicating. A key is owned by one server, so no server
+  // gets less than the load of the largest key it owns.
+  std::map<uint32_t, uint64_t> Rebalance(const std::map<std::string, uint64_t> &key_loads);
 
  private:
+  // Place the virtual nodes of a server on the ring.
+  void InsertVirtualNodes(uint32_t rank, uint32_t virtual_node_num);
+  std::map<uint32_t, uint64_t> GetRankLoads(const std::vector<std::pair<size_t, uint64_t>> &key_hash_loads) const;
+
   uint32_t virtual_node_num_;
   // The hash ring for the server nodes.
   // Key is the hash value of the virtual node.
   // Value is the physical node' rank id.
   std::map<size_t, uint32_t> ring_;
+  // The virtual node number of each server, which is virtual_node_num_ unless the ring has been rebalanced.
+  std::map<uint32_t, uint32_t> rank_virtual_node_nums_;
 };
 }  // namespace server
 }  // namespace fl
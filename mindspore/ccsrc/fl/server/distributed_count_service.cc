@@ -16,19 +16,19 @@
 
 #include "fl/server/distributed_count_service.h"
 #include <string>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 namespace mindspore {
 namespace fl {
 namespace server {
-void DistributedCountService::Initialize(const std::shared_ptr<ps::core::ServerNode> &server_node,
-                                         uint32_t counting_server_rank) {
+void DistributedCountService::Initialize(const std::shared_ptr<ps::core::ServerNode> &server_node) {
   server_node_ = server_node;
   MS_EXCEPTION_IF_NULL(server_node_);
   local_rank_ = server_node_->rank_id();
   server_num_ = ps::PSContext::instance()->initial_server_num();
-  counting_server_rank_ = counting_server_rank;
   return;
 }
 
@@ -56,19 +56,62 @@ void DistributedCountService::RegisterCounter(const std::string &name, size_t gl
   }
 
   MS_LOG(INFO) << "Rank " << local_rank_ << " register counter for " << name << " count:" << global_threshold_count;
-  // If the server is the leader server, it needs to set the counter handlers and do the real counting.
-  if (local_rank_ == counting_server_rank_) {
-    global_current_count_[name] = {};
-    global_threshold_count_[name] = global_threshold_count;
-    mutex_[name];
-  }
+  // Every server keeps the threshold counts because they decide which server does the real counting for each name.
+  global_current_count_[name] = {};
+  global_threshold_count_[name] = global_threshold_count;
+  mutex_[name];
   counter_handlers_[name] = counter_handlers;
+  std::shared_lock<std::shared_mutex> lock(router_mutex_);
+  if (router_ != nullptr) {
+    MS_LOG(WARNING) << "Counter for " << name << " is registered after the counter ring is built. The ring must be "
+                    << "built again, otherwise the servers may disagree on the counting server.";
+  }
+  return;
+}
+
+void DistributedCountService::BuildCounterRing() {
+  // The ring is built from scratch, so it only depends on the servers and the counters registered.
+  auto router = std::make_shared<ConsistentHashRing>(kCounterRingVirtualNodeNum);
+  for (uint32_t i = 0; i < server_num_; i++) {
+    if (!router->Insert(i)) {
+      MS_LOG(EXCEPTION) << "Add node " << i << " to router of count service failed.";
+      return;
+    }
+  }
+  std::map<std::string, uint64_t> counter_loads;
+  for (const auto &threshold_count : global_threshold_count_) {
+    counter_loads[threshold_count.first] = threshold_count.second;
+  }
+  std::map<uint32_t, uint64_t> rank_loads = router->Rebalance(counter_loads);
+  MS_LOG(INFO) << "Counter ring is built for " << counter_loads.size() << " counters. Expected counts served by rank "
+               << local_rank_ << " every iteration: " << rank_loads[local_rank_];
+
+  std::unique_lock<std::shared_mutex> lock(router_mutex_);
+  router_ = router;
   return;
 }
 
+bool DistributedCountService::FindCountingServer(const std::string &name, uint32_t *counting_server_rank) {
+  MS_EXCEPTION_IF_NULL(counting_server_rank);
+  std::shared_lock<std::shared_mutex> lock(router_mutex_);
+  if (router_ == nullptr) {
+    MS_LOG(ERROR) << "The counter ring is not built yet, can't find the counting server of " << name;
+    return false;
+  }
+  *counting_server_rank = router_->Find(name);
+  return true;
+}
+
 bool DistributedCountService::Count(const std::string &name, const std::string &id, std::string *reason) {
   MS_LOG(INFO) << "Rank " << local_rank_ << " reports count for " << name << " of " << id;
-  if (local_rank_ == counting_server_rank_) {
+  uint32_t counting_server_rank = 0;
+  if (!FindCountingServer(name, &counting_server_rank)) {
+    if (reason != nullptr) {
+      *reason = "The counter ring is not built yet.";
+    }
+    return false;
+  }
+  if (local_rank_ == counting_server_rank) {
     if (global_threshold_count_.count(name) == 0) {
       MS_LOG(ERROR) << "Counter for " << name << " is not registered.";
       return false;
@@ -81,22 +124,23 @@ bool DistributedCountService::Count(const std::string &name, const std::string &
       return false;
     }
 
-    MS_LOG(INFO) << "Leader server increase count for " << name << " of " << id;
+    MS_LOG(INFO) << "Counting server increase count for " << name << " of " << id;
     global_current_count_[name].insert(id);
     if (!TriggerCounterEvent(name, reason)) {
-      MS_LOG(ERROR) << "Leader server trigger count event failed.";
+      MS_LOG(ERROR) << "Counting server trigger count event failed.";
       return false;
     }
   } else {
-    // If this server is a follower server, it needs to send CountRequest to the leader server.
+    // If this server is not the counting server of the name, it needs to send CountRequest to the counting server.
     CountRequest report_count_req;
     report_count_req.set_name(name);
     report_count_req.set_id(id);
 
     std::shared_ptr<std::vector<unsigned char>> report_cnt_rsp_msg = nullptr;
-    if (!communicator_->SendPbRequest(report_count_req, counting_server_rank_, ps::core::TcpUserCommand::kCount,
+    if (!communicator_->SendPbRequest(report_count_req, counting_server_rank, ps::core::TcpUserCommand::kCount,
                                       &report_cnt_rsp_msg)) {
-      MS_LOG(ERROR) << "Sending reporting count message to leader server failed for " << name;
+      MS_LOG(ERROR) << "Sending reporting count message to counting server " << counting_server_rank
+                    << " failed for " << name;
       if (reason != nullptr) {
         *reason = kNetworkError;
       }
@@ -118,7 +162,11 @@ bool DistributedCountService::Count(const std::string &name, const std::string &
 
 bool DistributedCountService::CountReachThreshold(const std::string &name) {
   MS_LOG(INFO) << "Rank " << local_rank_ << " query whether count reaches threshold for " << name;
-  if (local_rank_ == counting_server_rank_) {
+  uint32_t counting_server_rank = 0;
+  if (!FindCountingServer(name, &counting_server_rank)) {
+    return false;
+  }
+  if (local_rank_ == counting_server_rank) {
     if (global_threshold_count_.count(name) == 0) {
       MS_LOG(ERROR) << "Counter for " << name << " is not set.";
       return false;
@@ -131,9 +179,10 @@ bool DistributedCountService::CountReachThreshold(const std::string &name) {
     count_reach_threshold_req.set_name(name);
 
     std::shared_ptr<std::vector<unsigned char>> query_cnt_enough_rsp_msg = nullptr;
-    if (!communicator_->SendPbRequest(count_reach_threshold_req, counting_server_rank_,
+    if (!communicator_->SendPbRequest(count_reach_threshold_req, counting_server_rank,
                                       ps::core::TcpUserCommand::kReachThreshold, &query_cnt_enough_rsp_msg)) {
-      MS_LOG(ERROR) << "Sending querying whether count reaches threshold message to leader server failed for " << name;
+      MS_LOG(ERROR) << "Sending querying whether count reaches threshold message to counting server "
+                    << counting_server_rank << " failed for " << name;
       return false;
     }
 
@@ -145,8 +194,9 @@ bool DistributedCountService::CountReachThreshold(const std::string &name) {
 }
 
 void DistributedCountService::ResetCounter(const std::string &name) {
-  if (local_rank_ == counting_server_rank_) {
-    MS_LOG(DEBUG) << "Leader server reset count for " << name;
+  uint32_t counting_server_rank = 0;
+  if (FindCountingServer(name, &counting_server_rank) && local_rank_ == counting_server_rank) {
+    MS_LOG(DEBUG) << "Counting server reset count for " << name;
     global_current_count_[name].clear();
   }
   return;
@@ -164,7 +214,11 @@ bool DistributedCountService::ReInitForScaling() {
   MS_LOG(INFO) << "After scheduler scaling, this server's rank is " << local_rank_ << ", server number is "
                << server_num_;
 
-  // Clear old counter data of this server.
+  // Clear old counter data of this server. The counters are registered again and the ring is built again for them.
+  {
+    std::unique_lock<std::shared_mutex> lock(router_mutex_);
+    router_ = nullptr;
+  }
   global_current_count_.clear();
   global_threshold_count_.clear();
   counter_handlers_.clear();
@@ -183,8 +237,18 @@ void DistributedCountService::HandleCountRequest(const std::shared_ptr<ps::core:
   const std::string &id = report_count_req.id();
 
   CountResponse count_rsp;
-  std::unique_lock<std::mutex> lock(mutex_[name]);
-  // If leader server has no counter for the name registered, return an error.
+  // Only the counting server of the name counts it, otherwise a counter could be counted on two servers whose rings
+  // differ, e.g. when one of them has not built its ring after scaling yet.
+  uint32_t counting_server_rank = 0;
+  if (!FindCountingServer(name, &counting_server_rank) || counting_server_rank != local_rank_) {
+    std::string reason = "Rank " + std::to_string(local_rank_) + " is not the counting server of " + name + ".";
+    count_rsp.set_result(false);
+    count_rsp.set_reason(reason);
+    MS_LOG(ERROR) << reason;
+    communicator_->SendResponse(count_rsp.SerializeAsString().data(), count_rsp.SerializeAsString().size(), message);
+    return;
+  }
+  // If counting server has no counter for the name registered, return an error.
   if (global_threshold_count_.count(name) == 0) {
     std::string reason = "Counter for " + name + " is not registered.";
     count_rsp.set_result(false);
@@ -193,8 +257,9 @@ void DistributedCountService::HandleCountRequest(const std::shared_ptr<ps::core:
     communicator_->SendResponse(count_rsp.SerializeAsString().data(), count_rsp.SerializeAsString().size(), message);
     return;
   }
+  std::unique_lock<std::mutex> lock(mutex_[name]);
 
-  // If leader server already has enough count for the name, return an error.
+  // If counting server already has enough count for the name, return an error.
   if (global_current_count_[name].size() >= global_threshold_count_[name]) {
     std::string reason =
       "Count for " + name + " is already enough. Threshold count is " + std::to_string(global_threshold_count_[name]);
@@ -206,7 +271,7 @@ void DistributedCountService::HandleCountRequest(const std::shared_ptr<ps::core:
   }
 
   // Insert the id for the counter, which means the count for the name is increased.
-  MS_LOG(INFO) << "Leader server increase count for " << name << " of " << id;
+  MS_LOG(INFO) << "Counting server increase count for " << name << " of " << id;
   global_current_count_[name].insert(id);
   std::string reason = "success";
   if (!TriggerCounterEvent(name, &reason)) {
@@ -231,13 +296,21 @@ void DistributedCountService::HandleCountReachThresholdRequest(
   count_reach_threshold_req.ParseFromArray(message->data(), SizeToInt(message->len()));
   const std::string &name = count_reach_threshold_req.name();
 
-  std::unique_lock<std::mutex> lock(mutex_[name]);
+  CountReachThresholdResponse count_reach_threshold_rsp;
+  uint32_t counting_server_rank = 0;
+  if (!FindCountingServer(name, &counting_server_rank) || counting_server_rank != local_rank_) {
+    MS_LOG(ERROR) << "Rank " << local_rank_ << " is not the counting server of " << name;
+    count_reach_threshold_rsp.set_is_enough(false);
+    communicator_->SendResponse(count_reach_threshold_rsp.SerializeAsString().data(),
+                                count_reach_threshold_rsp.SerializeAsString().size(), message);
+    return;
+  }
   if (global_threshold_count_.count(name) == 0) {
     MS_LOG(ERROR) << "Counter for " << name << " is not registered.";
     return;
   }
 
-  CountReachThresholdResponse count_reach_threshold_rsp;
+  std::unique_lock<std::mutex> lock(mutex_[name]);
   count_reach_threshold_rsp.set_is_enough(global_current_count_[name].size() == global_threshold_count_[name]);
   communicator_->SendResponse(count_reach_threshold_rsp.SerializeAsString().data(),
                               count_reach_threshold_rsp.SerializeAsString().size(), message);
@@ -250,7 +323,7 @@ void DistributedCountService::HandleCounterEvent(const std::shared_ptr<ps::core:
     return;
   }
 
-  // Respond as soon as possible so the leader server won't wait for each follower servers to finish calling the
+  // Respond as soon as possible so the counting server won't wait for each of the other servers to finish calling the
   // callbacks.
   std::string couter_event_rsp_msg = "success";
   communicator_->SendResponse(couter_event_rsp_msg.data(), couter_event_rsp_msg.size(), message);
@@ -295,8 +368,11 @@ bool DistributedCountService::TriggerFirstCountEvent(const std::string &name, st
   first_count_event.set_type(CounterEventType::FIRST_CNT);
   first_count_event.set_name(name);
 
-  // Broadcast to all follower servers.
-  for (uint32_t i = 1; i < server_num_; i++) {
+  // Broadcast to all the other servers.
+  for (uint32_t i = 0; i < server_num_; i++) {
+    if (i == local_rank_) {
+      continue;
+    }
     if (!communicator_->SendPbRequest(first_count_event, i, ps::core::TcpUserCommand::kCounterEvent)) {
       MS_LOG(ERROR) << "Activating first count event to server " << i << " failed.";
       if (reason != nullptr) {
@@ -305,7 +381,7 @@ bool DistributedCountService::TriggerFirstCountEvent(const std::string &name, st
       return false;
     }
   }
-  // Leader server directly calls the callback.
+  // Counting server directly calls the callback.
   counter_handlers_[name].first_count_handler(nullptr);
   return true;
 }
@@ -316,8 +392,11 @@ bool DistributedCountService::TriggerLastCountEvent(const std::string &name, std
   last_count_event.set_type(CounterEventType::LAST_CNT);
   last_count_event.set_name(name);
 
-  // Broadcast to all follower servers.
-  for (uint32_t i = 1; i < server_num_; i++) {
+  // Broadcast to all the other servers.
+  for (uint32_t i = 0; i < server_num_; i++) {
+    if (i == local_rank_) {
+      continue;
+    }
     if (!communicator_->SendPbRequest(last_count_event, i, ps::core::TcpUserCommand::kCounterEvent)) {
       MS_LOG(ERROR) << "Activating last count event to server " << i << " failed.";
       if (reason != nullptr) {
@@ -326,7 +405,7 @@ bool DistributedCountService::TriggerLastCountEvent(const std::string &name, std
       return false;
     }
   }
-  // Leader server directly calls the callback.
+  // Counting server directly calls the callback.
   counter_handlers_[name].last_count_handler(nullptr);
   return true;
 }
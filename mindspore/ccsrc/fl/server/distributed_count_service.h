@@ -20,16 +20,18 @@
 #include <set>
 #include <string>
 #include <memory>
+#include <shared_mutex>
 #include <unordered_map>
 #include "proto/ps.pb.h"
 #include "fl/server/common.h"
 #include "ps/core/server_node.h"
 #include "ps/core/communicator/tcp_communicator.h"
+#include "fl/server/consistent_hash_ring.h"
 
 namespace mindspore {
 namespace fl {
 namespace server {
-constexpr uint32_t kDefaultCountingServerRank = 0;
+constexpr uint32_t kCounterRingVirtualNodeNum = 32;
 constexpr auto kModuleDistributedCountService = "DistributedCountService";
 // The callbacks for the first count and last count event.
 typedef struct {
@@ -41,8 +43,16 @@ typedef struct {
 // aggregation counting, etc.
 
 // The counting could be called by any server, but only one server has the information
-// of the cluster count and we mark this server as the counting server. Other servers must communicate with this
-// counting server to increase/query count number.
+// of the cluster count of a name and we mark this server as the counting server of the name. Other servers must
+// communicate with this counting server to increase/query count number.
+
+// The counting servers are found on a consistent hash ring, so the counters are spread over the cluster instead of
+// sending every count to one server. The ring is built once all the counters are registered, and is rebalanced with the
+// threshold count of each counter as its expected load, which is the number of successful counts in every iteration.
+// So all servers build the same ring from the same registered counters without exchanging statistics. The observed
+// request rate, including the rejected and repeated counts, is not taken into account. A counter is never split: all
+// counts of a name go to one server, so the busiest server serves at least the largest counter. A server only counts
+// the names it owns on its ring and rejects the requests for other names.
 
 // On the first count or last count event, DistributedCountService on the counting server triggers the event on other
 // servers by sending counter event commands. This is for the purpose of keeping server cluster's consistency.
@@ -54,15 +64,20 @@ class DistributedCountService {
   }
 
   // Initialize counter service with the server node because communication is needed.
-  void Initialize(const std::shared_ptr<ps::core::ServerNode> &server_node, uint32_t counting_server_rank);
+  void Initialize(const std::shared_ptr<ps::core::ServerNode> &server_node);
 
   // Register message callbacks of the counting server to handle messages sent by the other servers.
   void RegisterMessageCallback(const std::shared_ptr<ps::core::TcpCommunicator> &communicator);
 
-  // Register counter to the counting server for the name with its threshold count in server cluster dimension and
-  // first/last count event callbacks.
+  // Register counter for the name with its threshold count in server cluster dimension and first/last count event
+  // callbacks. Every server registers all counters before counting, because the counting server of each name is
+  // decided by all the counters registered.
   void RegisterCounter(const std::string &name, size_t global_threshold_count, const CounterHandlers &counter_handlers);
 
+  // Build the consistent hash ring of the counting servers from the registered counters. It's called after all the
+  // counters are registered, at the start of the server and after scaling. Counting fails until the ring is built.
+  void BuildCounterRing();
+
   // Report a count to the counting server. Parameter 'id' is in case of repeated counting. Parameter 'reason' is the
   // reason why counting failed.
   bool Count(const std::string &name, const std::string &id, std::string *reason = nullptr);
@@ -98,6 +113,9 @@ class DistributedCountService {
   // method.
   void HandleCounterEvent(const std::shared_ptr<ps::core::MessageHandler> &message);
 
+  // Find the counting server of the name on the ring. Returns false if the ring is not built yet.
+  bool FindCountingServer(const std::string &name, uint32_t *counting_server_rank);
+
   // Call the callbacks when the first/last count event is triggered.
   bool TriggerCounterEvent(const std::string &name, std::string *reason = nullptr);
   bool TriggerFirstCountEvent(const std::string &name, std::string *reason = nullptr);
@@ -109,8 +127,10 @@ class DistributedCountService {
   uint32_t local_rank_;
   uint32_t server_num_;
 
-  // Only one server will be set to do the real counting.
-  uint32_t counting_server_rank_;
+  // Consistent hash ring to find the server which does the real counting for a name. It's replaced by BuildCounterRing
+  // and ReInitForScaling while the message threads look up the counting servers, so it's guarded by router_mutex_.
+  std::shared_ptr<ConsistentHashRing> router_;
+  std::shared_mutex router_mutex_;
 
   // Key: name, e.g, startFLJob, updateModel, push.
   // Value: a set of id without repeatation because each work may report multiple times.
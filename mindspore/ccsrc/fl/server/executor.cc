@@ -60,8 +60,8 @@ bool Executor::HandlePush(const std::string &param_name, const UploadData &uploa
     return false;
   }
 
-  std::mutex &mtx = parameter_mutex_[param_name];
-  std::unique_lock<std::mutex> lock(mtx);
+  std::shared_mutex &mtx = parameter_mutex_[param_name];
+  std::unique_lock<std::shared_mutex> lock(mtx);
   auto &param_aggr = param_aggrs_[param_name];
 
   // Push operation needs to wait until the pulling process is done.
@@ -103,16 +103,19 @@ bool Executor::HandleModelUpdate(const std::string &param_name, const UploadData
     return true;
   }
 
-  std::mutex &mtx = parameter_mutex_[param_name];
-  std::unique_lock<std::mutex> lock(mtx);
+  std::shared_mutex &mtx = parameter_mutex_[param_name];
   auto &param_aggr = param_aggrs_[param_name];
-
-  if (!param_aggr->UpdateData(upload_data)) {
-    MS_LOG(ERROR) << "Updating data for parameter " << param_name << " failed.";
-    return false;
+  // The uploaded data is aggregated in place, so the updates of different clients only wait for each other if the
+  // aggregators can't be launched concurrently.
+  std::shared_lock<std::shared_mutex> shared_lock(mtx, std::defer_lock);
+  std::unique_lock<std::shared_mutex> lock(mtx, std::defer_lock);
+  if (param_aggr->IsConcurrentAggregationSupported()) {
+    shared_lock.lock();
+  } else {
+    lock.lock();
   }
   // Different from Push, UpdateModel doesn't need to checkout the aggregation status.
-  if (!param_aggr->LaunchAggregators()) {
+  if (!param_aggr->LaunchAggregators(upload_data)) {
     MS_LOG(ERROR) << "Launching aggregators for parameter " << param_name << " failed.";
     return false;
   }
@@ -128,16 +131,12 @@ bool Executor::HandleModelUpdateAsync(const std::map<std::string, UploadData> &f
       continue;
     }
 
-    std::mutex &mtx = parameter_mutex_[param_name];
-    std::unique_lock<std::mutex> lock(mtx);
+    std::shared_mutex &mtx = parameter_mutex_[param_name];
+    std::unique_lock<std::shared_mutex> lock(mtx);
     auto &param_aggr = param_aggrs_[param_name];
 
     const UploadData &upload_data = trainable_param.second;
-    if (!param_aggr->UpdateData(upload_data)) {
-      MS_LOG(ERROR) << "Updating data for parameter " << param_name << " failed.";
-      return false;
-    }
-    if (!param_aggr->LaunchAggregators()) {
+    if (!param_aggr->LaunchAggregators(upload_data)) {
       MS_LOG(ERROR) << "Launching aggregators for parameter " << param_name << " failed.";
       return false;
     }
@@ -153,8 +152,8 @@ bool Executor::HandlePushWeight(const std::map<std::string, Address> &feature_ma
       continue;
     }
 
-    std::mutex &mtx = parameter_mutex_[param_name];
-    std::unique_lock<std::mutex> lock(mtx);
+    std::shared_mutex &mtx = parameter_mutex_[param_name];
+    std::unique_lock<std::shared_mutex> lock(mtx);
     auto &param_aggr = param_aggrs_[param_name];
 
     AddressPtr old_weight = param_aggr->GetWeight();
@@ -185,8 +184,8 @@ AddressPtr Executor::HandlePull(const std::string &param_name) {
     return nullptr;
   }
 
-  std::mutex &mtx = parameter_mutex_[param_name];
-  std::unique_lock<std::mutex> lock(mtx);
+  std::shared_mutex &mtx = parameter_mutex_[param_name];
+  std::unique_lock<std::shared_mutex> lock(mtx);
   auto &param_aggr = param_aggrs_[param_name];
 
   // Pulling must wait until the optimizing process is done.
@@ -211,8 +210,8 @@ std::map<std::string, AddressPtr> Executor::HandlePullWeight(const std::vector<s
       return weights;
     }
 
-    std::mutex &mtx = parameter_mutex_[param_name];
-    std::unique_lock<std::mutex> lock(mtx);
+    std::shared_mutex &mtx = parameter_mutex_[param_name];
+    std::unique_lock<std::shared_mutex> lock(mtx);
     const auto &param_aggr = param_aggrs_[param_name];
 
     AddressPtr addr = param_aggr->GetWeight();
@@ -234,8 +233,8 @@ bool Executor::IsWeightAggrDone(const std::vector<std::string> &param_names) {
       return false;
     }
 
-    std::mutex &mtx = parameter_mutex_[name];
-    std::unique_lock<std::mutex> lock(mtx);
+    std::shared_mutex &mtx = parameter_mutex_[name];
+    std::unique_lock<std::shared_mutex> lock(mtx);
     if (!param_aggrs_[name]->IsAggregationDone()) {
       MS_LOG(DEBUG) << "Update model for " << name << " is not done yet.";
       return false;
@@ -246,8 +245,8 @@ bool Executor::IsWeightAggrDone(const std::vector<std::string> &param_names) {
 
 void Executor::ResetAggregationStatus() {
   for (const auto &param_name : param_names_) {
-    std::mutex &mtx = parameter_mutex_[param_name];
-    std::unique_lock<std::mutex> lock(mtx);
+    std::shared_mutex &mtx = parameter_mutex_[param_name];
+    std::unique_lock<std::shared_mutex> lock(mtx);
     param_aggrs_[param_name]->ResetAggregationStatus();
   }
   return;
@@ -256,8 +255,8 @@ void Executor::ResetAggregationStatus() {
 std::map<std::string, AddressPtr> Executor::GetModel() {
   std::map<std::string, AddressPtr> model = {};
   for (const auto &name : param_names_) {
-    std::mutex &mtx = parameter_mutex_[name];
-    std::unique_lock<std::mutex> lock(mtx);
+    std::shared_mutex &mtx = parameter_mutex_[name];
+    std::unique_lock<std::shared_mutex> lock(mtx);
     AddressPtr addr = param_aggrs_[name]->GetWeight();
     if (addr == nullptr) {
       MS_LOG(WARNING) << "Get weight of " << name << " failed.";
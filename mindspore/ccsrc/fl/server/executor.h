@@ -23,6 +23,7 @@
 #include <string>
 #include <vector>
 #include <mutex>
+#include <shared_mutex>
 #include <condition_variable>
 #include "fl/server/common.h"
 #include "fl/server/parameter_aggregator.h"
@@ -119,8 +120,9 @@ class Executor {
   std::mutex model_mutex_;
 
   // Because ParameterAggregator is not threadsafe, we have to create mutex for each ParameterAggregator so we can
-  // acquire lock before calling its method.
-  std::map<std::string, std::mutex> parameter_mutex_;
+  // acquire lock before calling its method. Model updates only share the lock if the aggregators of the parameter can
+  // be launched concurrently.
+  std::map<std::string, std::shared_mutex> parameter_mutex_;
 #ifdef ENABLE_ARMOUR
   armour::CipherUnmask cipher_unmask_;
 #endif
@@ -64,6 +64,9 @@ class AggregationKernel : public CPUKernel {
     return;
   }
 
+  // Whether Launch could be called concurrently, each call with its own new data.
+  virtual bool IsConcurrentLaunchSupported() const { return false; }
+
   // Reinitialize aggregation kernel after scaling operations are done.
   virtual bool ReInitForScaling() { return true; }
 
@@ -17,12 +17,16 @@
 #ifndef MINDSPORE_CCSRC_FL_SERVER_KERNEL_FED_AVG_KERNEL_H_
 #define MINDSPORE_CCSRC_FL_SERVER_KERNEL_FED_AVG_KERNEL_H_
 
+#include <algorithm>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include <functional>
 #include "backend/kernel_compiler/cpu/cpu_kernel.h"
+#include "backend/kernel_compiler/cpu/nnacl/fp32/add_fp32.h"
 #include "fl/server/common.h"
 #include "fl/server/collective_ops_impl.h"
 #include "fl/server/distributed_count_service.h"
@@ -34,11 +38,18 @@ namespace mindspore {
 namespace fl {
 namespace server {
 namespace kernel {
+// The number of elements of the weight chunks locked separately during the accumulation.
+constexpr size_t kFedAvgChunkSize = 16384;
+
 // The implementation for the federated average. We do weighted average for the weights. The uploaded weights from
 // FL-clients is already multiplied by its data size so only sum and division are done in this kernel.
 
 // Pay attention that this kernel is the distributed version of federated average, which means each server node in the
 // cluster in invalved in the aggragation process. So the DistributedCountService and CollectiveOpsImpl are called.
+
+// The kernel can be launched concurrently for one weight. The weight is split into chunks which are locked separately,
+// so the updates of different clients are added into different chunks at the same time instead of waiting for each
+// other. The new weight is read in place from the request of the client.
 template <typename T, typename S>
 class FedAvgKernel : public AggregationKernel {
  public:
@@ -48,7 +59,8 @@ class FedAvgKernel : public AggregationKernel {
         data_size_addr_(nullptr),
         new_weight_addr_(nullptr),
         new_data_size_addr_(nullptr),
-        participated_(false) {}
+        participated_(false),
+        chunk_num_(0) {}
   ~FedAvgKernel() override = default;
 
   void InitKernel(const CNodePtr &kernel_node) override {
@@ -69,6 +81,9 @@ class FedAvgKernel : public AggregationKernel {
     input_size_list_.push_back(sizeof(size_t));
     input_size_list_.push_back(new_weight_size);
     input_size_list_.push_back(sizeof(size_t));
+    size_t weight_num = weight_size / sizeof(T);
+    chunk_num_ = (weight_num + kFedAvgChunkSize - 1) / kFedAvgChunkSize;
+    chunk_mutexes_ = std::make_unique<std::mutex[]>(chunk_num_);
 
     auto weight_node =
       AnfAlgo::VisitKernelWithReturnType(AnfAlgo::GetInputNode(kernel_node, cnode_weight_idx_), 0).first;
@@ -106,30 +121,36 @@ class FedAvgKernel : public AggregationKernel {
 
   bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
               const std::vector<AddressPtr> &outputs) override {
-    std::unique_lock<std::mutex> lock(weight_mutex_);
     // The weight and new_weight values should be multiplied by clients already, so we don't need to do multiplication
     // again.
     T *weight_addr = reinterpret_cast<T *>(inputs[0]->addr);
     S *data_size_addr = reinterpret_cast<S *>(inputs[1]->addr);
-    T *new_weight_addr = reinterpret_cast<T *>(inputs[2]->addr);
-    S *new_data_size_addr = reinterpret_cast<S *>(inputs[3]->addr);
-    if (accum_count_ == 0) {
-      ClearWeightAndDataSize();
+    const T *new_weight_addr = reinterpret_cast<const T *>(inputs[2]->addr);
+    const S *new_data_size_addr = reinterpret_cast<const S *>(inputs[3]->addr);
+    if (inputs[2]->size != inputs[0]->size) {
+      MS_LOG(ERROR) << "The new weight size " << inputs[2]->size << " of " << name_ << " is not the weight size "
+                    << inputs[0]->size;
+      return false;
     }
 
-    MS_LOG(DEBUG) << "Iteration: " << LocalMetaStore::GetInstance().curr_iter_num() << " launching FedAvgKernel for "
-                  << name_ << " new data size is " << new_data_size_addr[0] << ", current total data size is "
-                  << data_size_addr[0];
-    for (size_t i = 0; i < inputs[2]->size / sizeof(T); i++) {
-      weight_addr[i] += new_weight_addr[i];
+    size_t accum_count = 0;
+    {
+      std::unique_lock<std::mutex> lock(weight_mutex_);
+      // Only the first update of the round clears the weight, so no other update is adding into it at this time.
+      if (accum_count_ == 0) {
+        ClearWeightAndDataSize();
+      }
+      MS_LOG(DEBUG) << "Iteration: " << LocalMetaStore::GetInstance().curr_iter_num() << " launching FedAvgKernel for "
+                    << name_ << " new data size is " << new_data_size_addr[0] << ", current total data size is "
+                    << data_size_addr[0];
+      data_size_addr[0] += new_data_size_addr[0];
+      accum_count = ++accum_count_;
+      participated_ = true;
     }
-    data_size_addr[0] += new_data_size_addr[0];
-    lock.unlock();
-
-    accum_count_++;
-    participated_ = true;
+    // The updates start from different chunks so that concurrent ones rarely wait for the same chunk.
+    AccumulateWeight(new_weight_addr, inputs[0]->size / sizeof(T), accum_count, weight_addr);
     return DistributedCountService::GetInstance().Count(
-      name_, std::to_string(DistributedCountService::GetInstance().local_rank()) + "_" + std::to_string(accum_count_));
+      name_, std::to_string(DistributedCountService::GetInstance().local_rank()) + "_" + std::to_string(accum_count));
   }
 
   void Reset() override {
@@ -142,6 +163,8 @@ class FedAvgKernel : public AggregationKernel {
 
   bool IsAggregationDone() override { return done_; }
 
+  bool IsConcurrentLaunchSupported() const override { return true; }
+
   void SetParameterAddress(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
                            const std::vector<AddressPtr> &outputs) {
     weight_addr_ = inputs[0];
@@ -164,6 +187,25 @@ class FedAvgKernel : public AggregationKernel {
     return;
   }
 
+  void AccumulateWeight(const T *new_weight, size_t weight_num, size_t first_chunk, T *weight) {
+    for (size_t i = 0; i < chunk_num_; ++i) {
+      size_t chunk = (first_chunk + i) % chunk_num_;
+      size_t begin = chunk * kFedAvgChunkSize;
+      if (begin >= weight_num) {
+        continue;
+      }
+      size_t end = std::min(begin + kFedAvgChunkSize, weight_num);
+      std::unique_lock<std::mutex> lock(chunk_mutexes_[chunk]);
+      if constexpr (std::is_same<T, float>::value) {
+        (void)ElementAdd(weight + begin, new_weight + begin, weight + begin, SizeToInt(end - begin));
+      } else {
+        for (size_t j = begin; j < end; ++j) {
+          weight[j] += new_weight[j];
+        }
+      }
+    }
+  }
+
   // In some cases, the Launch method is not called and the weights involved in AllReduce should be set to 0.
   void ClearWeightAndDataSize() {
     int ret = memset_s(weight_addr_->addr, weight_addr_->size, 0x00, weight_addr_->size);
@@ -194,8 +236,11 @@ class FedAvgKernel : public AggregationKernel {
   // Whether the kernel's Launch method is called.
   bool participated_;
 
-  // The kernel could be called concurrently so we need lock to ensure threadsafe.
+  // The kernel could be called concurrently so we need lock to ensure threadsafe. The weight_mutex_ guards the data
+  // size and the status of the round, and each chunk of the weight has its own mutex.
   std::mutex weight_mutex_;
+  size_t chunk_num_;
+  std::unique_ptr<std::mutex[]> chunk_mutexes_;
 };
 }  // namespace kernel
 }  // namespace server
@@ -156,7 +156,7 @@ ResultCode UpdateModelKernel::UpdateModel(const schema::RequestUpdateModel *upda
     return ResultCode::kSuccessAndReturn;
   }
 
-  for (auto weight : feature_map) {
+  for (auto &weight : feature_map) {
     weight.second[kNewDataSize].addr = &data_size;
     weight.second[kNewDataSize].size = sizeof(size_t);
     executor_->HandleModelUpdate(weight.first, weight.second);
@@ -91,6 +91,44 @@ bool ParameterAggregator::LaunchAggregators() {
   return true;
 }
 
+bool ParameterAggregator::LaunchAggregators(const std::map<std::string, Address> &upload_data) {
+  for (auto &aggregator_with_params : aggregation_kernel_parameters_) {
+    std::shared_ptr<kernel::AggregationKernel> aggr_kernel = aggregator_with_params.first;
+    RETURN_IF_NULL(aggr_kernel, false);
+    // Only the uploaded inputs are replaced, the others still refer to the memory registered for the kernel.
+    std::vector<AddressPtr> inputs = aggregator_with_params.second.inputs;
+    const std::vector<std::string> &input_names = aggr_kernel->input_names();
+    for (size_t i = 0; i < input_names.size() && i < inputs.size(); i++) {
+      auto iter = upload_data.find(input_names[i]);
+      if (iter == upload_data.end()) {
+        continue;
+      }
+      if (iter->second.addr == nullptr || iter->second.size != inputs[i]->size) {
+        MS_LOG(ERROR) << "The uploaded " << input_names[i] << " of size " << iter->second.size
+                      << " does not match the size " << inputs[i]->size;
+        return false;
+      }
+      inputs[i] = std::make_shared<Address>(iter->second.addr, iter->second.size);
+    }
+
+    KernelParams &params = aggregator_with_params.second;
+    bool ret = aggr_kernel->Launch(inputs, params.workspace, params.outputs);
+    if (!ret) {
+      MS_LOG(ERROR) << "Launching aggregation kernel " << typeid(aggr_kernel.get()).name() << " failed.";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ParameterAggregator::IsConcurrentAggregationSupported() const {
+  return std::all_of(aggregation_kernel_parameters_.begin(), aggregation_kernel_parameters_.end(),
+                     [](const auto &aggregator_with_params) {
+                       return aggregator_with_params.first != nullptr &&
+                              aggregator_with_params.first->IsConcurrentLaunchSupported();
+                     });
+}
+
 bool ParameterAggregator::LaunchOptimizers() {
   for (auto &optimizer_with_params : optimizer_kernel_parameters_) {
     KernelParams &params = optimizer_with_params.second;
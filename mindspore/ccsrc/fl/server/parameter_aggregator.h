@@ -75,6 +75,11 @@ class ParameterAggregator {
   bool LaunchAggregators();
   bool LaunchOptimizers();
 
+  // Launch aggregators with the inputs found in upload_data read in place, instead of copying them by UpdateData first.
+  // Concurrent calls are allowed if IsConcurrentAggregationSupported returns true.
+  bool LaunchAggregators(const std::map<std::string, Address> &upload_data);
+  bool IsConcurrentAggregationSupported() const;
+
   // The implementation for primitive Pull in parameter server training mode.
   // Every call of this method will increase the count for pull by 1.
   AddressPtr Pull();
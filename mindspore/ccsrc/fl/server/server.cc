@@ -80,6 +80,8 @@ void Server::Run() {
     MS_LOG(INFO) << "Parameters for secure aggregation have been initiated.";
   }
   RegisterRoundKernel();
+  // All the counters are registered by the rounds and their kernels now.
+  DistributedCountService::GetInstance().BuildCounterRing();
   MS_LOG(INFO) << "Server started successfully.";
   safemode_ = false;
   lock.unlock();
@@ -366,7 +368,7 @@ void Server::StartCommunicator() {
   communicator_with_server_->Start();
   DistributedMetadataStore::GetInstance().Initialize(server_node_);
   CollectiveOpsImpl::GetInstance().Initialize(server_node_);
-  DistributedCountService::GetInstance().Initialize(server_node_, kLeaderServerRank);
+  DistributedCountService::GetInstance().Initialize(server_node_);
   MS_LOG(INFO) << "This server rank is " << server_node_->rank_id();
 
   MS_LOG(INFO) << "Start communicator with worker.";
@@ -402,6 +404,7 @@ void Server::ProcessAfterScalingOut() {
   if (!iteration_->ReInitForScaling(IntToUint(server_node_->server_num()), server_node_->rank_id())) {
     MS_LOG(WARNING) << "Iteration reinitializing failed.";
   }
+  DistributedCountService::GetInstance().BuildCounterRing();
   if (!Executor::GetInstance().ReInitForScaling()) {
     MS_LOG(WARNING) << "Executor reinitializing failed.";
   }
@@ -436,6 +439,7 @@ void Server::ProcessAfterScalingIn() {
   if (!iteration_->ReInitForScaling(IntToUint(server_node_->server_num()), server_node_->rank_id())) {
     MS_LOG(WARNING) << "Iteration reinitializing failed.";
   }
+  DistributedCountService::GetInstance().BuildCounterRing();
   if (!Executor::GetInstance().ReInitForScaling()) {
     MS_LOG(WARNING) << "Executor reinitializing failed.";
   }
@@ -19,6 +19,7 @@
 #include <deque>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
 
 #include "ir/anf.h"
@@ -31,8 +32,11 @@ namespace mindspore {
 namespace opt {
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name, const PrimitivePtr &prim,
                                  const RenormAction &renorm_action) {
+  MS_EXCEPTION_IF_NULL(prim);
   auto fn = [prim](const AnfNodePtr &node) -> bool { return IsPrimitiveCNode(node, prim); };
-  return std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  auto substitution = std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  substitution->prim_names_ = {prim->name()};
+  return substitution;
 }
 
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name,
@@ -59,7 +63,12 @@ SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std:
     return false;
   };
 
-  return std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  auto substitution = std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  for (auto &prim : prims) {
+    MS_EXCEPTION_IF_NULL(prim);
+    substitution->prim_names_.push_back(prim->name());
+  }
+  return substitution;
 }
 
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name,
@@ -103,8 +112,77 @@ static bool isTraversable(const AnfNodePtr &node) {
   return false;
 }
 
+// The nodes changed by the substitutions of a sweep, the next sweep of a substitution list only visits them.
+struct ChangedNodes {
+  std::vector<AnfNodePtr> nodes;
+  // set when a change brings in a func graph not managed before, whose nodes are only visited by a full sweep
+  bool need_full_sweep{false};
+};
+
+// Collects the nodes of res which are not in the graph yet, they are created by the substitution, and the nodes of
+// the graph they use, which get new users.
+static void CollectNewNodes(const FuncGraphManagerPtr &manager, const AnfNodePtr &res, ChangedNodes *changed) {
+  auto &all_nodes = manager->all_nodes();
+  std::unordered_set<AnfNodePtr> visited;
+  std::vector<AnfNodePtr> todo = {res};
+  while (!todo.empty()) {
+    auto node = todo.back();
+    todo.pop_back();
+    if (node == nullptr || !visited.insert(node).second) {
+      continue;
+    }
+    if (all_nodes.contains(node)) {
+      changed->nodes.push_back(node);
+      continue;
+    }
+    changed->nodes.push_back(node);
+    if (IsValueNode<FuncGraph>(node) && !manager->func_graphs().contains(GetValueNode<FuncGraphPtr>(node))) {
+      changed->need_full_sweep = true;
+    }
+    if (node->isa<CNode>()) {
+      auto &inputs = node->cast<CNodePtr>()->inputs();
+      (void)std::copy(inputs.begin(), inputs.end(), std::back_inserter(todo));
+    }
+  }
+}
+
+// Collects the nodes whose patterns may match differently after the changes. A pattern rooted at a node looks at
+// the inputs of the node recursively and may check their users, so it only changes when a node under the root got
+// different inputs or users. Those are the changed nodes, and the roots are the changed nodes and their users up
+// to the output, through the calls of the func graphs they are in as well.
+static std::vector<AnfNodePtr> CollectAffectedNodes(const FuncGraphManagerPtr &manager,
+                                                    const std::vector<AnfNodePtr> &changed_nodes) {
+  auto &all_nodes = manager->all_nodes();
+  auto &node_users = manager->node_users();
+  std::unordered_set<AnfNodePtr> visited;
+  std::unordered_set<FuncGraphPtr> visited_graphs;
+  std::vector<AnfNodePtr> affected;
+  std::vector<AnfNodePtr> todo(changed_nodes.begin(), changed_nodes.end());
+  while (!todo.empty()) {
+    auto node = todo.back();
+    todo.pop_back();
+    if (node == nullptr || !all_nodes.contains(node) || !visited.insert(node).second) {
+      continue;
+    }
+    affected.push_back(node);
+    auto users_iterator = node_users.find(node);
+    if (users_iterator != node_users.end()) {
+      for (auto &use : users_iterator->second) {
+        todo.push_back(use.first);
+      }
+    }
+    auto fg = node->func_graph();
+    if (fg != nullptr && visited_graphs.insert(fg).second) {
+      for (auto &entry : fg->func_graph_cnodes_index()) {
+        todo.push_back(entry.first->first);
+      }
+    }
+  }
+  return affected;
+}
+
 static AnfNodePtr DoTransform(const OptimizerPtr &optimizer, const AnfNodePtr &node,
-                              const SubstitutionPtr &substitution) {
+                              const SubstitutionPtr &substitution, ChangedNodes *changed = nullptr) {
   auto manager = optimizer->manager();
   bool is_match = substitution->predicate_(node);
   if (is_match) {
@@ -116,7 +194,25 @@ static AnfNodePtr DoTransform(const OptimizerPtr &optimizer, const AnfNodePtr &n
 #endif
       MS_LOG(DEBUG) << "Replace " << node->DebugString() << " with " << res->DebugString() << ", by "
                     << substitution->name_;
+      if (changed != nullptr) {
+        CollectNewNodes(manager, res, changed);
+        // The inputs of node lose a user.
+        if (node->isa<CNode>()) {
+          auto &inputs = node->cast<CNodePtr>()->inputs();
+          changed->nodes.insert(changed->nodes.end(), inputs.begin(), inputs.end());
+        }
+      }
       (void)manager->Replace(node, res);
+      if (changed != nullptr) {
+        // The users of node are users of res now, their inputs changed.
+        auto users_iterator = manager->node_users().find(res);
+        if (users_iterator != manager->node_users().end()) {
+          for (auto &use : users_iterator->second) {
+            changed->nodes.push_back(use.first);
+          }
+        }
+        changed->nodes.push_back(res);
+      }
 #ifdef ENABLE_PROFILE
       MsProfile::StatTime("replace." + substitution->name_, GetTime() - t);
 #endif
@@ -127,13 +223,15 @@ static AnfNodePtr DoTransform(const OptimizerPtr &optimizer, const AnfNodePtr &n
 }
 
 static void UpdateTransformingList(const OptimizerPtr &optimizer, const AnfNodePtr &node, std::deque<AnfNodePtr> *todo,
-                                   bool change, size_t seen) {
-  if (IsValueNode<FuncGraph>(node)) {
-    (*todo).emplace_back(GetValueNode<FuncGraphPtr>(node)->output());
-  }
-  if (node->isa<CNode>()) {
-    auto &inputs = node->cast<CNodePtr>()->inputs();
-    (void)std::copy(inputs.begin(), inputs.end(), std::back_inserter(*todo));
+                                   bool change, size_t seen, bool traverse_inputs = true) {
+  if (traverse_inputs) {
+    if (IsValueNode<FuncGraph>(node)) {
+      (*todo).emplace_back(GetValueNode<FuncGraphPtr>(node)->output());
+    }
+    if (node->isa<CNode>()) {
+      auto &inputs = node->cast<CNodePtr>()->inputs();
+      (void)std::copy(inputs.begin(), inputs.end(), std::back_inserter(*todo));
+    }
   }
 
   if (!change) {
@@ -158,7 +256,40 @@ static void UpdateTransformingList(const OptimizerPtr &optimizer, const AnfNodeP
   }
 }
 
-bool SubstitutionList::ApplyIRToSubstitutions(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph) const {
+SubstitutionList::SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once, bool global_sensitive)
+    : list_(patterns), is_once_(is_once), global_sensitive_(global_sensitive) {
+  for (size_t i = 0; i < list_.size(); i++) {
+    MS_EXCEPTION_IF_NULL(list_[i]);
+    if (list_[i]->prim_names_.empty()) {
+      any_candidates_.push_back(i);
+    }
+    for (auto &name : list_[i]->prim_names_) {
+      prim_candidates_[name].push_back(i);
+    }
+  }
+  // A cnode of the primitive may also be matched by the substitutions for any node.
+  for (auto &iter : prim_candidates_) {
+    auto &candidates = iter.second;
+    candidates.insert(candidates.end(), any_candidates_.begin(), any_candidates_.end());
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+  }
+}
+
+const std::vector<size_t> &SubstitutionList::GetCandidates(const AnfNodePtr &node) const {
+  if (prim_candidates_.empty() || !node->isa<CNode>()) {
+    return any_candidates_;
+  }
+  auto prim = GetCNodePrimitive(node);
+  if (prim == nullptr) {
+    return any_candidates_;
+  }
+  auto iter = prim_candidates_.find(prim->name());
+  return iter == prim_candidates_.end() ? any_candidates_ : iter->second;
+}
+
+bool SubstitutionList::ApplyIRToSubstitutions(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph,
+                                              std::vector<SubstitutionStat> *stats) const {
 #ifdef ENABLE_PROFILE
   double start = GetTime();
 #endif
@@ -179,9 +310,11 @@ bool SubstitutionList::ApplyIRToSubstitutions(const OptimizerPtr &optimizer, con
     node->seen_ = seen;
 
     bool change = false;
-    for (auto &substitution : list_) {
-      auto res = DoTransform(optimizer, node, substitution);
+    for (auto i : GetCandidates(node)) {
+      (*stats)[i].visits++;
+      auto res = DoTransform(optimizer, node, list_[i]);
       if (res != nullptr) {
+        (*stats)[i].hits++;
         change = true;
         changes = true;
         node = res;
@@ -197,35 +330,43 @@ bool SubstitutionList::ApplyIRToSubstitutions(const OptimizerPtr &optimizer, con
   return changes;
 }
 
-bool SubstitutionList::ApplySubstitutionToIR(const OptimizerPtr &optimizer, const AnfNodePtr &root_node,
-                                             const SubstitutionPtr &substitution) const {
+// Applies the substitution to the nodes in todo. With traverse_inputs the inputs of the visited nodes are visited
+// too, so a sweep from the output visits the whole graph, otherwise only the nodes in todo and the nodes changed by
+// the substitution are visited. The changed nodes are recorded if changed is not null.
+static bool ApplySubstitutionToNodes(const OptimizerPtr &optimizer, std::deque<AnfNodePtr> *todo,
+                                     const SubstitutionPtr &substitution, bool traverse_inputs, size_t *visits,
+                                     size_t *hits, ChangedNodes *changed) {
 #ifdef ENABLE_PROFILE
   double start = GetTime();
 #endif
   FuncGraphManagerPtr manager = optimizer->manager();
   auto seen = NewSeenGeneration();
-  std::deque<AnfNodePtr> todo;
-  todo.emplace_back(root_node);
   bool changes = false;
 
   auto &all_nodes = manager->all_nodes();
-  while (!todo.empty()) {
-    AnfNodePtr node = todo.front();
-    todo.pop_front();
+  while (!todo->empty()) {
+    AnfNodePtr node = todo->front();
+    todo->pop_front();
 
     if (node == nullptr || node->seen_ == seen || !isTraversable(node) || !all_nodes.contains(node)) {
       continue;
     }
     node->seen_ = seen;
+    (*visits)++;
 
     bool change = false;
-    auto res = DoTransform(optimizer, node, substitution);
+    size_t changed_begin = changed == nullptr ? 0 : changed->nodes.size();
+    auto res = DoTransform(optimizer, node, substitution, changed);
     if (res != nullptr) {
+      (*hits)++;
       change = true;
       changes = true;
       node = res;
+      if (!traverse_inputs && changed != nullptr) {
+        (void)std::copy(changed->nodes.begin() + changed_begin, changed->nodes.end(), std::back_inserter(*todo));
+      }
     }
-    UpdateTransformingList(optimizer, node, &todo, change, seen);
+    UpdateTransformingList(optimizer, node, todo, change, seen, traverse_inputs);
   }
 
 #ifdef ENABLE_PROFILE
@@ -252,7 +393,25 @@ void SubstitutionList::DisplayStatusOfSubstitution(const std::unordered_map<std:
   MS_LOG(DEBUG) << ss.str();
 }
 
-bool SubstitutionList::ApplySubstitutionsToIR(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph) const {
+void SubstitutionList::DisplayStatOfSubstitution(const std::vector<SubstitutionStat> &stats,
+                                                 const OptimizerPtr &optimizer, double time) const {
+  std::stringstream ss;
+  ss << "Pass: " << optimizer->name() << "(" << optimizer->CurPass_.counter << ")_" << optimizer->CurPass_.name
+     << " costs " << time << "s";
+  for (size_t i = 0; i < list_.size(); i++) {
+    if (stats[i].visits == 0) {
+      continue;
+    }
+    ss << std::endl << "  " << list_[i]->name_ << ": visits " << stats[i].visits << ", hits " << stats[i].hits;
+    if (stats[i].time > 0) {
+      ss << ", time " << stats[i].time << "s";
+    }
+  }
+  MS_LOG(DEBUG) << ss.str();
+}
+
+bool SubstitutionList::ApplySubstitutionsToIR(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph,
+                                              std::vector<SubstitutionStat> *stats) const {
   // Add for substitution status counting
   size_t space = 0;
   std::unordered_map<std::string, std::vector<bool>> status;
@@ -262,15 +421,40 @@ bool SubstitutionList::ApplySubstitutionsToIR(const OptimizerPtr &optimizer, con
     }
   }
 
+  // The first round sweeps the whole graph. A substitution only matches a node again after a node under it changed,
+  // so the next rounds only visit the nodes affected by the changes of the round before, unless the substitutions
+  // depend on the whole graph.
+  bool full_sweep = true;
+  std::vector<AnfNodePtr> round_nodes;
   bool changes = false;
   bool loop = true;
   while (loop) {
     loop = false;
+    ChangedNodes next_round;
     for (size_t i = 0; i < list_.size(); i++) {
       const auto &substitution = list_[i];
-      bool change = ApplySubstitutionToIR(optimizer, func_graph->output(), substitution);
+      double start = GetTime();
+      std::deque<AnfNodePtr> todo;
+      if (full_sweep || global_sensitive_) {
+        todo.emplace_back(func_graph->output());
+      } else {
+        todo.assign(round_nodes.begin(), round_nodes.end());
+      }
+      ChangedNodes changed;
+      bool change = ApplySubstitutionToNodes(optimizer, &todo, substitution, full_sweep || global_sensitive_,
+                                             &(*stats)[i].visits, &(*stats)[i].hits,
+                                             global_sensitive_ || is_once_ ? nullptr : &changed);
+      (*stats)[i].time += GetTime() - start;
       changes = changes || change;
       loop = loop || change;
+      if (change && !global_sensitive_ && !is_once_) {
+        // The substitutions after this one visit the affected nodes in this round, those before in the next.
+        auto affected = CollectAffectedNodes(optimizer->manager(), changed.nodes);
+        round_nodes.insert(round_nodes.end(), affected.begin(), affected.end());
+        next_round.nodes.insert(next_round.nodes.end(), affected.begin(), affected.end());
+        full_sweep = full_sweep || changed.need_full_sweep;
+        next_round.need_full_sweep = next_round.need_full_sweep || changed.need_full_sweep;
+      }
 
       static const auto enable_dump_pass_ir = (common::GetEnv("ENV_DUMP_PASS_IR") == "1");
       if (enable_dump_pass_ir && MsContext::GetInstance()->get_param<bool>(MS_CTX_SAVE_GRAPHS_FLAG)) {
@@ -292,6 +476,8 @@ bool SubstitutionList::ApplySubstitutionsToIR(const OptimizerPtr &optimizer, con
     if (is_once_) {
       break;
     }
+    full_sweep = next_round.need_full_sweep;
+    round_nodes = std::move(next_round.nodes);
   }
 
   // Display the status of each substitution
@@ -307,6 +493,8 @@ bool SubstitutionList::operator()(const FuncGraphPtr &func_graph, const Optimize
   FuncGraphManagerPtr manager = optimizer->manager();
   manager->AddFuncGraph(func_graph);
   bool changes = false;
+  double start = GetTime();
+  std::vector<SubstitutionStat> stats(list_.size());
   static const auto traverse_mode =
     (common::GetEnv("ENV_TRAVERSE_SUBSTITUTIONS_MODE") != "1" ? kOptTraverseFromIRToSubstitutions
                                                               : kOptTraverseFromSubstitutionsToIR);
@@ -315,11 +503,14 @@ bool SubstitutionList::operator()(const FuncGraphPtr &func_graph, const Optimize
       optimizer->traverse_nodes_first() && !is_once_ && !global_sensitive_) {
     MS_LOG(DEBUG) << "IR >> SUB, " << optimizer->name() << "(r" << optimizer->CurPass_.counter << ")_"
                   << optimizer->CurPass_.name;
-    changes = ApplyIRToSubstitutions(optimizer, func_graph);
+    changes = ApplyIRToSubstitutions(optimizer, func_graph, &stats);
   } else {
     MS_LOG(DEBUG) << "SUB >> IR, " << optimizer->name() << "(r" << optimizer->CurPass_.counter << ")_"
                   << optimizer->CurPass_.name;
-    changes = ApplySubstitutionsToIR(optimizer, func_graph);
+    changes = ApplySubstitutionsToIR(optimizer, func_graph, &stats);
+  }
+  if (optimizer->is_on_debug_) {
+    DisplayStatOfSubstitution(stats, optimizer, GetTime() - start);
   }
   return changes;
 }
@@ -43,6 +43,8 @@ class Substitution {
   PredicateFuncType predicate_{nullptr};
   // an enum to mark this Substitution relation to renormalize pass
   RenormAction renorm_action_;
+  // the names of the primitives of the cnodes the predicate may match, empty if it may match any node
+  std::vector<std::string> prim_names_;
   Substitution(const OptimizerCallerPtr &transform, const std::string &name, const PredicateFuncType &predicate,
                const RenormAction &renorm_action)
       : transform_(transform), name_(name), predicate_(predicate), renorm_action_(renorm_action) {}
@@ -65,23 +67,38 @@ enum OptTraverseSubstitutionsMode { kOptTraverseFromIRToSubstitutions = 0, kOptT
 class SubstitutionList {
  public:
   explicit SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once = false,
-                            bool global_sensitive = false)
-      : list_(patterns), is_once_(is_once), global_sensitive_(global_sensitive) {}
+                            bool global_sensitive = false);
   ~SubstitutionList() = default;
 
   bool operator()(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer) const;
 
+  // The substitutions which may match the node, in the order of the list.
+  const std::vector<size_t> &GetCandidates(const AnfNodePtr &node) const;
+
  private:
-  bool ApplyIRToSubstitutions(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph) const;
-  bool ApplySubstitutionToIR(const OptimizerPtr &optimizer, const AnfNodePtr &node, const SubstitutionPtr &sub) const;
-  bool ApplySubstitutionsToIR(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph) const;
+  // The number of nodes a substitution was tried on, of the replacements it made and the time it took in a pass.
+  struct SubstitutionStat {
+    size_t visits{0};
+    size_t hits{0};
+    double time{0.0};
+  };
+
+  bool ApplyIRToSubstitutions(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph,
+                              std::vector<SubstitutionStat> *stats) const;
+  bool ApplySubstitutionsToIR(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph,
+                              std::vector<SubstitutionStat> *stats) const;
   void DisplayStatusOfSubstitution(const std::unordered_map<std::string, std::vector<bool>> &status,
                                    const OptimizerPtr &optimizer, size_t space) const;
+  void DisplayStatOfSubstitution(const std::vector<SubstitutionStat> &stats, const OptimizerPtr &optimizer,
+                                 double time) const;
 
   std::vector<SubstitutionPtr> list_;
   // a flag to mark this list of Substitution can only be executed only once
   bool is_once_;
   bool global_sensitive_;
+  // the substitutions which may match a cnode of the primitive, and those which may match any node
+  std::unordered_map<std::string, std::vector<size_t>> prim_candidates_;
+  std::vector<size_t> any_candidates_;
 };
 }  // namespace opt
 }  // namespace mindspore
@@ -23,14 +23,20 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <algorithm>
+#include <cstdint>
+#include <numeric>
 #include "ir/func_graph.h"
+#include "abstract/abstract_value.h"
+#include "abstract/utils.h"
 #include "mindspore/core/base/core_ops.h"
 #include "utils/utils.h"
+#include "utils/ms_context.h"
 
 namespace mindspore {
 namespace opt {
 namespace {
 constexpr auto kGradientsFlag = "Gradients";
+constexpr double kGBToByte = 1024.0 * 1024.0 * 1024.0;
 
 bool CanNotRecomputed(const CNodePtr &node) {
   static std::unordered_set<PrimitivePtr> not_recomputed_op_list{prim::kPrimAllGather, prim::kPrimDropoutGenMask,
@@ -323,6 +329,286 @@ void SetRecomputedAttr(const FuncGraphPtr &graph, const std::vector<CNodePtr> &o
   }
 }
 
+bool IsComputeIntensive(const CNodePtr &node) {
+  static std::unordered_set<PrimitivePtr> compute_intensive_op_list{
+    prim::kPrimMatMul, prim::kPrimBatchMatMul, prim::kPrimConv2D, prim::kPrimConv2DTranspose,
+    prim::kPrimDepthwiseConv2dNative};
+
+  return std::any_of(compute_intensive_op_list.begin(), compute_intensive_op_list.end(),
+                     [&node](const PrimitivePtr &prim) { return IsPrimitiveCNode(node, prim); });
+}
+
+// The nodes whose outputs share the memory of their inputs.
+bool IsAliasNode(const AnfNodePtr &node, int input_index) {
+  return IsPrimitiveCNode(node, prim::kPrimTupleGetItem) || IsPrimitiveCNode(node, prim::kPrimMakeTuple) ||
+         (IsPrimitiveCNode(node, prim::kPrimDepend) && input_index == kRealInputIndexInDepend);
+}
+
+bool IsVirtualNode(const CNodePtr &node) {
+  return IsPrimitiveCNode(node, prim::kPrimTupleGetItem) || IsPrimitiveCNode(node, prim::kPrimMakeTuple) ||
+         IsPrimitiveCNode(node, prim::kPrimDepend) || IsPrimitiveCNode(node, prim::kPrimLoad) ||
+         IsPrimitiveCNode(node, prim::kPrimUpdateState) || IsPrimitiveCNode(node, prim::kPrimReturn);
+}
+
+// The size in bytes of the output, 0 if it is unknown.
+double OutputSize(const AbstractBasePtr &abstract) {
+  if (abstract == nullptr) {
+    return 0;
+  }
+  if (abstract->isa<abstract::AbstractSequeue>()) {
+    double size = 0;
+    for (const auto &element : abstract->cast<abstract::AbstractSequeuePtr>()->elements()) {
+      size += OutputSize(element);
+    }
+    return size;
+  }
+  if (!abstract->isa<abstract::AbstractTensor>()) {
+    return 0;
+  }
+  auto tensor_abstract = abstract->cast<abstract::AbstractTensorPtr>();
+  MS_EXCEPTION_IF_NULL(tensor_abstract->element());
+  auto type = tensor_abstract->element()->BuildType();
+  auto shape = tensor_abstract->shape();
+  if (type == nullptr || shape == nullptr) {
+    return 0;
+  }
+  double size = static_cast<double>(abstract::TypeIdSize(type->type_id()));
+  for (auto dim : shape->shape()) {
+    if (dim < 0) {
+      return 0;
+    }
+    size *= static_cast<double>(dim);
+  }
+  return size;
+}
+
+// The estimated memory of a node output along the topological order.
+struct ActivationLifetime {
+  double size = 0;
+  size_t begin = 0;
+  // The last position the output or its alias is used.
+  size_t end = 0;
+  // The last forward use and the first backward use. The output needs not to be kept between them if it is
+  // recomputed for the backward pass.
+  size_t last_forward_use = 0;
+  size_t first_bprop_use = SIZE_MAX;
+};
+
+std::vector<ActivationLifetime> EstimateLifetimes(const FuncGraphManagerPtr &mng,
+                                                  const std::vector<CNodePtr> &origin_nodes_topological,
+                                                  const std::unordered_map<CNodePtr, size_t> &positions) {
+  MS_EXCEPTION_IF_NULL(mng);
+  const auto &node_users = mng->node_users();
+  std::vector<ActivationLifetime> lifetimes(origin_nodes_topological.size());
+  // Visit the users before the node, so the lifetime of an alias extends the one of its input.
+  for (size_t i = origin_nodes_topological.size(); i > 0; --i) {
+    size_t pos = i - 1;
+    const auto &node = origin_nodes_topological[pos];
+    auto &lifetime = lifetimes[pos];
+    lifetime.size = IsVirtualNode(node) ? 0 : OutputSize(node->abstract());
+    lifetime.begin = lifetime.end = lifetime.last_forward_use = pos;
+    auto output_set_iter = node_users.find(node);
+    if (output_set_iter == node_users.end()) {
+      continue;
+    }
+    for (const auto &node_index_set : output_set_iter->second) {
+      auto user = node_index_set.first->cast<CNodePtr>();
+      auto user_iter = positions.find(user);
+      if (user_iter == positions.end()) {
+        continue;
+      }
+      auto user_pos = user_iter->second;
+      auto user_end = IsAliasNode(user, node_index_set.second) ? lifetimes[user_pos].end : user_pos;
+      lifetime.end = std::max(lifetime.end, user_end);
+      if (IsBpropNode(user)) {
+        lifetime.first_bprop_use = std::min(lifetime.first_bprop_use, user_pos);
+      } else {
+        lifetime.last_forward_use = std::max(lifetime.last_forward_use, user_end);
+      }
+    }
+  }
+  return lifetimes;
+}
+
+// The live memory along the topological order, with the memory added to a range of positions and the peak memory
+// in O(log n). Every tree node keeps the max of its children plus the memory added to its whole range.
+class LiveMemoryTree {
+ public:
+  explicit LiveMemoryTree(const std::vector<double> &live_memory) : size_(live_memory.size()) {
+    if (size_ == 0) {
+      MS_LOG(EXCEPTION) << "The live memory is empty.";
+    }
+    max_.assign(size_ * 4, 0);
+    added_.assign(size_ * 4, 0);
+    Build(1, 0, size_, live_memory);
+  }
+  ~LiveMemoryTree() = default;
+
+  // Add value to the positions in [begin, end).
+  void Add(size_t begin, size_t end, double value) {
+    end = std::min(end, size_);
+    if (begin < end) {
+      Add(1, 0, size_, begin, end, value);
+    }
+  }
+
+  double Peak() const { return max_[1]; }
+
+ private:
+  void Build(size_t node, size_t lo, size_t hi, const std::vector<double> &live_memory) {
+    if (hi - lo == 1) {
+      max_[node] = live_memory[lo];
+      return;
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    Build(node * 2, lo, mid, live_memory);
+    Build(node * 2 + 1, mid, hi, live_memory);
+    max_[node] = std::max(max_[node * 2], max_[node * 2 + 1]);
+  }
+
+  void Add(size_t node, size_t lo, size_t hi, size_t begin, size_t end, double value) {
+    if (begin <= lo && hi <= end) {
+      max_[node] += value;
+      added_[node] += value;
+      return;
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    if (begin < mid) {
+      Add(node * 2, lo, mid, begin, end, value);
+    }
+    if (end > mid) {
+      Add(node * 2 + 1, mid, hi, begin, end, value);
+    }
+    max_[node] = std::max(max_[node * 2], max_[node * 2 + 1]) + added_[node];
+  }
+
+  size_t size_;
+  std::vector<double> max_;
+  std::vector<double> added_;
+};
+
+void ReleaseLifetime(const ActivationLifetime &lifetime, LiveMemoryTree *live_memory) {
+  MS_EXCEPTION_IF_NULL(live_memory);
+  live_memory->Add(lifetime.last_forward_use + 1, lifetime.first_bprop_use, -lifetime.size);
+}
+
+// Select the nodes to recompute automatically until the estimated peak memory fits the budget set by the context
+// 'recompute_memory_budget'. The outputs of the forward nodes kept for the backward pass dominate the peak memory.
+// A node is recomputed if its inputs are kept or recomputed anyway, so recomputing it does not extend the lifetime
+// of others. The nodes freeing the most memory for the least recomputation, i.e. the memory-bound operators with
+// large outputs, are selected first, and the outputs of the compute-intensive operators are always kept.
+void SetAutoRecomputedAttr(const FuncGraphPtr &graph, const std::vector<CNodePtr> &origin_nodes_topological) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  double budget = static_cast<double>(context->get_param<float>(MS_CTX_RECOMPUTE_MEMORY_BUDGET)) * kGBToByte;
+  if (budget <= 0) {
+    return;
+  }
+  auto mng = graph->manager();
+  MS_EXCEPTION_IF_NULL(mng);
+  std::unordered_map<CNodePtr, size_t> positions;
+  for (size_t pos = 0; pos < origin_nodes_topological.size(); ++pos) {
+    positions[origin_nodes_topological[pos]] = pos;
+  }
+  auto lifetimes = EstimateLifetimes(mng, origin_nodes_topological, positions);
+  std::vector<double> live_memory(origin_nodes_topological.size() + 1, 0);
+  for (const auto &lifetime : lifetimes) {
+    live_memory[lifetime.begin] += lifetime.size;
+    live_memory[lifetime.end + 1] -= lifetime.size;
+  }
+  std::partial_sum(live_memory.begin(), live_memory.end(), live_memory.begin());
+  LiveMemoryTree live_memory_tree(live_memory);
+
+  std::vector<bool> recomputed(origin_nodes_topological.size(), false);
+  std::vector<size_t> candidates;
+  std::unordered_map<AnfNodePtr, bool> has_grad_inputs_map;
+  for (size_t pos = 0; pos < origin_nodes_topological.size(); ++pos) {
+    const auto &node = origin_nodes_topological[pos];
+    const auto &lifetime = lifetimes[pos];
+    if (IsBpropNode(node) || lifetime.first_bprop_use == SIZE_MAX) {
+      continue;
+    }
+    if (IsSetRecomputeCNodeAttr(node)) {
+      recomputed[pos] = true;
+      ReleaseLifetime(lifetime, &live_memory_tree);
+      continue;
+    }
+    // Nothing is released if the output is still used in the forward pass when the backward pass uses it.
+    if (lifetime.size <= 0 || lifetime.last_forward_use + 1 >= lifetime.first_bprop_use) {
+      continue;
+    }
+    if (IsVirtualNode(node) || IsSetNoRecomputeCNodeAttr(node) || CanNotRecomputed(node) || IsComputeIntensive(node) ||
+        GetCNodePrimitive(node) == nullptr || !node->abstract()->isa<abstract::AbstractTensor>()) {
+      continue;
+    }
+    if (!HasForwardOutput(mng, node) || HasGradInputs(node, &has_grad_inputs_map)) {
+      continue;
+    }
+    candidates.push_back(pos);
+  }
+  double origin_peak = live_memory_tree.Peak();
+  double peak = origin_peak;
+  if (peak <= budget) {
+    MS_LOG(INFO) << "The estimated peak memory " << peak << " bytes fits the recompute memory budget " << budget
+                 << " bytes, no node is recomputed automatically.";
+    return;
+  }
+
+  // A memory-bound kernel costs about the bytes it reads and writes.
+  auto recompute_cost = [&](size_t pos) {
+    double cost = lifetimes[pos].size;
+    for (const auto &input : origin_nodes_topological[pos]->inputs()) {
+      cost += OutputSize(input->abstract());
+    }
+    return cost;
+  };
+  std::vector<double> scores(origin_nodes_topological.size(), 0);
+  for (auto pos : candidates) {
+    scores[pos] = lifetimes[pos].size / recompute_cost(pos);
+  }
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [&scores](size_t a, size_t b) { return scores[a] > scores[b]; });
+  auto inputs_available = [&](size_t pos) {
+    const auto &inputs = origin_nodes_topological[pos]->inputs();
+    return std::all_of(inputs.begin(), inputs.end(), [&](const AnfNodePtr &input) {
+      auto iter = positions.find(input->cast<CNodePtr>());
+      return iter == positions.end() || recomputed[iter->second] ||
+             lifetimes[iter->second].end >= lifetimes[pos].first_bprop_use;
+    });
+  };
+  // Recomputing a node may make its users available, so sweep the candidates until nothing changes.
+  size_t recomputed_num = 0;
+  bool changed = true;
+  while (changed && peak > budget) {
+    changed = false;
+    for (auto pos : candidates) {
+      if (recomputed[pos] || !inputs_available(pos)) {
+        continue;
+      }
+      recomputed[pos] = true;
+      ReleaseLifetime(lifetimes[pos], &live_memory_tree);
+      auto cnode = origin_nodes_topological[pos];
+      cnode->AddAttr(kAttrRecompute, MakeValue(true));
+      MS_LOG(DEBUG) << "Recompute " << cnode->DebugString() << " automatically, releasing " << lifetimes[pos].size
+                    << " bytes.";
+      ++recomputed_num;
+      changed = true;
+      peak = live_memory_tree.Peak();
+      if (peak <= budget) {
+        break;
+      }
+    }
+  }
+  if (peak > budget) {
+    MS_LOG(WARNING) << "The estimated peak memory " << peak << " bytes still exceeds the recompute memory budget "
+                    << budget << " bytes after recomputing " << recomputed_num << " nodes automatically.";
+    return;
+  }
+  MS_LOG(INFO) << "Recompute " << recomputed_num << " nodes automatically, the estimated peak memory is reduced from "
+               << origin_peak << " to " << peak << " bytes within the recompute memory budget " << budget << " bytes.";
+}
+
 CNodePtr CreateNewRecomputedNode(const FuncGraphPtr &graph, const CNodePtr &origin_node,
                                  const std::vector<AnfNodePtr> &new_inputs) {
   auto recomputed_node = graph->NewCNode(new_inputs);
@@ -431,6 +717,7 @@ void InsertRecomputedNodes(const FuncGraphPtr &graph) {
   std::list<CNodePtr> orders = graph->GetOrderedCnodes();
   std::vector<CNodePtr> origin_nodes_topological(orders.begin(), orders.end());
   SetRecomputedAttr(graph, origin_nodes_topological);
+  SetAutoRecomputedAttr(graph, origin_nodes_topological);
   // Get candidate origin recomputed nodes which have no grad inputs and output to at least one grad node directly.
   std::vector<CNodePtr> candidate_recomputed_nodes = FindCandidateRecomputedNodes(mng, origin_nodes_topological);
   std::unordered_set<CNodePtr> visited_nodes;
@@ -0,0 +1,108 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frontend/parallel/allreduce_fusion/allreduce_bucket.h"
+#include <numeric>
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace parallel {
+std::vector<std::vector<size_t>> AllreduceBucketPlanner::Plan(const std::vector<GradientReadiness> &grads,
+                                                              double bucket_size) const {
+  std::vector<size_t> order(grads.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&grads](size_t a, size_t b) { return grads[a].ready_time < grads[b].ready_time; });
+  std::vector<std::vector<size_t>> buckets;
+  std::vector<size_t> bucket;
+  double filled = 0;
+  for (auto index : order) {
+    bucket.push_back(index);
+    filled += grads[index].size;
+    if (filled >= bucket_size) {
+      buckets.push_back(std::move(bucket));
+      bucket.clear();
+      filled = 0;
+    }
+  }
+  if (!bucket.empty()) {
+    buckets.push_back(std::move(bucket));
+  }
+  return buckets;
+}
+
+BucketSimulation AllreduceBucketPlanner::Simulate(const std::vector<GradientReadiness> &grads,
+                                                  const std::vector<std::vector<size_t>> &buckets) const {
+  BucketSimulation simulation;
+  for (const auto &grad : grads) {
+    simulation.backward_time = std::max(simulation.backward_time, grad.ready_time);
+  }
+  double comm_end = 0;
+  for (const auto &bucket : buckets) {
+    double ready_time = 0;
+    double size = 0;
+    for (auto index : bucket) {
+      if (index >= grads.size()) {
+        MS_LOG(EXCEPTION) << "The gradient index " << index << " is out of the range of " << grads.size() << ".";
+      }
+      ready_time = std::max(ready_time, grads[index].ready_time);
+      size += grads[index].size;
+    }
+    double time = allreduce_time_(size);
+    comm_end = std::max(comm_end, ready_time) + time;
+    simulation.communication_time += time;
+  }
+  simulation.finish_time = std::max(comm_end, simulation.backward_time);
+  return simulation;
+}
+
+std::vector<std::vector<size_t>> AllreduceBucketPlanner::PlanBest(const std::vector<GradientReadiness> &grads,
+                                                                  double min_bucket_size,
+                                                                  BucketSimulation *simulation) const {
+  MS_EXCEPTION_IF_NULL(simulation);
+  if (min_bucket_size <= 0) {
+    MS_LOG(EXCEPTION) << "The min bucket size must be positive, but got " << min_bucket_size << ".";
+  }
+  double total_size = 0;
+  for (const auto &grad : grads) {
+    total_size += grad.size;
+  }
+  std::vector<std::vector<size_t>> best_buckets;
+  BucketSimulation best_simulation;
+  bool last_size = false;
+  for (double bucket_size = min_bucket_size; !last_size; bucket_size *= 2) {
+    // All the gradients in one bucket is the last one to try.
+    if (bucket_size >= total_size) {
+      bucket_size = total_size;
+      last_size = true;
+    }
+    auto buckets = Plan(grads, bucket_size);
+    auto current = Simulate(grads, buckets);
+    MS_LOG(INFO) << "AllReduce bucket size " << bucket_size << ": " << buckets.size()
+                 << " buckets, backward time: " << current.backward_time
+                 << ", communication time: " << current.communication_time
+                 << ", overlap time: " << current.overlap_time() << ", exposed time: " << current.exposed_time();
+    if (best_buckets.empty() || current.finish_time < best_simulation.finish_time ||
+        (current.finish_time == best_simulation.finish_time && buckets.size() < best_buckets.size())) {
+      best_buckets = std::move(buckets);
+      best_simulation = current;
+    }
+  }
+  *simulation = best_simulation;
+  return best_buckets;
+}
+}  // namespace parallel
+}  // namespace mindspore
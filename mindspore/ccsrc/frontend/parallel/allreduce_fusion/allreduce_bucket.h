@@ -0,0 +1,75 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_FRONTEND_PARALLEL_ALLREDUCE_FUSION_ALLREDUCE_BUCKET_H_
+#define MINDSPORE_CCSRC_FRONTEND_PARALLEL_ALLREDUCE_FUSION_ALLREDUCE_BUCKET_H_
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace mindspore {
+namespace parallel {
+// A gradient to reduce: the time it becomes ready, counted from the start of the backward pass, and its size in bytes.
+struct GradientReadiness {
+  double ready_time;
+  double size;
+};
+
+// The expected timeline of the AllReduce of the buckets.
+struct BucketSimulation {
+  // When the last gradient is ready.
+  double backward_time = 0;
+  // The sum of the time of the AllReduce of all the buckets.
+  double communication_time = 0;
+  // When the last AllReduce ends.
+  double finish_time = 0;
+
+  // The communication left after the backward pass.
+  double exposed_time() const { return std::max(finish_time - backward_time, 0.0); }
+  // The communication hidden behind the backward pass.
+  double overlap_time() const { return communication_time - exposed_time(); }
+};
+
+// Plans the buckets of gradients fused into one AllReduce each. A bucket is filled along the order the gradients become
+// ready, and its AllReduce starts as soon as its last gradient is ready and the AllReduce before it ends. Small buckets
+// start early but pay the latency of AllReduce many times, the planner simulates the bucket sizes and keeps the one
+// finishing earliest.
+class AllreduceBucketPlanner {
+ public:
+  // allreduce_time gives the time of AllReduce against the size of the bucket in bytes.
+  explicit AllreduceBucketPlanner(std::function<double(double)> allreduce_time)
+      : allreduce_time_(std::move(allreduce_time)) {}
+  ~AllreduceBucketPlanner() = default;
+
+  // Splits the gradients into buckets of at least bucket_size bytes, except the last one. Returns the indices of the
+  // gradients in each bucket, the buckets in the order they are reduced.
+  std::vector<std::vector<size_t>> Plan(const std::vector<GradientReadiness> &grads, double bucket_size) const;
+  BucketSimulation Simulate(const std::vector<GradientReadiness> &grads,
+                            const std::vector<std::vector<size_t>> &buckets) const;
+  // Tries the bucket sizes doubling from min_bucket_size up to all the gradients in one bucket, and returns the buckets
+  // finishing earliest, and fewer buckets among them.
+  std::vector<std::vector<size_t>> PlanBest(const std::vector<GradientReadiness> &grads, double min_bucket_size,
+                                            BucketSimulation *simulation) const;
+
+ private:
+  std::function<double(double)> allreduce_time_;
+};
+}  // namespace parallel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_FRONTEND_PARALLEL_ALLREDUCE_FUSION_ALLREDUCE_BUCKET_H_
@@ -15,19 +15,43 @@
  */
 
 #include "frontend/parallel/allreduce_fusion/allreduce_fusion.h"
+#include <algorithm>
+#include <functional>
 #include <memory>
+#include <numeric>
 #include <queue>
 #include <string>
+#include <tuple>
 #include <unordered_set>
 #include "ir/func_graph.h"
+#include "frontend/parallel/allreduce_fusion/allreduce_bucket.h"
+#include "frontend/parallel/auto_parallel/cost_profile.h"
 #include "frontend/parallel/costmodel_context.h"
 #include "frontend/parallel/graph_util/node_info.h"
 #include "frontend/parallel/status.h"
 #include "frontend/parallel/step_parallel.h"
+#include "frontend/parallel/tensor_layout/tensor_layout.h"
 #include "utils/log_adapter.h"
 
 namespace mindspore {
 namespace parallel {
+namespace {
+// The smallest bucket tried by the bucket algorithm, in bytes.
+constexpr double kMinAllreduceBucketSize = 1024.0 * 1024.0;
+// The backward pass computes about twice as much as the forward pass: the gradients of both the inputs and the weights.
+constexpr double kBackwardComputationRatio = 2.0;
+
+// The size in bytes of the slice of the parameter on each device.
+double ParameterSliceSize(const AnfNodePtr &para) {
+  MS_EXCEPTION_IF_NULL(para);
+  auto layout = para->user_data<TensorLayout>();
+  MS_EXCEPTION_IF_NULL(layout);
+  auto shape = layout->slice_shape().array();
+  double elements = std::accumulate(shape.begin(), shape.end(), 1.0, std::multiplies<double>());
+  return elements * static_cast<double>(GetInputsTypeLen(para));
+}
+}  // namespace
+
 std::unordered_set<CNodePtr> FindCNodesWithPara(const AnfNodePtr &para, uint64_t recursive_times = 0) {
   if (recursive_times > MAX_RECURSIVE_CALL_TIMES) {
     MS_LOG(EXCEPTION) << "FindCNodesWithPara exceeds max recursive call times! Max recursive call times is "
@@ -380,10 +404,99 @@ Status AllreduceFusion::SetFusionByBackwardCompAndAllreduceTime() {
   return SUCCESS;
 }
 
+Status AllreduceFusion::GetSetFusionByBucketParams() {
+  // With a cost model profile, the times are estimated by the measured costs instead.
+  if (CostModelContext::GetInstance()->costmodel_profile() != nullptr) {
+    return SUCCESS;
+  }
+  allreduce_inherent_time_ = CostModelContext::GetInstance()->costmodel_allreduce_fusion_allreduce_inherent_time();
+  if (allreduce_inherent_time_ <= 0) {
+    MS_LOG(INFO) << "'costmodel_allreduce_fusion_allreduce_inherent_time' is " << allreduce_inherent_time_
+                 << ". Bypass ProcessAllreduceFusion";
+    return FAILED;
+  }
+  allreduce_bandwidth_ = CostModelContext::GetInstance()->costmodel_allreduce_fusion_allreduce_bandwidth();
+  if (allreduce_bandwidth_ <= 0) {
+    MS_LOG(INFO) << "'costmodel_allreduce_fusion_allreduce_bandwidth' is " << allreduce_bandwidth_
+                 << ". Bypass ProcessAllreduceFusion";
+    return FAILED;
+  }
+  computation_time_parameter_ =
+    CostModelContext::GetInstance()->costmodel_allreduce_fusion_computation_time_parameter();
+  if (computation_time_parameter_ <= 0) {
+    MS_LOG(INFO) << "'costmodel_allreduce_fusion_computation_time_parameter' is " << computation_time_parameter_
+                 << ". Bypass ProcessAllreduceFusion";
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
+Status AllreduceFusion::SetFusionByBucket() {
+  if (GetSetFusionByBucketParams() != SUCCESS) {
+    MS_LOG(ERROR) << "GetSetFusionByBucketParams failed!";
+    return FAILED;
+  }
+  allreduce_graph_.SortArnode();
+  if (allreduce_graph_.RemoveExtraParas() != SUCCESS) {
+    MS_LOG(ERROR) << "RemoveExtraParas failed!";
+    return FAILED;
+  }
+  const auto &profile = CostModelContext::GetInstance()->costmodel_profile();
+  // The gradients of the parameters of a node are ready once the backward pass has gone through the nodes between it
+  // and the output, whose forward computation is the depend_feat_size of the node. The parameters are sorted by the
+  // ready time and the name, so that all the devices get the same buckets.
+  std::vector<std::tuple<double, std::string, AnfNodePtr>> ready_paras;
+  for (auto &arnode : allreduce_graph_.arnode_vec()) {
+    double ready_time = profile != nullptr
+                          ? kBackwardComputationRatio * profile->ComputationTime(arnode.depend_feat_size())
+                          : computation_time_parameter_ * arnode.depend_feat_size();
+    for (auto &para : arnode.paras()) {
+      ready_paras.emplace_back(ready_time, ParameterName(para), para);
+    }
+  }
+  std::sort(ready_paras.begin(), ready_paras.end(), [](const auto &a, const auto &b) {
+    return std::tie(std::get<0>(a), std::get<1>(a)) < std::tie(std::get<0>(b), std::get<1>(b));
+  });
+  std::vector<GradientReadiness> grads;
+  for (auto &ready_para : ready_paras) {
+    grads.push_back({std::get<0>(ready_para), ParameterSliceSize(std::get<2>(ready_para))});
+  }
+
+  AllreduceBucketPlanner planner([this, &profile](double size) {
+    if (profile != nullptr) {
+      return profile->CommunicationTime(size);
+    }
+    return allreduce_inherent_time_ + size * allreduce_bandwidth_;
+  });
+  BucketSimulation simulation;
+  auto buckets = planner.PlanBest(grads, kMinAllreduceBucketSize, &simulation);
+  MS_LOG(INFO) << "AllReduce fusion by bucket: " << buckets.size() << " buckets of " << grads.size()
+               << " parameters, backward time: " << simulation.backward_time
+               << ", communication time: " << simulation.communication_time
+               << ", overlap time: " << simulation.overlap_time() << ", exposed time: " << simulation.exposed_time();
+  // As in the other algorithms, the parameters reduced last get the smallest fusion id.
+  int64_t fusion = 1;
+  for (auto bucket = buckets.rbegin(); bucket != buckets.rend(); ++bucket) {
+    std::vector<AnfNodePtr> paras;
+    (void)std::transform(bucket->begin(), bucket->end(), std::back_inserter(paras),
+                         [&ready_paras](size_t index) { return std::get<2>(ready_paras[index]); });
+    if (FindMirrorAndSetFusion(paras, fusion) != SUCCESS) {
+      MS_LOG(ERROR) << "FindMirrorAndSetFusion failed";
+      return FAILED;
+    }
+    fusion++;
+  }
+  MS_LOG(DEBUG) << "AllreduceGraph SetFusionByBucket succeed.";
+  return SUCCESS;
+}
+
 Status AllreduceFusion::SetFusionByAlgorithm(int64_t algorithm) {
-  if (algorithm == 1) {
+  if (algorithm == ALLREDUCE_FUSION_ALGORITHM_BY_BACKWARD_COMP_TIME) {
     return SetFusionByBackwardCompTime();
   }
+  if (algorithm == ALLREDUCE_FUSION_ALGORITHM_BY_BUCKET) {
+    return SetFusionByBucket();
+  }
   return SetFusionByBackwardCompAndAllreduceTime();
 }
 
@@ -393,7 +506,8 @@ Status AllreduceFusion::ProcessAllreduceFusion(const CNodePtr &ret) {
     return FAILED;
   }
   auto algorithm = CostModelContext::GetInstance()->costmodel_allreduce_fusion_algorithm();
-  if (algorithm < 1 || algorithm > 2) {
+  if ((algorithm < ALLREDUCE_FUSION_ALGORITHM_BY_BACKWARD_COMP_TIME) ||
+      (algorithm > ALLREDUCE_FUSION_ALGORITHM_BY_BUCKET)) {
     MS_LOG(INFO) << "'costmodel_allreduce_fusion_algorithm' is " << algorithm << ". Bypass ProcessAllreduceFusion";
     return SUCCESS;
   }
@@ -35,6 +35,11 @@ constexpr double DEFAULT_COST_MODEL_ALLREDUCE_FUSION_TAIL_TIME = 0.1;
 constexpr double DEFAULT_COST_MODEL_ALLREDUCE_FUSION_ALLREDUCE_INHERENT_TIME = 0.1;
 constexpr double DEFAULT_COST_MODEL_ALLREDUCE_FUSION_ALLREDUCE_BANDWIDTH = 0.1;
 constexpr double DEFAULT_COST_MODEL_ALLREDUCE_FUSION_COMPUTATION_TIME_PARAMETER = 0.1;
+// 1: split by the backward computation time; 2: split by the backward computation time and the AllReduce time;
+// 3: fill buckets along the order the gradients become ready, with the bucket size simulated to finish earliest.
+constexpr int64_t ALLREDUCE_FUSION_ALGORITHM_BY_BACKWARD_COMP_TIME = 1;
+constexpr int64_t ALLREDUCE_FUSION_ALGORITHM_BY_BACKWARD_COMP_AND_ALLREDUCE_TIME = 2;
+constexpr int64_t ALLREDUCE_FUSION_ALGORITHM_BY_BUCKET = 3;
 
 const uint64_t MAX_RECURSIVE_CALL_TIMES = 100;
 class AllreduceFusion {
@@ -62,6 +67,8 @@ class AllreduceFusion {
   Status SetFusionByBackwardCompTime();
   Status SetFusionByBackwardCompAndAllreduceTime();
   Status GetSetFusionByBackwardCompAndAllreduceTimeParams();
+  Status SetFusionByBucket();
+  Status GetSetFusionByBucketParams();
 
   AllreduceGraph allreduce_graph_;
   CNodePtr ret_;
@@ -61,6 +61,7 @@ class AllreduceGraph {
   void PrintArnodeVec() const;
   void PrintArnodeSet() const;
   const std::unordered_set<CNodePtr> &cnode_set() const { return cnode_set_; }
+  const std::vector<AllreduceNode> &arnode_vec() const { return arnode_vec_; }
   CNodePtr head_cnode() const { return head_cnode_; }
   Status set_head_cnode(const CNodePtr &node);
   double max() const { return max_; }
@@ -0,0 +1,240 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frontend/parallel/auto_parallel/cost_profile.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+
+#include "nlohmann/json.hpp"
+#include "debug/common.h"
+#include "utils/convert_utils_base.h"
+#include "utils/log_adapter.h"
+#ifdef ENABLE_MPI
+#include "runtime/device/cpu/mpi/mpi_interface.h"
+#endif
+
+namespace mindspore {
+namespace parallel {
+namespace {
+constexpr auto kComputationKey = "computation";
+constexpr auto kCommunicationKey = "communication";
+constexpr size_t kCalibrationRepeat = 10;
+constexpr size_t kCalibrationSizeStep = 4;
+constexpr size_t kCalibrationBaseBytes = 4096;
+constexpr size_t kComputationMinBytes = 4096;
+constexpr size_t kComputationMaxBytes = 64 * 1024 * 1024;
+// The smallest message measures the latency of the collective.
+constexpr size_t kCommunicationMinBytes = sizeof(float);
+constexpr size_t kCommunicationMaxBytes = 16 * 1024 * 1024;
+constexpr double kCurveEps = 1e-9;
+
+// The sizes to measure: min_bytes, then the sizes from 4KB up to max_bytes growing by 4 times.
+std::vector<size_t> CalibrationSizes(size_t min_bytes, size_t max_bytes) {
+  std::vector<size_t> sizes = {min_bytes};
+  for (size_t bytes = kCalibrationBaseBytes; bytes <= max_bytes; bytes *= kCalibrationSizeStep) {
+    if (bytes > min_bytes) {
+      sizes.push_back(bytes);
+    }
+  }
+  return sizes;
+}
+
+// Returns the average time of func in microseconds, after running it once to warm up.
+template <typename Func>
+double MeasureTime(const Func &func) {
+  func();
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kCalibrationRepeat; ++i) {
+    func();
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(end - start).count() / kCalibrationRepeat;
+}
+
+// The time of an element-wise addition, against the size of its inputs in total, as the computation cost of the
+// operators counts the bytes of their inputs.
+std::vector<std::pair<double, double>> MeasureComputation() {
+  auto sizes = CalibrationSizes(kComputationMinBytes, kComputationMaxBytes);
+  size_t max_num = kComputationMaxBytes / sizeof(float) / 2;
+  std::vector<float> input_a(max_num, 1.0f);
+  std::vector<float> input_b(max_num, 2.0f);
+  std::vector<float> output(max_num);
+  std::vector<std::pair<double, double>> points;
+  for (auto bytes : sizes) {
+    size_t num = bytes / sizeof(float) / 2;
+    double time = MeasureTime([&]() {
+      for (size_t i = 0; i < num; ++i) {
+        output[i] = input_a[i] + input_b[i];
+      }
+      // Keeps the loop from being optimized out.
+      volatile float sink = output[num - 1];
+      (void)sink;
+    });
+    points.emplace_back(static_cast<double>(bytes), time);
+  }
+  return points;
+}
+
+#ifdef ENABLE_MPI
+// The time of AllGather among all the processes, against the size of the slice sent by each process.
+std::vector<std::pair<double, double>> MeasureCommunication(const std::vector<int> &ranks) {
+  auto sizes = CalibrationSizes(kCommunicationMinBytes, kCommunicationMaxBytes);
+  std::vector<float> input(kCommunicationMaxBytes / sizeof(float), 1.0f);
+  std::vector<float> output(input.size() * ranks.size());
+  std::vector<std::pair<double, double>> points;
+  for (auto bytes : sizes) {
+    size_t num = bytes / sizeof(float);
+    double time = MeasureTime([&]() {
+      if (!MPIAllGather(input.data(), output.data(), ranks, num)) {
+        MS_LOG(EXCEPTION) << "AllGather of " << bytes << " bytes failed in calibrating the communication cost.";
+      }
+    });
+    points.emplace_back(static_cast<double>(bytes), time);
+  }
+  return points;
+}
+
+// Makes every process keep the slowest time measured among the processes for each point.
+void KeepSlowestTime(const std::vector<int> &ranks, std::vector<std::pair<double, double>> *points) {
+  std::vector<float> times;
+  (void)std::transform(points->begin(), points->end(), std::back_inserter(times),
+                       [](const std::pair<double, double> &point) { return static_cast<float>(point.second); });
+  std::vector<float> all_times(times.size() * ranks.size());
+  if (!MPIAllGather(times.data(), all_times.data(), ranks, times.size())) {
+    MS_LOG(EXCEPTION) << "AllGather of the calibrated times failed.";
+  }
+  for (size_t i = 0; i < points->size(); ++i) {
+    for (size_t rank = 0; rank < ranks.size(); ++rank) {
+      (*points)[i].second = std::max((*points)[i].second, static_cast<double>(all_times[rank * times.size() + i]));
+    }
+  }
+}
+#endif
+
+std::vector<std::pair<double, double>> ParseCurve(const nlohmann::json &content, const std::string &key,
+                                                  const std::string &file) {
+  auto iter = content.find(key);
+  if (iter == content.end() || !iter->is_array() || iter->empty()) {
+    MS_LOG(EXCEPTION) << "The cost model profile " << file << " has no curve of '" << key << "'.";
+  }
+  std::vector<std::pair<double, double>> points;
+  for (const auto &point : *iter) {
+    if (!point.is_array() || point.size() != 2 || !point[0].is_number() || !point[1].is_number() ||
+        point[0].get<double>() < 0 || point[1].get<double>() < 0) {
+      MS_LOG(EXCEPTION) << "The point " << point.dump() << " of the curve of '" << key << "' in the cost model profile "
+                        << file << " is not a pair of non-negative bytes and microseconds.";
+    }
+    points.emplace_back(point[0].get<double>(), point[1].get<double>());
+  }
+  return points;
+}
+
+nlohmann::json DumpCurve(const CostCurve &curve) {
+  nlohmann::json points = nlohmann::json::array();
+  for (const auto &point : curve.points()) {
+    points.push_back({point.first, point.second});
+  }
+  return points;
+}
+}  // namespace
+
+CostCurve::CostCurve(std::vector<std::pair<double, double>> points) : points_(std::move(points)) {
+  std::sort(points_.begin(), points_.end());
+}
+
+double CostCurve::Evaluate(double bytes) const {
+  if (points_.empty() || bytes <= 0) {
+    return 0;
+  }
+  auto iter = std::lower_bound(points_.begin(), points_.end(), bytes,
+                               [](const std::pair<double, double> &point, double size) { return point.first < size; });
+  std::pair<double, double> lower = {0, 0};
+  std::pair<double, double> upper;
+  if (iter == points_.begin()) {
+    upper = *iter;
+  } else if (iter == points_.end()) {
+    if (points_.size() > 1) {
+      lower = points_[points_.size() - 2];
+    }
+    upper = points_.back();
+  } else {
+    lower = *(iter - 1);
+    upper = *iter;
+  }
+  if (upper.first - lower.first < kCurveEps) {
+    return upper.second;
+  }
+  double time = lower.second + (bytes - lower.first) * (upper.second - lower.second) / (upper.first - lower.first);
+  return std::max(time, 0.0);
+}
+
+std::shared_ptr<CostProfile> CostProfile::Load(const std::string &file) {
+  std::ifstream fin(file);
+  if (!fin.is_open()) {
+    MS_LOG(EXCEPTION) << "Open the cost model profile " << file << " failed.";
+  }
+  nlohmann::json content;
+  try {
+    fin >> content;
+  } catch (nlohmann::json::parse_error &e) {
+    MS_LOG(EXCEPTION) << "Parse the cost model profile " << file << " failed: " << e.what();
+  }
+  if (!content.is_object()) {
+    MS_LOG(EXCEPTION) << "The cost model profile " << file << " is not a json object.";
+  }
+  return std::make_shared<CostProfile>(CostCurve(ParseCurve(content, kComputationKey, file)),
+                                       CostCurve(ParseCurve(content, kCommunicationKey, file)));
+}
+
+std::shared_ptr<CostProfile> CostProfile::Calibrate() {
+#ifdef ENABLE_MPI
+  int rank_size = GetMPIRankSize();
+  if (rank_size < 2) {
+    MS_LOG(EXCEPTION) << "Calibrating the communication cost needs at least 2 processes, but got " << rank_size << ".";
+  }
+  std::vector<int> ranks(IntToSize(rank_size));
+  std::iota(ranks.begin(), ranks.end(), 0);
+  auto computation = MeasureComputation();
+  auto communication = MeasureCommunication(ranks);
+  KeepSlowestTime(ranks, &computation);
+  KeepSlowestTime(ranks, &communication);
+  MS_LOG(INFO) << "Calibrated the cost model among " << rank_size << " processes.";
+  return std::make_shared<CostProfile>(CostCurve(computation), CostCurve(communication));
+#else
+  MS_LOG(EXCEPTION) << "Calibrating the communication cost needs MindSpore built with MPI.";
+#endif
+}
+
+void CostProfile::Save(const std::string &file) const {
+  auto realpath = Common::GetRealPath(file);
+  if (!realpath.has_value()) {
+    MS_LOG(EXCEPTION) << "Get real path of the cost model profile " << file << " failed.";
+  }
+  std::ofstream fout(realpath.value());
+  if (!fout.is_open()) {
+    MS_LOG(EXCEPTION) << "Open the cost model profile " << file << " for writing failed.";
+  }
+  nlohmann::json content;
+  content[kComputationKey] = DumpCurve(computation_);
+  content[kCommunicationKey] = DumpCurve(communication_);
+  fout << content.dump(2) << std::endl;
+}
+}  // namespace parallel
+}  // namespace mindspore
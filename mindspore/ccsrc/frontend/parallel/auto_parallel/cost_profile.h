@@ -0,0 +1,74 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_FRONTEND_PARALLEL_AUTO_PARALLEL_COST_PROFILE_H_
+#define MINDSPORE_CCSRC_FRONTEND_PARALLEL_AUTO_PARALLEL_COST_PROFILE_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mindspore {
+namespace parallel {
+// A measured curve of the time in microseconds against the size in bytes. The time is interpolated linearly between
+// the points, from the origin below the first point, and along the last segment beyond the last point.
+class CostCurve {
+ public:
+  CostCurve() = default;
+  explicit CostCurve(std::vector<std::pair<double, double>> points);
+  ~CostCurve() = default;
+
+  double Evaluate(double bytes) const;
+  const std::vector<std::pair<double, double>> &points() const { return points_; }
+  bool empty() const { return points_.empty(); }
+
+ private:
+  // Sorted by the size.
+  std::vector<std::pair<double, double>> points_;
+};
+
+// The costs measured on the machine by the calibration mode. With a profile, the cost model of auto parallel turns the
+// computation and the communication of the operators and the redistributions from bytes into times, and the costs of
+// the strategies are compared in microseconds.
+class CostProfile {
+ public:
+  CostProfile(const CostCurve &computation, const CostCurve &communication)
+      : computation_(computation), communication_(communication) {}
+  ~CostProfile() = default;
+
+  // Reads a profile saved by Save, raises an exception if the file is missing or malformed.
+  static std::shared_ptr<CostProfile> Load(const std::string &file);
+  // Measures the time of an element-wise kernel on the CPU, and the time of AllGather among all the processes with MPI.
+  // All the processes have to calibrate at the same time, and they get the same profile: each point keeps the slowest
+  // time measured among the processes.
+  static std::shared_ptr<CostProfile> Calibrate();
+  void Save(const std::string &file) const;
+
+  double ComputationTime(double bytes) const { return computation_.Evaluate(bytes); }
+  double CommunicationTime(double bytes) const { return communication_.Evaluate(bytes); }
+  const CostCurve &computation() const { return computation_; }
+  const CostCurve &communication() const { return communication_; }
+
+ private:
+  CostCurve computation_;
+  CostCurve communication_;
+};
+using CostProfilePtr = std::shared_ptr<CostProfile>;
+}  // namespace parallel
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_FRONTEND_PARALLEL_AUTO_PARALLEL_COST_PROFILE_H_
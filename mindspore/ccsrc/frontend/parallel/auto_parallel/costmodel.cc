@@ -15,13 +15,93 @@
  */
 
 #include "frontend/parallel/auto_parallel/costmodel.h"
+#include <atomic>
 #include <cmath>
 #include <numeric>
 #include <utility>
+#include "common/thread_pool.h"
+#include "frontend/parallel/auto_parallel/cost_profile.h"
 #include "frontend/parallel/auto_parallel/graph_costmodel.h"
+#include "utils/ms_exception.h"
 
 namespace mindspore {
 namespace parallel {
+namespace {
+// Fewer tasks are run in the calling thread, handing them to the thread pool costs more than running them.
+constexpr size_t kParallelRunMinTaskNum = 64;
+std::atomic<bool> keep_cheapest_cost_only{false};
+
+void KeepCheapestCost(CostPtrList *clist_ptrs) {
+  MS_EXCEPTION_IF_NULL(clist_ptrs);
+  if (clist_ptrs->size() <= 1) {
+    return;
+  }
+  const auto alpha = CostModelContext::GetInstance()->costmodel_alpha();
+  const auto beta = CostModelContext::GetInstance()->costmodel_beta();
+  const auto is_training = CostModelContext::GetInstance()->run_phase() == TRAINING_PHASE;
+  auto time = [alpha, beta, is_training](const CostPtr &cost) {
+    auto communication = is_training ? cost->communication_with_partial_para_ : cost->communication_forward_;
+    return alpha * cost->computation_cost_ + beta * communication;
+  };
+  auto cheapest = std::min_element(clist_ptrs->begin(), clist_ptrs->end(),
+                                   [&time](const CostPtr &a, const CostPtr &b) { return time(a) < time(b); });
+  auto least_memory =
+    std::min_element(clist_ptrs->begin(), clist_ptrs->end(), [](const CostPtr &a, const CostPtr &b) {
+      return a->memory_with_reuse_ < b->memory_with_reuse_;
+    });
+  CostPtrList ret{*cheapest};
+  if (least_memory != cheapest) {
+    ret.push_back(*least_memory);
+  }
+  *clist_ptrs = std::move(ret);
+}
+
+// Turns the bytes computed and communicated into the times measured in the profile. The forward and the backward
+// communications are turned separately, as each of them pays the latency of the collectives.
+void RefineByProfile(const CostProfile &profile, const CostPtr &cost, bool is_redistribution) {
+  cost->computation_cost_ = profile.ComputationTime(cost->computation_cost_);
+  if (is_redistribution) {
+    cost->communication_redis_forward_ = profile.CommunicationTime(cost->communication_redis_forward_);
+    cost->communication_redis_backward_ = profile.CommunicationTime(cost->communication_redis_backward_);
+    cost->communication_cost_ = cost->communication_redis_forward_ + cost->communication_redis_backward_;
+    cost->communication_without_parameter_ = cost->communication_cost_;
+    cost->communication_with_partial_para_ = cost->communication_cost_;
+    return;
+  }
+  const auto gamma = CostModelContext::GetInstance()->costmodel_gamma();
+  double backward = profile.CommunicationTime(cost->communication_cost_ - cost->communication_without_parameter_);
+  double forward = profile.CommunicationTime(cost->communication_without_parameter_);
+  cost->communication_without_parameter_ = forward;
+  cost->communication_cost_ = forward + backward;
+  cost->communication_with_partial_para_ = forward + gamma * backward;
+}
+}  // namespace
+
+void SetKeepCheapestCostOnly(bool keep) { keep_cheapest_cost_only = keep; }
+
+void ParallelRun(size_t task_num, const std::function<void(size_t)> &task) {
+  auto thread_num = common::ThreadPool::GetInstance().GetSyncRunThreadNum();
+  if (task_num < kParallelRunMinTaskNum || thread_num <= 1) {
+    for (size_t i = 0; i < task_num; ++i) {
+      task(i);
+    }
+    return;
+  }
+  size_t block_size = (task_num + thread_num - 1) / thread_num;
+  std::vector<common::Task> tasks;
+  for (size_t start = 0; start < task_num; start += block_size) {
+    size_t end = std::min(start + block_size, task_num);
+    tasks.emplace_back([start, end, &task]() {
+      for (size_t i = start; i < end; ++i) {
+        task(i);
+      }
+      return common::SUCCESS;
+    });
+  }
+  (void)common::ThreadPool::GetInstance().SyncRun(tasks);
+  MsException::Instance().CheckException();
+}
+
 void Simplify(CostPtrList *clist_ptrs) {
   const auto run_phase = CostModelContext::GetInstance()->run_phase();
   if (run_phase == TRAINING_PHASE) {
@@ -31,6 +111,9 @@ void Simplify(CostPtrList *clist_ptrs) {
     // inference phase
     SimplifyForDecreasingCommunicationForward(clist_ptrs);
   }
+  if (keep_cheapest_cost_only) {
+    KeepCheapestCost(clist_ptrs);
+  }
 }
 void SimplifyForDecreasingCommunicationForward(CostPtrList *clist_ptrs) {
   // Sort the cost_list with the computation_cost_ increasing, and communication_forward decreasing order. This method
@@ -81,6 +164,11 @@ void SimplifyForDecreasingCommunicationWithPartialPara(CostPtrList *clist_ptrs)
 
 void RefineForPracticalCost(const CostPtr &origin_cost, bool is_redistribution) {
   MS_EXCEPTION_IF_NULL(origin_cost);
+  const auto &profile = CostModelContext::GetInstance()->costmodel_profile();
+  if (profile != nullptr) {
+    RefineByProfile(*profile, origin_cost, is_redistribution);
+    return;
+  }
   const auto comm_threshold = CostModelContext::GetInstance()->costmodel_communi_threshold();
   const auto comm_const = CostModelContext::GetInstance()->costmodel_communi_const();
   const auto comm_bias = CostModelContext::GetInstance()->costmodel_communi_bias();
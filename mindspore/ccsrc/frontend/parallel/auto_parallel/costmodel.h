@@ -18,6 +18,7 @@
 #define MINDSPORE_CCSRC_FRONTEND_PARALLEL_AUTO_PARALLEL_COSTMODEL_H_
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -344,6 +345,12 @@ void Simplify(CostPtrList *clist);
 void SimplifyForDecreasingCommunicationForward(CostPtrList *clist);
 void SimplifyForDecreasingCommunicationWithPartialPara(CostPtrList *clist);
 void RefineForPracticalCost(const CostPtr &, bool is_redistribution);
+// Out of the time budget of the search, Simplify keeps the cheapest cost and the cost of the least memory only, so
+// that the remaining eliminations do not grow the cost lists any more.
+void SetKeepCheapestCostOnly(bool keep);
+// Runs task(0), ..., task(task_num - 1) on the common thread pool. The tasks must be independent of each other, and
+// must not run tasks on the thread pool themselves.
+void ParallelRun(size_t task_num, const std::function<void(size_t)> &task);
 }  // namespace parallel
 }  // namespace mindspore
 
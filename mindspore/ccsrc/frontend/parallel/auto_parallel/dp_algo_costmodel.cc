@@ -16,6 +16,7 @@
 
 #include "frontend/parallel/auto_parallel/dp_algo_costmodel.h"
 
+#include <chrono>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -27,11 +28,24 @@ Status GetStrategy(const CostGraphPtr &graph) {
   MS_EXCEPTION_IF_NULL(graph);
   std::vector<EliminationPtr> eliminations;
   bool flag = true;
+  const auto time_limit = CostModelContext::GetInstance()->dp_algo_time_limit();
+  const auto start_time = std::chrono::steady_clock::now();
+  bool out_of_time = false;
+  SetKeepCheapestCostOnly(false);
 
   // Phase 1: Shrink the CostGraph using 6 operations, and record them in the order.
   // Note: the checking and applying of the 6 operations MUST in current order.
   while (flag) {
     flag = false;
+    // Out of the time limit, the remaining operations keep the cheapest costs only, which are fast to combine, so the
+    // search still finishes with the best strategies found so far.
+    if ((time_limit > 0) && !out_of_time &&
+        (std::chrono::steady_clock::now() - start_time > std::chrono::seconds(time_limit))) {
+      out_of_time = true;
+      SetKeepCheapestCostOnly(true);
+      MS_LOG(WARNING) << "Searching strategies runs out of the time limit of " << time_limit
+                      << " seconds, the remaining eliminations keep the cheapest costs only.";
+    }
     auto node = graph->CheckOpElimination();
     if (node != nullptr) {
       // Applying the Operator Elimination
@@ -116,7 +130,9 @@ Status GetStrategy(const CostGraphPtr &graph) {
   }
 
   // Phase 2: Search the cost_list in the final graph, and determine the optimal one
-  if (graph->SearchStrategy() != SUCCESS) {
+  auto search_result = graph->SearchStrategy();
+  SetKeepCheapestCostOnly(false);
+  if (search_result != SUCCESS) {
     MS_LOG(ERROR) << "Searching strategy for the final failed.";
     return FAILED;
   }
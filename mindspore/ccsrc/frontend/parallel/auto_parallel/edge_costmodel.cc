@@ -60,30 +60,39 @@ Status Edge::InitEdgeCost() {
         }
       }
     }
-  } else {
-    for (auto &target_output : pre_op_output_) {
-      auto target_output_lyt = target_output.second[prev_op_output_index_].tensor_layout();
-      auto target_output_str = target_output.first;
-      auto type_length = prev_op_->GetOutputTypeLengths()[prev_op_output_index_];
-      auto type = prev_op_->outputs_type()[prev_op_output_index_];
-      for (auto &target_input : next_op_input_) {
-        auto target_input_lyt = target_input.second[next_op_input_index_].tensor_layout();
-        auto target_input_str = target_input.first;
-        CostPtr cost;
-        if (GetRedistributionCost(target_output_lyt, target_input_lyt, type_length, type, &cost) != SUCCESS) {
-          MS_LOG(EXCEPTION) << "Failure: redistribution cost calculation failed";
-        }
-        MS_EXCEPTION_IF_NULL(cost);
-        MS_LOG(DEBUG) << "The redistribution cost: computation_cost: " << cost->computation_cost_
-                      << ", communication_cost: " << cost->communication_cost_
-                      << ", communication_without_parameter_: " << cost->communication_without_parameter_
-                      << ", communication_with_partial_para_: " << cost->communication_with_partial_para_ << ".";
-        // refine communication cost calculation for practice
-        RefineForPracticalCost(cost, true);
-        cost->communication_forward_ = cost->communication_redis_forward_;
-        CostPtrKey ck = {target_output_str, target_input_str};
+  } else if (!pre_op_output_.empty() && !next_op_input_.empty()) {
+    // Many strategies share the layout of the tensor on this edge, so the redistribution cost is computed once for each
+    // distinct pair of layouts.
+    std::vector<TensorLayout> output_layouts, input_layouts;
+    std::vector<size_t> output_layout_index, input_layout_index;
+    GetDistinctLayouts(pre_op_output_, prev_op_output_index_, &output_layouts, &output_layout_index);
+    GetDistinctLayouts(next_op_input_, next_op_input_index_, &input_layouts, &input_layout_index);
+    auto type_length = prev_op_->GetOutputTypeLengths()[prev_op_output_index_];
+    auto type = prev_op_->outputs_type()[prev_op_output_index_];
+    std::vector<CostPtr> layout_costs(output_layouts.size() * input_layouts.size());
+    ParallelRun(layout_costs.size(), [&](size_t i) {
+      CostPtr cost;
+      if (GetRedistributionCost(output_layouts[i / input_layouts.size()], input_layouts[i % input_layouts.size()],
+                                type_length, type, &cost) != SUCCESS) {
+        MS_LOG(EXCEPTION) << "Failure: redistribution cost calculation failed";
+      }
+      MS_EXCEPTION_IF_NULL(cost);
+      MS_LOG(DEBUG) << "The redistribution cost: computation_cost: " << cost->computation_cost_
+                    << ", communication_cost: " << cost->communication_cost_
+                    << ", communication_without_parameter_: " << cost->communication_without_parameter_
+                    << ", communication_with_partial_para_: " << cost->communication_with_partial_para_ << ".";
+      // refine communication cost calculation for practice
+      RefineForPracticalCost(cost, true);
+      cost->communication_forward_ = cost->communication_redis_forward_;
+      layout_costs[i] = cost;
+    });
+    for (size_t i = 0; i < pre_op_output_.size(); ++i) {
+      for (size_t j = 0; j < next_op_input_.size(); ++j) {
+        // Each pair of strategies owns a copy of the cost, as the memory cost is set per pair later.
+        auto &layout_cost = layout_costs[output_layout_index[i] * input_layouts.size() + input_layout_index[j]];
+        CostPtrKey ck = {pre_op_output_[i].first, next_op_input_[j].first};
         CostPtrList cl;
-        cl.push_back(cost);
+        cl.push_back(std::make_shared<Cost>(*layout_cost));
         (void)cost_map_.emplace(std::make_pair(ck, cl));
         has_available_cost = true;
       }
@@ -111,6 +120,21 @@ Status Edge::InitEdgeCost() {
   return Status::SUCCESS;
 }
 
+void Edge::GetDistinctLayouts(const std::vector<std::pair<StrategyPtr, std::vector<TensorInfo>>> &strategy_infos,
+                              size_t tensor_index, std::vector<TensorLayout> *layouts,
+                              std::vector<size_t> *layout_index) {
+  MS_EXCEPTION_IF_NULL(layouts);
+  MS_EXCEPTION_IF_NULL(layout_index);
+  for (auto &strategy_info : strategy_infos) {
+    auto layout = strategy_info.second[tensor_index].tensor_layout();
+    auto iter = std::find(layouts->begin(), layouts->end(), layout);
+    layout_index->push_back(LongToSize(std::distance(layouts->begin(), iter)));
+    if (iter == layouts->end()) {
+      layouts->push_back(layout);
+    }
+  }
+}
+
 Status Edge::GetRedistributionCost(const TensorLayout &prev_op_output_layout, const TensorLayout &next_op_input_layout,
                                    size_t type_length, const TypePtr &type, CostPtr *cost) {
   MS_EXCEPTION_IF_NULL(prev_op_);
@@ -206,17 +230,18 @@ CostPtrList Edge::CreateEdgeEliminationCostList(const StrategyPtr &output_st_ptr
 
 void Edge::EdgeEliminationSetNewCost(OperatorInfoPtr, const std::vector<EdgePtr> &edges, OperatorInfoPtr) {
   bool valid = false;
-  for (const auto &output_pair : pre_op_output_) {
-    StrategyPtr output_st_ptr = output_pair.first;
-    for (const auto &input_pair : next_op_input_) {
-      StrategyPtr input_st_ptr = input_pair.first;
-      CostPtrList clist = CreateEdgeEliminationCostList(output_st_ptr, edges, input_st_ptr);
-      CostPtrKey key = {output_st_ptr, input_st_ptr};
-      cost_map_[key] = clist;
-      if ((!valid) && (!clist.empty())) {
-        valid = true;
-      }
+  // The cost lists of the pairs of strategies are independent of each other, they are created in parallel.
+  std::vector<CostPtrList> clists(pre_op_output_.size() * next_op_input_.size());
+  ParallelRun(clists.size(), [&](size_t i) {
+    clists[i] = CreateEdgeEliminationCostList(pre_op_output_[i / next_op_input_.size()].first, edges,
+                                              next_op_input_[i % next_op_input_.size()].first);
+  });
+  for (size_t i = 0; i < clists.size(); ++i) {
+    CostPtrKey key = {pre_op_output_[i / next_op_input_.size()].first, next_op_input_[i % next_op_input_.size()].first};
+    if ((!valid) && (!clists[i].empty())) {
+      valid = true;
     }
+    cost_map_[key] = std::move(clists[i]);
   }
   if (!valid) {
     MS_LOG(EXCEPTION) << "Creating edge: " << edge_name_ << " failed.";
@@ -278,18 +303,18 @@ CostPtrList Edge::CreateOpEliminationCostList(const EdgePtr &e1, const StrategyP
 
 void Edge::OpEliminationSetNewCost(const EdgePtr &e1, const OperatorInfoPtr &op, const EdgePtr &e2) {
   bool valid = false;
-  for (const auto &output_pair : pre_op_output_) {
-    StrategyPtr output_st_ptr = output_pair.first;
-    for (const auto &input_pair : next_op_input_) {
-      StrategyPtr input_st_ptr = input_pair.first;
-
-      CostPtrList clist = CreateOpEliminationCostList(e1, output_st_ptr, op, e2, input_st_ptr);
-      CostPtrKey key = {output_st_ptr, input_st_ptr};
-      cost_map_[key] = clist;
-      if ((!valid) && (!clist.empty())) {
-        valid = true;
-      }
+  // The cost lists of the pairs of strategies are independent of each other, they are created in parallel.
+  std::vector<CostPtrList> clists(pre_op_output_.size() * next_op_input_.size());
+  ParallelRun(clists.size(), [&](size_t i) {
+    clists[i] = CreateOpEliminationCostList(e1, pre_op_output_[i / next_op_input_.size()].first, op, e2,
+                                            next_op_input_[i % next_op_input_.size()].first);
+  });
+  for (size_t i = 0; i < clists.size(); ++i) {
+    CostPtrKey key = {pre_op_output_[i / next_op_input_.size()].first, next_op_input_[i % next_op_input_.size()].first};
+    if ((!valid) && (!clists[i].empty())) {
+      valid = true;
     }
+    cost_map_[key] = std::move(clists[i]);
   }
   if (!valid) {
     MS_LOG(EXCEPTION) << "Creating edge: " << edge_name_ << " failed.";
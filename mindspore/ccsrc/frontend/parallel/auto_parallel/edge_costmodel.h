@@ -147,6 +147,12 @@ class Edge {
   bool CheckStrategyCostPossibility() const;
 
  private:
+  // Collects the distinct layouts of the tensor_index-th tensor of the strategies, and the index of the layout of each
+  // strategy among them.
+  static void GetDistinctLayouts(
+    const std::vector<std::pair<std::shared_ptr<Strategy>, std::vector<TensorInfo>>> &strategy_infos,
+    size_t tensor_index, std::vector<TensorLayout> *layouts, std::vector<size_t> *layout_index);
+
   std::string edge_name_;
   std::shared_ptr<OperatorInfo> prev_op_, next_op_;
   std::map<CostPtrKey, CostPtrList> cost_map_;
@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
+#include <functional>
 #include <numeric>
 #include <string>
 #include <utility>
@@ -24,6 +26,7 @@
 #include "frontend/parallel/auto_parallel/graph_costmodel.h"
 #include "frontend/parallel/ops_info/reshape_info.h"
 #include "frontend/parallel/step_auto_parallel.h"
+#include "utils/hashing.h"
 
 namespace mindspore {
 namespace parallel {
@@ -1157,15 +1160,19 @@ OperatorInfoPtr CostGraph::EliminationMerge(const OperatorInfoPtr &op) {
   MS_EXCEPTION_IF_NULL(target_op);
   MS_EXCEPTION_IF_NULL(edge_ptr);
   MS_LOG(INFO) << "Now merging " << op->name() << " into " << target_op->name() << ".";
-  bool valid = false;
+  std::atomic<bool> valid{false};
 
-  for (auto &tar_stra_cost : target_op->GetStrategyCost()) {
+  // The new costlists of the strategies of the target_op are independent of each other, they are created in parallel.
+  auto tar_stra_costs = target_op->GetStrategyCost();
+  auto op_stra_costs = op->GetStrategyCost();
+  ParallelRun(tar_stra_costs.size(), [&](size_t i) {
+    auto &tar_stra_cost = tar_stra_costs[i];
     MS_EXCEPTION_IF_NULL(tar_stra_cost);
     auto tar_stra = tar_stra_cost->strategy_ptr;
     auto tar_clist_origin = tar_stra_cost->cost_list;
     CostPtrList tar_clist_new;
 
-    for (auto &op_stra_cost : op->GetStrategyCost()) {
+    for (auto &op_stra_cost : op_stra_costs) {
       MS_EXCEPTION_IF_NULL(op_stra_cost);
       auto op_stra = op_stra_cost->strategy_ptr;
       auto op_clist = op_stra_cost->cost_list;
@@ -1174,12 +1181,12 @@ OperatorInfoPtr CostGraph::EliminationMerge(const OperatorInfoPtr &op) {
       CreateMergeEliminationSubCostList(op_stra, op_clist, edge_clist, tar_stra, tar_clist_origin, &tar_clist_new);
     }
     Simplify(&tar_clist_new);
-    // Set the new costlist w.r.t the strategy
-    tar_stra_cost->cost_list = tar_clist_new;
-    if ((!valid) && (!tar_clist_new.empty())) {
+    if (!tar_clist_new.empty()) {
       valid = true;
     }
-  }
+    // Set the new costlist w.r.t the strategy
+    tar_stra_cost->cost_list = std::move(tar_clist_new);
+  });
 
   if (!valid) {
     MS_LOG(EXCEPTION) << "Merging " << op->name() << " into " << target_op->name() << " failed.";
@@ -1238,15 +1245,19 @@ OperatorInfoPtr CostGraph::EliminationContract(const OperatorInfoPtr &op) {
   auto target_op = op->GetAlivePrevEdges()[0]->prev_operator();
   auto edge_ptr = op->GetAlivePrevEdges()[0];
   MS_LOG(INFO) << "Now contracting " << op->name() << " into " << target_op->name() << ".";
-  bool valid = false;
+  std::atomic<bool> valid{false};
 
-  for (auto &tar_stra_cost : target_op->GetStrategyCost()) {
+  // The new costlists of the strategies of the target_op are independent of each other, they are created in parallel.
+  auto tar_stra_costs = target_op->GetStrategyCost();
+  auto op_stra_costs = op->GetStrategyCost();
+  ParallelRun(tar_stra_costs.size(), [&](size_t i) {
+    auto &tar_stra_cost = tar_stra_costs[i];
     MS_EXCEPTION_IF_NULL(tar_stra_cost);
     auto tar_stra = tar_stra_cost->strategy_ptr;
     auto tar_clist_origin = tar_stra_cost->cost_list;
     CostPtrList tar_clist_new;
 
-    for (auto &op_stra_cost : op->GetStrategyCost()) {
+    for (auto &op_stra_cost : op_stra_costs) {
       MS_EXCEPTION_IF_NULL(op_stra_cost);
       auto op_stra = op_stra_cost->strategy_ptr;
       auto op_clist = op_stra_cost->cost_list;
@@ -1255,12 +1266,12 @@ OperatorInfoPtr CostGraph::EliminationContract(const OperatorInfoPtr &op) {
       CreateContractEliminationSubCostList(op_stra, op_clist, edge_clist, tar_stra, tar_clist_origin, &tar_clist_new);
     }
     Simplify(&tar_clist_new);
-    // Set the new costlist w.r.t the strategy
-    tar_stra_cost->cost_list = tar_clist_new;
-    if ((!valid) && (!tar_clist_new.empty())) {
+    if (!tar_clist_new.empty()) {
       valid = true;
     }
-  }
+    // Set the new costlist w.r.t the strategy
+    tar_stra_cost->cost_list = std::move(tar_clist_new);
+  });
   if (!valid) {
     MS_LOG(EXCEPTION) << "Contracting " << op->name() << " into " << target_op->name() << " failed.";
   }
@@ -1925,5 +1936,73 @@ void CostGraph::CheckApproximateCostGraphEdges() {
     }
   }
 }
+
+size_t CostGraph::HashOfStrategyCosts() const {
+  std::hash<double> hash_double;
+  std::hash<int64_t> hash_int;
+  auto hash_cost_list = [&hash_double](size_t hash, const CostPtrList &cost_list) {
+    for (auto &cost : cost_list) {
+      MS_EXCEPTION_IF_NULL(cost);
+      hash = hash_combine({hash, hash_double(cost->computation_cost_), hash_double(cost->communication_cost_),
+                           hash_double(cost->communication_with_partial_para_),
+                           hash_double(cost->communication_forward_), hash_double(cost->memory_with_reuse_)});
+    }
+    return hash;
+  };
+  const auto context = CostModelContext::GetInstance();
+  size_t hash = hash_combine({hash_double(context->costmodel_alpha()), hash_double(context->costmodel_beta()),
+                              hash_double(context->device_memory_capacity()), hash_int(context->run_phase())});
+  for (auto &op : ops_) {
+    MS_EXCEPTION_IF_NULL(op);
+    hash = hash_combine(hash, std::hash<std::string>()(op->name()));
+    for (auto &swc : op->GetStrategyCost()) {
+      MS_EXCEPTION_IF_NULL(swc);
+      MS_EXCEPTION_IF_NULL(swc->strategy_ptr);
+      hash = hash_combine(hash, hash_int(swc->strategy_ptr->GetInputStage()));
+      for (auto &dims : swc->strategy_ptr->GetInputDim()) {
+        for (auto dim : dims) {
+          hash = hash_combine(hash, hash_int(dim));
+        }
+      }
+      hash = hash_cost_list(hash, swc->cost_list);
+    }
+    for (auto &edge : op->succ_edges()) {
+      MS_EXCEPTION_IF_NULL(edge);
+      hash = hash_combine(hash, std::hash<std::string>()(edge->edge_name()));
+      for (auto &output : edge->prev_op_output()) {
+        for (auto &input : edge->next_op_input()) {
+          hash = hash_cost_list(hash, edge->GetCostList(output.first, input.first));
+        }
+      }
+    }
+  }
+  return hash;
+}
+
+bool CostGraph::SelectStrategies(const std::vector<StrategyPtr> &strategies) {
+  if (strategies.size() != ops_.size()) {
+    return false;
+  }
+  std::vector<std::shared_ptr<StrategyWithCost>> selected;
+  for (size_t i = 0; i < ops_.size(); ++i) {
+    MS_EXCEPTION_IF_NULL(ops_[i]);
+    auto stra_costs = ops_[i]->GetStrategyCost();
+    auto iter = std::find_if(stra_costs.begin(), stra_costs.end(), [&strategies, i](const auto &swc) {
+      MS_EXCEPTION_IF_NULL(swc);
+      MS_EXCEPTION_IF_NULL(swc->strategy_ptr);
+      return swc->strategy_ptr->IsEqual(strategies[i]);
+    });
+    if (iter == stra_costs.end()) {
+      MS_LOG(INFO) << "The strategy is not a candidate of " << ops_[i]->name() << ".";
+      return false;
+    }
+    selected.push_back(*iter);
+  }
+  for (size_t i = 0; i < ops_.size(); ++i) {
+    auto &cost_list = selected[i]->cost_list;
+    ops_[i]->SetSelectedStrategyAndCost(selected[i]->strategy_ptr, cost_list.empty() ? nullptr : cost_list[0]);
+  }
+  return true;
+}
 }  // namespace parallel
 }  // namespace mindspore
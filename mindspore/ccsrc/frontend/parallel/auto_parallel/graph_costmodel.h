@@ -182,6 +182,12 @@ class CostGraph {
   // When APPROXIMATION is enabled in the DP algorithm, some edges may have no valid strategies.
   // This method is to re-init those edge involved operators.
   void CheckApproximateCostGraphEdges();
+  // The hash of the operators, their strategies and costs, and the costs of the edges, which determine the result of
+  // the strategy search.
+  size_t HashOfStrategyCosts() const;
+  // Selects the given strategy for each operator, in the order of GetOperators(). Nothing is selected and false is
+  // returned if some strategy is not a candidate of its operator.
+  bool SelectStrategies(const std::vector<StrategyPtr> &strategies);
   // Needed by rec_parser
   void add_inputs_tensor_name(const std::vector<std::string> &inputs_tensor_name) {
     inputs_tensor_name_list_.push_back(inputs_tensor_name);
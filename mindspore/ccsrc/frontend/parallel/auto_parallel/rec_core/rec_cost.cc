@@ -22,6 +22,8 @@
 #include <utility>
 #include <vector>
 
+#include "frontend/parallel/auto_parallel/cost_profile.h"
+#include "frontend/parallel/costmodel_context.h"
 #include "ir/anf.h"
 
 namespace mindspore {
@@ -118,7 +120,7 @@ double CostRedisWithAdjacentNode(const std::vector<std::pair<std::string, Strate
   }
 
   if (counter >= 2) {
-    new_redis_cost = tensor_size / 4.0;
+    new_redis_cost = CostCommunication(tensor_size / 4.0);
   } else if (counter == 0 || counter == 1) {
     new_redis_cost = 0;
   } else {
@@ -128,6 +130,15 @@ double CostRedisWithAdjacentNode(const std::vector<std::pair<std::string, Strate
   return new_redis_cost;
 }
 
+double CostCommunication(double tensor_size) {
+  const auto &profile = CostModelContext::GetInstance()->costmodel_profile();
+  if (profile == nullptr) {
+    return tensor_size;
+  }
+  // The tensors of the recursive programming are of float32.
+  return profile->CommunicationTime(tensor_size * sizeof(float));
+}
+
 // Get optimal strategy for MatMul
 StrategyRec CostMatMul::GetOptimalStr(const Graph::NodeType &node,
                                       const std::vector<std::pair<std::string, StrategyRec>> &node_name_to_strategy,
@@ -38,6 +38,10 @@ double CostRedisWithAdjacentNode(const std::vector<std::pair<std::string, Strate
                                  const std::vector<std::vector<float>> &mode, size_t i_strategy, size_t i_node,
                                  double tensor_size, bool is_search_forward);
 
+// Without a cost model profile, the cost of communicating a tensor is its size, otherwise it is the time measured for
+// communicating the tensor.
+double CostCommunication(double tensor_size);
+
 // class CostMatMul is used to compute the cost of MatMul operator.
 class CostMatMul {
  public:
@@ -49,19 +53,19 @@ class CostMatMul {
 
  private:
   double StrConcatDimI(int64_t a, int64_t b) {
-    cost_in_i_ = (static_cast<double>(a) * static_cast<double>(b)) / 2.0;
+    cost_in_i_ = CostCommunication((static_cast<double>(a) * static_cast<double>(b)) / 2.0);
 
     return cost_in_i_;
   }
 
   double StrConcatDimJ(int64_t a, int64_t b) {
-    cost_in_j_ = (static_cast<double>(a) * static_cast<double>(b)) / 2.0;
+    cost_in_j_ = CostCommunication((static_cast<double>(a) * static_cast<double>(b)) / 2.0);
 
     return cost_in_j_;
   }
 
   double StrReduceDimK(int64_t a, int64_t b) {
-    cost_in_k_ = (static_cast<double>(a) * static_cast<double>(b)) / 2.0;
+    cost_in_k_ = CostCommunication((static_cast<double>(a) * static_cast<double>(b)) / 2.0);
 
     return cost_in_k_;
   }
@@ -86,43 +90,43 @@ class CostConvolution {
 
  private:
   double StrDimB(int64_t TensorFilter) {
-    cost_in_b_ = static_cast<double>((TensorFilter) / 2.0);
+    cost_in_b_ = CostCommunication(static_cast<double>((TensorFilter) / 2.0));
 
     return cost_in_b_;
   }
 
   double StrDimI(int64_t TensorIn, int64_t TensorFilter) {
-    cost_in_i_ = static_cast<double>((TensorIn + TensorFilter) / 2.0);
+    cost_in_i_ = CostCommunication(static_cast<double>((TensorIn + TensorFilter) / 2.0));
 
     return cost_in_i_;
   }
 
   double StrDimJ(int64_t TensorIn, int64_t TensorFilter) {
-    cost_in_j_ = static_cast<double>((TensorIn + TensorFilter) / 2.0);
+    cost_in_j_ = CostCommunication(static_cast<double>((TensorIn + TensorFilter) / 2.0));
 
     return cost_in_j_;
   }
 
   double StrDimK(int64_t TensorIn) {
-    cost_in_k_ = static_cast<double>((TensorIn) / 2.0);
+    cost_in_k_ = CostCommunication(static_cast<double>((TensorIn) / 2.0));
 
     return cost_in_k_;
   }
 
   double StrDimDI(int64_t TensorIn, int64_t TensorOut) {
-    cost_in_di_ = static_cast<double>((TensorIn + TensorOut) / 2.0);
+    cost_in_di_ = CostCommunication(static_cast<double>((TensorIn + TensorOut) / 2.0));
 
     return cost_in_di_;
   }
 
   double StrDimDJ(int64_t TensorIn, int64_t TensorOut) {
-    cost_in_dj_ = static_cast<double>((TensorIn + TensorOut) / 2.0);
+    cost_in_dj_ = CostCommunication(static_cast<double>((TensorIn + TensorOut) / 2.0));
 
     return cost_in_dj_;
   }
 
   double StrDimQ(int64_t TensorOut) {
-    cost_in_q_ = static_cast<double>((TensorOut) / 2.0);
+    cost_in_q_ = CostCommunication(static_cast<double>((TensorOut) / 2.0));
 
     return cost_in_q_;
   }
@@ -19,6 +19,7 @@
 #include <memory>
 
 #include "frontend/parallel/allreduce_fusion/allreduce_fusion.h"
+#include "frontend/parallel/auto_parallel/cost_profile.h"
 #include "utils/ms_context.h"
 
 namespace mindspore {
@@ -46,6 +47,8 @@ void CostModelContext::ResetCostModel() {
   costmodel_communi_threshold_ = DEFAULT_COST_MODEL_COMMUNI_THRESHOLD;
   costmodel_communi_const_ = DEFAULT_COST_MODEL_COMMUNI_CONST;
   costmodel_communi_bias_ = DEFAULT_COST_MODEL_COMMUNI_BIAS;
+  costmodel_profile_file_.clear();
+  costmodel_profile_ = nullptr;
   is_multi_subgraphs_ = DEFAULT_IS_MULTI_SUBGRAPHS;
   run_phase_ = TRAINING_PHASE;
   costmodel_allreduce_fusion_algorithm_ = DEFAULT_COST_MODEL_ALLREDUCE_FUSION_ALGORITHM;
@@ -68,6 +71,7 @@ void CostModelContext::ResetAlgoParameters() {
   triangle_star_strategy_overwrite_ = DEFAULT_TRIANGLE_STAR_STRATEGY_OVERWRITE;
   dp_algo_enable_approxi_ = DEFAULT_DP_ALGO_ENABLE_APPROX;
   dp_algo_approxi_epsilon_ = DEFAULT_DP_ALGO_APPROX_EPSILON;
+  dp_algo_time_limit_ = DEFAULT_DP_ALGO_TIME_LIMIT;
 }
 
 void CostModelContext::PrintCostModel() {
@@ -79,11 +83,13 @@ void CostModelContext::PrintCostModel() {
   MS_LOG(INFO) << "costmodel_communi_threshold: " << costmodel_communi_threshold_ << ".";
   MS_LOG(INFO) << "costmodel_communi_const: " << costmodel_communi_const_ << ".";
   MS_LOG(INFO) << "costmodel_communi_bias: " << costmodel_communi_bias_ << ".";
+  MS_LOG(INFO) << "costmodel_profile: " << costmodel_profile_file_ << ".";
   MS_LOG(INFO) << "is_multi_subgraphs: " << is_multi_subgraphs_ << ".";
   MS_LOG(INFO) << "triangle_star_strategy_overwrite: " << triangle_star_strategy_overwrite_ << ".";
   MS_LOG(INFO) << "dp_algo_enable_approxi: " << dp_algo_enable_approxi_ << ".";
   MS_LOG(INFO) << "dp_algo_approxi_epsilon: " << dp_algo_approxi_epsilon_ << ".";
   MS_LOG(INFO) << "dp_algo_single_loop: " << dp_algo_single_loop_ << ".";
+  MS_LOG(INFO) << "dp_algo_time_limit: " << dp_algo_time_limit_ << ".";
   MS_LOG(INFO) << "run_phase: " << run_phase_ << ".";
   MS_LOG(INFO) << "tensor_slice_alignment_enable: " << tensor_slice_alignment_enable_ << ".";
   MS_LOG(INFO) << "tensor_slice_align_size: " << tensor_slice_alignment_size_ << ".";
@@ -92,7 +98,8 @@ void CostModelContext::PrintCostModel() {
 }
 
 void CostModelContext::set_costmodel_context_for_device(const std::string &device_target) {
-  if (device_target == kGPUDevice) {
+  // The measured costs need no weights for the device.
+  if (device_target == kGPUDevice && costmodel_profile_ == nullptr) {
     costmodel_beta_ = DEFAULT_COST_MODEL_BETA_GPU;
   }
 }
@@ -104,6 +111,13 @@ void CostModelContext::set_dp_algo_approxi_epsilon(double epsilon) {
   dp_algo_approxi_epsilon_ = epsilon;
 }
 
+void CostModelContext::set_dp_algo_time_limit(int64_t time_limit) {
+  if (time_limit < 0) {
+    MS_LOG(EXCEPTION) << "'time_limit' must be non-negative.";
+  }
+  dp_algo_time_limit_ = time_limit;
+}
+
 void CostModelContext::set_dp_algo_enable_approxi(bool approxi) {
   if (approxi) {
     MS_LOG(INFO) << "dp_algo_enable_approx: true.";
@@ -171,6 +185,28 @@ void CostModelContext::set_costmodel_communi_bias(double cm_communi_bias) {
   costmodel_communi_bias_ = cm_communi_bias;
 }
 
+void CostModelContext::set_costmodel_profile(const std::string &profile_file) {
+  if (profile_file.empty()) {
+    costmodel_profile_file_.clear();
+    costmodel_profile_ = nullptr;
+    return;
+  }
+  costmodel_profile_ = CostProfile::Load(profile_file);
+  costmodel_profile_file_ = profile_file;
+  // The computation and the communication are both measured in microseconds, so they are added up as they are.
+  costmodel_alpha_ = 1.0;
+  costmodel_beta_ = 1.0;
+  MS_LOG(INFO) << "Use the cost model profile " << profile_file << ", costmodel_alpha and costmodel_beta are set to 1.";
+}
+
+void CostModelContext::CalibrateCostModel(const std::string &profile_file) {
+  if (profile_file.empty()) {
+    MS_LOG(EXCEPTION) << "The file to save the calibrated cost model profile is empty.";
+  }
+  CostProfile::Calibrate()->Save(profile_file);
+  set_costmodel_profile(profile_file);
+}
+
 void CostModelContext::set_multi_subgraphs(bool multi_graphs) {
   if (multi_graphs) {
     MS_LOG(INFO) << "multi_subgraphs: true.";
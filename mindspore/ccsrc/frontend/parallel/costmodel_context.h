@@ -26,6 +26,8 @@
 
 namespace mindspore {
 namespace parallel {
+class CostProfile;
+
 #define OPERATOR_TO_OPERATOR_CONNECTOR "-"
 #define DEFAULT_DEVICE_MEMORY_CAPACITY (1024.0 * 1024.0 * 1024.0 * 16.0)
 #define DEFAULT_COST_MODEL_ALPHA 1.0
@@ -47,6 +49,7 @@ namespace parallel {
 #define DEFAULT_DP_ALGO_ENABLE_APPROX false
 #define DEFAULT_DP_ALGO_APPROX_EPSILON 0.1
 #define DEFAULT_DP_ALGO_SINGLE_LOOP true
+#define DEFAULT_DP_ALGO_TIME_LIMIT 0
 
 class CostModelContext {
  public:
@@ -92,6 +95,13 @@ class CostModelContext {
   void set_costmodel_communi_bias(double);
   double costmodel_communi_bias() const { return costmodel_communi_bias_; }
 
+  // COST_MODEL_PROFILE
+  void set_costmodel_profile(const std::string &);
+  std::string costmodel_profile_file() const { return costmodel_profile_file_; }
+  const std::shared_ptr<CostProfile> &costmodel_profile() const { return costmodel_profile_; }
+  // Measures the costs on this machine, saves them to the file and uses them as the profile.
+  void CalibrateCostModel(const std::string &);
+
   void set_multi_subgraphs(bool);
   bool is_multi_subgraphs() const { return is_multi_subgraphs_; }
 
@@ -153,6 +163,9 @@ class CostModelContext {
   void set_dp_algo_single_loop(bool);
   bool dp_algo_single_loop() const { return dp_algo_single_loop_; }
 
+  void set_dp_algo_time_limit(int64_t);
+  int64_t dp_algo_time_limit() const { return dp_algo_time_limit_; }
+
  private:
   CostModelContext();
   static std::shared_ptr<CostModelContext> cm_context_inst_;
@@ -181,6 +194,11 @@ class CostModelContext {
   // COST_MODEL_COMMUNI_BIAS
   double costmodel_communi_bias_;
 
+  // COST_MODEL_PROFILE: the costs measured by the calibration mode. With a profile, the costs are times in
+  // microseconds, instead of bytes refined by the COMMUNI_* parameters above.
+  std::string costmodel_profile_file_;
+  std::shared_ptr<CostProfile> costmodel_profile_;
+
   // MULTI_SUBGRAPHS
   bool is_multi_subgraphs_;
 
@@ -197,6 +215,10 @@ class CostModelContext {
   // Whether to generate a single suite of OperatorInfo for a loop.
   bool dp_algo_single_loop_;
 
+  // The time budget of the DP algorithm in seconds, 0 for no limit. Out of the budget, the DP algorithm keeps the
+  // cheapest cost only for each strategy, and finishes with the best strategies found so far.
+  int64_t dp_algo_time_limit_;
+
   int64_t run_phase_;  // 0: 'training', 1: 'inference'
 
   int64_t costmodel_allreduce_fusion_algorithm_;
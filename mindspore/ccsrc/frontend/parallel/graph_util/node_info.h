@@ -35,6 +35,8 @@ bool ParameterRequireGrad(const AnfNodePtr &node_ptr);
 
 size_t GetLengthOfDataType(const TypePtr &type);
 
+size_t GetInputsTypeLen(const AnfNodePtr &input);
+
 std::vector<bool> ExtractInputParameterByNode(const CNodePtr &node);
 
 std::vector<size_t> ExtractInputTypeLengthByNode(const CNodePtr &node);
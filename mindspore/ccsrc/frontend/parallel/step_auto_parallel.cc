@@ -897,6 +897,35 @@ void ReshapeCostCompute(const std::vector<AnfNodePtr> &all_nodes) {
   }
 }
 
+Status SearchOrLoadStrategy(const CostGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto &checkpoint = StrategyCheckpoint::GetInstance();
+  if (!checkpoint.LoadCheckPointOn() && !checkpoint.SaveCheckPointOn()) {
+    return GetStrategy(graph);
+  }
+  auto graph_hash = graph->HashOfStrategyCosts();
+  std::vector<StrategyPtr> strategies;
+  if (checkpoint.LoadCheckPointOn() && checkpoint.GetSearchedStrategy(graph_hash, &strategies) &&
+      graph->SelectStrategies(strategies)) {
+    MS_LOG(INFO) << "The strategies searched for the cost graph are loaded from the strategy checkpoint.";
+    checkpoint.set_searched_strategy(graph_hash, strategies);
+    return SUCCESS;
+  }
+  if (GetStrategy(graph) != SUCCESS) {
+    return FAILED;
+  }
+  strategies.clear();
+  for (auto &op : graph->GetOperators()) {
+    MS_EXCEPTION_IF_NULL(op);
+    if (op->selected_strategy() == nullptr) {
+      return SUCCESS;
+    }
+    strategies.push_back(op->selected_strategy());
+  }
+  checkpoint.set_searched_strategy(graph_hash, strategies);
+  return SUCCESS;
+}
+
 Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const FuncGraphPtr &root) {
   // There are 4 meta-steps to determine the parallelization strategy for the ANF graph.
   // Step 1: Traverse the ANF graph, and create NODEs for costgraph:
@@ -918,7 +947,8 @@ Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const Fu
   //      If 'sharding_propagation' is configured to be true, then the configured-sharding-strategies will propagate
   //      to the non-configured operators, with the goal of minimizing redistribution cost.
   //      Otherwise, DP algorithm is used to search strategy of the costgraph. Note that there may be several connected
-  //      components in the costgraph, and the DP algorithm runs on each of them.
+  //      components in the costgraph, and the DP algorithm runs on each of them. The strategies searched for the same
+  //      costgraph are reused from the strategy checkpoint.
   //
   // OUTPUT: the determined strategy for each operator.
 
@@ -963,7 +993,7 @@ Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const Fu
   if (ParallelContext::GetInstance()->sharding_propagation()) {
     entire_costgraph->StrategyPropagate(configured_stra_ops_);
     configured_stra_ops_.clear();
-  } else if (GetStrategy(entire_costgraph) != SUCCESS) {
+  } else if (SearchOrLoadStrategy(entire_costgraph) != SUCCESS) {
     MS_LOG(ERROR) << "Strategy search for cost-graph fails";
     return FAILED;
   }
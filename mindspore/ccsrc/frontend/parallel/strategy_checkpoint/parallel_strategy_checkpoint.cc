@@ -97,6 +97,37 @@ Status StrategyCheckpoint::LoadGroupInfo(const std::string &file, GroupInfoMap *
   return SUCCESS;
 }
 
+namespace {
+StrategyPtr ParseStrategy(const straspb::ParallelStrategys &parallel_strategys) {
+  auto stage = (int64_t)parallel_strategys.stage();
+  size_t strategys_num = LongToSize(parallel_strategys.parallel_strategy_size());
+  Strategys strategy_inputs;
+  for (size_t j = 0; j < strategys_num; j++) {
+    straspb::ParallelStrategy parallel_strategy = parallel_strategys.parallel_strategy(SizeToInt(j));
+    Dimensions dimension;
+    size_t dim_num = LongToSize(parallel_strategy.dim_size());
+    for (size_t k = 0; k < dim_num; k++) {
+      dimension.push_back(parallel_strategy.dim(SizeToInt(k)));
+    }
+    strategy_inputs.push_back(dimension);
+  }
+  return NewStrategy(stage, strategy_inputs);
+}
+
+void SerializeStrategy(const StrategyPtr &strategy, straspb::ParallelStrategys *parallel_strategys) {
+  MS_EXCEPTION_IF_NULL(strategy);
+  MS_EXCEPTION_IF_NULL(parallel_strategys);
+  parallel_strategys->set_stage(UlongToUint(LongToUlong(strategy->GetInputStage())));
+  for (auto &dims : strategy->GetInputDim()) {
+    straspb::ParallelStrategy *parallel_strategy = parallel_strategys->add_parallel_strategy();
+    MS_EXCEPTION_IF_NULL(parallel_strategy);
+    for (auto stra_dim : dims) {
+      parallel_strategy->add_dim(UlongToUint(LongToUlong(stra_dim)));
+    }
+  }
+}
+}  // namespace
+
 Status StrategyCheckpoint::Load(StrategyMap *strategy_map) {
   if (strategy_map == nullptr) {
     MS_LOG(EXCEPTION) << "Failure:strategy_map is nullptr";
@@ -118,24 +149,18 @@ Status StrategyCheckpoint::Load(StrategyMap *strategy_map) {
   for (size_t i = 0; i < node_num; i++) {
     straspb::ParallelStrategyItem parallel_strategy_item = parallel_strategy_map.parallel_strategy_item(SizeToInt(i));
     std::string node_name = parallel_strategy_item.node_name();
-    straspb::ParallelStrategys parallel_strategys = parallel_strategy_item.parallel_strategys();
-    auto stage = (int64_t)parallel_strategys.stage();
-    size_t strategys_num = LongToSize(parallel_strategys.parallel_strategy_size());
-    Strategys strategy_inputs;
-    for (size_t j = 0; j < strategys_num; j++) {
-      straspb::ParallelStrategy parallel_strategy = parallel_strategys.parallel_strategy(SizeToInt(j));
-      Dimensions dimension;
-      size_t dim_num = LongToSize(parallel_strategy.dim_size());
-      for (size_t k = 0; k < dim_num; k++) {
-        dimension.push_back(parallel_strategy.dim(SizeToInt(k)));
-      }
-      strategy_inputs.push_back(dimension);
-    }
-
-    StrategyPtr strategy = NewStrategy(stage, strategy_inputs);
-    (*strategy_map)[node_name] = strategy;
+    (*strategy_map)[node_name] = ParseStrategy(parallel_strategy_item.parallel_strategys());
     current_stage_ = (int64_t)parallel_strategy_map.current_stage();
   }
+  loaded_graph_hash_ = 0;
+  loaded_searched_strategies_.clear();
+  if (parallel_strategy_map.has_searched_strategy()) {
+    const auto &searched_strategy = parallel_strategy_map.searched_strategy();
+    loaded_graph_hash_ = searched_strategy.graph_hash();
+    for (int i = 0; i < searched_strategy.op_strategy_size(); ++i) {
+      loaded_searched_strategies_.push_back(ParseStrategy(searched_strategy.op_strategy(i)));
+    }
+  }
   return SUCCESS;
 }
 
@@ -147,16 +172,14 @@ Status StrategyCheckpoint::Save(const StrategyMap &strategy_map, const TensorInf
     straspb::ParallelStrategyItem *parallel_strategy_item = parallel_strategy_map.add_parallel_strategy_item();
     MS_EXCEPTION_IF_NULL(parallel_strategy_item);
     parallel_strategy_item->set_node_name(node_stra.first);
-    straspb::ParallelStrategys *parallel_strategys = parallel_strategy_item->mutable_parallel_strategys();
-    MS_EXCEPTION_IF_NULL(parallel_strategys);
-    MS_EXCEPTION_IF_NULL(node_stra.second);
-    parallel_strategys->set_stage(UlongToUint(LongToUlong(node_stra.second->GetInputStage())));
-    for (auto &dims : node_stra.second->GetInputDim()) {
-      straspb::ParallelStrategy *parallel_strategy = parallel_strategys->add_parallel_strategy();
-      MS_EXCEPTION_IF_NULL(parallel_strategy);
-      for (auto stra_dim : dims) {
-        parallel_strategy->add_dim(UlongToUint(LongToUlong(stra_dim)));
-      }
+    SerializeStrategy(node_stra.second, parallel_strategy_item->mutable_parallel_strategys());
+  }
+  if (!searched_strategies_.empty()) {
+    straspb::SearchedStrategy *searched_strategy = parallel_strategy_map.mutable_searched_strategy();
+    MS_EXCEPTION_IF_NULL(searched_strategy);
+    searched_strategy->set_graph_hash(searched_graph_hash_);
+    for (auto &strategy : searched_strategies_) {
+      SerializeStrategy(strategy, searched_strategy->add_op_strategy());
     }
   }
   for (auto &node_tensor_info : tensor_info_map) {
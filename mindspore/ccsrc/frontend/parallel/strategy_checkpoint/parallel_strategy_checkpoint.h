@@ -59,6 +59,20 @@ class StrategyCheckpoint {
   bool LoadCheckPointOn() const { return load_checkpoint_on_; }
   bool SaveCheckPointOn() const { return save_checkpoint_on_; }
 
+  // The strategies searched for the cost graph of hash graph_hash, one for each operator of the cost graph. They are
+  // saved along with the strategies of the operators, and reused when a cost graph of the same hash is searched.
+  void set_searched_strategy(size_t graph_hash, const std::vector<StrategyPtr> &strategies) {
+    searched_graph_hash_ = graph_hash;
+    searched_strategies_ = strategies;
+  }
+  bool GetSearchedStrategy(size_t graph_hash, std::vector<StrategyPtr> *strategies) const {
+    if (loaded_searched_strategies_.empty() || loaded_graph_hash_ != graph_hash) {
+      return false;
+    }
+    *strategies = loaded_searched_strategies_;
+    return true;
+  }
+
  private:
   std::string load_file_;
   std::string save_file_;
@@ -69,6 +83,10 @@ class StrategyCheckpoint {
   int64_t current_stage_;
   std::string group_info_save_file_;
   bool group_info_save_on_;
+  size_t searched_graph_hash_{0};
+  std::vector<StrategyPtr> searched_strategies_;
+  size_t loaded_graph_hash_{0};
+  std::vector<StrategyPtr> loaded_searched_strategies_;
 };
 }  // namespace parallel
 }  // namespace mindspore
@@ -438,6 +438,45 @@ bool AbstractSpecializeAction(const ResourcePtr &res) {
   return true;
 }
 
+bool IncrementalSpecializeAction(const ResourcePtr &res) {
+  FuncGraphPtr func_graph = res->func_graph();
+  if (func_graph == nullptr) {
+    MS_LOG(EXCEPTION) << "IncrementalSpecialize error";
+  }
+  // get original loaded graph to check inputs later
+  auto loaded_graph_ptr = GetLoadedGraph(res);
+  abstract::AbstractBasePtrList args_spec = res->args_spec();
+  for (const auto &param : func_graph->parameters()) {
+    auto param_node = std::static_pointer_cast<Parameter>(param);
+    if (param_node->has_default()) {
+      auto value = param_node->default_param();
+      auto abs_value = value->ToAbstract()->cast<abstract::AbstractTensorPtr>();
+      auto ref_key = std::make_shared<RefKey>(param_node->name());
+      args_spec.push_back(std::make_shared<abstract::AbstractRef>(ref_key->ToAbstract(), abs_value));
+    }
+  }
+  // Infer the graph specialized before for the shapes of the new inputs, the results of its last inference are cleared.
+  AnalysisResult result = AbstractAnalyze(res, func_graph, args_spec, true);
+  // The top graph may be replaced by infer, update the top graph when the infer is done
+  parse::Parser::UpdateTopFuncGraph(result.context->func_graph());
+
+  FuncGraphPtr new_fg = ProgramSpecialize(res, result.context->func_graph(), result.context);
+  MS_EXCEPTION_IF_NULL(new_fg);
+  res->set_func_graph(new_fg);
+  new_fg->EraseUnusedNodeInOrder();
+  for (auto fg : new_fg->func_graphs_used_total()) {
+    if (fg) {
+      fg->EraseUnusedNodeInOrder();
+    }
+  }
+  // check input after abstract when there is a loaded graph
+  if (loaded_graph_ptr != nullptr) {
+    CheckRootInputShapeAndType(res, loaded_graph_ptr);
+  }
+  MS_LOG(DEBUG) << "End graph: " << new_fg->ToString() << ", return: " << new_fg->get_return()->DebugString(true);
+  return true;
+}
+
 bool OptimizeAction(const ResourcePtr &res, const std::vector<PassItem> &passes) {
   size_t counter = 0;
   for (auto &pass : passes) {
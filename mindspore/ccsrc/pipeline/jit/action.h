@@ -34,6 +34,8 @@ bool ParseAction(const ResourcePtr &res);
 bool SymbolResolveAction(const ResourcePtr &res);
 bool AutoMonadAction(const ResourcePtr &res);
 bool AbstractSpecializeAction(const ResourcePtr &res);
+// Replaces the actions up to abstract_specialize when the graph specialized by an earlier compilation is reused.
+bool IncrementalSpecializeAction(const ResourcePtr &res);
 bool GeOptimizeAction(const ResourcePtr &res);
 bool VmOptimizeAction(const ResourcePtr &res);
 bool PynativeOptimizeAction(const ResourcePtr &res);
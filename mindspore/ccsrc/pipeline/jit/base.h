@@ -35,6 +35,8 @@ struct ExecutorInfo {
   std::size_t arg_list_size;
   // The all args of graph,including input data and weight.
   VectorRef arg_list;
+  // Whether the graph is specialized from the graph of the last compilation for inputs of other shapes.
+  bool incremental_compiled{false};
 };
 using ExecutorInfoPtr = std::shared_ptr<ExecutorInfo>;
 
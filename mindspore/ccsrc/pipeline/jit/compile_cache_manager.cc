@@ -0,0 +1,228 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/jit/compile_cache_manager.h"
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <utility>
+#include "debug/common.h"
+#include "debug/dump_proto.h"
+#include "load_mindir/load_model.h"
+#include "frontend/parallel/context.h"
+#include "utils/ms_context.h"
+#include "utils/system/sha256.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace pipeline {
+namespace {
+constexpr char kCompileCacheFileSuffix[] = ".mindir";
+constexpr size_t kMaxCompileCacheEntryNum = 16;
+
+// The phase without the compile key index prepended by the executor, which depends on the order of compilations,
+// and without the creation time and the id of the network appended to it.
+std::string GetPhaseName(const std::string &phase) {
+  auto phase_prefix = phase.substr(0, phase.find('.'));
+  auto pos = phase_prefix.find_first_not_of("0123456789");
+  return pos == std::string::npos ? "" : phase_prefix.substr(pos);
+}
+
+// The context that changes the graph compiled by the frontend.
+std::string GetContextInfo() {
+  std::ostringstream oss;
+  auto ms_context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(ms_context);
+  oss << "device_target:" << ms_context->get_param<std::string>(MS_CTX_DEVICE_TARGET)
+      << " mode:" << ms_context->get_param<int>(MS_CTX_EXECUTION_MODE)
+      << " enable_mindrt:" << ms_context->get_param<bool>(MS_CTX_ENABLE_MINDRT)
+      << " enable_graph_kernel:" << ms_context->get_param<bool>(MS_CTX_ENABLE_GRAPH_KERNEL)
+      << " graph_kernel_flags:" << ms_context->get_param<std::string>(MS_CTX_GRAPH_KERNEL_FLAGS)
+      << " enable_sparse:" << ms_context->get_param<bool>(MS_CTX_ENABLE_SPARSE)
+      << " grad_for_scalar:" << ms_context->get_param<bool>(MS_CTX_GRAD_FOR_SCALAR)
+      << " max_call_depth:" << ms_context->get_param<uint32_t>(MS_CTX_MAX_CALL_DEPTH) << '\n';
+  auto parallel_context = parallel::ParallelContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(parallel_context);
+  oss << "parallel_mode:" << parallel_context->parallel_mode()
+      << " strategy_search_mode:" << parallel_context->strategy_search_mode()
+      << " device_num:" << parallel_context->device_num() << " global_rank:" << parallel_context->global_rank()
+      << " full_batch:" << parallel_context->full_batch()
+      << " gradients_mean:" << parallel_context->gradients_mean()
+      << " pipeline_stages:" << parallel_context->pipeline_stage_split_num()
+      << " grad_accumulation_step:" << parallel_context->grad_accumulation_step()
+      << " enable_parallel_optimizer:" << parallel_context->enable_parallel_optimizer() << '\n';
+  return oss.str();
+}
+
+void SetFileUsed(const std::string &path) {
+  if (utime(path.c_str(), nullptr) != 0) {
+    MS_LOG(WARNING) << "Failed to update the access time of the compile cache file " << path;
+  }
+}
+}  // namespace
+
+void CompileCacheManager::InitCompileKey(const std::string &phase, const abstract::AbstractBasePtrList &args_spec) {
+  compile_key_.clear();
+  std::ostringstream oss;
+  oss << "version:" << ms_version_ << '\n';
+  auto dep_files = dep_files_;
+  std::sort(dep_files.begin(), dep_files.end());
+  for (const auto &dep_file : dep_files) {
+    auto file_hash = system::sha256::GetHashFromFile(dep_file);
+    if (file_hash.empty()) {
+      MS_LOG(WARNING) << "Failed to read the source file " << dep_file
+                      << " of the network, the compile cache is not used.";
+      return;
+    }
+    oss << dep_file << ':' << file_hash << '\n';
+  }
+  // The parameters and the hyperparameters are not in the source files, but change the compiled graph.
+  for (const auto &info : net_info_) {
+    oss << info << '\n';
+  }
+  oss << "phase:" << GetPhaseName(phase) << '\n';
+  // The string of an abstract holds the address of its value, which differs from one process to the next, so the key
+  // is built from the type, the shape and the value of the inputs that are not broadened.
+  for (const auto &arg : args_spec) {
+    MS_EXCEPTION_IF_NULL(arg);
+    auto type = arg->BuildType();
+    auto shape = arg->BuildShape();
+    auto value = arg->BuildValue();
+    MS_EXCEPTION_IF_NULL(type);
+    MS_EXCEPTION_IF_NULL(shape);
+    MS_EXCEPTION_IF_NULL(value);
+    oss << "arg:" << type->ToString() << ':' << shape->ToString();
+    if (!value->isa<AnyValue>()) {
+      oss << ':' << value->ToString();
+    }
+    oss << '\n';
+  }
+  oss << GetContextInfo();
+  compile_key_ = system::sha256::GetHashFromString(oss.str());
+  MS_LOG(INFO) << "The compile key of phase " << phase << " is " << compile_key_;
+}
+
+std::string CompileCacheManager::GetEntryPath() const {
+  auto realpath = Common::GetRealPath(cache_dir_ + "/" + compile_key_ + kCompileCacheFileSuffix);
+  if (!realpath.has_value()) {
+    MS_LOG(WARNING) << "Get real path failed. The compile cache directory is " << cache_dir_;
+    return "";
+  }
+  return realpath.value();
+}
+
+FuncGraphPtr CompileCacheManager::LoadFuncGraph(const FuncGraphManagerPtr &manager) const {
+  if (compile_key_.empty()) {
+    return nullptr;
+  }
+  auto entry_path = GetEntryPath();
+  if (entry_path.empty()) {
+    return nullptr;
+  }
+  if (!Common::FileExists(entry_path)) {
+    MS_LOG(INFO) << "The compile cache has no entry " << entry_path << ". Execute all the compilation actions.";
+    return nullptr;
+  }
+  MS_LOG(INFO) << "Use the compile cache \"" << entry_path << "\" and execute the backend actions only.";
+  FuncGraphPtr fg = mindspore::LoadMindIR(entry_path);
+  if (fg == nullptr) {
+    MS_LOG(WARNING) << "Failed to load the compile cache file " << entry_path
+                    << ", remove it and execute all the compilation actions.";
+    (void)remove(entry_path.c_str());
+    return nullptr;
+  }
+  SetFileUsed(entry_path);
+  if (fg->manager() == nullptr) {
+    MS_EXCEPTION_IF_NULL(manager);
+    manager->AddFuncGraph(fg);
+    fg->set_manager(manager);
+  }
+  return fg;
+}
+
+void CompileCacheManager::SaveFuncGraph(const FuncGraphPtr &func_graph) const {
+  MS_EXCEPTION_IF_NULL(func_graph);
+  if (compile_key_.empty()) {
+    return;
+  }
+  auto entry_path = GetEntryPath();
+  if (entry_path.empty()) {
+    return;
+  }
+  // Another job may be reading the entry, so it is replaced by a rename instead of being rewritten in place.
+  auto temp_path = entry_path + "." + std::to_string(getpid()) + ".tmp";
+  std::ofstream fout(temp_path, std::ios::binary);
+  if (!fout.is_open()) {
+    MS_LOG(WARNING) << "Open compile cache file '" << temp_path << "' failed!";
+    return;
+  }
+  mind_ir::ModelProto fg_model = GetBinaryProto(func_graph, true);
+  bool saved = fg_model.SerializeToOstream(&fout);
+  fout.close();
+  if (!saved) {
+    MS_LOG(WARNING) << "Failed to cache the graph to file " << temp_path;
+    (void)remove(temp_path.c_str());
+    return;
+  }
+  ChangeFileMode(temp_path, S_IRUSR);
+  if (rename(temp_path.c_str(), entry_path.c_str()) != 0) {
+    MS_LOG(WARNING) << "Failed to rename the compile cache file " << temp_path << " to " << entry_path;
+    (void)remove(temp_path.c_str());
+    return;
+  }
+  MS_LOG(INFO) << "Cache the graph compiled by the frontend to " << entry_path;
+  RemoveStaleEntries(entry_path.substr(0, entry_path.find_last_of('/')));
+}
+
+void CompileCacheManager::RemoveStaleEntries(const std::string &cache_dir) const {
+  DIR *dir = opendir(cache_dir.c_str());
+  if (dir == nullptr) {
+    return;
+  }
+  // The entries with their last access time.
+  std::vector<std::pair<time_t, std::string>> entries;
+  const std::string suffix = kCompileCacheFileSuffix;
+  struct dirent *file = nullptr;
+  while ((file = readdir(dir)) != nullptr) {
+    std::string file_name = file->d_name;
+    if (file_name.size() <= suffix.size() ||
+        file_name.compare(file_name.size() - suffix.size(), suffix.size(), suffix) != 0) {
+      continue;
+    }
+    auto path = cache_dir + "/" + file_name;
+    struct stat file_stat;
+    if (stat(path.c_str(), &file_stat) == 0) {
+      entries.emplace_back(file_stat.st_mtime, path);
+    }
+  }
+  (void)closedir(dir);
+  if (entries.size() <= kMaxCompileCacheEntryNum) {
+    return;
+  }
+  std::sort(entries.begin(), entries.end(), std::greater<std::pair<time_t, std::string>>());
+  for (size_t i = kMaxCompileCacheEntryNum; i < entries.size(); ++i) {
+    MS_LOG(INFO) << "Remove the least recently used compile cache file " << entries[i].second;
+    (void)remove(entries[i].second.c_str());
+  }
+}
+}  // namespace pipeline
+}  // namespace mindspore
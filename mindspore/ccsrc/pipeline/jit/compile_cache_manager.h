@@ -0,0 +1,63 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_MANAGER_H_
+#define MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_MANAGER_H_
+
+#include <string>
+#include <vector>
+#include "ir/anf.h"
+#include "ir/manager.h"
+#include "abstract/abstract_value.h"
+
+namespace mindspore {
+namespace pipeline {
+// The graphs compiled by the frontend, cached in a directory. Each entry is named by the hash of everything the
+// compilation depends on: the version of MindSpore, the source files, the parameters and the hyperparameters of the
+// network, the phase, the signature of the inputs and the context. A changed network misses the cache instead of
+// loading a stale graph, and several networks and input signatures share the directory. Entries are written to a
+// temporary file and renamed, so concurrent jobs never read a partial entry, and the least recently used ones are
+// removed beyond kMaxCompileCacheEntryNum.
+class CompileCacheManager {
+ public:
+  // The net_info is the name, shape and dtype of every parameter and the hyperparameters of the network.
+  CompileCacheManager(const std::string &cache_dir, const std::string &ms_version,
+                      const std::vector<std::string> &dep_files, const std::vector<std::string> &net_info)
+      : cache_dir_(cache_dir), ms_version_(ms_version), dep_files_(dep_files), net_info_(net_info) {}
+  ~CompileCacheManager() = default;
+
+  // Computes the key of the compilation of the phase with the inputs of args_spec.
+  void InitCompileKey(const std::string &phase, const abstract::AbstractBasePtrList &args_spec);
+  // Returns nullptr if the cache has no valid entry for the key.
+  FuncGraphPtr LoadFuncGraph(const FuncGraphManagerPtr &manager) const;
+  void SaveFuncGraph(const FuncGraphPtr &func_graph) const;
+
+  const std::string &compile_key() const { return compile_key_; }
+
+ private:
+  std::string GetEntryPath() const;
+  void RemoveStaleEntries(const std::string &cache_dir) const;
+
+  std::string cache_dir_;
+  std::string ms_version_;
+  std::vector<std::string> dep_files_;
+  std::vector<std::string> net_info_;
+  std::string compile_key_;
+};
+}  // namespace pipeline
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_MANAGER_H_
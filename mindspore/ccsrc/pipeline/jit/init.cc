@@ -97,8 +97,12 @@ PYBIND11_MODULE(_c_expression, m) {
     .def("build_data_graph", &ExecutorPy::BuildGraph, py::arg("build_params"), py::arg("phase") = py::str("train"),
          py::arg("broadcast_params") = py::dict(), "Build data graph.")
     .def("has_compiled", &ExecutorPy::HasCompiled, py::arg("phase") = py::str(""), "get if cell compiled.")
+    .def("is_incremental_compiled", &ExecutorPy::IsIncrementalCompiled, py::arg("phase") = py::str(""),
+         "get if cell compiled incrementally from the graph specialized before.")
     .def("run_init_graph", &ExecutorPy::RunInitGraph, "Run init Graph.")
-    .def("set_py_exe_path", &ExecutorPy::PyExePath, py::arg("phase") = py::str(""), "set python executable path.");
+    .def("set_py_exe_path", &ExecutorPy::PyExePath, py::arg("phase") = py::str(""), "set python executable path.")
+    .def("set_compile_cache_dep", &ExecutorPy::SetCompileCacheDep, py::arg("ms_version"), py::arg("dep_files"),
+         py::arg("net_info"), "Set the version, the source files and the network info the compile cache depends on.");
 
   (void)py::class_<EnvInstance, std::shared_ptr<EnvInstance>>(m, "EnvInstance_").def(py::init());
 
@@ -220,6 +224,12 @@ PYBIND11_MODULE(_c_expression, m) {
          "Set the parameter cost_model_communi_bias of the DP algorithm.")
     .def("get_costmodel_communi_bias", &CostModelContext::costmodel_communi_bias,
          "Get the parameter cost_model_communi_bias of the DP algorithm.")
+    .def("set_costmodel_profile", &CostModelContext::set_costmodel_profile,
+         "Set the file of the costs measured by the calibration mode.")
+    .def("get_costmodel_profile", &CostModelContext::costmodel_profile_file,
+         "Get the file of the costs measured by the calibration mode.")
+    .def("calibrate_cost_model", &CostModelContext::CalibrateCostModel,
+         "Measure the costs on this machine and save them to the file.")
     .def("set_multi_subgraphs", &CostModelContext::set_multi_subgraphs, "Set the parameter is_multi_subgraphs.")
     .def("get_multi_subgraphs", &CostModelContext::is_multi_subgraphs, "Get the parameter is_multi_subgraphs.")
     .def("set_run_phase", &CostModelContext::set_run_phase, "Set the flag run_phase.")
@@ -286,6 +296,10 @@ PYBIND11_MODULE(_c_expression, m) {
          "Set the flag of generating a single suite of OperatorInfos in for-loop.")
     .def("get_dp_algo_single_loop", &CostModelContext::dp_algo_single_loop,
          "Get the flag of whether or not generating a single suite of OperatorInfos in for-loop.")
+    .def("set_dp_algo_time_limit", &CostModelContext::set_dp_algo_time_limit,
+         "Set the time limit in seconds of the DP algorithm.")
+    .def("get_dp_algo_time_limit", &CostModelContext::dp_algo_time_limit,
+         "Get the time limit in seconds of the DP algorithm.")
     .def("reset_cost_model", &CostModelContext::ResetCostModel, "Reset the CostModelContext.")
     .def("reset_algo_parameters", &CostModelContext::ResetAlgoParameters, "Reset the AlgoParameters.");
 
@@ -409,7 +423,18 @@ PYBIND11_MODULE(_c_expression, m) {
     .def("set_dp_norm_clip", &PSContext::set_dp_norm_clip,
          "Set dp norm clip for federated learning secure aggregation.")
     .def("set_encrypt_type", &PSContext::set_encrypt_type,
-         "Set encrypt type for federated learning secure aggregation.");
+         "Set encrypt type for federated learning secure aggregation.")
+    .def("set_grad_compression", &PSContext::set_grad_compression,
+         "Set the codec of gradients pushed to parameter servers.")
+    .def("grad_compression", &PSContext::grad_compression, "Get the codec of gradients pushed to parameter servers.")
+    .def("set_grad_compression_ratio", &PSContext::set_grad_compression_ratio,
+         "Set the ratio of gradient values kept by top-k compression.")
+    .def("grad_compression_ratio", &PSContext::grad_compression_ratio,
+         "Get the ratio of gradient values kept by top-k compression.")
+    .def("set_embedding_storage_path", &PSContext::set_embedding_storage_path,
+         "Set the directory storing the embedding tables of parameter servers.")
+    .def("embedding_storage_path", &PSContext::embedding_storage_path,
+         "Get the directory storing the embedding tables of parameter servers.");
 
   (void)py::class_<OpInfoLoaderPy, std::shared_ptr<OpInfoLoaderPy>>(m, "OpInfoLoaderPy")
     .def(py::init())
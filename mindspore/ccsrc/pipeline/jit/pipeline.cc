@@ -52,6 +52,7 @@
 #include "utils/info.h"
 #include "load_mindir/load_model.h"
 #include "pipeline/jit/prim_bprop_optimizer.h"
+#include "pipeline/jit/compile_cache_manager.h"
 #include "runtime/hardware/device_context_manager.h"
 #include "utils/crypto.h"
 
@@ -105,8 +106,6 @@ std::unordered_map<abstract::AbstractBasePtrList, int64_t, abstract::AbstractBas
   g_args_cache;
 
 namespace {
-constexpr char kCompileCacheFilePath[] = "compile_cache.mindir";
-
 std::string GetBaseNameForIR(int64_t stage_idx, const std::string &action_name) {
   std::ostringstream oss;
   int spaces = 2;
@@ -165,32 +164,8 @@ void SetGpuLoopSink(const ResourcePtr &resource) {
   }
 }
 
-void GetCachedFuncGraph(const ResourcePtr &resource, const std::string &queue_name) {
-  MS_EXCEPTION_IF_NULL(resource);
-  auto realpath = Common::GetRealPath(kCompileCacheFilePath);
-  if (!realpath.has_value()) {
-    MS_LOG(EXCEPTION) << "Get real path failed. filename=" << kCompileCacheFilePath;
-  }
-  std::ifstream f(realpath.value());
-  bool cache_file_existed = f.good();
-  f.close();
-  if (!cache_file_existed) {
-    MS_LOG(WARNING) << "The compilation cache file '" << realpath.value()
-                    << "' dose not exist. Execute all the compilation actions.";
-    return;
-  }
-  MS_LOG(INFO) << "Use the compilation cache \"" << realpath.value() << "\" and execute the backend actions only.";
-  FuncGraphPtr fg = mindspore::LoadMindIR(realpath.value());
-  if (fg == nullptr) {
-    MS_LOG(EXCEPTION) << "Failed to load the compilation cache file: " << realpath.value();
-  }
-  FuncGraphManagerPtr mng = fg->manager();
-  if (mng == nullptr) {
-    auto res_mng = resource->manager();
-    MS_EXCEPTION_IF_NULL(res_mng);
-    res_mng->AddFuncGraph(fg);
-    fg->set_manager(res_mng);
-  }
+void SetQueueName(const FuncGraphPtr &fg, const std::string &queue_name) {
+  MS_EXCEPTION_IF_NULL(fg);
   auto cnodes = fg->GetOrderedCnodes();
   for (auto cnode : cnodes) {
     auto prim = GetValueNode<PrimitivePtr>(cnode->input(0));
@@ -199,28 +174,51 @@ void GetCachedFuncGraph(const ResourcePtr &resource, const std::string &queue_na
       break;
     }
   }
-  resource->set_func_graph(fg);
 }
 
-void CacheFuncGraph(const ResourcePtr &resource) {
-  MS_EXCEPTION_IF_NULL(resource);
-  auto realpath = Common::GetRealPath(kCompileCacheFilePath);
-  if (!realpath.has_value()) {
-    MS_LOG(EXCEPTION) << "Get real path failed. filename=" << kCompileCacheFilePath;
-  }
+// The phase without the key of its inputs, which python puts before the phase name.
+std::string GetIncrementalCompileKey(const std::string &phase_s) {
+  auto pos = phase_s.find_first_not_of("0123456789");
+  return pos == std::string::npos ? std::string() : phase_s.substr(pos);
+}
 
-  ChangeFileMode(realpath.value(), S_IRWXU);
-  std::ofstream fout(realpath.value());
-  if (!fout.is_open()) {
-    MS_LOG(EXCEPTION) << "Open cache file '" << realpath.value() << "' failed!";
+bool IsShapeOnlyChange(const AbstractBasePtr &old_arg, const AbstractBasePtr &new_arg) {
+  MS_EXCEPTION_IF_NULL(old_arg);
+  MS_EXCEPTION_IF_NULL(new_arg);
+  if (old_arg->isa<abstract::AbstractSequeue>() && new_arg->isa<abstract::AbstractSequeue>()) {
+    if (old_arg->isa<AbstractTuple>() != new_arg->isa<AbstractTuple>()) {
+      return false;
+    }
+    const auto &old_elements = old_arg->cast<abstract::AbstractSequeuePtr>()->elements();
+    const auto &new_elements = new_arg->cast<abstract::AbstractSequeuePtr>()->elements();
+    return old_elements.size() == new_elements.size() &&
+           std::equal(old_elements.begin(), old_elements.end(), new_elements.begin(), IsShapeOnlyChange);
+  }
+  if (old_arg->isa<AbstractTensor>() && new_arg->isa<AbstractTensor>()) {
+    auto old_tensor = old_arg->cast<AbstractTensorPtr>();
+    auto new_tensor = new_arg->cast<AbstractTensorPtr>();
+    MS_EXCEPTION_IF_NULL(old_tensor->element());
+    MS_EXCEPTION_IF_NULL(new_tensor->element());
+    MS_EXCEPTION_IF_NULL(old_tensor->shape());
+    MS_EXCEPTION_IF_NULL(new_tensor->shape());
+    return *old_tensor->element()->BuildType() == *new_tensor->element()->BuildType() &&
+           old_tensor->shape()->shape().size() == new_tensor->shape()->shape().size();
+  }
+  return *old_arg == *new_arg;
+}
+
+bool IncrementalCompileEnabled(const std::string &phase_s) {
+  if (!MsContext::GetInstance()->get_param<bool>(MS_CTX_ENABLE_INCREMENTAL_COMPILE) ||
+      phase_s.find("export") != std::string::npos) {
+    return false;
   }
-  FuncGraphPtr fg = resource->func_graph();
-  mind_ir::ModelProto fg_model = GetBinaryProto(fg, true);
-  if (!fg_model.SerializeToOstream(&fout)) {
-    MS_LOG(EXCEPTION) << "Failed to cache the graph to file " << realpath.value();
+  MS_EXCEPTION_IF_NULL(parallel::ParallelContext::GetInstance());
+  std::string parallel_mode = parallel::ParallelContext::GetInstance()->parallel_mode();
+  if (parallel_mode != parallel::STAND_ALONE && parallel_mode != parallel::DATA_PARALLEL) {
+    return false;
   }
-  fout.close();
-  ChangeFileMode(realpath.value(), S_IRUSR);
+  // The graph sunk with the dataset captures the queue and the iteration number of the compilation.
+  return ConfigManager::GetInstance().dataset_mode() != DS_SINK_MODE;
 }
 }  // namespace
 
@@ -334,6 +332,15 @@ bool ExecutorPy::HasCompiled(const std::string &phase) const {
   return true;
 }
 
+bool ExecutorPy::IsIncrementalCompiled(const std::string &phase) const {
+  auto iter = info_.find(phase);
+  if (iter == info_.end()) {
+    return false;
+  }
+  MS_EXCEPTION_IF_NULL(iter->second);
+  return iter->second->incremental_compiled;
+}
+
 py::bytes ExecutorPy::GetFuncGraphProto(const std::string &phase, const std::string &ir_type) {
   FuncGraphPtr fg_ptr = GetFuncGraph(phase);
   if (fg_ptr == nullptr) {
@@ -433,6 +440,13 @@ void ExecutorPy::DelNetRes(const std::string &id) {
         flag = true;
       }
     }
+    for (auto iter = incremental_compile_infos_.begin(); iter != incremental_compile_infos_.end();) {
+      if (iter->first.find(id) != string::npos) {
+        iter = incremental_compile_infos_.erase(iter);
+      } else {
+        ++iter;
+      }
+    }
 
     MS_LOG(DEBUG) << "Delete flag:" << flag;
 #ifdef ENABLE_GE
@@ -672,20 +686,6 @@ bool ExecutorPy::CompileInner(const py::object &obj, const py::tuple &args, cons
   MS_LOG(INFO) << "ExecutorPy compile phase:" << phase_s << "!";
   ResourcePtr resource = std::make_shared<Resource>(obj);
 
-  if (MsContext::GetInstance()->get_param<bool>(MS_CTX_LOAD_COMPILE_CACHE)) {
-#ifdef ENABLE_PROFILE
-    double t1 = GetTime();
-#endif
-    GetCachedFuncGraph(resource, queue_name);
-#ifdef ENABLE_PROFILE
-    double t2 = GetTime();
-    MsProfile::StatTime("LoadCachedFuncGraph", t2 - t1);
-#endif
-  }
-
-  auto p_actions = GetPipeline(resource, phase_s, use_vm);
-  std::shared_ptr<Pipeline> pip = std::make_shared<Pipeline>(resource, FilterActions(p_actions, phase_s));
-
   // get the parameters items and add the value to args_spec
   abstract::AbstractBasePtrList args_spec;
   std::size_t size = args.size();
@@ -698,9 +698,24 @@ bool ExecutorPy::CompileInner(const py::object &obj, const py::tuple &args, cons
     args_spec.push_back(ArgsToAbstract(converted));
   }
 
+  InitCompileCache(resource, phase_s, args_spec, queue_name);
+  bool incremental = InitIncrementalCompile(resource, phase_s, args_spec);
+
+  auto p_actions = GetPipeline(resource, phase_s, use_vm);
+  if (incremental) {
+    auto iter = std::find_if(p_actions.begin(), p_actions.end(),
+                             [](const ActionItem &item) { return item.first == "abstract_specialize"; });
+    if (iter != p_actions.end()) {
+      p_actions.erase(p_actions.begin(), iter + 1);
+      (void)p_actions.emplace(p_actions.begin(), "incremental_specialize", IncrementalSpecializeAction);
+    }
+  }
+  std::shared_ptr<Pipeline> pip = std::make_shared<Pipeline>(resource, FilterActions(p_actions, phase_s));
+
   resource->set_args_spec(args_spec);
   executor_info->arg_list_size = size;
   executor_info->resource = resource;
+  executor_info->incremental_compiled = incremental;
   info_[phase_s] = executor_info;
   pip->Run(phase_s);
 
@@ -716,6 +731,85 @@ bool ExecutorPy::CompileInner(const py::object &obj, const py::tuple &args, cons
   return true;
 }
 
+void ExecutorPy::SetCompileCacheDep(const std::string &ms_version, const std::vector<std::string> &dep_files,
+                                    const std::vector<std::string> &net_info) {
+  compile_cache_ms_version_ = ms_version;
+  compile_cache_dep_files_ = dep_files;
+  compile_cache_net_info_ = net_info;
+}
+
+void ExecutorPy::InitCompileCache(const ResourcePtr &resource, const std::string &phase_s,
+                                  const abstract::AbstractBasePtrList &args_spec, const std::string &queue_name) {
+  MS_EXCEPTION_IF_NULL(resource);
+  compile_cache_manager_ = nullptr;
+  auto ms_context = MsContext::GetInstance();
+  bool load_cache = ms_context->get_param<bool>(MS_CTX_LOAD_COMPILE_CACHE);
+  bool save_cache = ms_context->get_param<bool>(MS_CTX_SAVE_COMPILE_CACHE);
+  if (!IsPhaseTrain(phase_s) || (!load_cache && !save_cache)) {
+    return;
+  }
+  compile_cache_manager_ =
+    std::make_shared<CompileCacheManager>(ms_context->get_param<std::string>(MS_CTX_COMPILE_CACHE_PATH),
+                                          compile_cache_ms_version_, compile_cache_dep_files_, compile_cache_net_info_);
+  compile_cache_manager_->InitCompileKey(phase_s, args_spec);
+  if (!load_cache) {
+    return;
+  }
+#ifdef ENABLE_PROFILE
+  double t1 = GetTime();
+#endif
+  auto fg = compile_cache_manager_->LoadFuncGraph(resource->manager());
+  if (fg != nullptr) {
+    SetQueueName(fg, queue_name);
+    resource->set_func_graph(fg);
+  }
+#ifdef ENABLE_PROFILE
+  double t2 = GetTime();
+  MsProfile::StatTime("LoadCachedFuncGraph", t2 - t1);
+#endif
+}
+
+bool ExecutorPy::InitIncrementalCompile(const ResourcePtr &resource, const std::string &phase_s,
+                                        const abstract::AbstractBasePtrList &args_spec) {
+  MS_EXCEPTION_IF_NULL(resource);
+  // The graph loaded from the compile cache is compiled from the backend actions on.
+  if (resource->func_graph() != nullptr || !IncrementalCompileEnabled(phase_s)) {
+    return false;
+  }
+  auto iter = incremental_compile_infos_.find(GetIncrementalCompileKey(phase_s));
+  if (iter == incremental_compile_infos_.end()) {
+    return false;
+  }
+  const auto &info = iter->second;
+  if (info.args_spec.size() != args_spec.size() ||
+      !std::equal(info.args_spec.begin(), info.args_spec.end(), args_spec.begin(), IsShapeOnlyChange)) {
+    MS_LOG(INFO) << "The inputs of phase " << phase_s << " changed more than their shapes, compile it from scratch.";
+    return false;
+  }
+  auto fg = BasicClone(info.specialized_graph);
+  MS_EXCEPTION_IF_NULL(fg);
+  resource->manager()->AddFuncGraph(fg, true);
+  resource->set_func_graph(fg);
+  MS_LOG(INFO) << "Compile phase " << phase_s << " incrementally from the graph specialized before.";
+  return true;
+}
+
+void ExecutorPy::SaveIncrementalCompileInfo(const std::string &phase_s, const ResourcePtr &resource) {
+  MS_EXCEPTION_IF_NULL(resource);
+  if (!IncrementalCompileEnabled(phase_s)) {
+    return;
+  }
+  auto key = GetIncrementalCompileKey(phase_s);
+  MS_EXCEPTION_IF_NULL(resource->engine());
+  if (resource->engine()->shape_as_value()) {
+    MS_LOG(INFO) << "The graph of phase " << phase_s << " reads the shapes of its inputs, it can not be reused.";
+    (void)incremental_compile_infos_.erase(key);
+    return;
+  }
+  MS_EXCEPTION_IF_NULL(resource->func_graph());
+  incremental_compile_infos_[key] = {resource->args_spec(), BasicClone(resource->func_graph())};
+}
+
 std::vector<ActionItem> ExecutorPy::FilterActions(const std::vector<ActionItem> &actions, const std::string &phase) {
   // filter action after validate when 'export'.
   if (GetPhasePrefix(phase).rfind("export", 0) == std::string::npos) {
@@ -795,11 +889,14 @@ bool ExecutorPy::Compile(const py::object &obj, const py::tuple &args, const py:
 }
 
 void CacheValidateFuncGraph(const std::string &phase_s, const ResourcePtr &resource) {
-  if (IsPhaseTrain(phase_s) && MsContext::GetInstance()->get_param<bool>(MS_CTX_SAVE_COMPILE_CACHE)) {
+  MS_EXCEPTION_IF_NULL(resource);
+  auto compile_cache_manager = ExecutorPy::GetInstance()->compile_cache_manager();
+  if (IsPhaseTrain(phase_s) && MsContext::GetInstance()->get_param<bool>(MS_CTX_SAVE_COMPILE_CACHE) &&
+      compile_cache_manager != nullptr) {
 #ifdef ENABLE_PROFILE
     double t1 = GetTime();
 #endif
-    CacheFuncGraph(resource);
+    compile_cache_manager->SaveFuncGraph(resource->func_graph());
 #ifdef ENABLE_PROFILE
     double t2 = GetTime();
     MsProfile::StatTime("SaveCacheFuncGraph", t2 - t1);
@@ -829,6 +926,8 @@ void Pipeline::Run(const std::string &phase_s) {
         SetGpuLoopSink(resource_);
       } else if (action.first == "validate") {
         CacheValidateFuncGraph(phase_s, resource_);
+      } else if (action.first == "abstract_specialize" && result) {
+        ExecutorPy::GetInstance()->SaveIncrementalCompileInfo(phase_s, resource_);
       }
       if (!result) {
         MS_LOG(EXCEPTION) << "Pipeline running to end, failed in step:" << action.first;
@@ -952,6 +1051,8 @@ void ExecutorPy::TerminateDebugger() {
 py::object ExecutorPy::Run(const py::tuple &args, const py::object &phase) {
   // Mindspore debugger notify main thread to exit after one step, and will not run next step
   TerminateDebugger();
+  // The args may be the outputs of the ops recorded by the lazy mode of pynative.
+  pynative::PynativeExecutor::GetInstance()->forward_executor()->FlushLazyOps();
   std::size_t size = args.size();
   if (!py::isinstance<py::str>(phase)) {
     MS_LOG(EXCEPTION) << "Run failed, phase input is not a str";
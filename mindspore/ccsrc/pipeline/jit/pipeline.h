@@ -33,6 +33,7 @@
 #include "vm/segment_runner.h"
 #include "vm/transform.h"
 #include "pipeline/jit/base.h"
+#include "pipeline/jit/compile_cache_manager.h"
 
 namespace mindspore {
 extern const char kMsConvert[];
@@ -43,6 +44,13 @@ namespace pipeline {
 
 namespace py = pybind11;
 
+// The graph specialized by the last compilation of a phase, kept to compile the phase again for inputs of other
+// shapes without parsing and inferring the network from scratch.
+struct IncrementalCompileInfo {
+  abstract::AbstractBasePtrList args_spec;
+  FuncGraphPtr specialized_graph;
+};
+
 class Pipeline {
  public:
   Pipeline(const ResourcePtr &res, const std::vector<ActionItem> &actions) : resource_(res), actions_(actions) {}
@@ -86,6 +94,7 @@ class ExecutorPy : public std::enable_shared_from_this<ExecutorPy> {
   py::bytes GetFuncGraphProto(const std::string &phase, const std::string &type);
   compile::VmEvalFuncPtr GetVmEvalFunc(const std::string &phase);
   bool HasCompiled(const std::string &phase) const;
+  bool IsIncrementalCompiled(const std::string &phase) const;
 
   FuncGraphPtr BuildGraph(const py::dict &init_params, const std::string &phase,
                           const py::object &broadcast_params = {});
@@ -93,6 +102,12 @@ class ExecutorPy : public std::enable_shared_from_this<ExecutorPy> {
                                    const std::unordered_map<std::string, tensor::TensorPtr> &params);
   void RunInitGraph(const py::dict &init_params, const std::string &phase) const;
   void PyExePath(const py::object &phase);
+  // Sets the version of MindSpore and the source files of the network, both are part of the compile cache key.
+  void SetCompileCacheDep(const std::string &ms_version, const std::vector<std::string> &dep_files,
+                          const std::vector<std::string> &net_info);
+  const std::shared_ptr<CompileCacheManager> &compile_cache_manager() const { return compile_cache_manager_; }
+  // Keeps the graph specialized for the phase if the compilation did not depend on the values of the input shapes.
+  void SaveIncrementalCompileInfo(const std::string &phase_s, const ResourcePtr &resource);
   py::dict GetParameterLayout(const std::string &phase);
   py::dict GetCNodeStrategy(const std::string &phase);
   py::list GetParallelParameterNameList(const std::string &phase);
@@ -119,6 +134,13 @@ class ExecutorPy : public std::enable_shared_from_this<ExecutorPy> {
   // filter some pipeline actions according to phase, e.g. when exporting onnx, it is no need to execute actions after
   // 'validate' stage
   static std::vector<ActionItem> FilterActions(const std::vector<ActionItem> &actions, const std::string &phase);
+  // Loads the graph of the compilation from the compile cache when it is enabled and has the entry.
+  void InitCompileCache(const ResourcePtr &resource, const std::string &phase_s,
+                        const abstract::AbstractBasePtrList &args_spec, const std::string &queue_name);
+  // Sets a clone of the graph specialized before as the graph of the resource when the inputs only changed their
+  // shapes since, then the actions up to abstract_specialize are replaced by an incremental specialize.
+  bool InitIncrementalCompile(const ResourcePtr &resource, const std::string &phase_s,
+                              const abstract::AbstractBasePtrList &args_spec);
 
   std::map<std::string, ExecutorInfoPtr> info_;
   static std::shared_ptr<ExecutorPy> executor_;
@@ -127,6 +149,11 @@ class ExecutorPy : public std::enable_shared_from_this<ExecutorPy> {
   std::map<std::string, py::dict> stra_dict_;
   std::string phase_ = "";
   std::map<std::string, size_t> phase_to_num_op_info_;
+  std::string compile_cache_ms_version_;
+  std::vector<std::string> compile_cache_dep_files_;
+  std::vector<std::string> compile_cache_net_info_;
+  std::shared_ptr<CompileCacheManager> compile_cache_manager_{nullptr};
+  std::map<std::string, IncrementalCompileInfo> incremental_compile_infos_;
 };
 using ExecutorPyPtr = std::shared_ptr<ExecutorPy>;
 
@@ -463,6 +463,12 @@ EvaluatorPtr AnalysisEngine::_GetEvaluatorFor(const std::shared_ptr<PrimitiveAbs
   }
   MS_EXCEPTION_IF_NULL(func);
   auto primitive = func->prim();
+  MS_EXCEPTION_IF_NULL(primitive);
+  static const std::unordered_set<std::string> shape_as_value_prims = {
+    prim::kPrimShape->name(), prim::kPrimSize->name(), prim::kPrimArrayLen->name()};
+  if (shape_as_value_prims.count(primitive->name()) != 0) {
+    shape_as_value_ = true;
+  }
   auto evaluator = GetPrimEvaluator(primitive, shared_from_this());
   evaluators_[func] = evaluator;
   return evaluator;
@@ -284,6 +284,9 @@ class AnalysisEngine : public std::enable_shared_from_this<AnalysisEngine> {
 
   void CheckNoStackInSameFuncGraph(const AnfNodeConfigPtr &conf);
   bool enable_recursive_eval() const { return enable_recursive_eval_; }
+  // Whether the analysis has read the shape of a tensor as a value, e.g. by Shape. The specialized graph keeps such
+  // values as constants, so it is only valid for the shapes it was analyzed with.
+  bool shape_as_value() const { return shape_as_value_; }
   static EvalResultPtr ProcessEvalResults(const AbstractBasePtrList &out_specs, const AnfNodePtr &node);
 
  private:
@@ -320,6 +323,7 @@ class AnalysisEngine : public std::enable_shared_from_this<AnalysisEngine> {
                                                      const ConfigPtrList &args_conf_list);
 
   std::atomic_long forward_count_;
+  std::atomic_bool shape_as_value_{false};
 
   bool enable_recursive_eval_;
 
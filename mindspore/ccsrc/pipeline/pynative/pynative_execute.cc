@@ -1683,6 +1683,8 @@ py::object ForwardExecutor::RunOpInVM(const OpExecInfoPtr &op_exec_info, Pynativ
     return std::move(result);
   }
 
+  // The python compute function reads the values of the inputs.
+  lazy_executor_.Flush();
   auto primitive = op_exec_info->py_primitive;
   MS_EXCEPTION_IF_NULL(primitive);
   auto result = primitive->RunPyComputeFunction(op_inputs);
@@ -1722,6 +1724,15 @@ py::object ForwardExecutor::RunOpInMs(const OpExecInfoPtr &op_exec_info, Pynativ
   ConvertAttrToUnifyMindIR(op_exec_info);
   // get graph info for checking it whether existing in the cache
   std::string graph_info = GetSingleOpGraphInfo(op_exec_info, input_tensors, tensors_mask);
+  // The ops are recorded instead of run when no grad graph needs the device addresses of their outputs.
+  if (!grad()->grad_flag() && lazy_executor_.CanRecord(op_exec_info)) {
+    auto result = lazy_executor_.RecordOp(op_exec_info, input_tensors, tensors_mask, graph_info);
+    ms_context->set_param<bool>(MS_CTX_ENABLE_PYNATIVE_INFER, false);
+    *status = PYNATIVE_SUCCESS;
+    MS_LOG(DEBUG) << "End record op [" << op_exec_info->op_name << "] with backend policy ms";
+    return std::move(result);
+  }
+  lazy_executor_.Flush();
 #if defined(__APPLE__)
   session::OpRunInfo op_run_info = {op_exec_info->op_name,
                                     op_exec_info->py_primitive,
@@ -1767,6 +1778,7 @@ py::object ForwardExecutor::RunOpInMs(const OpExecInfoPtr &op_exec_info, Pynativ
 
 void ForwardExecutor::ClearRes() {
   MS_LOG(DEBUG) << "Clear forward res";
+  lazy_executor_.ClearRes();
   prim_abs_list_.clear();
   node_abs_map_.clear();
 }
@@ -2789,6 +2801,7 @@ py::object PynativeExecutor::CheckGraph(const py::object &cell, const py::args &
 }
 
 py::object PynativeExecutor::Run(const py::object &cell, const py::tuple &args) {
+  forward_executor()->FlushLazyOps();
   py::object ret;
   PynativeExecutorTry(grad_executor()->RunGraph, &ret, cell, args);
   return ret;
@@ -2850,11 +2863,13 @@ void PynativeExecutor::GradMsFunction(const py::object &out, const py::args &arg
 
 void PynativeExecutor::GradNet(const prim::GradOperationPtr &grad, const py::object &cell, const py::object &weights,
                                const py::args &args) {
+  forward_executor()->FlushLazyOps();
   py::object *ret = nullptr;
   PynativeExecutorTry(grad_executor()->GradGraph, ret, grad, cell, weights, args);
 }
 
 void PynativeExecutor::Sync() {
+  forward_executor()->FlushLazyOps();
   auto ms_context = MsContext::GetInstance();
   MS_EXCEPTION_IF_NULL(ms_context);
 
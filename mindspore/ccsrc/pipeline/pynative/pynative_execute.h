@@ -39,6 +39,7 @@
 #include "frontend/optimizer/ad/kpynative.h"
 #include "frontend/operator/composite/composite.h"
 #include "pipeline/pynative/pynative_abs_cache.h"
+#include "pipeline/pynative/pynative_lazy_executor.h"
 
 namespace mindspore::pynative {
 namespace py = pybind11;
@@ -301,6 +302,8 @@ class ForwardExecutor {
   std::unordered_map<std::string, abstract::AbstractBasePtr> &node_abs_map() { return node_abs_map_; }
   void ClearRes();
   AnfNodePtr ConstructForwardGraph(const OpExecInfoPtr &op_exec_info);
+  // Runs the ops recorded in lazy mode, before their outputs are read outside of the ops.
+  void FlushLazyOps() { lazy_executor_.Flush(); }
 
  private:
   GradExecutorPtr grad() const;
@@ -331,6 +334,7 @@ class ForwardExecutor {
   GradExecutorWeakPtr grad_executor_;
   PrimAbsCache prim_abs_list_;
   std::unordered_map<std::string, abstract::AbstractBasePtr> node_abs_map_;
+  LazyExecutor lazy_executor_;
 };
 
 class PynativeExecutor : public std::enable_shared_from_this<PynativeExecutor> {
@@ -0,0 +1,388 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/pynative/pynative_lazy_executor.h"
+#include <algorithm>
+#include <exception>
+#include "securec/include/securec.h"
+#include "abstract/abstract_value.h"
+#include "frontend/operator/ops.h"
+#include "pipeline/jit/action.h"
+#include "utils/ms_context.h"
+#include "utils/utils.h"
+#include "vm/transform.h"
+
+namespace mindspore::pynative {
+namespace {
+bool IsStaticTensorAbstract(const AbstractBasePtr &abs) {
+  if (abs == nullptr || !abs->isa<abstract::AbstractTensor>()) {
+    return false;
+  }
+  auto shape = abs->BuildShape();
+  if (shape == nullptr || !shape->isa<abstract::Shape>()) {
+    return false;
+  }
+  const auto &shape_vec = shape->cast<abstract::ShapePtr>()->shape();
+  return std::all_of(shape_vec.begin(), shape_vec.end(), [](int64_t dim) { return dim >= 0; });
+}
+
+bool IsStaticOutputAbstract(const AbstractBasePtr &abs) {
+  if (abs != nullptr && abs->isa<abstract::AbstractTuple>()) {
+    const auto &elements = abs->cast<abstract::AbstractTuplePtr>()->elements();
+    return !elements.empty() && std::all_of(elements.begin(), elements.end(), IsStaticTensorAbstract);
+  }
+  return IsStaticTensorAbstract(abs);
+}
+
+tensor::TensorPtr CreatePendingTensor(const AbstractBasePtr &abs) {
+  MS_EXCEPTION_IF_NULL(abs);
+  auto tensor_abs = abs->cast<abstract::AbstractTensorPtr>();
+  MS_EXCEPTION_IF_NULL(tensor_abs);
+  MS_EXCEPTION_IF_NULL(tensor_abs->element());
+  auto type = tensor_abs->element()->BuildType();
+  MS_EXCEPTION_IF_NULL(type);
+  auto shape = tensor_abs->BuildShape()->cast<abstract::ShapePtr>();
+  MS_EXCEPTION_IF_NULL(shape);
+  return std::make_shared<tensor::Tensor>(type->type_id(), shape->shape());
+}
+
+void FlattenOutputs(const BaseRef &output, std::vector<tensor::TensorPtr> *tensors) {
+  MS_EXCEPTION_IF_NULL(tensors);
+  if (utils::isa<VectorRef>(output)) {
+    auto output_list = utils::cast<VectorRef>(output);
+    for (const auto &item : output_list) {
+      FlattenOutputs(item, tensors);
+    }
+  } else if (utils::isa<tensor::TensorPtr>(output)) {
+    tensors->push_back(utils::cast<tensor::TensorPtr>(output));
+  } else {
+    MS_LOG(EXCEPTION) << "The output of the graph of the recorded ops is not a tensor: " << output.ToString();
+  }
+}
+
+void FillPendingTensor(const tensor::TensorPtr &pending, const tensor::TensorPtr &output) {
+  MS_EXCEPTION_IF_NULL(pending);
+  MS_EXCEPTION_IF_NULL(output);
+  if (pending->data_type() != output->data_type() || pending->Size() != output->Size()) {
+    MS_LOG(EXCEPTION) << "The output " << output->ToString() << " of the graph of the recorded ops mismatches "
+                      << "the inferred shape " << pending->shape() << " and type " << TypeIdLabel(pending->data_type());
+  }
+  // The backend sets new device addresses to the outputs of the graph after every run, so the pending tensor keeps
+  // the device address of the output, which is read by the later ops without a copy and synced when it is read.
+  if (output->device_address() != nullptr) {
+    pending->set_device_address(output->device_address());
+    pending->set_padding_type(output->padding_type());
+    pending->set_sync_status(kNeedSyncDeviceToHost);
+    pending->SetNeedWait(false);
+    return;
+  }
+  if (pending->Size() != 0) {
+    auto ret = memcpy_s(pending->data_c(), pending->Size(), output->data_c(), output->Size());
+    if (ret != EOK) {
+      MS_LOG(EXCEPTION) << "Memcpy the output of the graph of the recorded ops failed, ret: " << ret;
+    }
+  }
+  pending->SetNeedWait(false);
+}
+
+void FailPendingTensors(const std::vector<tensor::TensorPtr> &tensors, const std::exception_ptr &exception) {
+  for (const auto &tensor : tensors) {
+    MS_EXCEPTION_IF_NULL(tensor);
+    if (tensor->NeedWait()) {
+      tensor->SetException(exception);
+    }
+  }
+}
+}  // namespace
+
+bool LazyExecutor::CanRecord(const OpExecInfoPtr &op_exec_info) const {
+  MS_EXCEPTION_IF_NULL(op_exec_info);
+  auto ms_context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(ms_context);
+  if (ms_context->get_param<uint32_t>(MS_CTX_PYNATIVE_LAZY_OP_NUM) == 0 || op_exec_info->is_dynamic_shape) {
+    return false;
+  }
+  const auto &prim = op_exec_info->py_primitive;
+  MS_EXCEPTION_IF_NULL(prim);
+  // The ops with side effects run in order with the others, so they are not recorded.
+  auto effect_info = GetPrimEffectInfo(prim);
+  if (effect_info.memory || effect_info.io) {
+    return false;
+  }
+  return IsStaticOutputAbstract(op_exec_info->abstract);
+}
+
+py::tuple LazyExecutor::RecordOp(const OpExecInfoPtr &op_exec_info, const std::vector<tensor::TensorPtr> &input_tensors,
+                                 const std::vector<int64_t> &tensors_mask, const std::string &graph_info) {
+  MS_EXCEPTION_IF_NULL(op_exec_info);
+  MS_EXCEPTION_IF_NULL(op_exec_info->py_primitive);
+  MS_LOG(DEBUG) << "Record op [" << op_exec_info->op_name << "], recorded op num " << recorded_ops_.size();
+  RecordedOp op;
+  // The attrs of the primitive are updated by every call, so the recorded op keeps a copy of them.
+  op.prim = std::make_shared<Primitive>(*op_exec_info->py_primitive);
+  op.abstract = op_exec_info->abstract;
+  op.graph_info = graph_info;
+  op.inputs = input_tensors;
+  op.tensors_mask = tensors_mask;
+  if (op.abstract->isa<abstract::AbstractTuple>()) {
+    for (const auto &element : op.abstract->cast<abstract::AbstractTuplePtr>()->elements()) {
+      op.outputs.push_back(CreatePendingTensor(element));
+    }
+  } else {
+    op.outputs.push_back(CreatePendingTensor(op.abstract));
+  }
+  py::tuple result(op.outputs.size());
+  for (size_t i = 0; i < op.outputs.size(); ++i) {
+    op.outputs[i]->SetPending([this]() { Flush(); });
+    result[i] = op.outputs[i];
+  }
+  // The recorded ops read their inputs when they run, so an input written in place before, e.g. by assign_value,
+  // runs them first.
+  if (recorded_ops_.empty()) {
+    tensor::Tensor::set_inplace_write_hook([this]() { Flush(); });
+  }
+  recorded_ops_.push_back(std::move(op));
+
+  auto ms_context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(ms_context);
+  if (recorded_ops_.size() >= ms_context->get_param<uint32_t>(MS_CTX_PYNATIVE_LAZY_OP_NUM)) {
+    Flush();
+  }
+  return result;
+}
+
+void LazyExecutor::Flush() {
+  auto exception = RunRecordedOps();
+  if (exception != nullptr) {
+    std::rethrow_exception(exception);
+  }
+}
+
+void LazyExecutor::ClearRes() {
+  MS_LOG(DEBUG) << "Clear lazy executor res";
+  // The res is cleared while another exception is handled or at exit, so the failure of the recorded ops is not
+  // thrown here. It is kept by their outputs and raised when they are read.
+  (void)RunRecordedOps();
+  graph_cache_.clear();
+}
+
+std::exception_ptr LazyExecutor::RunRecordedOps() {
+  if (recorded_ops_.empty()) {
+    return nullptr;
+  }
+  std::vector<RecordedOp> ops;
+  ops.swap(recorded_ops_);
+  tensor::Tensor::set_inplace_write_hook(nullptr);
+  MS_LOG(DEBUG) << "Flush " << ops.size() << " recorded ops";
+  // The pending tensors may be waited with the gil released, e.g. by asnumpy.
+  py::gil_scoped_acquire gil_acquire;
+  auto ms_context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(ms_context);
+  bool enable_pynative_infer = ms_context->get_param<bool>(MS_CTX_ENABLE_PYNATIVE_INFER);
+  ms_context->set_param<bool>(MS_CTX_ENABLE_PYNATIVE_INFER, false);
+  std::exception_ptr exception = nullptr;
+  try {
+    RunGraph(ops);
+  } catch (const std::exception &e) {
+    MS_LOG(DEBUG) << "Run " << ops.size() << " recorded ops failed: " << e.what();
+    exception = std::current_exception();
+    for (const auto &op : ops) {
+      FailPendingTensors(op.outputs, exception);
+    }
+  }
+  ms_context->set_param<bool>(MS_CTX_ENABLE_PYNATIVE_INFER, enable_pynative_infer);
+  return exception;
+}
+
+void LazyExecutor::GetGraphInputs(const std::vector<RecordedOp> &ops, const ProducerMap &producers,
+                                  std::vector<tensor::TensorPtr> *graph_inputs, std::string *graph_key) const {
+  MS_EXCEPTION_IF_NULL(graph_inputs);
+  MS_EXCEPTION_IF_NULL(graph_key);
+  std::unordered_map<const tensor::Tensor *, size_t> input_index;
+  for (const auto &op : ops) {
+    graph_key->append(op.graph_info);
+    graph_key->append("(");
+    for (size_t i = 0; i < op.inputs.size(); ++i) {
+      const auto &input = op.inputs[i];
+      MS_EXCEPTION_IF_NULL(input);
+      if (op.tensors_mask[i] == kValueNodeTensorMask) {
+        // The constants are value nodes of the graph, so their values are a part of the key.
+        graph_key->append(input->ToString());
+      } else if (auto iter = producers.find(input.get()); iter != producers.end()) {
+        graph_key->append("o" + std::to_string(iter->second.first) + "_" + std::to_string(iter->second.second));
+      } else {
+        auto [index_iter, inserted] = input_index.emplace(input.get(), graph_inputs->size());
+        if (inserted) {
+          graph_inputs->push_back(input);
+        }
+        graph_key->append("p" + std::to_string(index_iter->second));
+      }
+      graph_key->append(",");
+    }
+    graph_key->append(")");
+  }
+}
+
+std::vector<LazyExecutor::OutputIndex> LazyExecutor::GetLiveOutputs(const std::vector<RecordedOp> &ops,
+                                                                    const ProducerMap &producers) const {
+  // The recorded ops hold their outputs and the outputs of the former ops they read, the other holders of a pending
+  // tensor are the python objects and the pending tensors read by the ops not recorded yet.
+  std::unordered_map<const tensor::Tensor *, int64_t> recorded_use_count;
+  for (const auto &op : ops) {
+    for (const auto &output : op.outputs) {
+      recorded_use_count[output.get()]++;
+    }
+    for (const auto &input : op.inputs) {
+      if (producers.find(input.get()) != producers.end()) {
+        recorded_use_count[input.get()]++;
+      }
+    }
+  }
+  std::vector<OutputIndex> live_outputs;
+  for (size_t i = 0; i < ops.size(); ++i) {
+    for (size_t j = 0; j < ops[i].outputs.size(); ++j) {
+      const auto &output = ops[i].outputs[j];
+      if (output.use_count() > recorded_use_count[output.get()]) {
+        live_outputs.emplace_back(i, j);
+      }
+    }
+  }
+  return live_outputs;
+}
+
+FuncGraphPtr LazyExecutor::BuildGraph(const std::vector<RecordedOp> &ops, const ProducerMap &producers,
+                                      const std::vector<tensor::TensorPtr> &graph_inputs,
+                                      const std::vector<OutputIndex> &live_outputs) const {
+  auto graph = std::make_shared<FuncGraph>();
+  std::unordered_map<const tensor::Tensor *, AnfNodePtr> input_nodes;
+  for (const auto &input : graph_inputs) {
+    auto param = graph->add_parameter();
+    param->set_abstract(input->ToAbstract()->Broaden());
+    input_nodes[input.get()] = param;
+  }
+
+  std::vector<AnfNodePtrList> op_outputs;
+  for (const auto &op : ops) {
+    AnfNodePtrList inputs{NewValueNode(op.prim)};
+    for (size_t i = 0; i < op.inputs.size(); ++i) {
+      const auto &input = op.inputs[i];
+      if (op.tensors_mask[i] == kValueNodeTensorMask) {
+        auto value_node = NewValueNode(input);
+        value_node->set_abstract(input->ToAbstract());
+        inputs.push_back(value_node);
+      } else if (auto iter = producers.find(input.get()); iter != producers.end()) {
+        inputs.push_back(op_outputs[iter->second.first][iter->second.second]);
+      } else {
+        inputs.push_back(input_nodes.at(input.get()));
+      }
+    }
+    auto cnode = graph->NewCNodeInOrder(inputs);
+    cnode->set_abstract(op.abstract);
+    AnfNodePtrList outputs;
+    if (op.abstract->isa<abstract::AbstractTuple>()) {
+      const auto &elements = op.abstract->cast<abstract::AbstractTuplePtr>()->elements();
+      for (size_t i = 0; i < elements.size(); ++i) {
+        auto index = NewValueNode(SizeToLong(i));
+        index->set_abstract(index->value()->ToAbstract());
+        auto getitem = graph->NewCNode({NewValueNode(prim::kPrimTupleGetItem), cnode, index});
+        getitem->set_abstract(elements[i]);
+        outputs.push_back(getitem);
+      }
+    } else {
+      outputs.push_back(cnode);
+    }
+    op_outputs.push_back(std::move(outputs));
+  }
+  AnfNodePtrList graph_outputs{NewValueNode(prim::kPrimMakeTuple)};
+  AbstractBasePtrList output_abs;
+  for (const auto &[op_index, output_index] : live_outputs) {
+    const auto &output = op_outputs[op_index][output_index];
+    graph_outputs.push_back(output);
+    output_abs.push_back(output->abstract());
+  }
+  auto output = graph->NewCNode(graph_outputs);
+  output->set_abstract(std::make_shared<abstract::AbstractTuple>(output_abs));
+  graph->set_output(output);
+  return graph;
+}
+
+pipeline::ResourcePtr LazyExecutor::CompileGraph(const FuncGraphPtr &graph) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  auto resource = std::make_shared<pipeline::Resource>();
+  resource->set_func_graph(graph);
+  auto manager = resource->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  manager->AddFuncGraph(graph, true);
+  compile::SetMindRTEnable();
+  resource->results()[pipeline::kBackend] = compile::CreateBackend();
+  (void)pipeline::TaskEmitAction(resource);
+  (void)pipeline::ExecuteAction(resource);
+  if (!resource->results()[pipeline::kOutput].is<compile::VmEvalFuncPtr>()) {
+    MS_LOG(EXCEPTION) << "The graph of the recorded ops is not compiled to a VmEvalFuncPtr";
+  }
+  return resource;
+}
+
+void LazyExecutor::RunGraph(const std::vector<RecordedOp> &ops) {
+  ProducerMap producers;
+  for (size_t i = 0; i < ops.size(); ++i) {
+    for (size_t j = 0; j < ops[i].outputs.size(); ++j) {
+      producers[ops[i].outputs[j].get()] = {i, j};
+    }
+  }
+  // The pending tensors only held by the recorded ops are never read, so they are not outputs of the graph and the
+  // backend may reuse their memory.
+  auto live_outputs = GetLiveOutputs(ops, producers);
+  if (live_outputs.empty()) {
+    MS_LOG(DEBUG) << "Skip " << ops.size() << " recorded ops, none of their outputs is used";
+    return;
+  }
+  std::vector<tensor::TensorPtr> graph_inputs;
+  std::string graph_key;
+  GetGraphInputs(ops, producers, &graph_inputs, &graph_key);
+  graph_key.append("->");
+  for (const auto &[op_index, output_index] : live_outputs) {
+    graph_key.append("o" + std::to_string(op_index) + "_" + std::to_string(output_index) + ",");
+  }
+  auto iter = graph_cache_.find(graph_key);
+  if (iter == graph_cache_.end()) {
+    MS_LOG(DEBUG) << "Compile the graph of " << ops.size() << " recorded ops";
+    auto resource = CompileGraph(BuildGraph(ops, producers, graph_inputs, live_outputs));
+    iter = graph_cache_.emplace(graph_key, resource).first;
+  }
+  auto run = iter->second->results()[pipeline::kOutput].cast<compile::VmEvalFuncPtr>();
+  MS_EXCEPTION_IF_NULL(run);
+
+  VectorRef args;
+  for (const auto &input : graph_inputs) {
+    // An input may be the output of the recorded ops of a failed flush, which raises the failure here.
+    if (input->NeedWait()) {
+      input->Wait();
+    }
+    args.push_back(input);
+  }
+  BaseRef value = (*run)(args);
+  std::vector<tensor::TensorPtr> outputs;
+  FlattenOutputs(value, &outputs);
+  if (outputs.size() != live_outputs.size()) {
+    MS_LOG(EXCEPTION) << "The graph of the recorded ops has " << outputs.size() << " outputs, but "
+                      << live_outputs.size() << " are needed";
+  }
+  for (size_t i = 0; i < live_outputs.size(); ++i) {
+    FillPendingTensor(ops[live_outputs[i].first].outputs[live_outputs[i].second], outputs[i]);
+  }
+}
+}  // namespace mindspore::pynative
@@ -0,0 +1,91 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PIPELINE_PYNATIVE_PYNATIVE_LAZY_EXECUTOR_H_
+#define MINDSPORE_CCSRC_PIPELINE_PYNATIVE_PYNATIVE_LAZY_EXECUTOR_H_
+
+#include <exception>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "pybind11/pybind11.h"
+#include "ir/anf.h"
+#include "ir/tensor.h"
+#include "pipeline/jit/resource.h"
+#include "pipeline/pynative/base.h"
+
+namespace mindspore::pynative {
+namespace py = pybind11;
+
+// Records the operators run in PyNative mode into a graph instead of running them one by one. The outputs of the
+// recorded operators are pending tensors, the graph is compiled by the graph backend, or taken from the cache of the
+// graphs of the same operators, and run once a pending tensor is read, an operator that can not be recorded is run,
+// or the number of the recorded operators reaches the limit set by the context.
+class LazyExecutor {
+ public:
+  LazyExecutor() = default;
+  ~LazyExecutor() = default;
+
+  // Whether the operator can be recorded: the lazy mode is on, the operator has no side effect and its outputs are
+  // tensors of known shapes.
+  bool CanRecord(const OpExecInfoPtr &op_exec_info) const;
+  // Records the operator and returns the pending tensors of its outputs, in the layout of the outputs of RunOpInMs.
+  py::tuple RecordOp(const OpExecInfoPtr &op_exec_info, const std::vector<tensor::TensorPtr> &input_tensors,
+                     const std::vector<int64_t> &tensors_mask, const std::string &graph_info);
+  // Runs the recorded operators and fills their outputs. On failure the outputs raise the exception when they are
+  // read, and it is thrown here as well.
+  void Flush();
+  void ClearRes();
+
+ private:
+  struct RecordedOp {
+    PrimitivePtr prim;
+    AbstractBasePtr abstract;
+    std::string graph_info;
+    std::vector<tensor::TensorPtr> inputs;
+    std::vector<int64_t> tensors_mask;
+    std::vector<tensor::TensorPtr> outputs;
+  };
+
+  // The index of an operator in the recorded operators and the index of an output of it.
+  using OutputIndex = std::pair<size_t, size_t>;
+  // The operator and output index producing each pending tensor of the recorded operators.
+  using ProducerMap = std::unordered_map<const tensor::Tensor *, OutputIndex>;
+
+  // Collects the tensors read by the recorded operators but not produced by them, which are the inputs of the graph.
+  // The key identifies the operators and how they are connected.
+  void GetGraphInputs(const std::vector<RecordedOp> &ops, const ProducerMap &producers,
+                      std::vector<tensor::TensorPtr> *graph_inputs, std::string *graph_key) const;
+  // Collects the outputs of the recorded operators still referenced by others than the recorded operators, which are
+  // the outputs of the graph.
+  std::vector<OutputIndex> GetLiveOutputs(const std::vector<RecordedOp> &ops, const ProducerMap &producers) const;
+  FuncGraphPtr BuildGraph(const std::vector<RecordedOp> &ops, const ProducerMap &producers,
+                          const std::vector<tensor::TensorPtr> &graph_inputs,
+                          const std::vector<OutputIndex> &live_outputs) const;
+  pipeline::ResourcePtr CompileGraph(const FuncGraphPtr &graph) const;
+  void RunGraph(const std::vector<RecordedOp> &ops);
+  // Runs the recorded operators and returns the exception of the failure, which is also set to their outputs.
+  std::exception_ptr RunRecordedOps();
+
+  std::vector<RecordedOp> recorded_ops_;
+  std::unordered_map<std::string, pipeline::ResourcePtr> graph_cache_;
+};
+}  // namespace mindspore::pynative
+
+#endif  // MINDSPORE_CCSRC_PIPELINE_PYNATIVE_PYNATIVE_LAZY_EXECUTOR_H_
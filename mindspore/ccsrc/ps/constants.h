@@ -27,6 +27,7 @@
 #include <functional>
 
 #include "ps/core/communicator/request_process_result_code.h"
+#include "ps/embedding_storage.h"
 
 namespace mindspore {
 namespace ps {
@@ -114,7 +115,7 @@ using Key = uint64_t;
 using Keys = std::vector<Key>;
 using Values = std::vector<float>;
 using ValuesPtr = std::shared_ptr<Values>;
-using Weight = std::vector<float>;
+using Weight = std::vector<float, WeightAllocator<float>>;
 using Grad = std::vector<float>;
 using LookupIds = std::vector<Key>;
 using Lengths = std::vector<int>;
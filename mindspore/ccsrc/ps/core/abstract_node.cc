@@ -309,6 +309,52 @@ bool AbstractNode::Send(const NodeRole &node_role, const std::vector<uint32_t> &
   return Wait(request_id, timeout);
 }
 
+bool AbstractNode::Send(const NodeRole &node_role, const std::vector<uint32_t> &rank_ids,
+                        const std::vector<std::vector<MessageSlice>> &slices, const SliceHolder &holder, int command,
+                        std::vector<VectorPtr> *output, const uint32_t &timeout) {
+  if (current_cluster_state_ == ClusterState::NODE_TIMEOUT) {
+    MS_LOG(DEBUG) << "The node is timeout, can not send message.";
+    return false;
+  }
+  if (rank_ids.size() != slices.size()) {
+    MS_LOG(EXCEPTION) << "The number of rank ids and slices should be equal!";
+  }
+  uint64_t request_id = AddMessageTrack(slices.size());
+  size_t size = rank_ids.size();
+
+  if (output != nullptr) {
+    set_message_callback(request_id, [&]() {
+      receive_messages_mutex_.lock();
+      auto res = receive_messages_[request_id];
+      for (size_t it = 0; it < size; ++it) {
+        (*output).push_back(res[rank_ids.at(it)]);
+      }
+      receive_messages_.erase(request_id);
+      receive_messages_mutex_.unlock();
+    });
+  }
+
+  for (size_t it = 0; it < size; ++it) {
+    if (!CommUtil::ValidateRankId(node_role, rank_ids.at(it), worker_num_, server_num_)) {
+      MS_LOG(EXCEPTION) << "The node role or rank_id is illegal, the worker num:" << worker_num_
+                        << ", the server num:" << server_num_ << ", the rank id:" << rank_ids.at(it);
+    }
+
+    auto message_meta = std::make_shared<MessageMeta>();
+    message_meta->set_cmd(NodeCommand::SEND_DATA);
+    message_meta->set_request_id(request_id);
+    message_meta->set_rank_id(node_info_.rank_id_);
+    message_meta->set_role(node_info_.node_role_);
+    message_meta->set_user_cmd(command);
+
+    auto client = GetOrCreateTcpClient(rank_ids.at(it));
+    client->SendMessage(message_meta, Protos::RAW, slices.at(it), holder);
+  }
+  MS_LOG(DEBUG) << "The node role is:" << CommUtil::NodeRoleToString(node_info_.node_role_)
+                << ", the node id is:" << node_info_.node_id_ << " send the request id is:" << request_id;
+  return Wait(request_id, timeout);
+}
+
 uint64_t AbstractNode::CollectiveSendAsync(const NodeRole &node_role, const uint32_t &rank_id, const void *data,
                                            size_t size) {
   MS_EXCEPTION_IF_NULL(data);
@@ -93,6 +93,11 @@ class AbstractNode : public Node {
   bool Send(const NodeRole &node_role, const std::vector<uint32_t> &rank_ids, const std::vector<DataPtr> &data,
             const std::vector<size_t> &data_lens, int command, std::vector<VectorPtr> *output,
             const uint32_t &timeout = kCommTimeoutInSeconds);
+  // Send the body of every message as slices of the caller's memory, the holder keeps that memory alive until it is
+  // written. The responses are collected into output unless it is nullptr.
+  bool Send(const NodeRole &node_role, const std::vector<uint32_t> &rank_ids,
+            const std::vector<std::vector<MessageSlice>> &slices, const SliceHolder &holder, int command,
+            std::vector<VectorPtr> *output = nullptr, const uint32_t &timeout = kCommTimeoutInSeconds);
 
   uint64_t CollectiveSendAsync(const enum NodeRole &node_role, const uint32_t &rank_id, const void *data, size_t size);
   std::pair<uint32_t, uint64_t> CollectiveReceiveAsync(const enum NodeRole &node_role, const uint32_t &rank_id,
@@ -175,6 +175,57 @@ std::string CommUtil::ClusterStateToString(const ClusterState &state) {
   MS_LOG(INFO) << "The cluster state:" << state;
   return kClusterState.at(state);
 }
+
+bool CommUtil::AddSlicesReference(struct evbuffer *buffer, const std::vector<MessageSlice> &slices,
+                                  const SliceHolder &holder) {
+  MS_EXCEPTION_IF_NULL(buffer);
+  for (const auto &slice : slices) {
+    if (slice.size == 0) {
+      continue;
+    }
+    MS_EXCEPTION_IF_NULL(slice.data);
+    // Every reference owns a copy of the holder, so the memory lives until the last slice has left the buffer.
+    auto slice_holder = new SliceHolder(holder);
+    auto cleanup = [](const void *, size_t, void *extra) { delete reinterpret_cast<SliceHolder *>(extra); };
+    if (evbuffer_add_reference(buffer, slice.data, slice.size, cleanup, slice_holder) == -1) {
+      delete slice_holder;
+      MS_LOG(ERROR) << "Event buffer add reference of " << slice.size << " bytes failed!";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CommUtil::SendSlicedMessage(struct bufferevent *buffer_event, const std::shared_ptr<MessageMeta> &meta,
+                                 const Protos &protos, const std::vector<MessageSlice> &slices,
+                                 const SliceHolder &holder) {
+  MS_EXCEPTION_IF_NULL(buffer_event);
+  MS_EXCEPTION_IF_NULL(meta);
+  bufferevent_lock(buffer_event);
+  bool res = true;
+  MessageHeader header;
+  header.message_proto_ = protos;
+  header.message_meta_length_ = SizeToUint(meta->ByteSizeLong());
+  header.message_length_ = SlicesSize(slices) + header.message_meta_length_;
+
+  if (bufferevent_write(buffer_event, &header, sizeof(header)) == -1) {
+    MS_LOG(ERROR) << "Event buffer add header failed!";
+    res = false;
+  }
+  if (bufferevent_write(buffer_event, meta->SerializeAsString().data(), meta->ByteSizeLong()) == -1) {
+    MS_LOG(ERROR) << "Event buffer add protobuf data failed!";
+    res = false;
+  }
+  if (!AddSlicesReference(bufferevent_get_output(buffer_event), slices, holder)) {
+    res = false;
+  }
+  if (bufferevent_flush(buffer_event, EV_READ | EV_WRITE, BEV_FLUSH) < 0) {
+    MS_LOG(ERROR) << "Bufferevent flush failed!";
+    res = false;
+  }
+  bufferevent_unlock(buffer_event);
+  return res;
+}
 }  // namespace core
 }  // namespace ps
 }  // namespace mindspore
@@ -31,6 +31,7 @@
 #endif
 
 #include <event2/buffer.h>
+#include <event2/bufferevent.h>
 #include <event2/event.h>
 #include <event2/http.h>
 #include <event2/keyvalq_struct.h>
@@ -48,12 +49,14 @@
 #include <thread>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <vector>
 
 #include "proto/comm.pb.h"
 #include "proto/ps.pb.h"
 #include "ps/core/cluster_metadata.h"
 #include "ps/core/cluster_config.h"
+#include "ps/core/communicator/message.h"
 #include "utils/log_adapter.h"
 #include "ps/ps_context.h"
 #include "utils/convert_utils_base.h"
@@ -99,6 +102,14 @@ class CommUtil {
   static bool IsFileExists(const std::string &file);
   // Convert cluster state to string when response the http request.
   static std::string ClusterStateToString(const ClusterState &state);
+  // Append the slices to the event buffer by reference, the holder is released once libevent has sent all of them.
+  static bool AddSlicesReference(struct evbuffer *buffer, const std::vector<MessageSlice> &slices,
+                                 const SliceHolder &holder);
+  // Write the header, the meta and the slices of a message to the buffer event and flush it. The slices are sent by
+  // reference as in AddSlicesReference. Returns false if any step fails.
+  static bool SendSlicedMessage(struct bufferevent *buffer_event, const std::shared_ptr<MessageMeta> &meta,
+                                const Protos &protos, const std::vector<MessageSlice> &slices,
+                                const SliceHolder &holder);
 
  private:
   static std::random_device rd;
@@ -19,6 +19,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace mindspore {
 namespace ps {
@@ -43,6 +44,23 @@ struct MessageHeader {
   uint64_t message_length_ = 0;
 };
 
+// A piece of the message body that is sent from the memory of the caller without being copied.
+struct MessageSlice {
+  const void *data = nullptr;
+  size_t size = 0;
+};
+
+// Keeps the memory of the slices alive until the event loop has written them to the socket.
+using SliceHolder = std::shared_ptr<void>;
+
+inline size_t SlicesSize(const std::vector<MessageSlice> &slices) {
+  size_t size = 0;
+  for (const auto &slice : slices) {
+    size += slice.size;
+  }
+  return size;
+}
+
 struct CommandMeta {
   // the command of this message,for example: register,heartbeat,data
   Command cmd;
@@ -342,6 +342,11 @@ bool TcpClient::SendMessage(const std::shared_ptr<MessageMeta> &meta, const Prot
   return res;
 }
 
+bool TcpClient::SendMessage(const std::shared_ptr<MessageMeta> &meta, const Protos &protos,
+                            const std::vector<MessageSlice> &slices, const SliceHolder &holder) {
+  return CommUtil::SendSlicedMessage(buffer_event_, meta, protos, slices, holder);
+}
+
 void TcpClient::StartTimer(const uint32_t &time) {
   MS_EXCEPTION_IF_NULL(event_base_);
   struct event *ev = nullptr;
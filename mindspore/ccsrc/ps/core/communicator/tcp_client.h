@@ -68,6 +68,9 @@ class TcpClient {
   void SetMessageCallback(const OnMessage &cb);
   bool SendMessage(const CommMessage &message) const;
   bool SendMessage(const std::shared_ptr<MessageMeta> &meta, const Protos &protos, const void *data, size_t size);
+  // Send the body slices straight from the caller's memory, which is kept alive by the holder until written.
+  bool SendMessage(const std::shared_ptr<MessageMeta> &meta, const Protos &protos,
+                   const std::vector<MessageSlice> &slices, const SliceHolder &holder);
   void StartTimer(const uint32_t &time);
   void set_timer_callback(const OnTimer &timer);
   const event_base &eventbase() const;
@@ -51,7 +51,11 @@ void TcpMessageHandler::ReceiveMessage(const void *buffer, size_t num) {
             return;
           }
           remaining_length_ = message_header_.message_length_;
-          message_buffer_ = std::make_unique<unsigned char[]>(remaining_length_);
+          // The receive buffer is kept across messages and only grows, so steady traffic does not allocate.
+          if (message_buffer_ == nullptr || message_buffer_capacity_ < remaining_length_) {
+            message_buffer_.reset(new unsigned char[remaining_length_]);
+            message_buffer_capacity_ = remaining_length_;
+          }
           buffer_data += (i + 1);
           break;
         }
@@ -81,8 +85,10 @@ void TcpMessageHandler::ReceiveMessage(const void *buffer, size_t num) {
                             message_buffer_.get() + message_header_.message_meta_length_,
                             message_header_.message_length_ - message_header_.message_meta_length_);
         }
-        message_buffer_.reset();
-        message_buffer_ = nullptr;
+        if (message_buffer_capacity_ > kMaxRetainedBufferSize) {
+          message_buffer_.reset();
+          message_buffer_capacity_ = 0;
+        }
         header_index_ = -1;
         last_copy_len_ = 0;
       }
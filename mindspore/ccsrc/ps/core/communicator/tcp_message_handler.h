@@ -36,11 +36,18 @@ namespace core {
 using messageReceive =
   std::function<void(const std::shared_ptr<MessageMeta> &, const Protos &, const void *, size_t size)>;
 constexpr int kHeaderLen = 16;
+// Receive buffers larger than 64MB are released after each message instead of being kept for the next one.
+constexpr size_t kMaxRetainedBufferSize = 64 << 20;
 
 class TcpMessageHandler {
  public:
   TcpMessageHandler()
-      : is_parsed_(false), message_buffer_(nullptr), remaining_length_(0), header_index_(-1), last_copy_len_(0) {}
+      : is_parsed_(false),
+        message_buffer_(nullptr),
+        message_buffer_capacity_(0),
+        remaining_length_(0),
+        header_index_(-1),
+        last_copy_len_(0) {}
   virtual ~TcpMessageHandler() = default;
 
   void SetCallback(const messageReceive &cb);
@@ -50,6 +57,7 @@ class TcpMessageHandler {
   messageReceive message_callback_;
   bool is_parsed_;
   std::unique_ptr<unsigned char[]> message_buffer_;
+  size_t message_buffer_capacity_;
   size_t remaining_length_;
   unsigned char header_[16]{0};
   int header_index_;
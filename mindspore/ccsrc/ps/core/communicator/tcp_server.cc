@@ -102,6 +102,11 @@ bool TcpConnection::SendMessage(const std::shared_ptr<MessageMeta> &meta, const
   return res;
 }
 
+bool TcpConnection::SendMessage(const std::shared_ptr<MessageMeta> &meta, const Protos &protos,
+                                const std::vector<MessageSlice> &slices, const SliceHolder &holder) const {
+  return CommUtil::SendSlicedMessage(buffer_event_, meta, protos, slices, holder);
+}
+
 TcpServer::TcpServer(const std::string &address, std::uint16_t port)
     : base_(nullptr),
       signal_event_(nullptr),
@@ -455,6 +460,13 @@ bool TcpServer::SendMessage(const std::shared_ptr<TcpConnection> &conn, const st
   return conn->SendMessage(meta, protos, data, size);
 }
 
+bool TcpServer::SendMessage(const std::shared_ptr<TcpConnection> &conn, const std::shared_ptr<MessageMeta> &meta,
+                            const Protos &protos, const std::vector<MessageSlice> &slices, const SliceHolder &holder) {
+  MS_EXCEPTION_IF_NULL(conn);
+  MS_EXCEPTION_IF_NULL(meta);
+  return conn->SendMessage(meta, protos, slices, holder);
+}
+
 void TcpServer::SendMessage(const std::shared_ptr<CommMessage> &message) {
   MS_EXCEPTION_IF_NULL(message);
   std::lock_guard<std::mutex> lock(connection_mutex_);
@@ -60,6 +60,8 @@ class TcpConnection {
   virtual void SendMessage(const void *buffer, size_t num) const;
   bool SendMessage(const std::shared_ptr<CommMessage> &message) const;
   bool SendMessage(const std::shared_ptr<MessageMeta> &meta, const Protos &protos, const void *data, size_t size) const;
+  bool SendMessage(const std::shared_ptr<MessageMeta> &meta, const Protos &protos,
+                   const std::vector<MessageSlice> &slices, const SliceHolder &holder) const;
   virtual void OnReadHandler(const void *buffer, size_t numBytes);
   const TcpServer *GetServer() const;
   const evutil_socket_t &GetFd() const;
@@ -108,6 +110,8 @@ class TcpServer {
   bool SendMessage(const std::shared_ptr<TcpConnection> &conn, const std::shared_ptr<CommMessage> &message);
   bool SendMessage(const std::shared_ptr<TcpConnection> &conn, const std::shared_ptr<MessageMeta> &meta,
                    const Protos &protos, const void *data, size_t sizee);
+  bool SendMessage(const std::shared_ptr<TcpConnection> &conn, const std::shared_ptr<MessageMeta> &meta,
+                   const Protos &protos, const std::vector<MessageSlice> &slices, const SliceHolder &holder);
   void SendMessage(const std::shared_ptr<CommMessage> &message);
   uint16_t BoundPort() const;
   std::string BoundIp() const;
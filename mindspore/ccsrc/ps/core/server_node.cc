@@ -54,6 +54,17 @@ void ServerNode::Response(const std::shared_ptr<TcpConnection> &conn, const std:
   server_->SendMessage(conn, meta, Protos::RAW, data, size);
 }
 
+void ServerNode::Response(const std::shared_ptr<TcpConnection> &conn, const std::shared_ptr<MessageMeta> &meta,
+                          const std::vector<MessageSlice> &slices, const SliceHolder &holder) {
+  MS_EXCEPTION_IF_NULL(conn);
+  MS_EXCEPTION_IF_NULL(meta);
+  meta->set_role(node_info_.node_role_);
+  meta->set_rank_id(node_info_.rank_id_);
+  MS_LOG(DEBUG) << "The node role is:" << CommUtil::NodeRoleToString(node_info_.node_role_)
+                << ", the node id is:" << node_info_.node_id_ << " send the request id is:" << meta->request_id();
+  server_->SendMessage(conn, meta, Protos::RAW, slices, holder);
+}
+
 void ServerNode::CreateTcpServer() {
   std::string interface;
   std::string server_ip;
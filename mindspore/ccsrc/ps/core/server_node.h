@@ -58,6 +58,8 @@ class ServerNode : public AbstractNode {
   void set_handler(const RequestHandler &handler);
   void Response(const std::shared_ptr<TcpConnection> &conn, const std::shared_ptr<MessageMeta> &meta, const void *data,
                 size_t size);
+  void Response(const std::shared_ptr<TcpConnection> &conn, const std::shared_ptr<MessageMeta> &meta,
+                const std::vector<MessageSlice> &slices, const SliceHolder &holder);
 
   std::shared_ptr<CommunicatorBase> GetOrCreateHttpComm(const std::string &ip, uint16_t port,
                                                         const std::shared_ptr<TaskExecutor> &task_executor);
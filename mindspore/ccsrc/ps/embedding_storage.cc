@@ -0,0 +1,140 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/embedding_storage.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <vector>
+
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+namespace {
+size_t PageSize() {
+  static const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  return page_size;
+}
+}  // namespace
+
+EmbeddingTableFile::EmbeddingTableFile(const std::string &dir, size_t row_num, size_t row_size, int64_t first_id)
+    : row_num_(row_num), row_size_(row_size), first_id_(first_id) {
+  if (row_num == 0 || row_size == 0) {
+    MS_LOG(EXCEPTION) << "The embedding table file must hold at least one row of one float, but got " << row_num
+                      << " rows of " << row_size << " floats.";
+  }
+  std::string path = dir + "/ms_embedding_XXXXXX";
+  std::vector<char> path_buf(path.begin(), path.end());
+  path_buf.push_back('\0');
+  fd_ = mkstemp(path_buf.data());
+  if (fd_ < 0) {
+    MS_LOG(EXCEPTION) << "Creating an embedding table file in " << dir << " failed: " << strerror(errno);
+  }
+  // Only the descriptor refers to the file from now on, the disk space is released when it is closed.
+  (void)unlink(path_buf.data());
+
+  size_t file_size = row_num * row_size * sizeof(float);
+  map_size_ = (file_size + PageSize() - 1) / PageSize() * PageSize();
+  if (ftruncate(fd_, static_cast<off_t>(map_size_)) != 0) {
+    (void)close(fd_);
+    MS_LOG(EXCEPTION) << "Resizing the embedding table file to " << map_size_ << " bytes failed: " << strerror(errno);
+  }
+  void *addr = mmap(nullptr, map_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+  if (addr == MAP_FAILED) {
+    (void)close(fd_);
+    MS_LOG(EXCEPTION) << "Mapping the embedding table file of " << map_size_ << " bytes failed: " << strerror(errno);
+  }
+  data_ = static_cast<float *>(addr);
+  // The rows are accessed at random, reading ahead would only load cold rows.
+  (void)madvise(addr, map_size_, MADV_RANDOM);
+  write_back_thread_ = std::thread(&EmbeddingTableFile::WriteBackLoop, this);
+  MS_LOG(INFO) << "Embedding table of " << row_num << " rows of " << row_size << " floats is stored in " << dir;
+}
+
+EmbeddingTableFile::~EmbeddingTableFile() {
+  {
+    std::unique_lock<std::mutex> lock(write_back_mutex_);
+    stopped_ = true;
+  }
+  write_back_cond_.notify_one();
+  if (write_back_thread_.joinable()) {
+    write_back_thread_.join();
+  }
+  if (data_ != nullptr) {
+    (void)munmap(data_, map_size_);
+  }
+  if (fd_ >= 0) {
+    (void)close(fd_);
+  }
+}
+
+size_t EmbeddingTableFile::PrefetchRow(size_t row, size_t last_page) const {
+  size_t page_size = PageSize();
+  size_t row_bytes = row_size_ * sizeof(float);
+  size_t begin = row * row_bytes / page_size;
+  size_t end = ((row + 1) * row_bytes - 1) / page_size;
+  if (begin == last_page) {
+    if (end == last_page) {
+      return last_page;
+    }
+    begin++;
+  }
+  auto addr = reinterpret_cast<char *>(data_) + begin * page_size;
+  (void)madvise(addr, (end - begin + 1) * page_size, MADV_WILLNEED);
+  return end;
+}
+
+void EmbeddingTableFile::WriteBackAsync() {
+  {
+    std::unique_lock<std::mutex> lock(write_back_mutex_);
+    write_back_requested_ = true;
+  }
+  write_back_cond_.notify_one();
+}
+
+void EmbeddingTableFile::WriteBackLoop() {
+  std::unique_lock<std::mutex> lock(write_back_mutex_);
+  while (true) {
+    write_back_cond_.wait(lock, [this]() { return write_back_requested_ || stopped_; });
+    if (stopped_) {
+      return;
+    }
+    write_back_requested_ = false;
+    lock.unlock();
+    // Starting the write back walks the pages of the whole file and may wait for the io queue, so it runs here
+    // instead of under the lock of the table.
+#ifdef __linux__
+    (void)sync_file_range(fd_, 0, 0, SYNC_FILE_RANGE_WRITE);
+#else
+    (void)msync(data_, map_size_, MS_ASYNC);
+#endif
+    lock.lock();
+  }
+}
+
+void CheckFileAllocation(size_t size, size_t file_size) {
+  if (size > file_size) {
+    MS_LOG(EXCEPTION) << "A weight of " << size << " bytes can not be stored in an embedding table file of "
+                      << file_size << " bytes.";
+  }
+}
+}  // namespace ps
+}  // namespace mindspore
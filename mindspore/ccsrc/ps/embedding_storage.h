@@ -0,0 +1,146 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_EMBEDDING_STORAGE_H_
+#define MINDSPORE_CCSRC_PS_EMBEDDING_STORAGE_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace mindspore {
+namespace ps {
+// An embedding table shard kept in a file on local disk and mapped into the memory of the server. The page cache
+// holds the rows in use and the kernel evicts the others under memory pressure, so a server can hold tables larger
+// than its memory while lookups, updates and optimizers keep accessing the table as plain memory.
+// The file is unlinked as soon as it is created, so it never outlives the server.
+class EmbeddingTableFile {
+ public:
+  // Creates a file of row_num rows of row_size floats in dir. The first row holds the embedding of id first_id.
+  EmbeddingTableFile(const std::string &dir, size_t row_num, size_t row_size, int64_t first_id);
+  ~EmbeddingTableFile();
+
+  float *data() const { return data_; }
+  size_t size() const { return row_num_ * row_size_; }
+  size_t row_num() const { return row_num_; }
+  size_t row_size() const { return row_size_; }
+  int64_t first_id() const { return first_id_; }
+
+  // Starts reading the rows of ids[i] - first_id from the disk in the background, so that the following accesses
+  // fault on all of them in parallel instead of one after another. The ids out of the table are skipped.
+  template <typename T>
+  void PrefetchRows(const T *ids, size_t id_num, int64_t first_id) const {
+    size_t last_page = SIZE_MAX;
+    for (size_t i = 0; i < id_num; ++i) {
+      int64_t row = static_cast<int64_t>(ids[i]) - first_id;
+      if (row < 0 || static_cast<size_t>(row) >= row_num_) {
+        continue;
+      }
+      last_page = PrefetchRow(static_cast<size_t>(row), last_page);
+    }
+  }
+
+  // Requests writing the modified rows back to the disk and returns at once. Keeping few dirty pages lets the
+  // kernel evict cold rows without writing them first. The write back runs on a thread of the file, so it never
+  // blocks the caller, and the requests made while it runs are served by one more write back.
+  void WriteBackAsync();
+
+ private:
+  // Returns the last page of the row, the row is not requested again when it starts on last_page.
+  size_t PrefetchRow(size_t row, size_t last_page) const;
+  void WriteBackLoop();
+
+  int fd_{-1};
+  float *data_{nullptr};
+  size_t row_num_{0};
+  size_t row_size_{0};
+  size_t map_size_{0};
+  int64_t first_id_{0};
+
+  std::mutex write_back_mutex_;
+  std::condition_variable write_back_cond_;
+  bool write_back_requested_{false};
+  bool stopped_{false};
+  std::thread write_back_thread_;
+};
+
+// Raises an exception if a weight of size bytes does not fit in a file of file_size bytes.
+void CheckFileAllocation(size_t size, size_t file_size);
+
+// The allocator of weights. It allocates from the heap, or hands out the memory of an embedding table file.
+// Copies of a weight are always allocated from the heap.
+template <typename T>
+class WeightAllocator {
+ public:
+  using value_type = T;
+
+  WeightAllocator() = default;
+  explicit WeightAllocator(const std::shared_ptr<EmbeddingTableFile> &file) : file_(file) {}
+  template <typename U>
+  WeightAllocator(const WeightAllocator<U> &other) : file_(other.file()) {}  // NOLINT
+
+  T *allocate(size_t n) {
+    if (file_ == nullptr) {
+      return std::allocator<T>().allocate(n);
+    }
+    CheckFileAllocation(n * sizeof(T), file_->size() * sizeof(float));
+    return reinterpret_cast<T *>(file_->data());
+  }
+
+  void deallocate(T *p, size_t n) {
+    if (file_ == nullptr) {
+      std::allocator<T>().deallocate(p, n);
+    }
+  }
+
+  // The pages of a new file read as zeros, so value-initializing a weight in a file neither writes nor dirties them.
+  template <typename U>
+  void construct(U *p) {
+    if (file_ == nullptr) {
+      ::new (static_cast<void *>(p)) U();
+    }
+  }
+
+  template <typename U, typename... Args>
+  void construct(U *p, Args &&... args) {
+    ::new (static_cast<void *>(p)) U(std::forward<Args>(args)...);
+  }
+
+  WeightAllocator select_on_container_copy_construction() const { return WeightAllocator(); }
+
+  const std::shared_ptr<EmbeddingTableFile> &file() const { return file_; }
+
+ private:
+  std::shared_ptr<EmbeddingTableFile> file_{nullptr};
+};
+
+template <typename T, typename U>
+bool operator==(const WeightAllocator<T> &a, const WeightAllocator<U> &b) {
+  return a.file() == b.file();
+}
+
+template <typename T, typename U>
+bool operator!=(const WeightAllocator<T> &a, const WeightAllocator<U> &b) {
+  return !(a == b);
+}
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_EMBEDDING_STORAGE_H_
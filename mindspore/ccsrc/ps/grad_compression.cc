@@ -0,0 +1,229 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/grad_compression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <numeric>
+
+#include "base/float16.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+namespace {
+constexpr float kInt8MaxValue = 127.0f;
+
+template <typename T>
+void AppendBytes(const T *data, size_t count, std::vector<unsigned char> *output) {
+  auto bytes = reinterpret_cast<const unsigned char *>(data);
+  (void)output->insert(output->end(), bytes, bytes + count * sizeof(T));
+}
+
+template <typename T>
+bool ReadBytes(const unsigned char *data, size_t size, size_t *pos, T *output, size_t count) {
+  if (size - *pos < count * sizeof(T)) {
+    return false;
+  }
+  if (count > 0) {
+    (void)std::memcpy(output, data + *pos, count * sizeof(T));
+  }
+  *pos += count * sizeof(T);
+  return true;
+}
+
+void EncodeFP16(const float *grad, size_t count, std::vector<unsigned char> *output) {
+  std::vector<float16> halves(count);
+  for (size_t i = 0; i < count; ++i) {
+    halves[i] = float16(grad[i]);
+  }
+  AppendBytes(halves.data(), count, output);
+}
+
+bool DecodeFP16(const unsigned char *data, size_t size, size_t count, float *output, size_t *pos) {
+  std::vector<float16> halves(count);
+  if (!ReadBytes(data, size, pos, halves.data(), count)) {
+    return false;
+  }
+  for (size_t i = 0; i < count; ++i) {
+    output[i] = static_cast<float>(halves[i]);
+  }
+  return true;
+}
+
+void EncodeInt8(const float *grad, size_t count, std::vector<unsigned char> *output) {
+  std::vector<int8_t> quantized(kInt8ChunkSize);
+  for (size_t start = 0; start < count; start += kInt8ChunkSize) {
+    size_t chunk = std::min(kInt8ChunkSize, count - start);
+    float max_abs = 0.0f;
+    for (size_t i = 0; i < chunk; ++i) {
+      max_abs = std::max(max_abs, std::fabs(grad[start + i]));
+    }
+    float scale = max_abs / kInt8MaxValue;
+    float inv_scale = scale > 0.0f ? 1.0f / scale : 0.0f;
+    for (size_t i = 0; i < chunk; ++i) {
+      float value = std::round(grad[start + i] * inv_scale);
+      quantized[i] = static_cast<int8_t>(std::max(-kInt8MaxValue, std::min(kInt8MaxValue, value)));
+    }
+    AppendBytes(&scale, 1, output);
+    AppendBytes(quantized.data(), chunk, output);
+  }
+}
+
+bool DecodeInt8(const unsigned char *data, size_t size, size_t count, float *output, size_t *pos) {
+  std::vector<int8_t> quantized(kInt8ChunkSize);
+  for (size_t start = 0; start < count; start += kInt8ChunkSize) {
+    size_t chunk = std::min(kInt8ChunkSize, count - start);
+    float scale = 0.0f;
+    if (!ReadBytes(data, size, pos, &scale, 1) || !ReadBytes(data, size, pos, quantized.data(), chunk)) {
+      return false;
+    }
+    for (size_t i = 0; i < chunk; ++i) {
+      output[start + i] = scale * quantized[i];
+    }
+  }
+  return true;
+}
+
+void EncodeTopK(const float *grad, size_t count, float topk_ratio, Values *residual,
+                std::vector<unsigned char> *output) {
+  MS_EXCEPTION_IF_NULL(residual);
+  // The residual accumulates what the previous pushes left out, so every gradient component is sent eventually.
+  if (residual->size() != count) {
+    residual->assign(count, 0.0f);
+  }
+  for (size_t i = 0; i < count; ++i) {
+    (*residual)[i] += grad[i];
+  }
+  size_t k = std::min(count, std::max(size_t(1), static_cast<size_t>(std::ceil(topk_ratio * count))));
+  std::vector<uint32_t> indices(count);
+  std::iota(indices.begin(), indices.end(), 0);
+  const auto &acc = *residual;
+  if (k < count) {
+    std::nth_element(indices.begin(), indices.begin() + k, indices.end(),
+                     [&acc](uint32_t a, uint32_t b) { return std::fabs(acc[a]) > std::fabs(acc[b]); });
+    indices.resize(k);
+    std::sort(indices.begin(), indices.end());
+  }
+  std::vector<float> values(k);
+  for (size_t i = 0; i < k; ++i) {
+    values[i] = acc[indices[i]];
+    (*residual)[indices[i]] = 0.0f;
+  }
+  auto k_value = static_cast<uint32_t>(k);
+  AppendBytes(&k_value, 1, output);
+  AppendBytes(indices.data(), k, output);
+  AppendBytes(values.data(), k, output);
+}
+
+bool DecodeTopK(const unsigned char *data, size_t size, size_t count, float *output, size_t *pos) {
+  uint32_t k = 0;
+  if (!ReadBytes(data, size, pos, &k, 1) || k > count) {
+    return false;
+  }
+  std::vector<uint32_t> indices(k);
+  std::vector<float> values(k);
+  if (!ReadBytes(data, size, pos, indices.data(), k) || !ReadBytes(data, size, pos, values.data(), k)) {
+    return false;
+  }
+  std::fill(output, output + count, 0.0f);
+  for (size_t i = 0; i < k; ++i) {
+    if (indices[i] >= count) {
+      return false;
+    }
+    output[indices[i]] = values[i];
+  }
+  return true;
+}
+}  // namespace
+
+GradCodec GradCodecFromName(const std::string &name) {
+  static const std::map<std::string, GradCodec> kNameToCodec = {{kGradCompressionNone, GradCodec::kNone},
+                                                                {kGradCompressionFP16, GradCodec::kFP16},
+                                                                {kGradCompressionInt8, GradCodec::kInt8},
+                                                                {kGradCompressionTopK, GradCodec::kTopK}};
+  auto iter = kNameToCodec.find(name);
+  if (iter == kNameToCodec.end()) {
+    MS_LOG(EXCEPTION) << name << " is invalid. Gradient compression must be " << kGradCompressionNone << ", "
+                      << kGradCompressionFP16 << ", " << kGradCompressionInt8 << " or " << kGradCompressionTopK;
+  }
+  return iter->second;
+}
+
+void EncodeGradient(GradCodec codec, const float *grad, size_t count, float topk_ratio, Values *residual,
+                    std::vector<unsigned char> *output) {
+  MS_EXCEPTION_IF_NULL(output);
+  if (count == 0) {
+    return;
+  }
+  MS_EXCEPTION_IF_NULL(grad);
+  switch (codec) {
+    case GradCodec::kNone:
+      AppendBytes(grad, count, output);
+      break;
+    case GradCodec::kFP16:
+      EncodeFP16(grad, count, output);
+      break;
+    case GradCodec::kInt8:
+      EncodeInt8(grad, count, output);
+      break;
+    case GradCodec::kTopK:
+      EncodeTopK(grad, count, topk_ratio, residual, output);
+      break;
+    default:
+      MS_LOG(EXCEPTION) << "Unknown gradient codec " << static_cast<uint32_t>(codec);
+  }
+}
+
+bool DecodeGradient(GradCodec codec, const unsigned char *data, size_t size, size_t count, float *output,
+                    size_t *consumed) {
+  MS_EXCEPTION_IF_NULL(consumed);
+  *consumed = 0;
+  if (count == 0) {
+    return true;
+  }
+  MS_EXCEPTION_IF_NULL(data);
+  MS_EXCEPTION_IF_NULL(output);
+  bool ret = false;
+  switch (codec) {
+    case GradCodec::kNone:
+      ret = ReadBytes(data, size, consumed, output, count);
+      break;
+    case GradCodec::kFP16:
+      ret = DecodeFP16(data, size, count, output, consumed);
+      break;
+    case GradCodec::kInt8:
+      ret = DecodeInt8(data, size, count, output, consumed);
+      break;
+    case GradCodec::kTopK:
+      ret = DecodeTopK(data, size, count, output, consumed);
+      break;
+    default:
+      MS_LOG(ERROR) << "Unknown gradient codec " << static_cast<uint32_t>(codec);
+      return false;
+  }
+  if (!ret) {
+    MS_LOG(ERROR) << "The " << size << " bytes of encoded data are invalid for " << count
+                  << " values of gradient codec " << static_cast<uint32_t>(codec);
+  }
+  return ret;
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,53 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_GRAD_COMPRESSION_H_
+#define MINDSPORE_CCSRC_PS_GRAD_COMPRESSION_H_
+
+#include <string>
+#include <vector>
+
+#include "ps/constants.h"
+
+namespace mindspore {
+namespace ps {
+// The encodings of the gradients pushed by the workers.
+// kFP16: every value as a half float.
+// kInt8: chunks of kInt8ChunkSize values, each stored as a float scale followed by the values quantized to int8.
+// kTopK: the count k, the indices and the values of the k largest magnitudes, the others are decoded as zero.
+enum class GradCodec : uint32_t { kNone = 0, kFP16 = 1, kInt8 = 2, kTopK = 3 };
+
+constexpr size_t kInt8ChunkSize = 256;
+
+constexpr char kGradCompressionNone[] = "NONE";
+constexpr char kGradCompressionFP16[] = "FP16";
+constexpr char kGradCompressionInt8[] = "INT8";
+constexpr char kGradCompressionTopK[] = "TOP_K";
+
+// Raises an exception if the name is none of the kGradCompression names.
+GradCodec GradCodecFromName(const std::string &name);
+
+// Appends the encoded gradient to output. With kTopK, the residual of the previous push is added to the gradient
+// before selecting the largest values and the part left unsent becomes the new residual.
+void EncodeGradient(GradCodec codec, const float *grad, size_t count, float topk_ratio, Values *residual,
+                    std::vector<unsigned char> *output);
+
+// Decodes count values into output and sets consumed to the number of bytes read, returns false if data is invalid.
+bool DecodeGradient(GradCodec codec, const unsigned char *data, size_t size, size_t count, float *output,
+                    size_t *consumed);
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_GRAD_COMPRESSION_H_
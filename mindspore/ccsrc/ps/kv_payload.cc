@@ -0,0 +1,156 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/kv_payload.h"
+
+#include <limits>
+
+#include "securec/include/securec.h"
+#include "utils/convert_utils_base.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+KVPayload::KVPayload(const KVMessage &message, const core::SliceHolder &values_owner) : values_owner_(values_owner) {
+  *meta_.mutable_keys() = message.keys();
+  *meta_.mutable_len() = message.len();
+  AddValues(message.values().data(), IntToSize(message.values_size()));
+}
+
+void KVPayload::AddValues(const float *values, size_t count) {
+  codecs_.push_back(static_cast<uint32_t>(GradCodec::kNone));
+  if (count == 0) {
+    return;
+  }
+  MS_EXCEPTION_IF_NULL(values);
+  size_t size = count * sizeof(float);
+  values_length_ += size;
+  // Values that continue the previous slice, like consecutive keys owned by the same server, extend it.
+  if (!value_slices_.empty()) {
+    auto &last = value_slices_.back();
+    if (reinterpret_cast<const unsigned char *>(last.data) + last.size == reinterpret_cast<const void *>(values)) {
+      last.size += size;
+      return;
+    }
+  }
+  value_slices_.push_back({values, size});
+}
+
+void KVPayload::AddEncodedValues(GradCodec codec, const std::shared_ptr<std::vector<unsigned char>> &encoded) {
+  MS_EXCEPTION_IF_NULL(encoded);
+  codecs_.push_back(static_cast<uint32_t>(codec));
+  encoded_values_.push_back(encoded);
+  if (encoded->empty()) {
+    return;
+  }
+  values_length_ += encoded->size();
+  value_slices_.push_back({encoded->data(), encoded->size()});
+}
+
+std::vector<core::MessageSlice> KVPayload::Slices() {
+  if (!encoded_values_.empty()) {
+    if (codecs_.size() != IntToSize(meta_.len_size())) {
+      MS_LOG(EXCEPTION) << "The payload has " << codecs_.size() << " value segments but " << meta_.len_size()
+                        << " lengths.";
+    }
+    *meta_.mutable_codecs() = {codecs_.begin(), codecs_.end()};
+  }
+  meta_data_ = meta_.SerializeAsString();
+  header_.meta_length_ = SizeToUint(meta_data_.length());
+  header_.values_length_ = values_length_;
+  std::vector<core::MessageSlice> slices = {{&header_, sizeof(header_)}, {meta_data_.data(), meta_data_.length()}};
+  (void)slices.insert(slices.end(), value_slices_.begin(), value_slices_.end());
+  return slices;
+}
+
+namespace {
+bool DecodeKVPayloadValues(const KVMessage &meta, const unsigned char *data, size_t size, Values *values) {
+  if (meta.codecs_size() != meta.len_size()) {
+    MS_LOG(ERROR) << "The payload has " << meta.codecs_size() << " codecs but " << meta.len_size() << " lengths.";
+    return false;
+  }
+  // The lengths are checked before the values are allocated. A negative length wraps around to a huge one, and the
+  // total must fit in the values of a KVMessage, whose size is an int.
+  const size_t max_count = IntToSize(std::numeric_limits<int>::max());
+  size_t total_count = 0;
+  for (int i = 0; i < meta.len_size(); ++i) {
+    auto len = meta.len(i);
+    if (static_cast<int64_t>(len) < 0 || len > max_count - total_count) {
+      MS_LOG(ERROR) << "The length " << static_cast<int64_t>(len) << " of value segment " << i
+                    << " is negative or makes the values more than " << max_count;
+      return false;
+    }
+    total_count += len;
+  }
+  values->resize(total_count);
+  size_t pos = 0;
+  size_t offset = 0;
+  for (int i = 0; i < meta.len_size(); ++i) {
+    size_t consumed = 0;
+    if (!DecodeGradient(static_cast<GradCodec>(meta.codecs(i)), data + pos, size - pos, meta.len(i),
+                        values->data() + offset, &consumed)) {
+      return false;
+    }
+    pos += consumed;
+    offset += meta.len(i);
+  }
+  if (pos != size) {
+    MS_LOG(ERROR) << "The payload has " << (size - pos) << " bytes left after decoding its values.";
+    return false;
+  }
+  return true;
+}
+}  // namespace
+
+bool ParseKVPayload(const void *data, size_t size, KVMessage *meta, Values *values) {
+  MS_EXCEPTION_IF_NULL(data);
+  MS_EXCEPTION_IF_NULL(meta);
+  MS_EXCEPTION_IF_NULL(values);
+  KVPayloadHeader header;
+  if (size < sizeof(header)) {
+    MS_LOG(ERROR) << "The payload size " << size << " is smaller than its header.";
+    return false;
+  }
+  auto bytes = reinterpret_cast<const unsigned char *>(data);
+  (void)memcpy_s(&header, sizeof(header), bytes, sizeof(header));
+  if (sizeof(header) + header.meta_length_ + header.values_length_ != size) {
+    MS_LOG(ERROR) << "The payload size " << size << " mismatches its header, meta length " << header.meta_length_
+                  << ", values length " << header.values_length_;
+    return false;
+  }
+  if (!meta->ParseFromArray(bytes + sizeof(header), UintToInt(header.meta_length_))) {
+    MS_LOG(ERROR) << "Parse the payload meta failed.";
+    return false;
+  }
+  auto values_data = bytes + sizeof(header) + header.meta_length_;
+  if (meta->codecs_size() > 0) {
+    return DecodeKVPayloadValues(*meta, values_data, header.values_length_, values);
+  }
+  if (header.values_length_ % sizeof(float) != 0) {
+    MS_LOG(ERROR) << "The values length " << header.values_length_ << " is not a multiple of the float size.";
+    return false;
+  }
+  values->resize(header.values_length_ / sizeof(float));
+  if (header.values_length_ > 0) {
+    auto ret = memcpy_s(values->data(), header.values_length_, values_data, header.values_length_);
+    if (ret != EOK) {
+      MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
+    }
+  }
+  return true;
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,80 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_KV_PAYLOAD_H_
+#define MINDSPORE_CCSRC_PS_KV_PAYLOAD_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "proto/ps.pb.h"
+#include "ps/constants.h"
+#include "ps/grad_compression.h"
+#include "ps/core/communicator/message.h"
+
+namespace mindspore {
+namespace ps {
+struct KVPayloadHeader {
+  // The length of the serialized KVMessage that carries the keys and lengths.
+  uint32_t meta_length_ = 0;
+  uint32_t reserved_ = 0;
+  // The length in bytes of the values following the KVMessage, which are encoded if the KVMessage has codecs.
+  uint64_t values_length_ = 0;
+};
+
+// The framed format of the push and pull messages between workers and servers: a KVPayloadHeader, a KVMessage with
+// the keys and lengths only, then the raw float values. The values are never encoded by protobuf, they are sent as
+// slices of the memory they already live in.
+class KVPayload {
+ public:
+  // The owner keeps the memory of the referenced values alive until the payload has been written to the socket.
+  explicit KVPayload(const core::SliceHolder &values_owner = nullptr) : values_owner_(values_owner) {}
+  // Takes the keys and lengths of the message and references its values, the message must be kept by the owner.
+  KVPayload(const KVMessage &message, const core::SliceHolder &values_owner);
+  ~KVPayload() = default;
+
+  void AddKey(const Key &key) { meta_.add_keys(key); }
+  void AddLength(uint64_t length) { meta_.add_len(length); }
+  void AddValues(const float *values, size_t count);
+  // Adds the values of the next len segment as encoded by codec. Once a payload has encoded values, every len segment
+  // must be added by its own AddValues or AddEncodedValues call.
+  void AddEncodedValues(GradCodec codec, const std::shared_ptr<std::vector<unsigned char>> &encoded);
+
+  bool has_keys() const { return meta_.keys_size() > 0; }
+
+  // Serializes the metadata and returns the slices of the whole payload. They point into this object, which must not
+  // be moved or changed until they are sent.
+  std::vector<core::MessageSlice> Slices();
+
+ private:
+  KVMessage meta_;
+  core::SliceHolder values_owner_;
+  std::vector<core::MessageSlice> value_slices_;
+  size_t values_length_{0};
+  // The codec of every AddValues or AddEncodedValues call, and the encoded data kept alive for the slices.
+  std::vector<uint32_t> codecs_;
+  std::vector<std::shared_ptr<std::vector<unsigned char>>> encoded_values_;
+  KVPayloadHeader header_;
+  std::string meta_data_;
+};
+
+// Parses a payload built by KVPayload. The values are copied out since nothing aligns them inside the message, and
+// decoded if they were encoded.
+bool ParseKVPayload(const void *data, size_t size, KVMessage *meta, Values *values);
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_KV_PAYLOAD_H_
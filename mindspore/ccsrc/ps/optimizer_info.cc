@@ -25,6 +25,8 @@ namespace mindspore {
 namespace ps {
 void OptimizerInfo::AddWorkspace(const AddressPtr &workspace) { workspaces_.push_back(workspace); }
 
+void OptimizerInfo::AddState(const WeightPtr &state) { states_.push_back(state); }
+
 const std::vector<AddressPtr> &OptimizerInfo::inputs() const { return inputs_; }
 
 const std::vector<AddressPtr> &OptimizerInfo::workspaces() const { return workspaces_; }
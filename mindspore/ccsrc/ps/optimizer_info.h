@@ -36,6 +36,8 @@ class OptimizerInfo {
                            size_t rank_id) {}
   virtual void Reset() {}
   void AddWorkspace(const AddressPtr &workspace);
+  // Keeps the memory of an optimizer state, e.g. the moments of Adam, alive with the optimizer info.
+  void AddState(const WeightPtr &state);
 
   virtual const AddressPtr &gradient() = 0;
   virtual const AddressPtr &indices() = 0;
@@ -55,6 +57,7 @@ class OptimizerInfo {
   std::vector<AddressPtr> inputs_;
   std::vector<AddressPtr> workspaces_;
   std::vector<AddressPtr> outputs_;
+  std::vector<WeightPtr> states_;
 };
 
 class DenseOptimInfo : public OptimizerInfo {
@@ -19,6 +19,7 @@
 #include <memory>
 #include <functional>
 #include "backend/kernel_compiler/cpu/ps/sparse_apply_ftrl_ps_kernel.h"
+#include "ps/ps_context.h"
 
 namespace mindspore {
 namespace ps {
@@ -108,6 +109,31 @@ AddressPtr OptimizerInfoBuilder::GenInputAddrPtr(const std::string &optim_type,
   return addr_ptr;
 }
 
+AddressPtr OptimizerInfoBuilder::GenStateAddrPtr(const WeightPtr &weight, float init_value,
+                                                 std::vector<WeightPtr> *states) {
+  MS_EXCEPTION_IF_NULL(weight);
+  MS_EXCEPTION_IF_NULL(states);
+  // The state of an embedding table in a file is kept in a file of the same rows, so that it does not hold the memory
+  // the table file saves. A zero state is not filled, the pages of the new file read as zeros.
+  WeightAllocator<float> allocator;
+  const auto &table_file = weight->get_allocator().file();
+  if (table_file != nullptr) {
+    allocator = WeightAllocator<float>(std::make_shared<EmbeddingTableFile>(
+      PSContext::instance()->embedding_storage_path(), table_file->row_num(), table_file->row_size(),
+      table_file->first_id()));
+  }
+  WeightPtr state = (init_value == 0) ? std::make_shared<Weight>(weight->size(), allocator)
+                                      : std::make_shared<Weight>(weight->size(), init_value, allocator);
+  MS_EXCEPTION_IF_NULL(state);
+  states->push_back(state);
+
+  AddressPtr addr_ptr = std::make_shared<kernel::Address>();
+  MS_EXCEPTION_IF_NULL(addr_ptr);
+  addr_ptr->addr = state->data();
+  addr_ptr->size = state->size() * sizeof(float);
+  return addr_ptr;
+}
+
 OptimizerInfo *MomentumOptimInfoBuilder::BuildInputs(const WeightPtr &weight, const Keys &, const Values &values,
                                                      const Lengths &lens, const InputsShapePtr &, size_t,
                                                      const std::shared_ptr<PServerKernel> &, bool) {
@@ -116,23 +142,17 @@ OptimizerInfo *MomentumOptimInfoBuilder::BuildInputs(const WeightPtr &weight, co
   weight_addr->addr = weight->data();
   weight_addr->size = weight->size() * sizeof(float);
 
-  AddressPtr accumulate = std::make_shared<kernel::Address>();
-  MS_EXCEPTION_IF_NULL(accumulate);
-  accumulate->addr = new float[weight->size()];
-  MS_EXCEPTION_IF_NULL(accumulate->addr);
-  accumulate->size = weight->size() * sizeof(float);
-  int64_t ret = memset_s(accumulate->addr, accumulate->size, 0x00, accumulate->size);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "memset_s error, errorno(" << ret << ")";
-    delete[] reinterpret_cast<float *>(accumulate->addr);
-    accumulate->addr = nullptr;
-    return nullptr;
-  }
+  std::vector<WeightPtr> states;
+  AddressPtr accumulate = GenStateAddrPtr(weight, 0, &states);
 
   AddressPtr learning_rate = GenInputAddrPtr<float>(kApplyMomentum, "lr", const_cast<float *>(values.data()), lens);
   AddressPtr gradient = GenInputAddrPtr<float>(kApplyMomentum, "grad", const_cast<float *>(values.data()), lens);
   AddressPtr momentum = GenInputAddrPtr<float>(kApplyMomentum, "momentum", const_cast<float *>(values.data()), lens);
-  return new MomentumOptimInfo(weight_addr, accumulate, learning_rate, gradient, momentum);
+  OptimizerInfo *optim_info = new MomentumOptimInfo(weight_addr, accumulate, learning_rate, gradient, momentum);
+  for (const auto &state : states) {
+    optim_info->AddState(state);
+  }
+  return optim_info;
 }
 
 OptimizerInfo *SparseAdamOptimInfoBuilder::BuildInputs(const WeightPtr &weight, const Keys &, const Values &values,
@@ -143,33 +163,9 @@ OptimizerInfo *SparseAdamOptimInfoBuilder::BuildInputs(const WeightPtr &weight,
   weight_addr->addr = weight->data();
   weight_addr->size = weight->size() * sizeof(float);
 
-  AddressPtr m = std::make_shared<kernel::Address>();
-  MS_EXCEPTION_IF_NULL(m);
-  m->addr = new float[weight->size()];
-  MS_EXCEPTION_IF_NULL(m->addr);
-  m->size = weight->size() * sizeof(float);
-  int64_t ret = memset_s(m->addr, m->size, 0x00, m->size);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "memset_s error, errorno(" << ret << ")";
-    delete[] reinterpret_cast<float *>(m->addr);
-    m->addr = nullptr;
-    return nullptr;
-  }
-
-  AddressPtr v = std::make_shared<kernel::Address>();
-  MS_EXCEPTION_IF_NULL(v);
-  v->addr = new float[weight->size()];
-  MS_EXCEPTION_IF_NULL(v->addr);
-  v->size = weight->size() * sizeof(float);
-  ret = memset_s(v->addr, v->size, 0x00, v->size);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "memset_s error, errorno(" << ret << ")";
-    delete[] reinterpret_cast<float *>(v->addr);
-    v->addr = nullptr;
-    delete[] reinterpret_cast<float *>(m->addr);
-    m->addr = nullptr;
-    return nullptr;
-  }
+  std::vector<WeightPtr> states;
+  AddressPtr m = GenStateAddrPtr(weight, 0, &states);
+  AddressPtr v = GenStateAddrPtr(weight, 0, &states);
 
   AddressPtr beta1_power = GenInputAddrPtr<float>(kSparseAdam, "beta1_power", const_cast<float *>(values.data()), lens);
   AddressPtr beta2_power = GenInputAddrPtr<float>(kSparseAdam, "beta2_power", const_cast<float *>(values.data()), lens);
@@ -180,8 +176,12 @@ OptimizerInfo *SparseAdamOptimInfoBuilder::BuildInputs(const WeightPtr &weight,
   AddressPtr grad = GenInputAddrPtr<float>(kSparseAdam, "grad", const_cast<float *>(values.data()), lens, inputs_shape);
   AddressPtr indices =
     GenInputAddrPtr<float>(kSparseAdam, "indices", const_cast<float *>(values.data()), lens, inputs_shape);
-  return new SparseAdamOptimInfo(weight_addr, m, v, beta1_power, beta2_power, learning_rate, beta1, beta2, epsilon,
-                                 grad, indices, sharded);
+  OptimizerInfo *optim_info = new SparseAdamOptimInfo(weight_addr, m, v, beta1_power, beta2_power, learning_rate,
+                                                      beta1, beta2, epsilon, grad, indices, sharded);
+  for (const auto &state : states) {
+    optim_info->AddState(state);
+  }
+  return optim_info;
 }
 
 OptimizerInfo *SparseFtrlOptimInfoBuilder::BuildInputs(const WeightPtr &weight, const Keys &, const Values &values,
@@ -194,33 +194,20 @@ OptimizerInfo *SparseFtrlOptimInfoBuilder::BuildInputs(const WeightPtr &weight,
   weight_addr->addr = weight->data();
   weight_addr->size = weight->size() * sizeof(float);
 
-  AddressPtr accum = std::make_shared<kernel::Address>();
-  MS_EXCEPTION_IF_NULL(accum);
-  accum->addr = new float[weight->size()];
-  MS_EXCEPTION_IF_NULL(accum->addr);
-  accum->size = weight->size() * sizeof(float);
-  for (size_t i = 0; i < weight->size(); i++) {
-    float *tmp = reinterpret_cast<float *>(accum->addr);
-    tmp[i] = std::dynamic_pointer_cast<SparseApplyFtrlPSKernel>(pserver_kernel)->init_accum();
-  }
-
-  AddressPtr linear = std::make_shared<kernel::Address>();
-  MS_EXCEPTION_IF_NULL(linear);
-  linear->addr = new float[weight->size()];
-  MS_EXCEPTION_IF_NULL(linear->addr);
-  int64_t ret = memset_s(linear->addr, weight->size() * sizeof(float), 0x00, weight->size() * sizeof(float));
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "memset_s error, errorno(" << ret << ")";
-    delete[] reinterpret_cast<float *>(linear->addr);
-    linear->addr = nullptr;
-    return nullptr;
-  }
-  linear->size = weight->size() * sizeof(float);
+  auto ftrl_kernel = std::dynamic_pointer_cast<SparseApplyFtrlPSKernel>(pserver_kernel);
+  MS_EXCEPTION_IF_NULL(ftrl_kernel);
+  std::vector<WeightPtr> states;
+  AddressPtr accum = GenStateAddrPtr(weight, ftrl_kernel->init_accum(), &states);
+  AddressPtr linear = GenStateAddrPtr(weight, 0, &states);
 
   AddressPtr grad = GenInputAddrPtr<float>(kSparseFtrl, "grad", const_cast<float *>(values.data()), lens, inputs_shape);
   AddressPtr indices =
     GenInputAddrPtr<float>(kSparseFtrl, "indices", const_cast<float *>(values.data()), lens, inputs_shape);
-  return new SparseFtrlOptimInfo(weight_addr, accum, linear, grad, indices, sharded);
+  OptimizerInfo *optim_info = new SparseFtrlOptimInfo(weight_addr, accum, linear, grad, indices, sharded);
+  for (const auto &state : states) {
+    optim_info->AddState(state);
+  }
+  return optim_info;
 }
 }  // namespace ps
 }  // namespace mindspore
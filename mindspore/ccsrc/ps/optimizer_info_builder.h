@@ -48,6 +48,8 @@ class OptimizerInfoBuilder {
   template <typename T>
   AddressPtr GenInputAddrPtr(const std::string &optim_type, const std::string &input_name, void *ps_data,
                              const Lengths &lens, const InputsShapePtr &inputs_shape = nullptr);
+  // Allocates an optimizer state of the size of the weight filled with init_value, and appends it to states.
+  AddressPtr GenStateAddrPtr(const WeightPtr &weight, float init_value, std::vector<WeightPtr> *states);
   size_t worker_num_;
 };
 
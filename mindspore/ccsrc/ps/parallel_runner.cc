@@ -0,0 +1,103 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/parallel_runner.h"
+
+namespace mindspore {
+namespace ps {
+ParallelRunner::ParallelRunner(size_t thread_num) {
+  for (size_t i = 1; i < thread_num; i++) {
+    threads_.emplace_back(&ParallelRunner::Loop, this);
+  }
+}
+
+ParallelRunner::~ParallelRunner() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    exit_ = true;
+  }
+  batch_cv_.notify_all();
+  for (auto &thread : threads_) {
+    thread.join();
+  }
+}
+
+void ParallelRunner::Run(size_t task_num, const std::function<void(size_t)> &func) {
+  std::lock_guard<std::mutex> run_lock(run_mutex_);
+  std::exception_ptr exception = nullptr;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // A thread woken up late for the previous batch may still be looking for its tasks.
+    done_cv_.wait(lock, [this] { return running_thread_num_ == 0; });
+    func_ = &func;
+    task_num_ = task_num;
+    next_task_ = 0;
+    exception_ = nullptr;
+    ++batch_id_;
+    ++running_thread_num_;
+  }
+  if (task_num > 1) {
+    batch_cv_.notify_all();
+  }
+  RunTasks();
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    --running_thread_num_;
+    done_cv_.wait(lock, [this] { return running_thread_num_ == 0; });
+    exception = exception_;
+    exception_ = nullptr;
+  }
+  if (exception != nullptr) {
+    std::rethrow_exception(exception);
+  }
+}
+
+void ParallelRunner::Loop() {
+  size_t batch_id = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      batch_cv_.wait(lock, [this, batch_id] { return exit_ || batch_id_ != batch_id; });
+      if (exit_) {
+        return;
+      }
+      batch_id = batch_id_;
+      ++running_thread_num_;
+    }
+    RunTasks();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --running_thread_num_;
+    }
+    done_cv_.notify_all();
+  }
+}
+
+void ParallelRunner::RunTasks() {
+  for (size_t i = next_task_++; i < task_num_; i = next_task_++) {
+    try {
+      (*func_)(i);
+    } catch (const std::exception &) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (exception_ == nullptr) {
+        exception_ = std::current_exception();
+      }
+      next_task_ = task_num_;
+    }
+  }
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,68 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_PARALLEL_RUNNER_H_
+#define MINDSPORE_CCSRC_PS_PARALLEL_RUNNER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mindspore {
+namespace ps {
+// A bounded set of persistent threads which run the tasks of a batch together with the calling thread, so that no
+// thread is created per batch. The parameter server applies the optimizers of different keys with it. The optimizer
+// kernels run common::ThreadPool::SyncRun themselves, which can't be nested, so the tasks can't run on that pool.
+class ParallelRunner {
+ public:
+  // Starts thread_num - 1 threads, the calling thread of Run is the last one.
+  explicit ParallelRunner(size_t thread_num);
+  ~ParallelRunner();
+  ParallelRunner(const ParallelRunner &) = delete;
+  ParallelRunner &operator=(const ParallelRunner &) = delete;
+
+  // Runs func(0), ..., func(task_num - 1) and returns when they are all done. After a task throws, the tasks not
+  // started yet are skipped and the first exception is rethrown. The batches of concurrent calls run one by one.
+  void Run(size_t task_num, const std::function<void(size_t)> &func);
+
+  size_t thread_num() const { return threads_.size() + 1; }
+
+ private:
+  void Loop();
+  // Runs the tasks of the current batch until none is left.
+  void RunTasks();
+
+  std::vector<std::thread> threads_;
+  std::mutex run_mutex_;
+  // mutex_ guards the fields below but next_task_, the batch is only changed when no thread runs its tasks.
+  std::mutex mutex_;
+  std::condition_variable batch_cv_;
+  std::condition_variable done_cv_;
+  const std::function<void(size_t)> *func_{nullptr};
+  size_t task_num_{0};
+  std::atomic<size_t> next_task_{0};
+  size_t batch_id_{0};
+  size_t running_thread_num_{0};
+  std::exception_ptr exception_{nullptr};
+  bool exit_{false};
+};
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_PARALLEL_RUNNER_H_
@@ -44,6 +44,8 @@ void ParameterServer::Run(const FuncGraphPtr &func_graph) {
 bool ParameterServer::Init(const FuncGraphPtr &func_graph) {
   pserver_num_ = std::strtol(mindspore::common::GetEnv(kEnvPServerNum).c_str(), nullptr, 10);
   worker_num_ = std::strtol(mindspore::common::GetEnv(kEnvWorkerNum).c_str(), nullptr, 10);
+  apply_thread_num_ = std::max(1U, std::thread::hardware_concurrency());
+  apply_runner_ = std::make_unique<ParallelRunner>(apply_thread_num_);
   func_graph_ = func_graph;
   handler_.reset(new ServerHandler(this));
   handler_->Init();
@@ -163,7 +165,7 @@ void ParameterServer::InitEmbeddingTable(
   const ParamInitInfo &param_init_info) {
   MS_EXCEPTION_IF_NULL(shapes);
   if (weights_.count(key) == 0) {
-    std::shared_ptr<PServerKernel> lookup =
+    auto lookup =
       std::make_shared<kernel::ps::EmbeddingLookUpPSKernel>(server_node_->rank_id(), pserver_num_, worker_num_);
     lookup->InitKernel(shapes);
     embedding_lookup_ops_[key] = lookup;
@@ -172,7 +174,16 @@ void ParameterServer::InitEmbeddingTable(
     const std::vector<size_t> &input_shapes = lookup->input_sizes();
     size_t total_dims =
       std::accumulate(input_shapes.begin(), input_shapes.end(), IntToSize(1), std::multiplies<size_t>());
-    WeightPtr embedding = std::make_shared<Weight>(total_dims, 0);
+    WeightPtr embedding = nullptr;
+    const std::string &storage_path = PSContext::instance()->embedding_storage_path();
+    if (storage_path.empty() || input_shapes.empty() || input_shapes[0] == 0) {
+      embedding = std::make_shared<Weight>(total_dims, 0);
+    } else {
+      size_t row_num = input_shapes[0];
+      auto table_file =
+        std::make_shared<EmbeddingTableFile>(storage_path, row_num, total_dims / row_num, lookup->offset());
+      embedding = std::make_shared<Weight>(total_dims, WeightAllocator<float>(table_file));
+    }
     MS_EXCEPTION_IF_NULL(embedding);
     float *embedding_data = embedding->data();
     std::default_random_engine engine;
@@ -191,7 +202,7 @@ void ParameterServer::InitEmbeddingTable(
       }
     }
     weights_[key] = embedding;
-    MS_LOG(DEBUG) << "The key:" << key << " the embedding:" << *embedding;
+    MS_LOG(DEBUG) << "The key:" << key << " the embedding size:" << embedding->size();
     tokens_[key] = 0;
     is_embedding_[key] = true;
 
@@ -209,28 +220,29 @@ void ParameterServer::Finalize() {
 void ParameterServer::UpdateWeights() {
   while (true) {
     MS_LOG(INFO) << "The running is:" << running_ << " the ready is:" << this->ReadyForUpdateWeights();
-    std::unique_lock<std::mutex> lock(mutex_);
-    apply_grads_cv_.wait(lock, [this] { return this->ReadyForUpdateWeights() || !running_; });
-    if (!running_) {
-      break;
-    }
-
-    for (auto iter = weights_.begin(); iter != weights_.end(); iter++) {
-      Key key = iter->first;
-      WeightPtr weight_ptr = iter->second;
-
-      std::shared_ptr<PServerKernel> optimizer = nullptr;
-      if (weight_key_to_optims_.count(key) > 0) {
-        optimizer = optimizers_[key];
+    std::vector<ApplyTask> tasks;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      apply_grads_cv_.wait(lock, [this] { return this->ReadyForUpdateWeights() || !running_; });
+      if (!running_) {
+        break;
       }
-      MS_EXCEPTION_IF_NULL(optimizer);
 
-      std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
-      if (optim_info != nullptr) {
-        const std::vector<kernel::AddressPtr> &inputs = optim_info->inputs();
-        const std::vector<kernel::AddressPtr> &workspaces = optim_info->workspaces();
-        const std::vector<kernel::AddressPtr> &outputs = optim_info->outputs();
+      for (auto iter = weights_.begin(); iter != weights_.end(); iter++) {
+        Key key = iter->first;
+        WeightPtr weight_ptr = iter->second;
+        MS_EXCEPTION_IF_NULL(weight_ptr);
 
+        std::shared_ptr<PServerKernel> optimizer = nullptr;
+        if (weight_key_to_optims_.count(key) > 0) {
+          optimizer = optimizers_[key];
+        }
+        MS_EXCEPTION_IF_NULL(optimizer);
+
+        std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
+        if (optim_info == nullptr) {
+          continue;
+        }
         std::vector<std::vector<size_t>> shapes = {};
         std::vector<size_t> indices_shape = {};
         indices_shape.emplace_back(optim_info->indice_size());
@@ -243,19 +255,58 @@ void ParameterServer::UpdateWeights() {
                            return *input_shapes;
                          });
         }
-        optimizer->ReInit(shapes);
-        optim_info->ComputeMean(shapes, worker_num_, pserver_num_, server_node_->rank_id());
-        optimizer->Execute(inputs, workspaces, outputs);
-        optim_info->Reset();
+        tasks.push_back(
+          {key, weight_ptr->size(), optimizer, optim_info, shapes, weight_ptr->get_allocator().file()});
       }
-      if (!is_embedding_[key]) {
-        tokens_[key] = worker_num_;
+    }
+
+    // No push is accepted until the counters are reset below, so the optimizer infos are not touched meanwhile.
+    // Lookups and updates of embedding tables only wait for the optimizer of their own key.
+    ApplyOptimizers(&tasks);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (auto iter = weights_.begin(); iter != weights_.end(); iter++) {
+      if (!is_embedding_[iter->first]) {
+        tokens_[iter->first] = worker_num_;
       }
     }
     ResetGradAccumCount();
   }
 }
 
+void ParameterServer::ApplyOptimizers(std::vector<ApplyTask> *tasks) {
+  MS_EXCEPTION_IF_NULL(tasks);
+  // Start with the largest weights, so that the small ones fill up the threads at the end.
+  std::sort(tasks->begin(), tasks->end(),
+            [](const ApplyTask &a, const ApplyTask &b) { return a.weight_size > b.weight_size; });
+  MS_EXCEPTION_IF_NULL(apply_runner_);
+  apply_runner_->Run(tasks->size(), [this, tasks](size_t i) { ApplyOptimizer(tasks->at(i)); });
+}
+
+void ParameterServer::ApplyOptimizer(const ApplyTask &task) {
+  MS_EXCEPTION_IF_NULL(task.optimizer);
+  MS_EXCEPTION_IF_NULL(task.optim_info);
+  std::unique_lock<std::mutex> lock(key_mutex(task.key));
+  const std::vector<kernel::AddressPtr> &inputs = task.optim_info->inputs();
+  const std::vector<kernel::AddressPtr> &workspaces = task.optim_info->workspaces();
+  const std::vector<kernel::AddressPtr> &outputs = task.optim_info->outputs();
+  task.optimizer->ReInit(task.shapes);
+  task.optim_info->ComputeMean(task.shapes, worker_num_, pserver_num_, server_node_->rank_id());
+  if (task.table_file != nullptr && task.optim_info->IsSparse()) {
+    // The indices of the gradient are the rows of the local shard once the mean is computed.
+    const AddressPtr &indices = task.optim_info->indices();
+    MS_EXCEPTION_IF_NULL(indices);
+    task.table_file->PrefetchRows(reinterpret_cast<const int *>(indices->addr), task.optim_info->indice_size(), 0);
+  }
+  task.optimizer->Execute(inputs, workspaces, outputs);
+  task.optim_info->Reset();
+  if (task.table_file != nullptr) {
+    task.table_file->WriteBackAsync();
+  }
+}
+
+std::mutex &ParameterServer::key_mutex(const Key &key) { return key_mutexes_[key % kKeyLockStripes]; }
+
 void ParameterServer::AccumGrad(const Keys &keys, const Values &values, const Lengths &lengths) {
   std::unique_lock<std::mutex> lock(mutex_);
   const Key &key = keys[0];
@@ -297,28 +348,40 @@ WeightPtr ParameterServer::weight(const Key &key) {
   }
   WeightPtr weight_ptr = weights_[key];
   MS_EXCEPTION_IF_NULL(weight_ptr);
-  WeightPtr copy_weight_ptr = std::make_shared<std::vector<float>>(weight_ptr->size(), 0);
+  WeightPtr copy_weight_ptr = std::make_shared<Weight>(weight_ptr->size(), 0);
   MS_EXCEPTION_IF_NULL(copy_weight_ptr);
   copy_weight_ptr = weight_ptr;
   tokens_[key] -= 1;
   return copy_weight_ptr;
 }
 
-void ParameterServer::DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, KVMessage *res) {
+bool ParameterServer::GetEmbeddingTable(const Key &key, WeightPtr *table_ptr,
+                                        std::shared_ptr<PServerKernel> *table_lookup_op) {
   std::unique_lock<std::mutex> lock(mutex_);
-  MS_EXCEPTION_IF_NULL(res);
   if (weights_.count(key) == 0) {
     MS_LOG(ERROR) << "Invalid embedding table key " << key;
-    return;
+    return false;
   }
   if (embedding_lookup_ops_.count(key) == 0) {
     MS_LOG(ERROR) << "Invalid embedding lookup op key " << key;
+    return false;
+  }
+  *table_ptr = weights_[key];
+  MS_EXCEPTION_IF_NULL(*table_ptr);
+  *table_lookup_op = embedding_lookup_ops_[key];
+  MS_EXCEPTION_IF_NULL(*table_lookup_op);
+  return true;
+}
+
+void ParameterServer::DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, KVMessage *res) {
+  MS_EXCEPTION_IF_NULL(res);
+  WeightPtr table_ptr = nullptr;
+  std::shared_ptr<PServerKernel> table_lookup_op = nullptr;
+  if (!GetEmbeddingTable(key, &table_ptr, &table_lookup_op)) {
     return;
   }
-  WeightPtr table_ptr = weights_[key];
-  MS_EXCEPTION_IF_NULL(table_ptr);
-  std::shared_ptr<PServerKernel> table_lookup_op = embedding_lookup_ops_[key];
-  MS_EXCEPTION_IF_NULL(table_lookup_op);
+  // The lookup op is reinitialized with the shape of every request, so lookups of a table are serialized.
+  std::unique_lock<std::mutex> lock(key_mutex(key));
 
   // Update shapes of lookup operator
   std::vector<std::vector<size_t>> shapes = {};
@@ -338,6 +401,11 @@ void ParameterServer::DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, KV
   embedding_table->addr = table_ptr->data();
   embedding_table->size = table_ptr->size() * sizeof(float);
 
+  const auto &table_file = table_ptr->get_allocator().file();
+  if (table_file != nullptr) {
+    table_file->PrefetchRows(lookup_ids.data(), lookup_ids.size(), table_file->first_id());
+  }
+
   std::unique_ptr<int[]> tmp_ids(new int[lookup_ids.size()]);
   MS_EXCEPTION_IF_NULL(tmp_ids);
   for (size_t i = 0; i < lookup_ids.size(); i++) {
@@ -363,19 +431,20 @@ void ParameterServer::DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, KV
 }
 
 void ParameterServer::UpdateEmbeddings(const Key &key, const LookupIds &lookup_ids, const Values &vals) {
-  if (weights_.count(key) == 0) {
-    MS_LOG(ERROR) << "Invalid embedding table key " << key;
+  WeightPtr table_ptr = nullptr;
+  std::shared_ptr<PServerKernel> table_lookup_op = nullptr;
+  if (!GetEmbeddingTable(key, &table_ptr, &table_lookup_op)) {
     return;
   }
-  if (embedding_lookup_ops_.count(key) == 0) {
-    MS_LOG(ERROR) << "Invalid embedding lookup op key " << key;
-    return;
+  std::unique_lock<std::mutex> lock(key_mutex(key));
+  const auto &table_file = table_ptr->get_allocator().file();
+  if (table_file != nullptr) {
+    table_file->PrefetchRows(lookup_ids.data(), lookup_ids.size(), table_file->first_id());
   }
-  WeightPtr table_ptr = weights_[key];
-  MS_EXCEPTION_IF_NULL(table_ptr);
-  std::shared_ptr<PServerKernel> table_lookup_op = embedding_lookup_ops_[key];
-  MS_EXCEPTION_IF_NULL(table_lookup_op);
   table_lookup_op->UpdateEmbeddings(table_ptr->data(), lookup_ids.data(), vals.data(), lookup_ids.size());
+  if (table_file != nullptr) {
+    table_file->WriteBackAsync();
+  }
 }
 
 inline bool ParameterServer::ReadyForUpdateWeights() const {
@@ -483,13 +552,13 @@ void ParameterServer::ServerHandler::Init() {
   handlers_[kInitWeightToOptimIdCmd] = &ServerHandler::HandleInitWeightToOptimId;
   handlers_[kInitOptimInputsShapeCmd] = &ServerHandler::HandleInitInputsShape;
   handlers_[kInitEmbeddingsCmd] = &ServerHandler::HandleInitEmbeddings;
-  handlers_[kCheckReadyForPushCmd] = &ServerHandler::HandleCheckReadyForPush;
-  handlers_[kCheckReadyForPullCmd] = &ServerHandler::HandleCheckReadyForPull;
   handlers_[kEmbeddingLookupCmd] = &ServerHandler::HandleEmbeddingLookup;
   handlers_[kUpdateEmbeddingsCmd] = &ServerHandler::HandleUpdateEmbeddings;
   handlers_[kFinalizeCmd] = &ServerHandler::HandleFinalize;
   handlers_[kPushCmd] = &ServerHandler::HandlePushReq;
-  handlers_[kPullCmd] = &ServerHandler::HandlePullReq;
+  payload_handlers_[kCheckReadyForPushCmd] = &ServerHandler::HandleCheckReadyForPush;
+  payload_handlers_[kCheckReadyForPullCmd] = &ServerHandler::HandleCheckReadyForPull;
+  payload_handlers_[kPullCmd] = &ServerHandler::HandlePullReq;
   commands_[kInitWeightsCmd] = "kInitWeightsCmd";
   commands_[kInitWeightToOptimIdCmd] = "kInitWeightToOptimIdCmd";
   commands_[kInitOptimInputsShapeCmd] = "kInitOptimInputsShapeCmd";
@@ -512,6 +581,14 @@ void ParameterServer::ServerHandler::operator()(const std::shared_ptr<core::TcpC
   }
   MS_LOG(INFO) << "The command is:" << commands_[meta->user_cmd()];
 
+  auto payload_iter = payload_handlers_.find(meta->user_cmd());
+  if (payload_iter != payload_handlers_.end()) {
+    auto payload = std::make_shared<KVPayload>();
+    (this->*(payload_iter->second))(data, size, payload.get());
+    ps_->server_node_->Response(conn, meta, payload->Slices(), payload);
+    return;
+  }
+
   auto &handler_ptr = handlers_[meta->user_cmd()];
   (this->*handler_ptr)(data, size, output);
   MS_LOG(DEBUG) << "The output size is:" << output->size();
@@ -533,46 +610,45 @@ void ParameterServer::ServerHandler::operator()(const std::shared_ptr<core::TcpC
 void ParameterServer::ServerHandler::HandlePushReq(const DataPtr &data, size_t size, const VectorPtr &res) {
   MS_EXCEPTION_IF_NULL(res);
   KVMessage input;
-  CHECK_RETURN_TYPE(input.ParseFromArray(data.get(), SizeToInt(size)));
+  Values values;
+  CHECK_RETURN_TYPE(ParseKVPayload(data.get(), size, &input, &values));
   Keys keys = {input.keys().begin(), input.keys().end()};
-  Values values = {input.values().begin(), input.values().end()};
   Lengths lens = {input.len().begin(), input.len().end()};
   MS_LOG(DEBUG) << "The keys:" << keys << " the values:" << values << " the len:" << lens;
   ps_->AccumGrad(keys, values, lens);
 }
 
-void ParameterServer::ServerHandler::HandlePullReq(const DataPtr &data, size_t size, const VectorPtr &res) {
+void ParameterServer::ServerHandler::HandlePullReq(const DataPtr &data, size_t size, KVPayload *res) {
   MS_EXCEPTION_IF_NULL(res);
   KVMessage input;
-  CHECK_RETURN_TYPE(input.ParseFromArray(data.get(), SizeToInt(size)));
-  KVMessage res_data;
-  *res_data.mutable_keys() = input.keys();
+  Values unused;
+  CHECK_RETURN_TYPE(ParseKVPayload(data.get(), size, &input, &unused));
   Key key = input.keys()[0];
-  auto weight = ps_->weight(key);
-  *res_data.mutable_values() = {weight->begin(), weight->end()};
-  res->resize(res_data.ByteSizeLong());
-  size_t dest_size = res_data.ByteSizeLong();
-  size_t src_size = res_data.ByteSizeLong();
-  int ret = memcpy_s(res->data(), dest_size, res_data.SerializeAsString().data(), src_size);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
+  // Send a snapshot of the weight, the optimizer may update it while the response is still being written.
+  WeightPtr weight_ptr = ps_->weight(key);
+  auto weight = std::make_shared<Values>(weight_ptr->begin(), weight_ptr->end());
+  *res = KVPayload(weight);
+  for (const auto &input_key : input.keys()) {
+    res->AddKey(input_key);
   }
+  res->AddValues(weight->data(), weight->size());
 }
 
 void ParameterServer::ServerHandler::HandleInitWeights(const DataPtr &data, size_t size, const VectorPtr &res) {
   std::unique_lock<std::mutex> lock(ps_->mutex());
   MS_EXCEPTION_IF_NULL(res);
   KVMessage input;
-  CHECK_RETURN_TYPE(input.ParseFromArray(data.get(), SizeToInt(size)));
+  Values values;
+  CHECK_RETURN_TYPE(ParseKVPayload(data.get(), size, &input, &values));
   int key_num = input.keys_size();
-  const float *data_ptr = input.values().data();
+  const float *data_ptr = values.data();
   size_t pos = 0;
   for (int i = 0; i < key_num; i++) {
     Key key = input.keys()[i];
-    size_t data_len = input.len_size() != key_num ? input.values_size() / key_num : input.len()[i];
+    size_t data_len = input.len_size() != key_num ? values.size() / key_num : input.len()[i];
 
     if (!ps_->HasWeight(key)) {
-      WeightPtr weight_ptr = std::make_shared<std::vector<float>>(data_ptr + pos, data_ptr + (pos + data_len));
+      WeightPtr weight_ptr = std::make_shared<Weight>(data_ptr + pos, data_ptr + (pos + data_len));
       MS_EXCEPTION_IF_NULL(weight_ptr);
       ps_->InitWeight(key, weight_ptr);
 
@@ -588,11 +664,15 @@ void ParameterServer::ServerHandler::HandleInitWeightToOptimId(const DataPtr &da
   std::unique_lock<std::mutex> lock(ps_->mutex());
   MS_EXCEPTION_IF_NULL(res);
   KVMessage input;
-  CHECK_RETURN_TYPE(input.ParseFromArray(data.get(), SizeToInt(size)));
+  Values values;
+  CHECK_RETURN_TYPE(ParseKVPayload(data.get(), size, &input, &values));
   int key_num = input.keys_size();
+  if (values.size() < IntToSize(key_num)) {
+    MS_LOG(EXCEPTION) << "The optimizer ids of " << key_num << " keys are missing, got " << values.size();
+  }
   for (int i = 0; i < key_num; i++) {
     Key key = input.keys()[i];
-    float val = input.values()[i];
+    float val = values[i];
     if (init_weight_to_optim_[key]) {
       continue;
     } else {
@@ -606,7 +686,8 @@ void ParameterServer::ServerHandler::HandleInitInputsShape(const DataPtr &data,
   std::unique_lock<std::mutex> lock(ps_->mutex());
   MS_EXCEPTION_IF_NULL(res);
   KVMessage input;
-  CHECK_RETURN_TYPE(input.ParseFromArray(data.get(), SizeToInt(size)));
+  Values values;
+  CHECK_RETURN_TYPE(ParseKVPayload(data.get(), size, &input, &values));
   const Key &key = input.keys()[0];
   if (init_optim_info_[key]) {
     return;
@@ -614,7 +695,6 @@ void ParameterServer::ServerHandler::HandleInitInputsShape(const DataPtr &data,
     init_optim_info_[key] = true;
   }
   Keys keys = {input.keys().begin(), input.keys().end()};
-  Values values = {input.values().begin(), input.values().end()};
   Lengths lens = {input.len().begin(), input.len().end()};
   ps_->InitOptimInputsShape(keys, values, lens);
 }
@@ -655,41 +735,31 @@ void ParameterServer::ServerHandler::HandleInitEmbeddings(const DataPtr &data, s
   ps_->InitEmbeddingTable(key, shapes, param_init_info);
 }
 
-void ParameterServer::ServerHandler::HandleCheckReadyForPush(const DataPtr &data, size_t size, const VectorPtr &res) {
+void ParameterServer::ServerHandler::HandleCheckReadyForPush(const DataPtr &data, size_t size, KVPayload *res) {
   MS_EXCEPTION_IF_NULL(res);
   KVMessage input;
-  CHECK_RETURN_TYPE(input.ParseFromArray(data.get(), SizeToInt(size)));
+  Values unused;
+  CHECK_RETURN_TYPE(ParseKVPayload(data.get(), size, &input, &unused));
   const Key &key = input.keys()[0];
   bool ready = ps_->ReadyForPush(key);
   MS_LOG(INFO) << "The ready is:" << ready;
-  KVMessage res_data;
-  res_data.add_keys(key);
-  res_data.add_values(ready);
-  res->resize(res_data.ByteSizeLong());
-  size_t dest_size = res_data.ByteSizeLong();
-  size_t src_size = res_data.ByteSizeLong();
-  int ret = memcpy_s(res->data(), dest_size, res_data.SerializeAsString().data(), src_size);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
-  }
+  auto ready_value = std::make_shared<Values>(1, static_cast<float>(ready));
+  *res = KVPayload(ready_value);
+  res->AddKey(key);
+  res->AddValues(ready_value->data(), ready_value->size());
 }
 
-void ParameterServer::ServerHandler::HandleCheckReadyForPull(const DataPtr &data, size_t size, const VectorPtr &res) {
+void ParameterServer::ServerHandler::HandleCheckReadyForPull(const DataPtr &data, size_t size, KVPayload *res) {
   MS_EXCEPTION_IF_NULL(res);
   KVMessage input;
-  CHECK_RETURN_TYPE(input.ParseFromArray(data.get(), SizeToInt(size)));
+  Values unused;
+  CHECK_RETURN_TYPE(ParseKVPayload(data.get(), size, &input, &unused));
   const Key &key = input.keys()[0];
   bool ready = ps_->ReadyForPull(key);
-  KVMessage res_data;
-  res_data.add_keys(key);
-  res_data.add_values(ready);
-  res->resize(res_data.ByteSizeLong());
-  size_t dest_size = res_data.ByteSizeLong();
-  size_t src_size = res_data.ByteSizeLong();
-  int ret = memcpy_s(res->data(), dest_size, res_data.SerializeAsString().data(), src_size);
-  if (ret != 0) {
-    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
-  }
+  auto ready_value = std::make_shared<Values>(1, static_cast<float>(ready));
+  *res = KVPayload(ready_value);
+  res->AddKey(key);
+  res->AddValues(ready_value->data(), ready_value->size());
 }
 
 void ParameterServer::ServerHandler::HandleEmbeddingLookup(const DataPtr &data, size_t size, const VectorPtr &res) {
@@ -714,7 +784,6 @@ void ParameterServer::ServerHandler::HandleEmbeddingLookup(const DataPtr &data,
 }
 
 void ParameterServer::ServerHandler::HandleUpdateEmbeddings(const DataPtr &data, size_t size, const VectorPtr &res) {
-  std::unique_lock<std::mutex> lock(ps_->mutex());
   MS_EXCEPTION_IF_NULL(res);
   KVMessage input;
   CHECK_RETURN_TYPE(input.ParseFromArray(data.get(), SizeToInt(size)));
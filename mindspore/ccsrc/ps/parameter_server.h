@@ -33,6 +33,7 @@
 #include <map>
 #include <functional>
 #include <algorithm>
+#include <array>
 
 #include "ir/func_graph.h"
 #include "backend/session/session_basic.h"
@@ -57,6 +58,8 @@
 #include "ps/constants.h"
 #include "ps/util.h"
 #include "ps/embedding_table_shard_metadata.h"
+#include "ps/kv_payload.h"
+#include "ps/parallel_runner.h"
 #include "utils/log_adapter.h"
 #include "proto/comm.pb.h"
 #include "proto/ps.pb.h"
@@ -65,6 +68,10 @@
 
 namespace mindspore {
 namespace ps {
+// The number of locks the keys are spread over. Optimizers, lookups and updates of keys on different locks run
+// concurrently.
+constexpr size_t kKeyLockStripes = 64;
+
 class ParameterServer {
  public:
   static ParameterServer &GetInstance() {
@@ -83,6 +90,7 @@ class ParameterServer {
         func_graph_(nullptr),
         sess_(nullptr),
         running_(true),
+        apply_thread_num_(1),
         thread_(nullptr),
         server_node_(nullptr) {}
   ~ParameterServer() = default;
@@ -97,13 +105,13 @@ class ParameterServer {
     void operator()(const std::shared_ptr<core::TcpConnection> &conn, const std::shared_ptr<core::MessageMeta> &meta,
                     const DataPtr &data, size_t size);
     void HandlePushReq(const DataPtr &data, size_t size, const VectorPtr &res);
-    void HandlePullReq(const DataPtr &data, size_t size, const VectorPtr &res);
+    void HandlePullReq(const DataPtr &data, size_t size, KVPayload *res);
     void HandleInitWeights(const DataPtr &data, size_t size, const VectorPtr &res);
     void HandleInitWeightToOptimId(const DataPtr &data, size_t size, const VectorPtr &res);
     void HandleInitInputsShape(const DataPtr &data, size_t size, const VectorPtr &res);
     void HandleInitEmbeddings(const DataPtr &data, size_t size, const VectorPtr &res);
-    void HandleCheckReadyForPush(const DataPtr &data, size_t size, const VectorPtr &res);
-    void HandleCheckReadyForPull(const DataPtr &data, size_t size, const VectorPtr &res);
+    void HandleCheckReadyForPush(const DataPtr &data, size_t size, KVPayload *res);
+    void HandleCheckReadyForPull(const DataPtr &data, size_t size, KVPayload *res);
     void HandleEmbeddingLookup(const DataPtr &data, size_t size, const VectorPtr &res);
     void HandleUpdateEmbeddings(const DataPtr &data, size_t size, const VectorPtr &res);
     void HandleFinalize(const DataPtr &data, size_t size, const VectorPtr &res);
@@ -112,6 +120,9 @@ class ParameterServer {
     ParameterServer *ps_;
     typedef void (ServerHandler::*RequestHandler)(const DataPtr &data, size_t size, const VectorPtr &res);
     std::unordered_map<int, RequestHandler> handlers_;
+    // The handlers answering with a KVPayload, which is sent from the memory of the response values.
+    typedef void (ServerHandler::*PayloadHandler)(const DataPtr &data, size_t size, KVPayload *res);
+    std::unordered_map<int, PayloadHandler> payload_handlers_;
     std::unordered_map<int, std::string> commands_;
     std::unordered_map<Key, bool> init_weights_;
     std::unordered_map<Key, bool> init_weight_to_optim_;
@@ -130,8 +141,22 @@ class ParameterServer {
   bool HasWeight(const Key &key);
   void Finalize();
   void UpdateWeights();
+  // The optimizer of one key, collected under mutex_ and executed under the lock of the key only.
+  struct ApplyTask {
+    Key key;
+    size_t weight_size;
+    std::shared_ptr<PServerKernel> optimizer;
+    std::shared_ptr<OptimizerInfo> optim_info;
+    std::vector<std::vector<size_t>> shapes;
+    // The file of the weight if it is an embedding table stored on disk.
+    std::shared_ptr<EmbeddingTableFile> table_file;
+  };
+  void ApplyOptimizers(std::vector<ApplyTask> *tasks);
+  void ApplyOptimizer(const ApplyTask &task);
+  std::mutex &key_mutex(const Key &key);
   void AccumGrad(const Keys &key, const Values &values, const Lengths &lengths);
   WeightPtr weight(const Key &key);
+  bool GetEmbeddingTable(const Key &key, WeightPtr *table_ptr, std::shared_ptr<PServerKernel> *table_lookup_op);
   void DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, KVMessage *res);
   void UpdateEmbeddings(const Key &key, const LookupIds &lookup_ids, const Values &vals);
   inline bool ReadyForUpdateWeights() const;
@@ -150,6 +175,9 @@ class ParameterServer {
   FuncGraphPtr func_graph_;
   std::shared_ptr<session::SessionBasic> sess_;
   bool running_;
+  size_t apply_thread_num_;
+  // The threads applying the optimizers of the keys in parallel.
+  std::unique_ptr<ParallelRunner> apply_runner_;
 
   std::unordered_map<Key, std::shared_ptr<PServerKernel>> optimizers_;
   std::unordered_map<Key, InputsShapePtr> optim_inputs_shape_;
@@ -160,12 +188,15 @@ class ParameterServer {
   std::unordered_map<Key, std::string> weight_key_to_optim_op_;
   std::unordered_map<Key, WeightPtr> weights_;
   std::unordered_map<Key, bool> is_embedding_;
-  std::unordered_map<Key, WeightPtr> grads_;
+  std::unordered_map<Key, GradPtr> grads_;
   std::unordered_map<Key, size_t> grads_accum_counter_;
   std::unordered_map<Key, std::shared_ptr<PServerKernel>> embedding_lookup_ops_;
   std::unordered_map<Key, uint64_t> tokens_;
 
+  // mutex_ guards the maps and counters of the server, key_mutexes_ guard the weights and kernels of the keys.
+  // When both are needed, mutex_ is released before taking the lock of a key.
   std::mutex mutex_;
+  std::array<std::mutex, kKeyLockStripes> key_mutexes_;
   std::condition_variable apply_grads_cv_;
 
   std::unique_ptr<std::thread> thread_;
@@ -32,7 +32,7 @@ int EmbeddingHashMap::ParseData(const int id, int *const swap_out_index, int *co
 
   if (!need_swap) {
     hash_count_++;
-    (void)hash_id_to_index_.emplace(id, hash_index);
+    hash_id_to_index_.Insert(id, hash_index);
     hash_map_elements_[hash_index].set_id(id);
     hash_map_elements_[hash_index].set_step(data_step);
     return hash_index;
@@ -41,8 +41,8 @@ int EmbeddingHashMap::ParseData(const int id, int *const swap_out_index, int *co
   swap_out_index[*swap_out_size] = hash_index;
   swap_out_ids[*swap_out_size] = hash_map_elements_[hash_index].id_;
   (*swap_out_size)++;
-  (void)hash_id_to_index_.erase(hash_map_elements_[hash_index].id_);
-  (void)hash_id_to_index_.emplace(id, hash_index);
+  (void)hash_id_to_index_.Erase(hash_map_elements_[hash_index].id_);
+  hash_id_to_index_.Insert(id, hash_index);
   hash_map_elements_[hash_index].set_id(id);
   hash_map_elements_[hash_index].set_step(data_step);
   return hash_index;
@@ -85,9 +85,8 @@ int EmbeddingHashMap::FindInsertionPos(const size_t, const size_t graph_running_
 void EmbeddingHashMap::DumpHashMap() {
   MS_LOG(INFO) << "Dump hash map info begin, hash_capacity: " << hash_capacity_ << " hash_count: " << hash_count_;
   MS_LOG(INFO) << "Dump hash_id_to_index: ";
-  for (auto iter = hash_id_to_index_.begin(); iter != hash_id_to_index_.end(); ++iter) {
-    MS_LOG(INFO) << "  id: " << iter->first << " index: " << iter->second;
-  }
+  hash_id_to_index_.ForEach(
+    [](int64_t id, int index) { MS_LOG(INFO) << "  id: " << id << " index: " << index; });
   MS_LOG(INFO) << "Dump hash_map_unit: ";
   for (size_t i = 0; i < hash_map_elements_.size(); i++) {
     if (!hash_map_elements_[i].IsEmpty()) {
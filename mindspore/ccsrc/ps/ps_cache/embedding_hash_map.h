@@ -21,7 +21,7 @@
 #include <utility>
 #include <memory>
 #include <vector>
-#include <unordered_map>
+#include "ps/ps_cache/embedding_id_map.h"
 #include "utils/convert_utils_base.h"
 
 namespace mindspore {
@@ -49,6 +49,7 @@ class EmbeddingHashMap {
         current_batch_start_pos_(0),
         graph_running_index_num_(0),
         graph_running_index_pos_(0),
+        hash_id_to_index_(hash_capacity),
         expired_element_full_(false) {
     hash_map_elements_.resize(hash_capacity);
     // In multi-device mode, embedding table are distributed on different devices by ID interval,
@@ -63,7 +64,7 @@ class EmbeddingHashMap {
                 const size_t graph_running_step, size_t *const swap_out_size, bool *const need_wait_graph);
   size_t hash_step(const int hash_index) const { return hash_map_elements_[hash_index].step_; }
   void set_hash_step(const int hash_index, const size_t step) { hash_map_elements_[hash_index].set_step(step); }
-  const std::unordered_map<int, int> &hash_id_to_index() const { return hash_id_to_index_; }
+  const EmbeddingIdMap &hash_id_to_index() const { return hash_id_to_index_; }
   size_t hash_capacity() const { return hash_capacity_; }
   void DumpHashMap();
   void Reset();
@@ -74,12 +75,12 @@ class EmbeddingHashMap {
   size_t hash_count_;
   size_t hash_capacity_;
   std::vector<HashMapElement> hash_map_elements_;
-  std::unordered_map<int, int> hash_id_to_index_;
   size_t current_pos_;
   size_t current_batch_start_pos_;
   size_t graph_running_index_num_;
   size_t graph_running_index_pos_;
   std::unique_ptr<int[]> graph_running_index_;
+  EmbeddingIdMap hash_id_to_index_;
   bool expired_element_full_;
 };
 }  // namespace ps
@@ -0,0 +1,157 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/ps_cache/embedding_id_map.h"
+#include <algorithm>
+#include <cstring>
+#include "ps/ps_cache/embedding_hash_map.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+namespace {
+constexpr uint64_t kHashMultiplier = 0x9E3779B97F4A7C15ULL;
+constexpr uint64_t kLowBytes = 0x0101010101010101ULL;
+constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+constexpr uint8_t kCtrlMask = 0x7F;
+constexpr size_t kHashBits = 64;
+constexpr size_t kBitsPerByte = 8;
+constexpr size_t kMinSlotNum = 16;
+
+// Returns the high bit of every byte of group equal to value, with a rare false positive next to a real match.
+inline uint64_t MatchByte(uint64_t group, uint8_t value) {
+  uint64_t x = group ^ (kLowBytes * value);
+  return (x - kLowBytes) & ~x & kHighBits;
+}
+
+inline size_t LowestByte(uint64_t mask) { return static_cast<size_t>(__builtin_ctzll(mask)) / kBitsPerByte; }
+}  // namespace
+
+EmbeddingIdMap::EmbeddingIdMap(size_t capacity) : capacity_(capacity), slot_num_(kMinSlotNum), size_(0) {
+  // At most half of the slots are used, which keeps the probe chains short.
+  while (slot_num_ < capacity * 2) {
+    slot_num_ *= 2;
+  }
+  size_t bits = 0;
+  while ((size_t(1) << bits) < slot_num_) {
+    ++bits;
+  }
+  hash_shift_ = kHashBits - bits;
+  ctrl_ = std::make_unique<uint8_t[]>(slot_num_ + kGroupSize);
+  ids_ = std::make_unique<int64_t[]>(slot_num_);
+  indices_ = std::make_unique<int[]>(slot_num_);
+  Clear();
+}
+
+uint64_t EmbeddingIdMap::Hash(int64_t id) const {
+  uint64_t hash = static_cast<uint64_t>(id) * kHashMultiplier;
+  return hash ^ (hash >> (kHashBits / 2));
+}
+
+uint64_t EmbeddingIdMap::LoadGroup(size_t slot) const {
+  uint64_t group = 0;
+  (void)std::memcpy(&group, ctrl_.get() + slot, sizeof(group));
+  return group;
+}
+
+void EmbeddingIdMap::SetCtrl(size_t slot, uint8_t ctrl) {
+  ctrl_[slot] = ctrl;
+  if (slot < kGroupSize) {
+    ctrl_[slot_num_ + slot] = ctrl;
+  }
+}
+
+size_t EmbeddingIdMap::FindSlot(int64_t id) const {
+  uint64_t hash = Hash(id);
+  auto tag = static_cast<uint8_t>(hash & kCtrlMask);
+  size_t mask = slot_num_ - 1;
+  size_t slot = HomeSlot(hash);
+  for (size_t probed = 0; probed < slot_num_; probed += kGroupSize) {
+    uint64_t group = LoadGroup(slot);
+    for (uint64_t match = MatchByte(group, tag); match != 0; match &= match - 1) {
+      size_t candidate = (slot + LowestByte(match)) & mask;
+      if (ids_[candidate] == id && ctrl_[candidate] == tag) {
+        return candidate;
+      }
+    }
+    // The probe chain of id ends at the first empty slot.
+    if (MatchByte(group, kEmptySlot) != 0) {
+      break;
+    }
+    slot = (slot + kGroupSize) & mask;
+  }
+  return slot_num_;
+}
+
+int EmbeddingIdMap::Find(int64_t id) const {
+  size_t slot = FindSlot(id);
+  return slot == slot_num_ ? INVALID_INDEX_VALUE : indices_[slot];
+}
+
+void EmbeddingIdMap::Insert(int64_t id, int index) {
+  size_t slot = FindSlot(id);
+  if (slot != slot_num_) {
+    indices_[slot] = index;
+    return;
+  }
+  if (size_ >= capacity_) {
+    MS_LOG(EXCEPTION) << "The embedding id map is full, capacity: " << capacity_;
+  }
+  uint64_t hash = Hash(id);
+  size_t mask = slot_num_ - 1;
+  slot = HomeSlot(hash);
+  while (ctrl_[slot] != kEmptySlot) {
+    slot = (slot + 1) & mask;
+  }
+  SetCtrl(slot, static_cast<uint8_t>(hash & kCtrlMask));
+  ids_[slot] = id;
+  indices_[slot] = index;
+  ++size_;
+}
+
+bool EmbeddingIdMap::Erase(int64_t id) {
+  size_t hole = FindSlot(id);
+  if (hole == slot_num_) {
+    return false;
+  }
+  size_t mask = slot_num_ - 1;
+  // Move back every following id of the chain whose home slot is not between the hole and its current slot.
+  for (size_t slot = (hole + 1) & mask; ctrl_[slot] != kEmptySlot; slot = (slot + 1) & mask) {
+    size_t home = HomeSlot(Hash(ids_[slot]));
+    if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+      SetCtrl(hole, ctrl_[slot]);
+      ids_[hole] = ids_[slot];
+      indices_[hole] = indices_[slot];
+      hole = slot;
+    }
+  }
+  SetCtrl(hole, kEmptySlot);
+  --size_;
+  return true;
+}
+
+void EmbeddingIdMap::Prefetch(int64_t id) const {
+  size_t slot = HomeSlot(Hash(id));
+  __builtin_prefetch(ctrl_.get() + slot);
+  __builtin_prefetch(ids_.get() + slot);
+}
+
+void EmbeddingIdMap::Clear() {
+  std::fill(ctrl_.get(), ctrl_.get() + slot_num_ + kGroupSize, kEmptySlot);
+  size_ = 0;
+}
+}  // namespace ps
+}  // namespace mindspore
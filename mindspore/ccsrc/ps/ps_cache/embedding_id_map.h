@@ -0,0 +1,77 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_PS_CACHE_EMBEDDING_ID_MAP_H_
+#define MINDSPORE_CCSRC_PS_PS_CACHE_EMBEDDING_ID_MAP_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace mindspore {
+namespace ps {
+// Maps embedding ids to their cache index with open addressing. A control byte per slot keeps 7 bits of the hash of
+// the id, or kEmptySlot, and the control bytes are probed 8 at a time as one word, so a lookup compares the full ids
+// of the slots whose bits match only. The table never holds more than the capacity given at construction and never
+// grows. Erasing shifts the following ids of the probe chain back, so no tombstones slow down later lookups.
+class EmbeddingIdMap {
+ public:
+  explicit EmbeddingIdMap(size_t capacity);
+  ~EmbeddingIdMap() = default;
+
+  // Returns the index of id, or INVALID_INDEX_VALUE if id is not in the map.
+  int Find(int64_t id) const;
+  // Sets the index of id, which is inserted if it is not in the map.
+  void Insert(int64_t id, int index);
+  bool Erase(int64_t id);
+  // Fetches the first probed slots of id into the cache, to be called a few ids before looking it up.
+  void Prefetch(int64_t id) const;
+  void Clear();
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  template <typename Func>
+  void ForEach(Func &&func) const {
+    for (size_t i = 0; i < slot_num_; ++i) {
+      if (ctrl_[i] != kEmptySlot) {
+        func(ids_[i], indices_[i]);
+      }
+    }
+  }
+
+ private:
+  static constexpr uint8_t kEmptySlot = 0x80;
+  static constexpr size_t kGroupSize = 8;
+
+  uint64_t Hash(int64_t id) const;
+  size_t HomeSlot(uint64_t hash) const { return static_cast<size_t>(hash >> hash_shift_); }
+  uint64_t LoadGroup(size_t slot) const;
+  void SetCtrl(size_t slot, uint8_t ctrl);
+  size_t FindSlot(int64_t id) const;
+
+  size_t capacity_;
+  size_t slot_num_;
+  size_t hash_shift_;
+  size_t size_;
+  // The control bytes are followed by a copy of the first kGroupSize ones, so a group never wraps around.
+  std::unique_ptr<uint8_t[]> ctrl_;
+  std::unique_ptr<int64_t[]> ids_;
+  std::unique_ptr<int[]> indices_;
+};
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_PS_CACHE_EMBEDDING_ID_MAP_H_
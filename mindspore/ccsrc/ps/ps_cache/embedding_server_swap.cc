@@ -0,0 +1,190 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/ps_cache/embedding_server_swap.h"
+#include <utility>
+#include "securec/include/securec.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+namespace {
+// The number of the threads sending the requests to the servers, which is enough for the lookups of a few tables to
+// run together.
+constexpr size_t kServerSwapThreadNum = 4;
+}  // namespace
+
+EmbeddingServerSwap::EmbeddingServerSwap(const UpdateFunc &update_func, const LookUpFunc &lookup_func)
+    : update_func_(update_func), lookup_func_(lookup_func) {
+  for (size_t i = 0; i < kServerSwapThreadNum; ++i) {
+    threads_.emplace_back(&EmbeddingServerSwap::Loop, this);
+  }
+}
+
+EmbeddingServerSwap::~EmbeddingServerSwap() {
+  {
+    std::lock_guard<std::mutex> locker(mutex_);
+    exit_ = true;
+  }
+  request_cv_.notify_all();
+  for (auto &thread : threads_) {
+    if (thread.joinable()) {
+      thread.join();
+    }
+  }
+}
+
+void EmbeddingServerSwap::Update(uint64_t key, const std::vector<int> &ids, const std::vector<float> &data) {
+  Post(&updates_, [this, key, ids, data]() {
+    try {
+      update_func_(key, ids, data);
+    } catch (const std::exception &e) {
+      MS_LOG(ERROR) << "Update embeddings of servers failed: " << e.what();
+      throw;
+    }
+  });
+}
+
+void EmbeddingServerSwap::WaitUpdates() {
+  auto exception = Wait(&updates_);
+  if (exception != nullptr) {
+    std::rethrow_exception(exception);
+  }
+}
+
+void EmbeddingServerSwap::StartLookUp(uint64_t key, const int *ids, size_t ids_num, size_t embedding_size,
+                                      const std::unordered_map<int, size_t> &evicted_ids,
+                                      const std::vector<float> &evicted_data, std::vector<float> *result) {
+  Post(&lookups_, [this, key, ids, ids_num, embedding_size, &evicted_ids, &evicted_data, result]() {
+    try {
+      if (!LookUp(key, ids, ids_num, embedding_size, evicted_ids, evicted_data, result)) {
+        std::lock_guard<std::mutex> locker(mutex_);
+        lookup_success_ = false;
+      }
+    } catch (const std::exception &e) {
+      MS_LOG(ERROR) << "Look up embeddings from servers failed: " << e.what();
+      throw;
+    }
+  });
+}
+
+bool EmbeddingServerSwap::WaitLookUps() {
+  auto exception = Wait(&lookups_);
+  std::lock_guard<std::mutex> locker(mutex_);
+  bool success = lookup_success_;
+  lookup_success_ = true;
+  if (exception != nullptr) {
+    std::rethrow_exception(exception);
+  }
+  return success;
+}
+
+void EmbeddingServerSwap::Post(RequestQueue *queue, std::function<void()> &&request) {
+  {
+    std::lock_guard<std::mutex> locker(mutex_);
+    queue->requests.push_back(std::move(request));
+    queue->pending_num++;
+  }
+  request_cv_.notify_one();
+}
+
+std::exception_ptr EmbeddingServerSwap::Wait(RequestQueue *queue) {
+  std::unique_lock<std::mutex> locker(mutex_);
+  done_cv_.wait(locker, [queue]() { return queue->pending_num == 0; });
+  auto first_exception = queue->exception;
+  queue->exception = nullptr;
+  return first_exception;
+}
+
+void EmbeddingServerSwap::Loop() {
+  std::unique_lock<std::mutex> locker(mutex_);
+  while (true) {
+    request_cv_.wait(locker, [this]() { return exit_ || !lookups_.requests.empty() || !updates_.requests.empty(); });
+    // The requests queued before the swap is destroyed still run, as the updates of the last step.
+    if (lookups_.requests.empty() && updates_.requests.empty()) {
+      return;
+    }
+    RequestQueue *queue = lookups_.requests.empty() ? &updates_ : &lookups_;
+    auto request = std::move(queue->requests.front());
+    queue->requests.pop_front();
+    locker.unlock();
+    std::exception_ptr exception = nullptr;
+    try {
+      request();
+    } catch (const std::exception &) {
+      exception = std::current_exception();
+    }
+    locker.lock();
+    if (exception != nullptr && queue->exception == nullptr) {
+      queue->exception = exception;
+    }
+    queue->pending_num--;
+    if (queue->pending_num == 0) {
+      done_cv_.notify_all();
+    }
+  }
+}
+
+bool EmbeddingServerSwap::LookUp(uint64_t key, const int *ids, size_t ids_num, size_t embedding_size,
+                                 const std::unordered_map<int, size_t> &evicted_ids,
+                                 const std::vector<float> &evicted_data, std::vector<float> *result) const {
+  MS_ERROR_IF_NULL(ids);
+  MS_ERROR_IF_NULL(result);
+  result->assign(ids_num * embedding_size, 0);
+  std::vector<int> lookup_ids;
+  std::vector<size_t> lookup_pos;
+  size_t copy_len = embedding_size * sizeof(float);
+  for (size_t i = 0; i < ids_num; ++i) {
+    auto iter = evicted_ids.find(ids[i]);
+    if (iter == evicted_ids.end()) {
+      lookup_ids.push_back(ids[i]);
+      lookup_pos.push_back(i);
+      continue;
+    }
+    if ((iter->second + 1) * embedding_size > evicted_data.size()) {
+      MS_LOG(ERROR) << "The evicted embedding " << iter->second << " is out of the evicted data of size "
+                    << evicted_data.size();
+      return false;
+    }
+    auto ret = memcpy_s(result->data() + i * embedding_size, copy_len,
+                        evicted_data.data() + iter->second * embedding_size, copy_len);
+    if (ret != EOK) {
+      MS_LOG(ERROR) << "Evicted embedding memcpy failed.";
+      return false;
+    }
+  }
+  if (lookup_ids.empty()) {
+    return true;
+  }
+  std::vector<float> server_result(lookup_ids.size() * embedding_size, 0);
+  lookup_func_(key, lookup_ids, &server_result);
+  if (server_result.size() != lookup_ids.size() * embedding_size) {
+    MS_LOG(ERROR) << "The size of lookup result " << server_result.size() << " is not "
+                  << lookup_ids.size() * embedding_size;
+    return false;
+  }
+  for (size_t i = 0; i < lookup_pos.size(); ++i) {
+    auto ret = memcpy_s(result->data() + lookup_pos[i] * embedding_size, copy_len,
+                        server_result.data() + i * embedding_size, copy_len);
+    if (ret != EOK) {
+      MS_LOG(ERROR) << "Lookup result memcpy failed.";
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,92 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_PS_CACHE_EMBEDDING_SERVER_SWAP_H_
+#define MINDSPORE_CCSRC_PS_PS_CACHE_EMBEDDING_SERVER_SWAP_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace mindspore {
+namespace ps {
+// Swaps the embeddings between the host cache and the servers without blocking the swaps between the device and the
+// host. The rows evicted from the host cache are sent to the servers in background, and the missing rows of the tables
+// are looked up concurrently. A failure of a background request is kept and rethrown by the wait for it.
+// The requests run on a few threads started with the swap, the lookups first, as they are waited for within the step
+// while the updates are waited for by the next one.
+class EmbeddingServerSwap {
+ public:
+  using UpdateFunc = std::function<void(uint64_t key, const std::vector<int> &ids, const std::vector<float> &data)>;
+  using LookUpFunc = std::function<void(uint64_t key, const std::vector<int> &ids, std::vector<float> *data)>;
+
+  EmbeddingServerSwap(const UpdateFunc &update_func, const LookUpFunc &lookup_func);
+  ~EmbeddingServerSwap();
+  EmbeddingServerSwap(const EmbeddingServerSwap &) = delete;
+  EmbeddingServerSwap &operator=(const EmbeddingServerSwap &) = delete;
+
+  // Sends the rows of the ids to the servers in background, which is waited for by WaitUpdates.
+  void Update(uint64_t key, const std::vector<int> &ids, const std::vector<float> &data);
+  // Waits for the updates sent so far, and rethrows the exception of a failed one.
+  void WaitUpdates();
+
+  // Looks the rows of the ids up in background, which is waited for by WaitLookUps. The ids in evicted_ids are
+  // evicted within the same step, so their rows are copied from evicted_data instead of the servers, which may not be
+  // updated yet. The arguments must live until WaitLookUps returns.
+  void StartLookUp(uint64_t key, const int *ids, size_t ids_num, size_t embedding_size,
+                   const std::unordered_map<int, size_t> &evicted_ids, const std::vector<float> &evicted_data,
+                   std::vector<float> *result);
+  // Waits for the lookups, and rethrows the exception of a failed one. Returns false if a lookup failed otherwise.
+  bool WaitLookUps();
+
+ private:
+  bool LookUp(uint64_t key, const int *ids, size_t ids_num, size_t embedding_size,
+              const std::unordered_map<int, size_t> &evicted_ids, const std::vector<float> &evicted_data,
+              std::vector<float> *result) const;
+  // The requests of a kind, which are waited for together.
+  struct RequestQueue {
+    std::deque<std::function<void()>> requests;
+    // The requests queued or running.
+    size_t pending_num{0};
+    std::exception_ptr exception{nullptr};
+  };
+
+  void Post(RequestQueue *queue, std::function<void()> &&request);
+  // Waits for the requests of the queue and returns the first exception kept by them.
+  std::exception_ptr Wait(RequestQueue *queue);
+  void Loop();
+
+  UpdateFunc update_func_;
+  LookUpFunc lookup_func_;
+  // mutex_ guards the queues and lookup_success_.
+  std::mutex mutex_;
+  std::condition_variable request_cv_;
+  std::condition_variable done_cv_;
+  RequestQueue lookups_;
+  RequestQueue updates_;
+  bool lookup_success_{true};
+  bool exit_{false};
+  std::vector<std::thread> threads_;
+};
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_PS_CACHE_EMBEDDING_SERVER_SWAP_H_
@@ -345,6 +345,7 @@ void PsCacheManager::Finalize() {
   if (process_data_thread_.joinable()) {
     process_data_thread_.join();
   }
+  server_swap_.WaitUpdates();
 }
 
 bool PsCacheManager::ProcessData() {
@@ -382,14 +383,7 @@ bool PsCacheManager::ProcessData() {
     MS_LOG(ERROR) << "Ps cache wait graph finish failed.";
     return false;
   }
-  for (const auto &item : hash_tables_) {
-    auto key = Worker::GetInstance().GetParamKey(item.first);
-    auto hash_info = item.second;
-    RETURN_IF_FALSE(HashSwapHostToServer(key, hash_info));
-    RETURN_IF_FALSE(HashSwapDeviceToHost(hash_info));
-    RETURN_IF_FALSE(HashSwapServerToHost(key, hash_info));
-    RETURN_IF_FALSE(HashSwapHostToDevice(hash_info));
-  }
+  RETURN_IF_FALSE(SwapHashTables());
   size_t dest_len = data_size;
   // Replace the batch_ids by hash index for getNext-op getting hash index as input.
   if (memcpy_s(data, dest_len, hash_index.get(), data_size) != EOK) {
@@ -421,6 +415,9 @@ bool PsCacheManager::CheckCacheHitOrOutRangeTask(const int *batch_ids, const siz
   const auto &hash_id_to_index = device_hash_map->hash_id_to_index();
 
   for (size_t i = 0; i < batch_ids_len; ++i) {
+    if (i + kIdPrefetchDistance < batch_ids_len) {
+      hash_id_to_index.Prefetch(batch_ids[i + kIdPrefetchDistance]);
+    }
     if (batch_ids[i] < emb_table_slice_bounds_.first) {
       hash_index[i] = batch_ids[i] - vocab_cache_size_diff_;
       out_range[i] = true;
@@ -431,12 +428,12 @@ bool PsCacheManager::CheckCacheHitOrOutRangeTask(const int *batch_ids, const siz
       out_range[i] = true;
       continue;
     }
-    auto iter = hash_id_to_index.find(batch_ids[i]);
-    if (iter != hash_id_to_index.end()) {
-      hash_index[i] = iter->second + cache_indices_bounds_.first;
-      if (device_hash_map->hash_step(iter->second) != data_step_) {
+    int index = hash_id_to_index.Find(batch_ids[i]);
+    if (index != INVALID_INDEX_VALUE) {
+      hash_index[i] = index + cache_indices_bounds_.first;
+      if (device_hash_map->hash_step(index) != data_step_) {
         ++(*hash_hit_count);
-        device_hash_map->set_hash_step(iter->second, data_step_);
+        device_hash_map->set_hash_step(index, data_step_);
       }
       in_device[i] = true;
     }
@@ -509,7 +506,15 @@ bool PsCacheManager::ParseData(const int *batch_ids, const size_t batch_ids_len,
   }
   RETURN_IF_FALSE(CheckCacheHitOrOutRange(batch_ids, batch_ids_len, hash_index, in_device.get(), out_range.get()));
   RETURN_IF_FALSE(ResetEmbeddingHashMap());
+  const auto &device_id_map = embedding_device_cache_->device_hash_map_->hash_id_to_index();
+  const auto &host_id_map = embedding_host_cache_->host_hash_map_->hash_id_to_index();
   for (size_t i = 0; i < batch_ids_len; i++) {
+    // The ids missing in the device cache are looked up in both maps a few iterations later.
+    size_t next = i + kIdPrefetchDistance;
+    if (next < batch_ids_len && !in_device[next] && !out_range[next]) {
+      device_id_map.Prefetch(batch_ids[next]);
+      host_id_map.Prefetch(batch_ids[next]);
+    }
     if (in_device[i] || out_range[i]) {
       continue;
     }
@@ -551,13 +556,10 @@ bool PsCacheManager::ParseDeviceData(size_t id, bool *need_swap_device_to_host,
   auto &device_hash_map = embedding_device_cache_->device_hash_map_;
   MS_ERROR_IF_NULL(device_hash_map);
 
-  int index = INVALID_INDEX_VALUE;
-  const auto &hash_id_to_index = device_hash_map->hash_id_to_index();
-  const auto &iter = hash_id_to_index.find(id);
-  if (iter != hash_id_to_index.end()) {
+  int index = device_hash_map->hash_id_to_index().Find(id);
+  if (index != INVALID_INDEX_VALUE) {
     *need_swap_device_to_host = false;
     *need_swap_host_to_device = false;
-    index = iter->second;
     if (device_hash_map->hash_step(index) != data_step_) {
       statistics_info_.hash_hit_count_++;
       device_hash_map->set_hash_step(index, data_step_);
@@ -597,10 +599,8 @@ bool PsCacheManager::ParseHostDataHostToDevice(size_t id) {
   auto &host_hash_map = embedding_host_cache_->host_hash_map_;
   MS_ERROR_IF_NULL(host_hash_map);
 
-  const auto &hash_id_to_index = host_hash_map->hash_id_to_index();
-  const auto &iter = hash_id_to_index.find(id);
-  if (iter != hash_id_to_index.end()) {
-    auto index = iter->second;
+  int index = host_hash_map->hash_id_to_index().Find(id);
+  if (index != INVALID_INDEX_VALUE) {
     if (host_hash_map->hash_step(index) != data_step_) {
       host_hash_map->set_hash_step(index, data_step_);
     }
@@ -613,9 +613,8 @@ bool PsCacheManager::ParseHostDataHostToDevice(size_t id) {
     MS_ERROR_IF_NULL(server_to_host_index);
     MS_ERROR_IF_NULL(server_to_host_ids);
     while (true) {
-      auto index =
-        host_hash_map->ParseData(id, host_to_server_index, host_to_server_ids, data_step_, graph_running_step_,
-                                 &statistics_info_.host_to_server_size_, &host_need_wait_graph_);
+      index = host_hash_map->ParseData(id, host_to_server_index, host_to_server_ids, data_step_, graph_running_step_,
+                                       &statistics_info_.host_to_server_size_, &host_need_wait_graph_);
       if (index == INVALID_INDEX_VALUE) {
         RETURN_IF_FALSE(WaitGraphRun());
         continue;
@@ -639,10 +638,8 @@ bool PsCacheManager::ParseHostDataDeviceToHost() {
   auto &host_hash_map = embedding_host_cache_->host_hash_map_;
   MS_ERROR_IF_NULL(host_hash_map);
   int swap_device_to_host_id = device_to_host_ids[statistics_info_.device_to_host_size_ - 1];
-  const auto &hash_id_to_index = host_hash_map->hash_id_to_index();
-  const auto &iter = hash_id_to_index.find(swap_device_to_host_id);
-  if (iter != hash_id_to_index.end()) {
-    auto index = iter->second;
+  int index = host_hash_map->hash_id_to_index().Find(swap_device_to_host_id);
+  if (index != INVALID_INDEX_VALUE) {
     if (host_hash_map->hash_step(index) != data_step_) {
       host_hash_map->set_hash_step(index, data_step_);
     }
@@ -651,9 +648,9 @@ bool PsCacheManager::ParseHostDataDeviceToHost() {
     int *host_to_server_index = embedding_host_cache_->host_to_server_index.get();
     int *host_to_server_ids = embedding_host_cache_->host_to_server_ids.get();
     while (true) {
-      auto index =
-        host_hash_map->ParseData(swap_device_to_host_id, host_to_server_index, host_to_server_ids, data_step_,
-                                 graph_running_step_, &statistics_info_.host_to_server_size_, &host_need_wait_graph_);
+      index = host_hash_map->ParseData(swap_device_to_host_id, host_to_server_index, host_to_server_ids, data_step_,
+                                       graph_running_step_, &statistics_info_.host_to_server_size_,
+                                       &host_need_wait_graph_);
       if (index == INVALID_INDEX_VALUE) {
         RETURN_IF_FALSE(WaitGraphRun());
         continue;
@@ -829,7 +826,63 @@ bool PsCacheManager::HashSwapDeviceToHost(const HashTableInfo &hash_info) {
   return true;
 }
 
-bool PsCacheManager::HashSwapHostToServer(size_t key, const HashTableInfo &hash_info) {
+bool PsCacheManager::SwapHashTables() {
+  // The rows sent to the servers in the previous step must be there before this step looks ids up.
+  server_swap_.WaitUpdates();
+  std::vector<std::pair<size_t, const HashTableInfo *>> tables;
+  for (const auto &item : hash_tables_) {
+    tables.emplace_back(Worker::GetInstance().GetParamKey(item.first), &item.second);
+  }
+  // Read the rows evicted from the host cache before they are overwritten, the servers are updated in background.
+  std::vector<std::vector<float>> host_to_server_data(tables.size());
+  for (size_t i = 0; i < tables.size(); ++i) {
+    RETURN_IF_FALSE(HashSwapHostToServer(tables[i].first, *tables[i].second, &host_to_server_data[i]));
+  }
+
+  // An id evicted and requested again within the step is served from the rows just read instead of the servers.
+  std::unordered_map<int, size_t> evicted_ids;
+  auto host_to_server_ids = embedding_host_cache_->host_to_server_ids.get();
+  for (size_t i = 0; i < statistics_info_.host_to_server_size_; ++i) {
+    evicted_ids[host_to_server_ids[i]] = i;
+  }
+  // Look the missing rows of all tables up concurrently, while the device evicts its rows into the host cache.
+  std::vector<std::vector<float>> server_to_host_data(tables.size());
+  auto server_to_host_ids = embedding_host_cache_->server_to_host_ids.get();
+  auto server_to_host_size = statistics_info_.server_to_host_size_;
+  if (server_to_host_size != 0) {
+    for (size_t i = 0; i < tables.size(); ++i) {
+      server_swap_.StartLookUp(tables[i].first, server_to_host_ids, server_to_host_size,
+                               tables[i].second->embedding_size, evicted_ids, host_to_server_data[i],
+                               &server_to_host_data[i]);
+    }
+  }
+  bool swap_success = true;
+  std::exception_ptr swap_exception = nullptr;
+  try {
+    for (size_t i = 0; i < tables.size() && swap_success; ++i) {
+      swap_success = HashSwapDeviceToHost(*tables[i].second);
+    }
+  } catch (const std::exception &) {
+    swap_exception = std::current_exception();
+  }
+  // The lookups use the buffers of this function, so they are joined before any exception leaves it. The failure of
+  // a lookup is rethrown here.
+  bool lookup_success = server_swap_.WaitLookUps();
+  if (swap_exception != nullptr) {
+    std::rethrow_exception(swap_exception);
+  }
+  RETURN_IF_FALSE(swap_success && lookup_success);
+
+  for (size_t i = 0; i < tables.size(); ++i) {
+    RETURN_IF_FALSE(HashSwapServerToHost(*tables[i].second, server_to_host_data[i]));
+    RETURN_IF_FALSE(HashSwapHostToDevice(*tables[i].second));
+  }
+  return true;
+}
+
+bool PsCacheManager::HashSwapHostToServer(size_t key, const HashTableInfo &hash_info,
+                                          std::vector<float> *swap_out_data) {
+  MS_ERROR_IF_NULL(swap_out_data);
   MS_ERROR_IF_NULL(embedding_host_cache_);
   auto host_to_server_ids = embedding_host_cache_->host_to_server_ids.get();
   auto host_to_server_index = embedding_host_cache_->host_to_server_index.get();
@@ -838,12 +891,11 @@ bool PsCacheManager::HashSwapHostToServer(size_t key, const HashTableInfo &hash_
     return true;
   }
   std::vector<int> lookup_ids(swap_indices_size, 0);
-  std::vector<float> swap_out_data;
   auto embedding_size = hash_info.embedding_size;
-  swap_out_data.resize(swap_indices_size * embedding_size);
+  swap_out_data->resize(swap_indices_size * embedding_size);
   auto host_hash_table_addr = reinterpret_cast<float *>(hash_info.host_address.get());
   RETURN_IF_FALSE(LookUpHostHashTable(embedding_size, swap_indices_size, host_hash_table_addr, host_to_server_index,
-                                      swap_out_data.data()));
+                                      swap_out_data->data()));
 
   size_t copy_len = swap_indices_size * sizeof(int);
   size_t dest_len = copy_len;
@@ -852,30 +904,25 @@ bool PsCacheManager::HashSwapHostToServer(size_t key, const HashTableInfo &hash_
     MS_LOG(ERROR) << "Lookup id memcpy failed.";
     return false;
   }
-  Worker::GetInstance().UpdateEmbeddingTable({key}, lookup_ids, swap_out_data);
+  // The update overlaps with the rest of the swap and with the graph step, it is waited for by the next step.
+  server_swap_.Update(key, lookup_ids, *swap_out_data);
   return true;
 }
 
-bool PsCacheManager::HashSwapServerToHost(size_t key, const HashTableInfo &hash_info) {
+bool PsCacheManager::HashSwapServerToHost(const HashTableInfo &hash_info, const std::vector<float> &lookup_result) {
   MS_ERROR_IF_NULL(embedding_host_cache_);
   auto swap_indices_size = statistics_info_.server_to_host_size_;
-  auto server_to_host_ids = embedding_host_cache_->server_to_host_ids.get();
   auto server_to_host_index = embedding_host_cache_->server_to_host_index.get();
   if (swap_indices_size == 0) {
     return true;
   }
   auto host_hash_table_addr = reinterpret_cast<float *>(hash_info.host_address.get());
   auto embedding_size = hash_info.embedding_size;
-  std::vector<float> lookup_result(swap_indices_size * embedding_size, 0);
-  std::vector<int> lookup_ids(swap_indices_size, 0);
-  size_t copy_len = swap_indices_size * sizeof(int);
-  size_t dest_len = copy_len;
-  auto ret = memcpy_s(lookup_ids.data(), dest_len, server_to_host_ids, copy_len);
-  if (ret != EOK) {
-    MS_LOG(ERROR) << "Lookup id memcpy failed.";
+  if (lookup_result.size() != swap_indices_size * embedding_size) {
+    MS_LOG(ERROR) << "The size of lookup result " << lookup_result.size() << " is not "
+                  << swap_indices_size * embedding_size;
     return false;
   }
-  Worker::GetInstance().DoPSEmbeddingLookup(key, lookup_ids, &lookup_result, mindspore::ps::kEmbeddingLookupCmd);
   RETURN_IF_FALSE(InsertHostHashTable(embedding_size, IntToSize(swap_indices_size), server_to_host_index,
                                       lookup_result.data(), host_hash_table_addr));
   return true;
@@ -973,6 +1020,7 @@ void PsCacheManager::SyncEmbeddingTable() {
   if (!initialized_ps_cache_) {
     return;
   }
+  server_swap_.WaitUpdates();
   if (!SyncHostEmbeddingTable()) {
     MS_LOG(ERROR) << "SyncHostEmbeddingTable failed.";
   }
@@ -995,10 +1043,10 @@ bool PsCacheManager::SyncHostEmbeddingTable() {
   std::unique_ptr<int[]> host_to_server_indices_ptr = std::make_unique<int[]>(swap_indices_lens);
   MS_ERROR_IF_NULL(host_to_server_indices_ptr);
   size_t idx = 0;
-  for (const auto &item : hash_id_to_index) {
-    host_to_server_ids_ptr[idx] = item.first;
-    host_to_server_indices_ptr[idx++] = item.second;
-  }
+  hash_id_to_index.ForEach([&host_to_server_ids_ptr, &host_to_server_indices_ptr, &idx](int64_t id, int index) {
+    host_to_server_ids_ptr[idx] = LongToInt(id);
+    host_to_server_indices_ptr[idx++] = index;
+  });
   for (const auto &item : hash_tables_) {
     const auto &hash_info = item.second;
     if (hash_info.param_init_info_.param_type_ != kWeight) {
@@ -1040,10 +1088,10 @@ bool PsCacheManager::SyncDeviceEmbeddingTable() {
   std::unique_ptr<int[]> device_to_server_indices_ptr = std::make_unique<int[]>(swap_indices_lens);
   MS_ERROR_IF_NULL(device_to_server_indices_ptr);
   size_t idx = 0;
-  for (const auto &item : hash_id_to_index) {
-    device_to_server_ids_ptr[idx] = item.first;
-    device_to_server_indices_ptr[idx++] = item.second;
-  }
+  hash_id_to_index.ForEach([&device_to_server_ids_ptr, &device_to_server_indices_ptr, &idx](int64_t id, int index) {
+    device_to_server_ids_ptr[idx] = LongToInt(id);
+    device_to_server_indices_ptr[idx++] = index;
+  });
   for (const auto &item : hash_tables_) {
     const auto &hash_info = item.second;
     if (hash_info.param_init_info_.param_type_ != kWeight) {
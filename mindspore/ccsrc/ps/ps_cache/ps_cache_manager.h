@@ -19,6 +19,7 @@
 
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <thread>
 #include <atomic>
@@ -34,6 +35,7 @@
 #include "ps/ps_context.h"
 #include "ps/ps_cache/ps_data/ps_data_prefetch.h"
 #include "ps/ps_cache/embedding_hash_map.h"
+#include "ps/ps_cache/embedding_server_swap.h"
 #include "ps/ps_cache/ps_cache_factory.h"
 
 namespace mindspore {
@@ -41,6 +43,8 @@ namespace ps {
 constexpr size_t kHostCacheScaleFactor = 10;
 constexpr size_t kMaxThreadNum = 16;
 constexpr size_t kMaxIdsPerThread = 10000;
+// How many ids ahead of the current one the slots of the id maps are prefetched.
+constexpr size_t kIdPrefetchDistance = 8;
 using mindspore::kernel::Address;
 
 struct HashTableInfo {
@@ -160,8 +164,9 @@ class PsCacheManager {
   bool HashSwapDeviceIn(const int *swap_in_ids, const int *swap_in_index, const HashTableInfo &hash_info, size_t key);
   bool HashSwapHostToDevice(const HashTableInfo &hash_info);
   bool HashSwapDeviceToHost(const HashTableInfo &hash_info);
-  bool HashSwapHostToServer(size_t key, const HashTableInfo &hash_info);
-  bool HashSwapServerToHost(size_t key, const HashTableInfo &hash_info);
+  bool SwapHashTables();
+  bool HashSwapHostToServer(size_t key, const HashTableInfo &hash_info, std::vector<float> *swap_out_data);
+  bool HashSwapServerToHost(const HashTableInfo &hash_info, const std::vector<float> &lookup_result);
   bool InsertHostHashTable(size_t embedding_size, size_t insert_indices_size, const int *insert_indices,
                            const float *insert_data, float *hash_table_addr);
   bool LookUpHostHashTable(size_t embedding_size, size_t indices_lens, const float *hash_table_addr,
@@ -190,6 +195,14 @@ class PsCacheManager {
   std::condition_variable data_prase_;
   std::condition_variable insert_init_info_;
   std::thread process_data_thread_;
+  // The rows evicted from the host cache are sent to the servers in background, and waited for before the next lookup.
+  EmbeddingServerSwap server_swap_{
+    [](uint64_t key, const std::vector<int> &ids, const std::vector<float> &data) {
+      Worker::GetInstance().UpdateEmbeddingTable({key}, ids, data);
+    },
+    [](uint64_t key, const std::vector<int> &ids, std::vector<float> *data) {
+      Worker::GetInstance().DoPSEmbeddingLookup(key, ids, data, kEmbeddingLookupCmd);
+    }};
 
   std::map<std::string, HashTableInfo> hash_tables_;
   std::shared_ptr<EmbeddingDeviceCache> embedding_device_cache_;
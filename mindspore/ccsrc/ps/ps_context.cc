@@ -194,6 +194,28 @@ void PSContext::set_encrypt_type(const std::string &encrypt_type) {
 }
 const std::string &PSContext::encrypt_type() const { return encrypt_type_; }
 
+void PSContext::set_grad_compression(const std::string &grad_compression) {
+  (void)GradCodecFromName(grad_compression);
+  grad_compression_ = grad_compression;
+}
+
+const std::string &PSContext::grad_compression() const { return grad_compression_; }
+
+void PSContext::set_grad_compression_ratio(float grad_compression_ratio) {
+  if (grad_compression_ratio <= 0 || grad_compression_ratio > 1) {
+    MS_LOG(EXCEPTION) << "grad_compression_ratio must be in (0, 1], but got " << grad_compression_ratio;
+  }
+  grad_compression_ratio_ = grad_compression_ratio;
+}
+
+float PSContext::grad_compression_ratio() const { return grad_compression_ratio_; }
+
+void PSContext::set_embedding_storage_path(const std::string &embedding_storage_path) {
+  embedding_storage_path_ = embedding_storage_path;
+}
+
+const std::string &PSContext::embedding_storage_path() const { return embedding_storage_path_; }
+
 void PSContext::set_dp_eps(float dp_eps) {
   if (dp_eps > 0) {
     dp_eps_ = dp_eps;
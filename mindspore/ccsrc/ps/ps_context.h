@@ -21,6 +21,7 @@
 #include <string>
 #include <memory>
 #include "ps/constants.h"
+#include "ps/grad_compression.h"
 #include "ps/core/cluster_metadata.h"
 #include "ps/core/cluster_config.h"
 
@@ -178,6 +179,15 @@ class PSContext {
   void set_encrypt_type(const std::string &encrypt_type);
   const std::string &encrypt_type() const;
 
+  void set_grad_compression(const std::string &grad_compression);
+  const std::string &grad_compression() const;
+
+  void set_grad_compression_ratio(float grad_compression_ratio);
+  float grad_compression_ratio() const;
+
+  void set_embedding_storage_path(const std::string &embedding_storage_path);
+  const std::string &embedding_storage_path() const;
+
  private:
   PSContext()
       : ps_enabled_(false),
@@ -215,7 +225,10 @@ class PSContext {
         dp_eps_(50),
         dp_delta_(0.01),
         dp_norm_clip_(1.0),
-        encrypt_type_(kNotEncryptType) {}
+        encrypt_type_(kNotEncryptType),
+        grad_compression_(kGradCompressionNone),
+        grad_compression_ratio_(0.01),
+        embedding_storage_path_("") {}
   bool ps_enabled_;
   bool is_worker_;
   bool is_pserver_;
@@ -304,6 +317,15 @@ class PSContext {
 
   // Secure mechanism for federated learning. Used in federated learning for now.
   std::string encrypt_type_;
+
+  // Codec of the gradients pushed by the workers in parameter server mode.
+  std::string grad_compression_;
+
+  // Ratio of the gradient values sent by the top-k codec.
+  float grad_compression_ratio_;
+
+  // Directory on local disk storing the embedding tables of the servers, which are kept in memory if it is empty.
+  std::string embedding_storage_path_;
 };
 }  // namespace ps
 }  // namespace mindspore
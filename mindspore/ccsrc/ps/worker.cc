@@ -32,6 +32,8 @@ void Worker::Run() {
   }
 
   Initialize();
+  grad_codec_ = GradCodecFromName(PSContext::instance()->grad_compression());
+  grad_compression_ratio_ = PSContext::instance()->grad_compression_ratio();
 
   worker_node_.RegisterEventCallback(core::ClusterEvent::SCHEDULER_TIMEOUT, [this]() {
     MS_LOG(ERROR) << "Trigger timeout event: SCHEDULER_TIMEOUT begin to exit the system!";
@@ -80,10 +82,11 @@ void Worker::Push(const std::vector<size_t> &keys, std::vector<uintptr_t> addrs,
   }
 
   size_t total_size = std::accumulate(sizes.begin(), sizes.end(), 0, std::plus<int64_t>());
-  std::vector<float> total_buffer(total_size, 0);
+  // The gradients are gathered once into a buffer owned by the message, the servers' shares are sent from it as is.
+  auto total_buffer = std::make_shared<Values>(total_size, 0);
   size_t offset = 0;
   for (size_t i = 0; i < sizes.size(); i++) {
-    void *dst_data = total_buffer.data() + offset / sizeof(float);
+    void *dst_data = total_buffer->data() + offset / sizeof(float);
     void *src_data = reinterpret_cast<void *>(addrs[i]);
     MS_EXCEPTION_IF_NULL(dst_data);
     MS_EXCEPTION_IF_NULL(src_data);
@@ -111,7 +114,7 @@ void Worker::Push(const std::vector<size_t> &keys, std::vector<uintptr_t> addrs,
     std::vector<int64_t> &var_shape = key_to_optim_shapes_[key][0];
     int64_t first_dim_size = var_shape[0];
     int64_t outer_dim_size = std::accumulate(var_shape.begin() + 1, var_shape.end(), 1, std::multiplies<int64_t>());
-    MS_LOG(DEBUG) << "The keys:" << keys << " the total_buffer:" << total_buffer << " the sizes_int:" << sizes_int
+    MS_LOG(DEBUG) << "The keys:" << keys << " the total_buffer:" << *total_buffer << " the sizes_int:" << sizes_int
                   << " the grad_index:" << grad_index << " the indice_index:" << indice_index
                   << " the first_dim_size:" << first_dim_size << " the outer_dim_size" << outer_dim_size;
     PushSparseData(std::vector<Key>(keys), total_buffer, std::vector<int>(sizes_int), grad_index, indice_index,
@@ -462,9 +465,9 @@ void Worker::InitPSOptimId(const size_t param_key) {
   int64_t optim_id = key_to_optimId_[param_key];
 
   std::vector<Key> keys = {param_key};
-  std::vector<float> optim_id_vals = {static_cast<float>(optim_id)};
-  std::vector<int> optim_id_lens = {SizeToInt(optim_id_vals.size())};
-  MS_LOG(INFO) << "The keys is" << keys << " the optim_id_vals is: " << optim_id_vals
+  auto optim_id_vals = std::make_shared<Values>(1, static_cast<float>(optim_id));
+  std::vector<int> optim_id_lens = {SizeToInt(optim_id_vals->size())};
+  MS_LOG(INFO) << "The keys is" << keys << " the optim_id_vals is: " << *optim_id_vals
                << " optim_id_lens is:" << optim_id_lens;
   PushData(keys, optim_id_vals, optim_id_lens, kInitWeightToOptimIdCmd);
 }
@@ -472,22 +475,22 @@ void Worker::InitPSOptimId(const size_t param_key) {
 void Worker::InitPSOptimInputShapes(const size_t key) {
   std::vector<Key> keys;
   std::vector<int> shape_len;
-  std::vector<float> all_shape;
+  auto all_shape = std::make_shared<Values>();
   std::vector<ShapeVector> shapes = key_to_optim_shapes_[key];
   for (auto shape : shapes) {
     keys.push_back(key);
     if (shape.size() == 0) {
       shape_len.push_back(1);
-      all_shape.push_back(1);
+      all_shape->push_back(1);
     } else {
       shape_len.push_back(SizeToLong(shape.size()));
-      std::transform(shape.begin(), shape.end(), std::back_inserter(all_shape),
+      std::transform(shape.begin(), shape.end(), std::back_inserter(*all_shape),
                      [](size_t dim) -> float { return static_cast<float>(dim); });
     }
   }
   MS_LOG(INFO) << "keys:" << keys;
   MS_LOG(INFO) << "shape_len:" << shape_len;
-  MS_LOG(INFO) << "all_shape:" << all_shape;
+  MS_LOG(INFO) << "all_shape:" << *all_shape;
   if (!init_keys_[key]) {
     init_keys_[key] = true;
   }
@@ -496,13 +499,13 @@ void Worker::InitPSOptimInputShapes(const size_t key) {
 
 void Worker::InitPSParamData(const std::vector<size_t> &keys, void *const origin_addr, size_t size) {
   MS_EXCEPTION_IF_NULL(origin_addr);
-  std::vector<float> addr{reinterpret_cast<float *>(origin_addr),
-                          reinterpret_cast<float *>(origin_addr) + size / sizeof(float)};
+  auto addr = std::make_shared<Values>(reinterpret_cast<float *>(origin_addr),
+                                       reinterpret_cast<float *>(origin_addr) + size / sizeof(float));
   std::vector<Key> key(keys);
   std::vector<int> lens;
-  lens.push_back(addr.size());
+  lens.push_back(addr->size());
   MS_LOG(INFO) << "the keys are:" << keys;
-  MS_LOG(INFO) << "the values are:" << addr;
+  MS_LOG(INFO) << "the values are:" << *addr;
   PushData(key, addr, lens, kInitWeightsCmd);
   init_keys_[key[0]] = true;
 }
@@ -631,43 +634,37 @@ void Worker::BuildSparseValue(const std::vector<int> &lengths, const size_t grad
   }
 }
 
-void Worker::PushData(const std::vector<Key> &keys, const std::vector<float> &vals, const std::vector<int> &lens,
-                      int cmd, int64_t) {
-  KVMessage kvs;
-  *kvs.mutable_keys() = {keys.begin(), keys.end()};
-  *kvs.mutable_values() = {vals.begin(), vals.end()};
-  *kvs.mutable_len() = {lens.begin(), lens.end()};
+void Worker::PushData(const std::vector<Key> &keys, const ValuesPtr &vals, const std::vector<int> &lens, int cmd,
+                      int64_t) {
+  MS_EXCEPTION_IF_NULL(vals);
   MS_LOG(INFO) << "the result is:" << embedding_table_ranges_.count(keys[0]);
   if (embedding_table_ranges_.count(keys[0])) {
     if (cmd == kInitWeightsCmd) {
+      KVMessage kvs;
+      *kvs.mutable_keys() = {keys.begin(), keys.end()};
+      *kvs.mutable_values() = {vals->begin(), vals->end()};
+      *kvs.mutable_len() = {lens.begin(), lens.end()};
       SendForPush(cmd, kvs, worker_init_embedding_partitioner_, {});
     } else {
-      std::string kv_data = kvs.SerializeAsString();
-      std::shared_ptr<unsigned char[]> res(new unsigned char[kv_data.length()]);
-      size_t dest_size = kv_data.length();
-      int ret = memcpy_s(res.get(), dest_size, kv_data.data(), kv_data.length());
-      if (ret != 0) {
-        MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
-        return;
-      }
-      worker_node_.Broadcast(core::NodeRole::SERVER, res, kv_data.length(), cmd);
+      SendForPush(cmd, keys, vals, lens, true);
     }
   } else {
-    SendForPush(cmd, kvs, round_robin_partitioner_, {});
+    SendForPush(cmd, keys, vals, lens, false);
   }
 }
 
-void Worker::PushSparseData(const std::vector<Key> &keys, const std::vector<float> &vals, const std::vector<int> &lens,
+void Worker::PushSparseData(const std::vector<Key> &keys, const ValuesPtr &vals, const std::vector<int> &lens,
                             size_t grad_index, size_t indice_index, size_t first_dim_size, size_t outer_dim_size) {
-  KVMessage kvs;
-  *kvs.mutable_keys() = {keys.begin(), keys.end()};
-  *kvs.mutable_values() = {vals.begin(), vals.end()};
-  *kvs.mutable_len() = {lens.begin(), lens.end()};
+  MS_EXCEPTION_IF_NULL(vals);
   if (embedding_table_ranges_.count(keys[0])) {
+    KVMessage kvs;
+    *kvs.mutable_keys() = {keys.begin(), keys.end()};
+    *kvs.mutable_values() = {vals->begin(), vals->end()};
+    *kvs.mutable_len() = {lens.begin(), lens.end()};
     std::map<int64_t, int64_t> attrs{{0, grad_index}, {1, indice_index}, {2, first_dim_size}, {3, outer_dim_size}};
     SendForPush(kPushCmd, kvs, sparse_partitioner_, attrs);
   } else {
-    SendForPush(kPushCmd, kvs, round_robin_partitioner_, {});
+    SendForPush(kPushCmd, keys, vals, lens, false);
   }
 }
 
@@ -935,61 +932,75 @@ void Worker::BroadcastPartitioner(const KVMessage &send, PartitionKVMessages *pa
 
 void Worker::SendForPush(int cmd, const KVMessage &send, const KVPartitioner &partitioner,
                          const std::map<int64_t, int64_t> &attrs) {
-  PartitionKVMessages messages;
-  partitioner(send, &messages, attrs);
+  auto messages = std::make_shared<PartitionKVMessages>();
+  partitioner(send, messages.get(), attrs);
   std::vector<uint32_t> rank_ids;
-  std::vector<DataPtr> data;
-  std::vector<size_t> sizes;
-  for (size_t i = 0; i < messages.size(); i++) {
-    if (messages.at(i).first) {
-      rank_ids.push_back(i);
-      std::string kv_data = messages.at(i).second.SerializeAsString();
+  auto payloads = ToKVPayloads(cmd, messages, &rank_ids);
+  SendKVPayloads(cmd, rank_ids, payloads);
+}
 
-      std::shared_ptr<unsigned char[]> res(new unsigned char[kv_data.length()]);
-      size_t dest_size = kv_data.length();
-      int ret = memcpy_s(res.get(), dest_size, kv_data.data(), kv_data.length());
-      if (ret != 0) {
-        MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
-        return;
-      }
-      data.push_back(res);
-      sizes.push_back(kv_data.length());
+void Worker::SendForPush(int cmd, const std::vector<Key> &keys, const ValuesPtr &vals, const std::vector<int> &lens,
+                         bool broadcast) {
+  MS_EXCEPTION_IF_NULL(vals);
+  if (!vals->empty() && lens.size() != keys.size()) {
+    MS_LOG(EXCEPTION) << "The keys size " << keys.size() << " and the lens size " << lens.size() << " mismatch.";
+  }
+  bool is_sparse = false;
+  size_t grad_segment = (broadcast || keys.empty()) ? INDEX_NOT_SEND : GradSegment(cmd, keys[0], &is_sparse);
+  auto payloads = std::make_shared<std::vector<KVPayload>>(LongToSize(server_num_), KVPayload(vals));
+  size_t offset = 0;
+  for (size_t i = 0; i < keys.size(); i++) {
+    int64_t server_id = broadcast ? 0 : key_to_server_id_[keys[i]];
+    auto &payload = payloads->at(LongToSize(server_id));
+    payload.AddKey(keys[i]);
+    if (vals->empty()) {
+      continue;
+    }
+    size_t len = IntToSize(lens[i]);
+    if (offset + len > vals->size()) {
+      MS_LOG(EXCEPTION) << "The lens of the keys exceed the values size " << vals->size();
+    }
+    if (i == grad_segment) {
+      AddGradValues(&payload, keys[i], vals->data() + offset, len, is_sparse);
+    } else {
+      payload.AddValues(vals->data() + offset, len);
+    }
+    payload.AddLength(len);
+    offset += len;
+  }
+
+  std::vector<uint32_t> rank_ids;
+  for (size_t i = 0; i < payloads->size(); i++) {
+    if (broadcast) {
+      // Every server gets the same keys and values, only the metadata is duplicated.
+      payloads->at(i) = payloads->at(0);
+    }
+    if (payloads->at(i).has_keys()) {
+      rank_ids.push_back(SizeToUint(i));
     }
   }
-  worker_node_.Send(core::NodeRole::SERVER, rank_ids, data, sizes, cmd);
+  auto end = std::remove_if(payloads->begin(), payloads->end(), [](const KVPayload &p) { return !p.has_keys(); });
+  (void)payloads->erase(end, payloads->end());
+  SendKVPayloads(cmd, rank_ids, payloads);
 }
 
 void Worker::SendForPull(int cmd, const KVMessage &send, const KVPartitioner &partitioner,
                          const std::map<int64_t, int64_t> &, std::vector<float> *vals, std::vector<int> *lens) {
   MS_EXCEPTION_IF_NULL(vals);
-  PartitionKVMessages messages;
-  partitioner(send, &messages, {});
+  auto messages = std::make_shared<PartitionKVMessages>();
+  partitioner(send, messages.get(), {});
   std::vector<uint32_t> rank_ids;
-  std::vector<DataPtr> data;
-  std::vector<size_t> sizes;
-  for (size_t i = 0; i < messages.size(); i++) {
-    if (messages.at(i).first) {
-      rank_ids.push_back(i);
-      std::string kv_data = messages.at(i).second.SerializeAsString();
-
-      std::shared_ptr<unsigned char[]> res(new unsigned char[kv_data.length()]);
-      size_t dest_size = kv_data.length();
-      int ret = memcpy_s(res.get(), dest_size, kv_data.data(), kv_data.length());
-      if (ret != 0) {
-        MS_LOG(ERROR) << "memcpy_s error, errorno(" << ret << ")";
-        return;
-      }
-      data.push_back(res);
-      sizes.push_back(kv_data.length());
-    }
-  }
+  auto payloads = ToKVPayloads(cmd, messages, &rank_ids);
   std::vector<VectorPtr> resp;
-  worker_node_.Send(core::NodeRole::SERVER, rank_ids, data, sizes, cmd, &resp);
+  SendKVPayloads(cmd, rank_ids, payloads, &resp);
   vals->clear();
+  Values values;
   for (size_t i = 0; i < resp.size(); ++i) {
     KVMessage message;
-    CHECK_RETURN_TYPE(message.ParseFromArray(resp.at(i)->data(), SizeToInt(resp.at(i)->size())));
-    std::copy(message.values().begin(), message.values().end(), std::back_inserter(*vals));
+    if (!ParseKVPayload(resp.at(i)->data(), resp.at(i)->size(), &message, &values)) {
+      MS_LOG(EXCEPTION) << "Parse the pull response from server " << rank_ids.at(i) << " failed.";
+    }
+    (void)vals->insert(vals->end(), values.begin(), values.end());
 
     if (lens) {
       lens->clear();
@@ -997,5 +1008,89 @@ void Worker::SendForPull(int cmd, const KVMessage &send, const KVPartitioner &pa
     }
   }
 }
+
+void Worker::SendKVPayloads(int cmd, const std::vector<uint32_t> &rank_ids,
+                            const std::shared_ptr<std::vector<KVPayload>> &payloads, std::vector<VectorPtr> *output) {
+  MS_EXCEPTION_IF_NULL(payloads);
+  std::vector<std::vector<core::MessageSlice>> slices;
+  for (auto &payload : *payloads) {
+    slices.push_back(payload.Slices());
+  }
+  // The payloads and the values they reference stay alive until every slice has been written.
+  worker_node_.Send(core::NodeRole::SERVER, rank_ids, slices, payloads, cmd, output);
+}
+
+std::shared_ptr<std::vector<KVPayload>> Worker::ToKVPayloads(int cmd,
+                                                             const std::shared_ptr<PartitionKVMessages> &messages,
+                                                             std::vector<uint32_t> *rank_ids) {
+  MS_EXCEPTION_IF_NULL(messages);
+  MS_EXCEPTION_IF_NULL(rank_ids);
+  auto payloads = std::make_shared<std::vector<KVPayload>>();
+  for (size_t i = 0; i < messages->size(); i++) {
+    if (!messages->at(i).first) {
+      continue;
+    }
+    rank_ids->push_back(SizeToUint(i));
+    const auto &message = messages->at(i).second;
+    bool is_sparse = false;
+    size_t grad_segment = message.keys_size() > 0 ? GradSegment(cmd, message.keys(0), &is_sparse) : INDEX_NOT_SEND;
+    if (grad_segment >= IntToSize(message.len_size())) {
+      payloads->emplace_back(message, messages);
+      continue;
+    }
+
+    KVPayload payload(messages);
+    for (const auto &key : message.keys()) {
+      payload.AddKey(key);
+    }
+    size_t offset = 0;
+    for (size_t j = 0; j < IntToSize(message.len_size()); j++) {
+      size_t len = message.len(j);
+      if (offset + len > IntToSize(message.values_size())) {
+        MS_LOG(EXCEPTION) << "The lens of the message exceed its values size " << message.values_size();
+      }
+      const float *values = message.values().data() + offset;
+      if (j == grad_segment) {
+        AddGradValues(&payload, message.keys(0), values, len, is_sparse);
+      } else {
+        payload.AddValues(values, len);
+      }
+      payload.AddLength(len);
+      offset += len;
+    }
+    payloads->push_back(payload);
+  }
+  return payloads;
+}
+
+size_t Worker::GradSegment(int cmd, const Key &key, bool *is_sparse) {
+  MS_EXCEPTION_IF_NULL(is_sparse);
+  if (cmd != kPushCmd || grad_codec_ == GradCodec::kNone || key_to_optimId_.count(key) == 0) {
+    return INDEX_NOT_SEND;
+  }
+  auto iter = kOptimToPSSendIdx.find(Util::optimizer_name(key_to_optimId_[key]));
+  if (iter == kOptimToPSSendIdx.end() || iter->second.count("grad") == 0) {
+    return INDEX_NOT_SEND;
+  }
+  *is_sparse = iter->second.count("indices") != 0;
+  return iter->second.at("grad");
+}
+
+void Worker::AddGradValues(KVPayload *payload, const Key &key, const float *grad, size_t count, bool is_sparse) {
+  MS_EXCEPTION_IF_NULL(payload);
+  // The rows of a sparse gradient change from one push to the next, so there is no residual for top-k to keep.
+  if (grad_codec_ == GradCodec::kTopK && is_sparse) {
+    payload->AddValues(grad, count);
+    return;
+  }
+  Values *residual = nullptr;
+  if (grad_codec_ == GradCodec::kTopK) {
+    std::lock_guard<std::mutex> lock(residual_mutex_);
+    residual = &topk_residuals_[key];
+  }
+  auto encoded = std::make_shared<std::vector<unsigned char>>();
+  EncodeGradient(grad_codec_, grad, count, grad_compression_ratio_, residual, encoded.get());
+  payload->AddEncodedValues(grad_codec_, encoded);
+}
 }  // namespace ps
 }  // namespace mindspore
@@ -37,6 +37,8 @@
 #include "ps/ps_cache/ps_data/ps_data_prefetch.h"
 #include "ps/core/worker_node.h"
 #include "ps/embedding_table_shard_metadata.h"
+#include "ps/kv_payload.h"
+#include "ps/grad_compression.h"
 #include "proto/comm.pb.h"
 #include "proto/ps.pb.h"
 #include "ps/ps_context.h"
@@ -81,7 +83,8 @@ class Worker {
   void Finalize();
 
  private:
-  Worker() : server_num_(-1), running_(false), key_cnt_(0) {}
+  Worker()
+      : server_num_(-1), running_(false), key_cnt_(0), grad_codec_(GradCodec::kNone), grad_compression_ratio_(1.0) {}
   ~Worker() = default;
   Worker(const Worker &) = delete;
   Worker &operator=(const Worker &) = delete;
@@ -101,9 +104,9 @@ class Worker {
   void BuildSparseValue(const std::vector<int> &lengths, const size_t grad_index, const size_t indice_index,
                         const float *original_data, const float *grads, int *indices, std::vector<float> *reduced_data);
 
-  void PushData(const std::vector<Key> &keys, const std::vector<float> &vals, const std::vector<int> &lens = {},
+  void PushData(const std::vector<Key> &keys, const ValuesPtr &vals, const std::vector<int> &lens = {},
                 int command = 0, int64_t priority = 0);
-  void PushSparseData(const std::vector<Key> &keys, const std::vector<float> &vals, const std::vector<int> &lens,
+  void PushSparseData(const std::vector<Key> &keys, const ValuesPtr &vals, const std::vector<int> &lens,
                       size_t grad_index, size_t indice_index, size_t first_dim_size, size_t outer_dim_size);
   void PullData(const std::vector<Key> &keys, std::vector<float> *const vals, std::vector<int> *lens = nullptr,
                 int cmd = 0, int64_t priority = 0);
@@ -123,8 +126,20 @@ class Worker {
                             const std::map<int64_t, int64_t> &attrs);
   void SendForPush(int cmd, const KVMessage &send, const KVPartitioner &partitioner,
                    const std::map<int64_t, int64_t> &attrs);
+  // Pushes the values to the servers owning their keys, or to every server if broadcast, without copying them.
+  void SendForPush(int cmd, const std::vector<Key> &keys, const ValuesPtr &vals, const std::vector<int> &lens,
+                   bool broadcast);
   void SendForPull(int cmd, const KVMessage &send, const KVPartitioner &partitioner,
                    const std::map<int64_t, int64_t> &attrs, std::vector<float> *vals, std::vector<int> *lens);
+  void SendKVPayloads(int cmd, const std::vector<uint32_t> &rank_ids,
+                      const std::shared_ptr<std::vector<KVPayload>> &payloads,
+                      std::vector<VectorPtr> *output = nullptr);
+  std::shared_ptr<std::vector<KVPayload>> ToKVPayloads(int cmd, const std::shared_ptr<PartitionKVMessages> &messages,
+                                                       std::vector<uint32_t> *rank_ids);
+  // Returns the index of the len segment holding the gradient if the values pushed by cmd are compressed, otherwise
+  // INDEX_NOT_SEND.
+  size_t GradSegment(int cmd, const Key &key, bool *is_sparse);
+  void AddGradValues(KVPayload *payload, const Key &key, const float *grad, size_t count, bool is_sparse);
 
   int64_t server_num_;
   bool running_;
@@ -147,6 +162,13 @@ class Worker {
   std::unordered_map<Key, size_t> embedding_row_cnt_;
 
   std::unordered_map<Key, std::shared_ptr<std::vector<EmbeddingTableShardMetadata>>> embedding_table_ranges_;
+
+  // The codec of the pushed gradients and the ratio of values kept by top-k.
+  GradCodec grad_codec_;
+  float grad_compression_ratio_;
+  // The part of every dense gradient that top-k has not sent yet, added to the next gradient of the key.
+  std::mutex residual_mutex_;
+  std::unordered_map<Key, Values> topk_residuals_;
 };
 }  // namespace ps
 }  // namespace mindspore
@@ -85,6 +85,7 @@ REGISTER_PYBIND_DEFINE(MsContextPy, ([](const py::module *m) {
                            .value("save_graphs", MsCtxParam::MS_CTX_SAVE_GRAPHS_FLAG)
                            .value("enable_parallel_split", MsCtxParam::MS_CTX_ENABLE_PARALLEL_SPLIT)
                            .value("max_device_memory", MsCtxParam::MS_CTX_MAX_DEVICE_MEMORY)
+                           .value("recompute_memory_budget", MsCtxParam::MS_CTX_RECOMPUTE_MEMORY_BUDGET)
                            .value("mode", MsCtxParam::MS_CTX_EXECUTION_MODE)
                            .value("device_target", MsCtxParam::MS_CTX_DEVICE_TARGET)
                            .value("_graph_memory_max_size", MsCtxParam::MS_CTX_GRAPH_MEMORY_MAX_SIZE)
@@ -100,7 +101,10 @@ REGISTER_PYBIND_DEFINE(MsContextPy, ([](const py::module *m) {
                            .value("graph_kernel_flags", MsCtxParam::MS_CTX_GRAPH_KERNEL_FLAGS)
                            .value("grad_for_scalar", MsCtxParam::MS_CTX_GRAD_FOR_SCALAR)
                            .value("save_compile_cache", MsCtxParam::MS_CTX_SAVE_COMPILE_CACHE)
-                           .value("load_compile_cache", MsCtxParam::MS_CTX_LOAD_COMPILE_CACHE);
+                           .value("load_compile_cache", MsCtxParam::MS_CTX_LOAD_COMPILE_CACHE)
+                           .value("compile_cache_path", MsCtxParam::MS_CTX_COMPILE_CACHE_PATH)
+                           .value("enable_incremental_compile", MsCtxParam::MS_CTX_ENABLE_INCREMENTAL_COMPILE)
+                           .value("pynative_lazy_op_num", MsCtxParam::MS_CTX_PYNATIVE_LAZY_OP_NUM);
                          (void)py::class_<mindspore::MsContext, std::shared_ptr<mindspore::MsContext>>(*m, "MSContext")
                            .def_static("get_instance", &mindspore::MsContext::GetInstance, "Get ms context instance.")
                            .def("get_param", &mindspore::MsCtxGetParameter, "Get value of specified parameter.")
@@ -24,6 +24,23 @@
 
 namespace mindspore {
 namespace runtime {
+namespace {
+// Releases the swapped inputs of the kernel when the launch finishes, fails or throws, which keeps the running count
+// of their swap info from pinning them in the device memory.
+class SwapLaunchGuard {
+ public:
+  explicit SwapLaunchGuard(const KernelSwapInfo *kernel_swap_info) : kernel_swap_info_(kernel_swap_info) {}
+  ~SwapLaunchGuard() {
+    if (kernel_swap_info_ != nullptr) {
+      MemSwapScheduler::GetInstance().PostLaunchKernel(kernel_swap_info_);
+    }
+  }
+
+ private:
+  const KernelSwapInfo *kernel_swap_info_;
+};
+}  // namespace
+
 void KernelActor::Init() {
   // Set the number of actor running dependent messages.
   running_dependent_msg_num_ = SizeToInt(input_datas_num_ + input_controls_num_);
@@ -32,6 +49,7 @@ void KernelActor::Init() {
   real_input_num_ = AnfAlgo::GetInputTensorNum(kernel_);
   kernel_info_ = static_cast<KernelInfo *>(kernel_->kernel_info());
   is_dynamic_shape_ = AnfAlgo::IsDynamicShape(kernel_);
+  kernel_swap_info_ = MemSwapScheduler::GetInstance().FetchKernelSwapInfo(kernel_.get());
 
   // Init the device tensors and kernel launch info.
   copy_input_device_tensors_.resize(real_input_num_);
@@ -202,19 +220,46 @@ void KernelActor::OnMemoryAllocFinish(OpContext<DeviceTensor> *context) {
   MS_EXCEPTION_IF_NULL(context);
   MS_EXCEPTION_IF_NULL(kernel_);
   MS_EXCEPTION_IF_NULL(device_context_);
-  PreLaunchKernel(context);
+  // The swapped out inputs must be swapped in before the launch, and the swap in finish message resumes the launch.
+  if (kernel_swap_info_ != nullptr) {
+    auto aid = GetAID();
+    auto swap_in_callback = [aid, context]() { Async(aid, &KernelActor::OnSwapInFinish, context); };
+    if (!MemSwapScheduler::GetInstance().PreLaunchKernel(kernel_swap_info_, swap_in_callback)) {
+      running_dependent_msg_num_ = 1;
+      return;
+    }
+  }
+  LaunchKernel(context);
+}
+
+void KernelActor::OnSwapInFinish(OpContext<DeviceTensor> *context) {
+  MS_EXCEPTION_IF_NULL(context);
+  LaunchKernel(context);
+}
 
-  try {
-    auto ret = device_context_->LaunchKernel(kernel_, launch_info_.inputs_, launch_info_.workspaces_,
-                                             launch_info_.outputs_, is_dynamic_shape_);
-    if (!ret) {
-      std::string error_info = "Launch kernel failed: " + kernel_->fullname_with_scope();
+void KernelActor::LaunchKernel(OpContext<DeviceTensor> *context) {
+  MS_EXCEPTION_IF_NULL(context);
+  {
+    // The swapped inputs are released before the outputs are sent, since the consumers start the swap of the outputs.
+    SwapLaunchGuard swap_launch_guard(kernel_swap_info_);
+    if ((kernel_swap_info_ != nullptr) && !MemSwapScheduler::GetInstance().CheckInputsResident(kernel_swap_info_)) {
+      std::string error_info = "Swap in the inputs of kernel failed: " + kernel_->fullname_with_scope();
+      SET_OPCONTEXT_FAIL_RET_WITH_ERROR_BY_STRATEGY(strategy_, (*context), error_info);
+    }
+    PreLaunchKernel(context);
+
+    try {
+      auto ret = device_context_->LaunchKernel(kernel_, launch_info_.inputs_, launch_info_.workspaces_,
+                                               launch_info_.outputs_, is_dynamic_shape_);
+      if (!ret) {
+        std::string error_info = "Launch kernel failed: " + kernel_->fullname_with_scope();
+        SET_OPCONTEXT_FAIL_RET_WITH_ERROR_BY_STRATEGY(strategy_, (*context), error_info);
+      }
+    } catch (const std::exception &e) {
+      MsException::Instance().SetException();
+      std::string error_info = "Launch kernel exception: " + kernel_->fullname_with_scope();
       SET_OPCONTEXT_FAIL_RET_WITH_ERROR_BY_STRATEGY(strategy_, (*context), error_info);
     }
-  } catch (const std::exception &e) {
-    MsException::Instance().SetException();
-    std::string error_info = "Launch kernel exception: " + kernel_->fullname_with_scope();
-    SET_OPCONTEXT_FAIL_RET_WITH_ERROR_BY_STRATEGY(strategy_, (*context), error_info);
   }
 
   // Debug actor is blocked, must wait debug actor callback message to process continue.
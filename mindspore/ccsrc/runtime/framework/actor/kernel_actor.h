@@ -26,6 +26,7 @@
 #include "runtime/framework/actor/debug_aware_actor.h"
 #include "runtime/hardware/device_context.h"
 #include "runtime/framework/device_tensor_store.h"
+#include "runtime/framework/mem_swap_scheduler.h"
 #include "backend/kernel_compiler/kernel.h"
 #include "ir/anf.h"
 #include "ir/tensor.h"
@@ -50,6 +51,7 @@ class KernelActor : public DebugAwareActor {
         kernel_(kernel),
         kernel_info_(nullptr),
         is_dynamic_shape_(false),
+        kernel_swap_info_(nullptr),
         device_context_(device_context),
         memory_manager_aid_(memory_manager_aid),
         debug_aid_(debug_aid),
@@ -77,6 +79,8 @@ class KernelActor : public DebugAwareActor {
   void SendMemoryFreeReq(OpContext<DeviceTensor> *context) override;
   // The callback after memory alloc finished.
   void OnMemoryAllocFinish(OpContext<DeviceTensor> *context) override;
+  // The callback after the swapped out inputs are swapped in.
+  void OnSwapInFinish(OpContext<DeviceTensor> *context);
 
   // The debug related operation interface.
   void SendDebugReq(OpContext<DeviceTensor> *context) override;
@@ -95,6 +99,8 @@ class KernelActor : public DebugAwareActor {
   // In step mode, push the input tensors which contain valid device address into input_device_tensors_ directly.
   void PushInputDeviceTensor(const std::vector<TensorPtr> *input_tensors);
 
+  // Launch the kernel when the inputs are resident.
+  void LaunchKernel(OpContext<DeviceTensor> *context);
   // The processing before kernel launch: update the info of kernel launch.
   void PreLaunchKernel(OpContext<DeviceTensor> *context);
   // The processing after kernel launch: 1.erase input, 2.free memory, 3.send output.
@@ -109,6 +115,8 @@ class KernelActor : public DebugAwareActor {
   CNodePtr kernel_;
   KernelInfo *kernel_info_;
   bool is_dynamic_shape_;
+  // The memory swap info of kernel, nullptr means the kernel is not related to the memory swap.
+  const KernelSwapInfo *kernel_swap_info_;
 
   // The device interface of kernel launch.
   const DeviceContext *device_context_;
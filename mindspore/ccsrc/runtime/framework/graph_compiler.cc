@@ -19,6 +19,7 @@
 #include <map>
 #include <utility>
 #include "runtime/device/device_address.h"
+#include "runtime/framework/mem_swap_scheduler.h"
 #include "common/trans.h"
 #include "utils/convert_utils.h"
 #include "ir/tensor.h"
@@ -336,6 +337,8 @@ GraphId GraphCompiler::CompileGraphImpl(const KernelGraphPtr &graph, const Devic
   if (ms_context->get_param<int>(MS_CTX_EXECUTION_MODE) == kGraphMode) {
     // Create device address for all anf nodes of graph.
     CreateDeviceAddress(graph, device_context);
+    // Build the memory swap plan by the kernel execution order.
+    MemSwapScheduler::GetInstance().BuildSwapPlan(graph, device_context);
   }
 
   graph->set_is_all_nop_node(opt::IsAllNopNode(graph.get()));
@@ -18,6 +18,7 @@
 #include "runtime/framework/actor/memory_manager_actor.h"
 #include "runtime/framework/actor/debug_actor.h"
 #include "runtime/framework/actor/recorder_actor.h"
+#include "runtime/framework/mem_swap_scheduler.h"
 #include "runtime/hardware/device_context_manager.h"
 #include "mindrt/src/actor/actormgr.h"
 #include "mindrt/include/async/async.h"
@@ -431,6 +432,9 @@ void GraphScheduler::Clear() {
   // Clear the member of DeviceTensorStore.
   DeviceTensorStore::GetInstance().Clear();
 
+  // Clear the swap plan and the swapped data of MemSwapScheduler.
+  MemSwapScheduler::GetInstance().Clear();
+
   // Clear global maps.
   actors_.clear();
   actor_name_to_actor_.clear();
@@ -0,0 +1,253 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/framework/host_swap_storage.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include "utils/log_adapter.h"
+#include "utils/convert_utils_base.h"
+
+namespace mindspore {
+namespace runtime {
+namespace {
+constexpr size_t kWordSize = sizeof(uint32_t);
+constexpr size_t kBlockHeaderSize = 2;
+// The first word of the encoded stream.
+constexpr uint32_t kRawFormat = 0;
+constexpr uint32_t kRunLengthFormat = 1;
+
+void AppendTailWord(const void *data, size_t size, std::vector<uint32_t> *output) {
+  size_t tail_size = size % kWordSize;
+  if (tail_size == 0) {
+    return;
+  }
+  uint32_t tail_word = 0;
+  auto ret = memcpy_s(&tail_word, kWordSize, static_cast<const uint8_t *>(data) + size - tail_size, tail_size);
+  if (ret != EOK) {
+    MS_LOG(EXCEPTION) << "Memcpy error, errorno(" << ret << ")";
+  }
+  output->emplace_back(tail_word);
+}
+}  // namespace
+
+void CompressedHostSwapStorage::Compress(const void *data, size_t size, std::vector<uint32_t> *output) {
+  MS_EXCEPTION_IF_NULL(data);
+  MS_EXCEPTION_IF_NULL(output);
+  output->clear();
+  const auto words = static_cast<const uint32_t *>(data);
+  size_t word_num = size / kWordSize;
+  // The raw format costs the format word, the data words and the tail word.
+  size_t raw_encoded_num = 1 + (size + kWordSize - 1) / kWordSize;
+  output->emplace_back(kRunLengthFormat);
+  bool use_raw_format = false;
+  size_t i = 0;
+  while (i < word_num) {
+    size_t literal_start = i;
+    while (i < word_num && words[i] != 0) {
+      ++i;
+    }
+    size_t literal_num = i - literal_start;
+    size_t zero_start = i;
+    while (i < word_num && words[i] == 0) {
+      ++i;
+    }
+    // Give up the run length encoding as soon as it can't be smaller than the raw format.
+    if (output->size() + kBlockHeaderSize + literal_num >= raw_encoded_num) {
+      use_raw_format = true;
+      break;
+    }
+    output->emplace_back(static_cast<uint32_t>(literal_num));
+    output->emplace_back(static_cast<uint32_t>(i - zero_start));
+    output->insert(output->end(), words + literal_start, words + literal_start + literal_num);
+  }
+
+  if (use_raw_format) {
+    output->clear();
+    output->reserve(raw_encoded_num);
+    output->emplace_back(kRawFormat);
+    output->insert(output->end(), words, words + word_num);
+  }
+  AppendTailWord(data, size, output);
+}
+
+bool CompressedHostSwapStorage::Decompress(const std::vector<uint32_t> &input, void *data, size_t size) {
+  MS_EXCEPTION_IF_NULL(data);
+  auto words = static_cast<uint32_t *>(data);
+  size_t word_num = size / kWordSize;
+  size_t tail_size = size % kWordSize;
+  size_t tail_num = (tail_size != 0) ? 1 : 0;
+  if (input.size() < 1 + tail_num) {
+    return false;
+  }
+  size_t input_end = input.size() - tail_num;
+
+  if (input[0] == kRawFormat) {
+    if (input_end != 1 + word_num) {
+      return false;
+    }
+    if (word_num > 0) {
+      auto ret = memcpy_s(words, word_num * kWordSize, input.data() + 1, word_num * kWordSize);
+      if (ret != EOK) {
+        MS_LOG(ERROR) << "Memcpy error, errorno(" << ret << ")";
+        return false;
+      }
+    }
+  } else if (input[0] == kRunLengthFormat) {
+    size_t in_pos = 1;
+    size_t out_pos = 0;
+    while (in_pos < input_end) {
+      if (in_pos + kBlockHeaderSize > input_end) {
+        return false;
+      }
+      size_t literal_num = input[in_pos];
+      size_t zero_num = input[in_pos + 1];
+      in_pos += kBlockHeaderSize;
+      if ((in_pos + literal_num > input_end) || (out_pos + literal_num + zero_num > word_num)) {
+        return false;
+      }
+      for (size_t j = 0; j < literal_num; ++j) {
+        words[out_pos++] = input[in_pos++];
+      }
+      for (size_t j = 0; j < zero_num; ++j) {
+        words[out_pos++] = 0;
+      }
+    }
+    if (out_pos != word_num) {
+      return false;
+    }
+  } else {
+    return false;
+  }
+
+  if (tail_size != 0) {
+    auto ret = memcpy_s(static_cast<uint8_t *>(data) + word_num * kWordSize, tail_size, &input.back(), tail_size);
+    if (ret != EOK) {
+      MS_LOG(ERROR) << "Memcpy error, errorno(" << ret << ")";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CompressedHostSwapStorage::Put(const void *key, const void *data, size_t size) {
+  std::vector<uint32_t> compressed;
+  Compress(data, size, &compressed);
+  std::lock_guard<std::mutex> locker(mutex_);
+  auto &stored = compressed_data_[key];
+  stored_size_ -= stored.size() * kWordSize;
+  stored.swap(compressed);
+  stored.shrink_to_fit();
+  stored_size_ += stored.size() * kWordSize;
+  return true;
+}
+
+bool CompressedHostSwapStorage::Get(const void *key, void *data, size_t size) {
+  std::lock_guard<std::mutex> locker(mutex_);
+  const auto &iter = compressed_data_.find(key);
+  if (iter == compressed_data_.end()) {
+    MS_LOG(ERROR) << "Can't find the swapped data of key: " << key;
+    return false;
+  }
+  if (!Decompress(iter->second, data, size)) {
+    MS_LOG(ERROR) << "Decompress the swapped data failed, key: " << key << ", size: " << size;
+    return false;
+  }
+  return true;
+}
+
+void CompressedHostSwapStorage::Remove(const void *key) {
+  std::lock_guard<std::mutex> locker(mutex_);
+  const auto &iter = compressed_data_.find(key);
+  if (iter != compressed_data_.end()) {
+    stored_size_ -= iter->second.size() * kWordSize;
+    (void)compressed_data_.erase(iter);
+  }
+}
+
+void CompressedHostSwapStorage::Clear() {
+  std::lock_guard<std::mutex> locker(mutex_);
+  compressed_data_.clear();
+  stored_size_ = 0;
+}
+
+std::string FileSwapStorage::GetFileName(const void *key) const {
+  std::ostringstream file_name;
+  file_name << swap_path_ << "/mem_swap_" << key << ".bin";
+  return file_name.str();
+}
+
+bool FileSwapStorage::Put(const void *key, const void *data, size_t size) {
+  MS_EXCEPTION_IF_NULL(data);
+  auto file_name = GetFileName(key);
+  std::ofstream ofs(file_name, std::ios::out | std::ios::trunc | std::ios::binary);
+  if (!ofs.is_open()) {
+    MS_LOG(ERROR) << "Open swap file failed: " << file_name;
+    return false;
+  }
+  (void)ofs.write(static_cast<const char *>(data), SizeToLong(size));
+  if (!ofs.good()) {
+    MS_LOG(ERROR) << "Write swap file failed: " << file_name << ", size: " << size;
+    ofs.close();
+    return false;
+  }
+  ofs.close();
+
+  std::lock_guard<std::mutex> locker(mutex_);
+  auto &file_size = file_sizes_[key];
+  stored_size_ = stored_size_ - file_size + size;
+  file_size = size;
+  return true;
+}
+
+bool FileSwapStorage::Get(const void *key, void *data, size_t size) {
+  MS_EXCEPTION_IF_NULL(data);
+  auto file_name = GetFileName(key);
+  std::ifstream ifs(file_name, std::ios::in | std::ios::binary);
+  if (!ifs.is_open()) {
+    MS_LOG(ERROR) << "Open swap file failed: " << file_name;
+    return false;
+  }
+  (void)ifs.read(static_cast<char *>(data), SizeToLong(size));
+  bool ret = ifs.good() || (ifs.eof() && static_cast<size_t>(ifs.gcount()) == size);
+  ifs.close();
+  if (!ret) {
+    MS_LOG(ERROR) << "Read swap file failed: " << file_name << ", size: " << size;
+  }
+  return ret;
+}
+
+void FileSwapStorage::Remove(const void *key) {
+  std::lock_guard<std::mutex> locker(mutex_);
+  const auto &iter = file_sizes_.find(key);
+  if (iter == file_sizes_.end()) {
+    return;
+  }
+  (void)std::remove(GetFileName(key).c_str());
+  stored_size_ -= iter->second;
+  (void)file_sizes_.erase(iter);
+}
+
+void FileSwapStorage::Clear() {
+  std::lock_guard<std::mutex> locker(mutex_);
+  for (const auto &file_size : file_sizes_) {
+    (void)std::remove(GetFileName(file_size.first).c_str());
+  }
+  file_sizes_.clear();
+  stored_size_ = 0;
+}
+}  // namespace runtime
+}  // namespace mindspore
@@ -0,0 +1,95 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_HOST_SWAP_STORAGE_H_
+#define MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_HOST_SWAP_STORAGE_H_
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace runtime {
+// The storage tier of the swapped out device tensors, the key is the address of device tensor.
+class HostSwapStorage {
+ public:
+  HostSwapStorage() = default;
+  virtual ~HostSwapStorage() = default;
+
+  // Save the data of size to the storage, the old data of the same key is overwritten.
+  virtual bool Put(const void *key, const void *data, size_t size) = 0;
+  // Load the data of size from the storage to the data buffer.
+  virtual bool Get(const void *key, void *data, size_t size) = 0;
+  virtual void Remove(const void *key) = 0;
+  virtual void Clear() = 0;
+
+  // The real bytes occupied by the storage.
+  size_t stored_size() const { return stored_size_; }
+
+ protected:
+  size_t stored_size_{0};
+};
+using HostSwapStoragePtr = std::shared_ptr<HostSwapStorage>;
+
+// Keep the swapped out data in the host memory, compressed by the run length encoding of zero words, which is
+// effective for the activations after relu-like and dropout operators.
+class CompressedHostSwapStorage : public HostSwapStorage {
+ public:
+  CompressedHostSwapStorage() = default;
+  ~CompressedHostSwapStorage() override = default;
+
+  bool Put(const void *key, const void *data, size_t size) override;
+  bool Get(const void *key, void *data, size_t size) override;
+  void Remove(const void *key) override;
+  void Clear() override;
+
+  // The encoded stream starts with the format word. The run length format is the sequence of block: [literal word
+  // count, zero word count, literal words]. The data is kept in the raw format when the run length encoding is not
+  // smaller, so the encoded stream is never larger than the data by more than the format word. In both formats the
+  // tail bytes which are not aligned to the word are appended at the end.
+  static void Compress(const void *data, size_t size, std::vector<uint32_t> *output);
+  static bool Decompress(const std::vector<uint32_t> &input, void *data, size_t size);
+
+ private:
+  std::mutex mutex_;
+  std::unordered_map<const void *, std::vector<uint32_t>> compressed_data_;
+};
+
+// Write the swapped out data to the files in the swap directory, which is usually located on the local NVMe.
+class FileSwapStorage : public HostSwapStorage {
+ public:
+  explicit FileSwapStorage(const std::string &swap_path) : swap_path_(swap_path) {}
+  ~FileSwapStorage() override { Clear(); }
+
+  bool Put(const void *key, const void *data, size_t size) override;
+  bool Get(const void *key, void *data, size_t size) override;
+  void Remove(const void *key) override;
+  void Clear() override;
+
+ private:
+  std::string GetFileName(const void *key) const;
+
+  std::string swap_path_;
+  std::mutex mutex_;
+  std::unordered_map<const void *, size_t> file_sizes_;
+};
+}  // namespace runtime
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_HOST_SWAP_STORAGE_H_
@@ -0,0 +1,359 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/framework/mem_swap_scheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <set>
+#include <string>
+#include <utility>
+#include "backend/session/anf_runtime_algorithm.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace runtime {
+namespace {
+constexpr char kMemSwapEnableEnv[] = "MS_MEM_SWAP_ENABLE";
+constexpr char kMemSwapPathEnv[] = "MS_MEM_SWAP_PATH";
+// Only the device tensor not smaller than the threshold (4M) is worth to be swapped.
+constexpr size_t kSwapTensorSizeThreshold = 4 << 20;
+// The minimum kernel distance between two uses of the device tensor which triggers the swap.
+constexpr size_t kSwapDistanceThreshold = 32;
+// The kernel distance of the prefetch ahead of the use.
+constexpr size_t kPrefetchDistance = 8;
+}  // namespace
+
+MemSwapScheduler::MemSwapScheduler() {
+  enable_ = (common::GetEnv(kMemSwapEnableEnv) == "1");
+  if (!enable_) {
+    return;
+  }
+  auto swap_path = common::GetEnv(kMemSwapPathEnv);
+  if (swap_path.empty()) {
+    swap_storage_ = std::make_shared<CompressedHostSwapStorage>();
+    MS_LOG(INFO) << "Enable the memory swap to the compressed host memory.";
+  } else {
+    swap_storage_ = std::make_shared<FileSwapStorage>(swap_path);
+    MS_LOG(INFO) << "Enable the memory swap to the swap path: " << swap_path;
+  }
+}
+
+MemSwapScheduler::~MemSwapScheduler() { Clear(); }
+
+void MemSwapScheduler::BuildSwapPlan(const KernelGraphPtr &graph, const DeviceContext *device_context) {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(device_context);
+  if (!enable_ || (device_context->GetDeviceAddressType() != device::DeviceAddressType::kCPU)) {
+    return;
+  }
+
+  // The graph outputs are used by the other actors, which are out of the swap plan.
+  std::set<KernelWithIndex> graph_outputs;
+  for (const auto &output : AnfAlgo::GetAllOutputWithIndex(graph->output())) {
+    (void)graph_outputs.emplace(AnfAlgo::VisitKernelWithReturnType(output.first, output.second, false));
+  }
+
+  // Collect the use positions in the execution order of the candidate device tensors, the first use is the producer.
+  const auto &execution_order = graph->execution_order();
+  std::vector<DeviceTensor *> candidate_tensors;
+  std::unordered_map<DeviceTensor *, std::vector<size_t>> use_positions;
+  std::set<DeviceTensor *> invalid_tensors;
+  for (size_t i = 0; i < execution_order.size(); ++i) {
+    const auto &kernel = execution_order[i];
+    MS_EXCEPTION_IF_NULL(kernel);
+    for (size_t j = 0; j < AnfAlgo::GetInputTensorNum(kernel); ++j) {
+      auto device_tensor = AnfAlgo::GetPrevNodeMutableOutputAddr(kernel, j, false).get();
+      const auto &iter = use_positions.find(device_tensor);
+      if ((iter != use_positions.end()) && (iter->second.back() != i)) {
+        iter->second.emplace_back(i);
+      }
+    }
+
+    bool is_swappable_kernel = !AnfAlgo::IsCommunicationOp(kernel);
+    for (size_t j = 0; j < AnfAlgo::GetOutputTensorNum(kernel); ++j) {
+      if (!AnfAlgo::OutputAddrExist(kernel, j, false)) {
+        continue;
+      }
+      auto device_tensor = AnfAlgo::GetMutableOutputAddr(kernel, j, false).get();
+      MS_EXCEPTION_IF_NULL(device_tensor);
+      // The device tensor shared by the inplace kernels is written more than once, which can't be swapped.
+      if (use_positions.count(device_tensor) > 0) {
+        (void)invalid_tensors.insert(device_tensor);
+        continue;
+      }
+      KernelWithIndex output_with_index(kernel, j);
+      if (!is_swappable_kernel || (device_tensor->GetSize() < kSwapTensorSizeThreshold) ||
+          (graph_outputs.count(output_with_index) > 0) || graph->IsInRefOutputMap(output_with_index)) {
+        continue;
+      }
+      use_positions[device_tensor] = {i};
+      candidate_tensors.emplace_back(device_tensor);
+    }
+  }
+
+  // Swap out the device tensor at the largest use gap which is longer than the distance threshold.
+  size_t swap_tensor_num = 0;
+  size_t swap_tensor_size = 0;
+  for (const auto &device_tensor : candidate_tensors) {
+    const auto &positions = use_positions[device_tensor];
+    if ((invalid_tensors.count(device_tensor) > 0) || (positions.size() < 2)) {
+      continue;
+    }
+    size_t gap_index = 0;
+    for (size_t k = 1; k + 1 < positions.size(); ++k) {
+      if (positions[k + 1] - positions[k] > positions[gap_index + 1] - positions[gap_index]) {
+        gap_index = k;
+      }
+    }
+    if (positions[gap_index + 1] - positions[gap_index] < kSwapDistanceThreshold) {
+      continue;
+    }
+
+    auto swap_tensor = std::make_shared<SwapTensorInfo>(device_tensor, device_context, gap_index + 1);
+    swap_tensors_.emplace_back(swap_tensor);
+    auto get_kernel_swap_info = [this, &execution_order](size_t position) {
+      auto &kernel_swap_info = kernel_swap_infos_[execution_order[position].get()];
+      if (kernel_swap_info == nullptr) {
+        kernel_swap_info = std::make_shared<KernelSwapInfo>();
+      }
+      return kernel_swap_info;
+    };
+    get_kernel_swap_info(positions[0])->output_tensors_.emplace_back(swap_tensor.get());
+    for (size_t k = 1; k < positions.size(); ++k) {
+      get_kernel_swap_info(positions[k])->input_tensors_.emplace_back(swap_tensor.get());
+    }
+    size_t next_use_position = positions[gap_index + 1];
+    size_t prefetch_position = next_use_position > kPrefetchDistance ? next_use_position - kPrefetchDistance : 0;
+    prefetch_position = std::max(positions[gap_index] + 1, prefetch_position);
+    get_kernel_swap_info(prefetch_position)->prefetch_tensors_.emplace_back(swap_tensor.get());
+    ++swap_tensor_num;
+    swap_tensor_size += device_tensor->GetSize();
+  }
+
+  if ((swap_tensor_num > 0) && !swap_thread_.joinable()) {
+    stop_ = false;
+    swap_thread_ = std::thread(&MemSwapScheduler::SwapTaskLoop, this);
+  }
+  MS_LOG(INFO) << "The memory swap plan of graph " << graph->graph_id() << ": swap tensor number " << swap_tensor_num
+               << ", swap tensor size " << swap_tensor_size;
+}
+
+const KernelSwapInfo *MemSwapScheduler::FetchKernelSwapInfo(const AnfNode *kernel) const {
+  const auto &iter = kernel_swap_infos_.find(kernel);
+  if (iter == kernel_swap_infos_.end()) {
+    return nullptr;
+  }
+  return iter->second.get();
+}
+
+bool MemSwapScheduler::PreLaunchKernel(const KernelSwapInfo *kernel_swap_info,
+                                       const std::function<void()> &swap_in_callback) {
+  MS_EXCEPTION_IF_NULL(kernel_swap_info);
+  for (auto &swap_tensor : kernel_swap_info->prefetch_tensors_) {
+    std::lock_guard<std::mutex> locker(swap_tensor->mutex_);
+    RequestSwapIn(swap_tensor);
+  }
+
+  // The waiting count starts from one to avoid invoking the callback before all the input tensors are requested.
+  auto waiting_count = std::make_shared<std::atomic<size_t>>(1);
+  auto on_resident = [waiting_count, swap_in_callback]() {
+    if (waiting_count->fetch_sub(1) == 1) {
+      swap_in_callback();
+    }
+  };
+  for (auto &swap_tensor : kernel_swap_info->input_tensors_) {
+    std::lock_guard<std::mutex> locker(swap_tensor->mutex_);
+    // The running count keeps the tensor from being swapped out before the kernel launches.
+    ++swap_tensor->running_count_;
+    if (swap_tensor->state_ != SwapState::kResident) {
+      // The prefetch may be not in time, or the kernels are launched out of the execution order.
+      ++(*waiting_count);
+      swap_tensor->resident_callbacks_.emplace_back(on_resident);
+      RequestSwapIn(swap_tensor);
+    }
+  }
+  // Release the initial count, the callback is not invoked here if all the input tensors are resident.
+  return waiting_count->fetch_sub(1) == 1;
+}
+
+bool MemSwapScheduler::CheckInputsResident(const KernelSwapInfo *kernel_swap_info) const {
+  MS_EXCEPTION_IF_NULL(kernel_swap_info);
+  for (auto &swap_tensor : kernel_swap_info->input_tensors_) {
+    std::lock_guard<std::mutex> locker(swap_tensor->mutex_);
+    if (swap_tensor->device_tensor_->GetPtr() == nullptr) {
+      MS_LOG(ERROR) << "The device tensor is invalid after swap in, size: " << swap_tensor->device_tensor_->GetSize();
+      return false;
+    }
+  }
+  return true;
+}
+
+void MemSwapScheduler::PostLaunchKernel(const KernelSwapInfo *kernel_swap_info) {
+  MS_EXCEPTION_IF_NULL(kernel_swap_info);
+  auto try_swap_out = [this](SwapTensorInfo *swap_tensor) {
+    // Only swap out when all the uses before the gap have finished and no kernel is using it.
+    if ((swap_tensor->used_count_ == swap_tensor->swap_out_use_count_) && (swap_tensor->running_count_ == 0) &&
+        (swap_tensor->state_ == SwapState::kResident) && (swap_tensor->device_tensor_->GetPtr() != nullptr)) {
+      swap_tensor->state_ = SwapState::kSwappingOut;
+      PushSwapTask([this, swap_tensor]() { SwapOut(swap_tensor); });
+    }
+  };
+
+  // The producer resets the runtime state of the new step.
+  for (auto &swap_tensor : kernel_swap_info->output_tensors_) {
+    std::lock_guard<std::mutex> locker(swap_tensor->mutex_);
+    swap_tensor->used_count_ = 1;
+    swap_tensor->running_count_ = 0;
+    try_swap_out(swap_tensor);
+  }
+
+  for (auto &swap_tensor : kernel_swap_info->input_tensors_) {
+    std::lock_guard<std::mutex> locker(swap_tensor->mutex_);
+    --swap_tensor->running_count_;
+    ++swap_tensor->used_count_;
+    try_swap_out(swap_tensor);
+  }
+}
+
+void MemSwapScheduler::RequestSwapIn(SwapTensorInfo *swap_tensor) {
+  MS_EXCEPTION_IF_NULL(swap_tensor);
+  if ((swap_tensor->state_ == SwapState::kResident) || swap_tensor->swap_in_pending_) {
+    return;
+  }
+  swap_tensor->swap_in_pending_ = true;
+  PushSwapTask([this, swap_tensor]() { SwapIn(swap_tensor); });
+}
+
+void MemSwapScheduler::SwapOut(SwapTensorInfo *swap_tensor) {
+  MS_EXCEPTION_IF_NULL(swap_tensor);
+  auto device_tensor = swap_tensor->device_tensor_;
+  MS_EXCEPTION_IF_NULL(device_tensor);
+  MS_EXCEPTION_IF_NULL(swap_tensor->device_context_);
+  // No kernel uses the device tensor in the swapping out state, so the data is saved without the lock.
+  bool ret = swap_storage_->Put(device_tensor, device_tensor->GetPtr(), device_tensor->GetSize());
+
+  std::lock_guard<std::mutex> locker(swap_tensor->mutex_);
+  if (!ret) {
+    // Keep the device tensor resident when the swap storage fails.
+    MS_LOG(WARNING) << "Swap out the device tensor failed, size: " << device_tensor->GetSize();
+    swap_tensor->state_ = SwapState::kResident;
+  } else {
+    swap_tensor->device_context_->FreeMemory(device_tensor);
+    swap_tensor->state_ = SwapState::kSwappedOut;
+    swap_out_size_ += device_tensor->GetSize();
+  }
+}
+
+void MemSwapScheduler::SwapInData(SwapTensorInfo *swap_tensor) {
+  auto device_tensor = swap_tensor->device_tensor_;
+  // The waiting kernels check the device ptr and report the failure of swap in.
+  try {
+    if (!swap_tensor->device_context_->AllocateMemory(device_tensor, device_tensor->GetSize())) {
+      MS_LOG(ERROR) << "Memory isn't enough and alloc failed when swap in, size: " << device_tensor->GetSize();
+    } else if (!swap_storage_->Get(device_tensor, device_tensor->GetMutablePtr(), device_tensor->GetSize())) {
+      MS_LOG(ERROR) << "Load the swapped data failed, size: " << device_tensor->GetSize();
+      swap_tensor->device_context_->FreeMemory(device_tensor);
+    } else {
+      swap_in_size_ += device_tensor->GetSize();
+    }
+  } catch (const std::exception &e) {
+    MS_LOG(ERROR) << "Swap in the device tensor failed: " << e.what();
+    if (device_tensor->GetPtr() != nullptr) {
+      swap_tensor->device_context_->FreeMemory(device_tensor);
+    }
+  }
+}
+
+void MemSwapScheduler::SwapIn(SwapTensorInfo *swap_tensor) {
+  MS_EXCEPTION_IF_NULL(swap_tensor);
+  auto device_tensor = swap_tensor->device_tensor_;
+  MS_EXCEPTION_IF_NULL(device_tensor);
+  MS_EXCEPTION_IF_NULL(swap_tensor->device_context_);
+
+  std::vector<std::function<void()>> resident_callbacks;
+  {
+    std::lock_guard<std::mutex> locker(swap_tensor->mutex_);
+    swap_tensor->swap_in_pending_ = false;
+    if (swap_tensor->state_ == SwapState::kSwappedOut) {
+      if (device_tensor->GetPtr() != nullptr) {
+        // The memory of the swapped out tensor is allocated again by the producer of the next step, which holds the
+        // newer data, so the swapped data is dropped instead of overwriting the live memory.
+        MS_LOG(WARNING) << "The swapped out device tensor already holds the device memory, size: "
+                        << device_tensor->GetSize();
+      } else {
+        SwapInData(swap_tensor);
+      }
+      swap_storage_->Remove(device_tensor);
+      swap_tensor->state_ = SwapState::kResident;
+    }
+    // The tensor keeps resident when the swap out fails, and the waiting kernels are resumed as well.
+    resident_callbacks.swap(swap_tensor->resident_callbacks_);
+  }
+
+  // Invoke the callbacks without the lock, which send the messages to the waiting kernel actors.
+  for (const auto &callback : resident_callbacks) {
+    callback();
+  }
+}
+
+void MemSwapScheduler::PushSwapTask(const std::function<void()> &task) {
+  {
+    std::lock_guard<std::mutex> locker(task_mutex_);
+    swap_tasks_.push(task);
+  }
+  task_cond_.notify_one();
+}
+
+void MemSwapScheduler::SwapTaskLoop() {
+  while (true) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> locker(task_mutex_);
+      task_cond_.wait(locker, [this]() { return stop_ || !swap_tasks_.empty(); });
+      // Finish all the remaining swap tasks before exit, the waiting kernels depend on them.
+      if (swap_tasks_.empty()) {
+        return;
+      }
+      task = std::move(swap_tasks_.front());
+      swap_tasks_.pop();
+    }
+    try {
+      task();
+    } catch (const std::exception &e) {
+      MS_LOG(ERROR) << "Run the memory swap task failed: " << e.what();
+    }
+  }
+}
+
+void MemSwapScheduler::Clear() {
+  if (swap_thread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> locker(task_mutex_);
+      stop_ = true;
+    }
+    task_cond_.notify_all();
+    swap_thread_.join();
+  }
+  MS_LOG(INFO) << "The memory swap statistics: swap out size " << swap_out_size_ << ", swap in size "
+               << swap_in_size_;
+  kernel_swap_infos_.clear();
+  swap_tensors_.clear();
+  if (swap_storage_ != nullptr) {
+    swap_storage_->Clear();
+  }
+}
+}  // namespace runtime
+}  // namespace mindspore
@@ -0,0 +1,139 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_MEM_SWAP_SCHEDULER_H_
+#define MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_MEM_SWAP_SCHEDULER_H_
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "utils/ms_utils.h"
+#include "runtime/framework/device_tensor_store.h"
+#include "runtime/framework/host_swap_storage.h"
+#include "runtime/hardware/device_context.h"
+#include "backend/session/kernel_graph.h"
+
+namespace mindspore {
+namespace runtime {
+using mindspore::device::DeviceContext;
+using session::KernelWithIndex;
+
+enum class SwapState { kResident, kSwappingOut, kSwappedOut };
+
+// The swap info of the large and long-lived device tensor, which is swapped out after the uses before the largest
+// use gap in the execution order, and swapped in (prefetched) ahead of the use after the gap.
+struct SwapTensorInfo {
+  SwapTensorInfo(DeviceTensor *device_tensor, const DeviceContext *device_context, size_t swap_out_use_count)
+      : device_tensor_(device_tensor), device_context_(device_context), swap_out_use_count_(swap_out_use_count) {}
+  DeviceTensor *device_tensor_;
+  const DeviceContext *device_context_;
+  // The device tensor is swapped out when the used count reaches it, and the producer is the first use.
+  size_t swap_out_use_count_;
+
+  // The runtime state, the used count and the running count are reset by the producer in every step.
+  std::mutex mutex_;
+  SwapState state_{SwapState::kResident};
+  bool swap_in_pending_{false};
+  size_t used_count_{0};
+  size_t running_count_{0};
+  // The callbacks of the kernels waiting the tensor to be resident, which are invoked on the swap thread.
+  std::vector<std::function<void()>> resident_callbacks_;
+};
+using SwapTensorInfoPtr = std::shared_ptr<SwapTensorInfo>;
+
+// The swap info of kernel, which is fetched by the kernel actor in the initialization.
+struct KernelSwapInfo {
+  // The swap tensors produced by the kernel.
+  std::vector<SwapTensorInfo *> output_tensors_;
+  // The swap tensors consumed by the kernel, which must be resident before the kernel launch.
+  std::vector<SwapTensorInfo *> input_tensors_;
+  // The swap tensors which are prefetched before the kernel launch.
+  std::vector<SwapTensorInfo *> prefetch_tensors_;
+};
+using KernelSwapInfoPtr = std::shared_ptr<KernelSwapInfo>;
+
+// The memory swap scheduler spills the large, long-lived activations of the actor runtime to the host swap storage
+// (the compressed host memory or the files in the swap path) and prefetches them ahead of use. The swap plan is built
+// by the kernel execution order of graph in the graph compiler, and the swap tasks are executed in order on a
+// dedicated thread to keep the swap cost off the kernel launch path.
+// Enable by the environment variable MS_MEM_SWAP_ENABLE=1, and the swap directory is set by MS_MEM_SWAP_PATH.
+class MemSwapScheduler {
+ public:
+  static MemSwapScheduler &GetInstance() {
+    static MemSwapScheduler instance;
+    return instance;
+  }
+
+  bool enable() const { return enable_; }
+
+  // Build the swap plan of graph by the kernel execution order, only the kernel graph executed on CPU is supported.
+  void BuildSwapPlan(const KernelGraphPtr &graph, const DeviceContext *device_context);
+  // Get the swap info of kernel, return nullptr if the kernel is not related to the memory swap.
+  const KernelSwapInfo *FetchKernelSwapInfo(const AnfNode *kernel) const;
+
+  // Prefetch the swapped out tensors and request the input tensors to be resident before the kernel launch. Return
+  // true if all the input tensors are resident, otherwise the swap in is in progress and the callback is invoked on the
+  // swap thread once all of them become resident. The kernel must not block the actor thread for the swap in, but
+  // check the inputs by CheckInputsResident and launch in the callback.
+  bool PreLaunchKernel(const KernelSwapInfo *kernel_swap_info, const std::function<void()> &swap_in_callback);
+  // Check whether the input tensors are valid after the swap in.
+  bool CheckInputsResident(const KernelSwapInfo *kernel_swap_info) const;
+  // Update the used count and swap out the tensors which will not be used for a long distance after the kernel launch.
+  void PostLaunchKernel(const KernelSwapInfo *kernel_swap_info);
+
+  void Clear();
+
+ private:
+  MemSwapScheduler();
+  ~MemSwapScheduler();
+  DISABLE_COPY_AND_ASSIGN(MemSwapScheduler);
+
+  // The swap task is pushed into queue and executed by the swap thread in order, so the swap in task of tensor always
+  // runs after the swap out task.
+  void PushSwapTask(const std::function<void()> &task);
+  void SwapTaskLoop();
+  void SwapOut(SwapTensorInfo *swap_tensor);
+  void SwapIn(SwapTensorInfo *swap_tensor);
+  // Allocate the device memory and load the swapped data, needs hold the mutex of swap tensor.
+  void SwapInData(SwapTensorInfo *swap_tensor);
+  // Push the swap in task if the tensor is swapped out or swapping out, needs hold the mutex of swap tensor.
+  void RequestSwapIn(SwapTensorInfo *swap_tensor);
+
+  bool enable_{false};
+  HostSwapStoragePtr swap_storage_{nullptr};
+
+  std::vector<SwapTensorInfoPtr> swap_tensors_;
+  std::unordered_map<const AnfNode *, KernelSwapInfoPtr> kernel_swap_infos_;
+
+  std::thread swap_thread_;
+  std::mutex task_mutex_;
+  std::condition_variable task_cond_;
+  std::queue<std::function<void()>> swap_tasks_;
+  bool stop_{false};
+
+  // The statistics of swap.
+  size_t swap_out_size_{0};
+  size_t swap_in_size_{0};
+};
+}  // namespace runtime
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_MEM_SWAP_SCHEDULER_H_
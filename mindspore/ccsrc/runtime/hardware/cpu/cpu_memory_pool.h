@@ -39,7 +39,8 @@ class CPUMemoryPool : public DynamicMemPoolBestFit {
   size_t total_mem_size() override;
 
  private:
-  CPUMemoryPool() = default;
+  // The actor runtime allocates and frees memory from multiple threads, so the thread memory cache is enabled.
+  CPUMemoryPool() { set_enable_thread_mem_cache(true); }
   DISABLE_COPY_AND_ASSIGN(CPUMemoryPool);
 
   size_t total_used_memory_{0};
@@ -95,6 +95,7 @@ constexpr auto kFlattenGradOpName = "FlattenGrad";
 constexpr auto kExpandDimsOpName = "ExpandDims";
 constexpr auto kReshapeOpName = "Reshape";
 constexpr auto kTransposeOpName = "Transpose";
+constexpr auto kFusedElementwiseOpName = "FusedElementwise";
 constexpr auto kSplitOpName = "Split";
 constexpr auto kSplitVOpName = "SplitV";
 constexpr auto kSparseApplyAdagradOpName = "SparseApplyAdagrad";
@@ -442,6 +443,8 @@ constexpr auto kAttrRecursiveEnd = "recursive_end";
 constexpr auto kAttrRecursive = "recursive";
 constexpr auto kAttrMultiCallEnd = "multicall_end";
 constexpr auto kAttrProfilingIterEnd = "PROFILING_ITER_END";
+constexpr auto kAttrFusedOpNames = "fused_op_names";
+constexpr auto kAttrFusedOpInputs = "fused_op_inputs";
 
 // primal attr key name
 constexpr auto kPrimalAttrForwardNodeName = "forward_node_name";
@@ -17,13 +17,16 @@
 """Providing interface methods."""
 import types
 import sys
+import os
+import inspect
+import hashlib
 from collections import OrderedDict
 from functools import wraps
 
 from mindspore import context
 from mindspore import log as logger
 from .tensor import Tensor as MsTensor
-from .._c_expression import generate_key, Executor_, Tensor, MetaTensor, PynativeExecutor_
+from .._c_expression import generate_key, Executor_, Tensor, MetaTensor, PynativeExecutor_, typing
 from .._c_expression import verify_inputs_signature, init_exec_dataset, _set_dataset_mode_config, init_pipeline
 from ..parallel._ps_context import _is_role_pserver
 from ..parallel._utils import _get_device_num, _get_global_rank, _need_to_full, _check_full_batch, _to_full_tensor, \
@@ -357,6 +360,100 @@ def _parameter_broadcast(obj, auto_parallel_mode):
     _build_broadcast_graph(broadcast_params_dict, broadcast_phase)
 
 
+def _get_source_file(obj):
+    """Get the Python source file defining obj, or None for builtin and compiled objects."""
+    try:
+        source_file = inspect.getsourcefile(obj)
+    except TypeError:
+        return None
+    return os.path.realpath(source_file) if source_file else None
+
+
+def _get_compile_cache_dep_files(obj):
+    """
+    Get the source files of the network, whose changes make the compile cache of the network stale.
+
+    They are the files defining the classes of the network and of its sub cells, their base classes, and the functions,
+    classes and modules imported by these files.
+    """
+    objs = [obj]
+    if hasattr(obj, 'cells_and_names'):
+        objs.extend(cell for _, cell in obj.cells_and_names())
+    dep_files = set()
+    modules = set()
+    for item in objs:
+        item_types = [item] if isinstance(item, (types.FunctionType, types.MethodType)) else type(item).__mro__
+        for item_type in item_types:
+            source_file = _get_source_file(item_type)
+            if source_file:
+                dep_files.add(source_file)
+                modules.add(inspect.getmodule(item_type))
+    for module in modules:
+        if module is None:
+            continue
+        for value in vars(module).values():
+            if inspect.ismodule(value):
+                source_file = getattr(value, '__file__', None)
+                source_file = os.path.realpath(source_file) if source_file else None
+            elif inspect.isfunction(value) or inspect.isclass(value):
+                source_file = _get_source_file(value)
+            else:
+                continue
+            if source_file and source_file.endswith('.py'):
+                dep_files.add(source_file)
+    return sorted(dep_files)
+
+
+def _get_compile_cache_attr_repr(value):
+    """Get the representation of the attribute in the compile cache key, or None if it does not change the graph."""
+    if value is None or isinstance(value, (bool, int, float, str)):
+        return repr(value)
+    if isinstance(value, (tuple, list)):
+        items = [_get_compile_cache_attr_repr(item) for item in value]
+        return None if None in items else type(value).__name__ + '(' + ','.join(items) + ')'
+    if isinstance(value, typing.Type):
+        return str(value)
+    if isinstance(value, MetaTensor):
+        # The tensor attribute is a constant of the graph.
+        data_hash = hashlib.sha256(value.asnumpy().tobytes()).hexdigest() if isinstance(value, Tensor) else ''
+        return 'Tensor(' + str(value.shape) + ',' + str(value.dtype) + ',' + data_hash + ')'
+    return None
+
+
+def _get_compile_cache_net_info(obj):
+    """
+    Get the parameters and the hyperparameters of the network, which are not in its source files but change the
+    compiled graph.
+
+    They are the name, shape, dtype and requires_grad of every parameter, the scalar, sequence, type and tensor
+    attributes of the network and its sub cells, and the attributes of the primitives they hold.
+    """
+    from ..ops.primitive import Primitive
+    net_info = []
+    if hasattr(obj, 'parameters_and_names'):
+        for name, param in obj.parameters_and_names():
+            net_info.append('param:' + name + ':' + str(param.shape) + ':' + str(param.dtype) + ':' +
+                            str(param.requires_grad))
+    cells = [('', obj)]
+    if hasattr(obj, 'cells_and_names'):
+        cells.extend((name, cell) for name, cell in obj.cells_and_names() if cell is not obj)
+    ignore_list = getattr(type(obj), 'IGNORE_LIST', [])
+    for cell_name, cell in cells:
+        if not hasattr(cell, '__dict__'):
+            continue
+        for attr_name, value in sorted(vars(cell).items(), key=lambda item: item[0]):
+            if attr_name in ignore_list:
+                continue
+            if isinstance(value, Primitive):
+                attrs = [(key, _get_compile_cache_attr_repr(attr)) for key, attr in sorted(value.attrs.items())]
+                attr_repr = value.name + str([attr for attr in attrs if attr[1] is not None])
+            else:
+                attr_repr = _get_compile_cache_attr_repr(value)
+            if attr_repr is not None:
+                net_info.append('attr:' + cell_name + '.' + attr_name + ':' + attr_repr)
+    return net_info
+
+
 class _PynativeExecutor:
     """
     A pynative executor used to compile/manage/run single op.
@@ -528,6 +625,10 @@ class _Executor:
         enable_debug_runtime = context.get_context("enable_debug_runtime")
         enable_ge = context.get_context("enable_ge")
         use_vm = not enable_ge or (enable_debug_runtime and context.get_context("mode") == context.PYNATIVE_MODE)
+        if context.get_context("save_compile_cache") or context.get_context("load_compile_cache"):
+            from ..version import __version__ as ms_version
+            self._executor.set_compile_cache_dep(ms_version, _get_compile_cache_dep_files(obj),
+                                                 _get_compile_cache_net_info(obj))
         result = self._executor.compile(obj, args_list, phase, use_vm, self.queue_name)
         self.compile_cache[phase] = phase
         if not result:
@@ -605,6 +706,19 @@ class _Executor:
         """
         return self._executor.has_compiled(phase)
 
+    def is_incremental_compiled(self, phase='predict'):
+        """
+        Specify whether the graph is compiled incrementally from the graph specialized before for inputs of other
+        shapes.
+
+        Args:
+            phase (str): The phase name. Default: 'predict'.
+
+        Returns:
+            bool, specifies whether the specific graph has been compiled incrementally.
+        """
+        return self._executor.is_incremental_compiled(phase)
+
     def __call__(self, obj, *args, phase='predict'):
         if context.get_context("precompile_only") or _is_role_pserver():
             return None
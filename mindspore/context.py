@@ -223,6 +223,11 @@ class _Context:
             raise ValueError(f"Max call depth must be greater than 0, but got {max_call_depth}")
         self.set_param(ms_ctx_param.max_call_depth, max_call_depth)
 
+    def set_pynative_lazy_op_num(self, op_num):
+        if op_num < 0:
+            raise ValueError(f"PyNative lazy op num must be greater than or equal to 0, but got {op_num}")
+        self.set_param(ms_ctx_param.pynative_lazy_op_num, op_num)
+
     def set_profiling_options(self, option):
         if not isinstance(option, str):
             raise TypeError("The parameter option must be str.")
@@ -248,6 +253,12 @@ class _Context:
             raise ValueError("Context param max_device_memory should be in correct format! Such as \"3.5GB\"")
         self.set_param(ms_ctx_param.max_device_memory, max_device_memory_value)
 
+    def set_recompute_memory_budget(self, recompute_memory_budget):
+        if recompute_memory_budget != "0GB" and not Validator.check_str_by_regular(recompute_memory_budget,
+                                                                                   _re_pattern):
+            raise ValueError("Context param recompute_memory_budget should be in correct format! Such as \"3.5GB\"")
+        self.set_param(ms_ctx_param.recompute_memory_budget, float(recompute_memory_budget[:-2]))
+
     def set_print_file_path(self, file_path):
         """Add timestamp suffix to file name. Sets print file path."""
         print_file_path = os.path.realpath(file_path)
@@ -286,9 +297,11 @@ class _Context:
         'device_id': set_device_id,
         'auto_tune_mode': set_auto_tune_mode,
         'max_call_depth': set_max_call_depth,
+        'pynative_lazy_op_num': set_pynative_lazy_op_num,
         'profiling_options': set_profiling_options,
         'variable_memory_max_size': set_variable_memory_max_size,
         'max_device_memory': set_max_device_memory,
+        'recompute_memory_budget': set_recompute_memory_budget,
         'print_file_path': set_print_file_path,
         'env_config_path': set_env_config_path
     }
@@ -487,8 +500,8 @@ def _check_target_specific_cfgs(device, arg_key):
         'enable_auto_mixed_precision': ['Ascend'],
         'enable_dump': ['Ascend'],
         'save_dump_path': ['Ascend'],
-        'enable_graph_kernel': ['Ascend', 'GPU'],
-        'graph_kernel_flags': ['Ascend', 'GPU'],
+        'enable_graph_kernel': ['Ascend', 'GPU', 'CPU'],
+        'graph_kernel_flags': ['Ascend', 'GPU', 'CPU'],
         'enable_reduce_precision': ['Ascend'],
         'enable_profiling': ['Ascend'],
         'profiling_options': ['Ascend'],
@@ -514,7 +527,9 @@ def _check_target_specific_cfgs(device, arg_key):
                  enable_profiling=bool, profiling_options=str, enable_auto_mixed_precision=bool,
                  enable_graph_kernel=bool, check_bprop=bool, max_device_memory=str, print_file_path=str,
                  enable_sparse=bool, max_call_depth=int, env_config_path=str, graph_kernel_flags=str,
-                 save_compile_cache=bool, load_compile_cache=bool, grad_for_scalar=bool)
+                 save_compile_cache=bool, load_compile_cache=bool, compile_cache_path=str,
+                 enable_incremental_compile=bool, grad_for_scalar=bool, pynative_lazy_op_num=int,
+                 recompute_memory_budget=str)
 def set_context(**kwargs):
     """
     Set context for running environment.
@@ -540,18 +555,24 @@ def set_context(**kwargs):
     Common(CPU/GPU/Ascend)       Ascend                       GPU
     ===========================  ===========================  =================
     check_bprop                  print_file_path              max_device_memory
-    device_id                    enable_dump                  enable_graph_kernel
-    device_target                save_dump_path               graph_kernel_flags
-    enable_sparse                enable_graph_kernel
-    max_call_depth               enable_reduce_precision
-    mode                         enable_profiling
-    reserve_class_name_in_scope  profiling_options
-    save_graphs                  variable_memory_max_size
-    save_graphs_path             auto_tune_mode
-    env_config_path              graph_kernel_flags
+    device_id                    enable_dump
+    device_target                save_dump_path
+    enable_sparse                enable_reduce_precision
+    max_call_depth               enable_profiling
+    mode                         profiling_options
+    reserve_class_name_in_scope  variable_memory_max_size
+    save_graphs                  auto_tune_mode
+    save_graphs_path
+    env_config_path
     grad_for_scalar
     save_compile_cache
     load_compile_cache
+    compile_cache_path
+    enable_incremental_compile
+    pynative_lazy_op_num
+    recompute_memory_budget
+    enable_graph_kernel
+    graph_kernel_flags
     ===========================  ===========================  =================
 
     Args:
@@ -570,7 +591,7 @@ def set_context(**kwargs):
             `device_id = os.getenv("DEVICE_ID")` and the `save_graphs_path` can be set by
             `context.set_context(save_graphs_path="path/to/ir/files"+device_id)`.
         enable_graph_kernel (bool): Whether to enable graph kernel fusion to optimize network execution performance.
-             Default: False.
+             On CPU, chains of float32 elementwise operators are fused and executed as single loops. Default: False.
         graph_kernel_flags (str): Optimization options of graph kernel fusion. Experienced user only.
             For example, `context.set_context(graph_kernel_flags="--opt_level=2 --dump_as_text")`.
             Some general options:
@@ -658,10 +679,31 @@ def set_context(**kwargs):
         save_compile_cache (bool): Whether to cache the graph compiled by frontend. Default: False.
             This is an experimental prototype that is subject to change and/or deletion.
         load_compile_cache (bool): Whether to use the cache of the graph compiled by frontend.
-            When it is true, the graph compilation will skip the frontend compilation process. It means that
-            you should make sure the network has not been changed since the last execution. Currently we have
-            not support automatic checking the changes yet. Default: False.
+            When it is true, the graph compilation will skip the frontend compilation process if the cache has the
+            graph of the network. The cache entries are keyed by the version of MindSpore, the source files of the
+            network, the input signature and the context, so a changed network is compiled again instead of using a
+            stale graph. Default: False.
             This is an experimental prototype that is subject to change and/or deletion.
+        compile_cache_path (str): The directory of the compile cache. It holds the entries of several networks and
+            input signatures, and the least recently used entries are removed when there are too many of them.
+            Default: "compile_cache".
+        enable_incremental_compile (bool): Whether to reuse the graph specialized by the frontend when a network is
+            compiled again with inputs that differ in their shapes only, e.g. sequences of another length. The types
+            and shapes of the graph are inferred again, but the network is not parsed and analyzed from scratch.
+            A network whose graph reads the shapes of tensors as values, e.g. by `Shape`, is compiled from scratch, as
+            those values are constants of the graph. Only the stand alone and data parallel modes without dataset sink
+            mode are supported. Default: False.
+        pynative_lazy_op_num (int): The maximum number of operators recorded in PyNative mode before they are run.
+            If it is positive, the operators without gradient recording are not run one by one, but recorded into a
+            graph that is compiled, cached and run by the graph backend once a recorded output is read, e.g. by
+            `asnumpy` or print, an operator that can not be recorded is run, or the number of recorded operators
+            reaches this value. 0 runs every operator immediately. Default: 0.
+        recompute_memory_budget (str): The memory budget of each device for the activations in graph mode training,
+            in the format of max_device_memory, such as "20GB". If the estimated peak memory of the network exceeds
+            it, the forward operators whose outputs are kept for the backward pass are selected to be recomputed
+            automatically, in addition to the ones set by `recompute`, preferring the cheap operators with large
+            outputs. The outputs of MatMul and convolution operators are kept. "0GB" disables the selection.
+            Default: "0GB".
 
     Raises:
         ValueError: If input key is not an attribute in context.
@@ -782,6 +824,13 @@ def set_ps_context(**kwargs):
         enable_ps (bool): Whether to enable parameter server training mode.
                           Only after enable_ps is set True, the environment variables will be effective.
                           Default: False.
+        grad_compression (str): Codec of the gradients pushed by workers, which can be 'NONE', 'FP16', 'INT8' or
+                                'TOP_K'. 'TOP_K' sends only the values of largest magnitude of dense gradients and
+                                adds the unsent part to the next step. Default: 'NONE'.
+        grad_compression_ratio (float): Ratio of the gradient values sent with 'TOP_K', in (0, 1]. Default: 0.01.
+        embedding_storage_path (str): Directory on a local disk of each server where the embedding tables are stored
+                                      instead of memory, the rows in use being cached in memory. Default: '', which
+                                      keeps the tables in memory.
 
     Raises:
         ValueError: If input key is not the attribute in parameter server training mode context.
@@ -543,9 +543,27 @@ bool Tensor::ValueEqual(const Tensor &tensor) const {
   return (&tensor == this || (MetaTensor::operator==(tensor) && data_->equals(*tensor.data_)));
 }
 
+namespace {
+std::mutex inplace_write_hook_mutex;
+std::function<void()> inplace_write_hook = nullptr;
+}  // namespace
+
+void Tensor::set_inplace_write_hook(const std::function<void()> &hook) {
+  std::lock_guard<std::mutex> lock(inplace_write_hook_mutex);
+  inplace_write_hook = hook;
+}
+
 // assign value to this tensor
 Tensor &Tensor::AssignValue(const Tensor &tensor) {
   if (this != &tensor) {
+    std::function<void()> hook;
+    {
+      std::lock_guard<std::mutex> lock(inplace_write_hook_mutex);
+      hook = inplace_write_hook;
+    }
+    if (hook != nullptr) {
+      hook();
+    }
     MetaTensor::operator=(tensor);
     device_sync_ = tensor.device_sync_;
     data_ = tensor.data_;
@@ -621,6 +639,8 @@ std::string Tensor::ToStringRepr() const {
 void Tensor::data_sync(bool need_wait) const {
   if (need_wait) {
     Wait();
+  } else {
+    Flush();
   }
   if (device_sync_ == nullptr) {
     return;
@@ -23,6 +23,8 @@
 #include <numeric>
 #include <mutex>
 #include <condition_variable>
+#include <functional>
+#include <exception>
 
 #include "ir/device_sync.h"
 #include "ir/meta_tensor.h"
@@ -84,28 +86,67 @@ class WaitEvent : public ExceptionListener {
   void OnException() override { set_need_wait(false); }
 
   void Wait() const {
+    Flush();
     std::unique_lock<std::mutex> lock(mutex_);
     if (!need_wait_) {
       return;
     }
     MsException::Instance().SetExceptionListener(const_cast<WaitEvent *>(this));
-    cond_var_.wait(lock, [this] { return !need_wait_; });
+    cond_var_.wait(lock, [this] { return !need_wait_ || exception_ != nullptr; });
     MsException::Instance().SetExceptionListener(nullptr);
+    if (exception_ != nullptr) {
+      std::rethrow_exception(exception_);
+    }
     MsException::Instance().CheckException();
   }
 
   void set_need_wait(bool need_wait) {
     std::unique_lock<std::mutex> lock(mutex_);
     need_wait_ = need_wait;
+    exception_ = nullptr;
     if (!need_wait_) {
+      flush_func_ = nullptr;
       cond_var_.notify_all();
     }
   }
 
   bool need_wait() const { return need_wait_; }
 
+  // The flush function runs the work that sets the event, it is called by the first wait instead of blocking on
+  // another thread. It is used by the outputs of operators that are recorded but not run yet.
+  void set_flush_func(const std::function<void()> &flush_func) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    flush_func_ = flush_func;
+  }
+
+  // The event keeps waiting after the work fails, and every wait raises the exception of the work instead of
+  // returning the data that is never written.
+  void set_exception(const std::exception_ptr &exception) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    exception_ = exception;
+    flush_func_ = nullptr;
+    cond_var_.notify_all();
+  }
+
+  void Flush() const {
+    std::function<void()> flush_func;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (exception_ != nullptr) {
+        std::rethrow_exception(exception_);
+      }
+      if (!need_wait_ || flush_func_ == nullptr) {
+        return;
+      }
+      flush_func = flush_func_;
+    }
+    flush_func();
+  }
+
  private:
   bool need_wait_{false};
+  std::function<void()> flush_func_{nullptr};
+  std::exception_ptr exception_{nullptr};
   mutable std::mutex mutex_;
   mutable std::condition_variable cond_var_;
 };
@@ -336,6 +377,29 @@ class Tensor : public MetaTensor {
     event_ = nullptr;
   }
 
+  // Marks the tensor as the output of an operator that is not run yet, flush_func runs it when the tensor is waited.
+  void SetPending(const std::function<void()> &flush_func) {
+    SetNeedWait(true);
+    event_->set_flush_func(flush_func);
+  }
+
+  // Runs the operator of a pending tensor without waiting for other events.
+  void Flush() const {
+    if (event_ != nullptr) {
+      event_->Flush();
+    }
+  }
+
+  // Marks the pending tensor as failed, the exception is raised when the tensor is waited.
+  void SetException(const std::exception_ptr &exception) {
+    SetNeedWait(true);
+    event_->set_exception(exception);
+  }
+
+  // The hook is called before the data of any tensor is replaced in place, e.g. to run the operators that are
+  // recorded but not run yet and read the old data.
+  static void set_inplace_write_hook(const std::function<void()> &hook);
+
   void SetDeviceEvent(const std::shared_ptr<DeviceEvent> &device_event) { device_event_ = device_event; }
 
   void WaitDevice() {
@@ -60,6 +60,7 @@ MsContext::MsContext(const std::string &policy, const std::string &target) {
   }
 
   set_param<uint32_t>(MS_CTX_MAX_CALL_DEPTH, MAX_CALL_DEPTH_DEFAULT);
+  set_param<uint32_t>(MS_CTX_PYNATIVE_LAZY_OP_NUM, 0);
   set_param<std::string>(MS_CTX_DEVICE_TARGET, target);
   set_param<int>(MS_CTX_EXECUTION_MODE, kGraphMode);
   set_param<bool>(MS_CTX_ENABLE_TASK_SINK, true);
@@ -78,6 +79,7 @@ MsContext::MsContext(const std::string &policy, const std::string &target) {
   set_param<std::string>(MS_CTX_PROFILING_OPTIONS, "training_trace");
   set_param<bool>(MS_CTX_CHECK_BPROP_FLAG, false);
   set_param<float>(MS_CTX_MAX_DEVICE_MEMORY, kDefaultMaxDeviceMemory);
+  set_param<float>(MS_CTX_RECOMPUTE_MEMORY_BUDGET, 0);
   set_param<std::string>(MS_CTX_PRINT_FILE_PATH, "");
   set_param<bool>(MS_CTX_ENABLE_GRAPH_KERNEL, false);
   set_param<bool>(MS_CTX_ENABLE_SPARSE, false);
@@ -86,6 +88,8 @@ MsContext::MsContext(const std::string &policy, const std::string &target) {
   set_param<bool>(MS_CTX_GRAD_FOR_SCALAR, false);
   set_param<bool>(MS_CTX_SAVE_COMPILE_CACHE, false);
   set_param<bool>(MS_CTX_LOAD_COMPILE_CACHE, false);
+  set_param<std::string>(MS_CTX_COMPILE_CACHE_PATH, "compile_cache");
+  set_param<bool>(MS_CTX_ENABLE_INCREMENTAL_COMPILE, false);
   set_param<bool>(MS_CTX_ENABLE_MINDRT, false);
   set_param<bool>(MS_CTX_ALREADY_SET_ENABLE_MINDRT, false);
 
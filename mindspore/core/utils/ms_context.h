@@ -90,6 +90,7 @@ enum MsCtxParam : unsigned {
   MS_CTX_LOAD_COMPILE_CACHE,
   MS_CTX_ENABLE_MINDRT,
   MS_CTX_ALREADY_SET_ENABLE_MINDRT,
+  MS_CTX_ENABLE_INCREMENTAL_COMPILE,
   MS_CTX_TYPE_BOOL_END,
 
   // parameter of type int
@@ -103,11 +104,13 @@ enum MsCtxParam : unsigned {
   MS_CTX_GE_REF,
   MS_CTX_MAX_CALL_DEPTH,
   MS_CTX_TSD_REF,
+  MS_CTX_PYNATIVE_LAZY_OP_NUM,
   MS_CTX_TYPE_UINT32_END,
 
   // parameter of type float
   MS_CTX_TYPE_FLOAT_BEGIN = MS_CTX_TYPE_UINT32_END,
   MS_CTX_MAX_DEVICE_MEMORY = MS_CTX_TYPE_FLOAT_BEGIN,
+  MS_CTX_RECOMPUTE_MEMORY_BUDGET,
   MS_CTX_TYPE_FLOAT_END,
 
   // parameter of type string
@@ -124,6 +127,7 @@ enum MsCtxParam : unsigned {
   MS_CTX_TUNE_MODE,
   MS_CTX_GRAPH_KERNEL_FLAGS,
   MS_CTX_INFER_PRECISION_MODE,  // GPU inference precision mode configured by Serving or Unify API.
+  MS_CTX_COMPILE_CACHE_PATH,
   MS_CTX_TYPE_STRING_END,
 
   // parameter numbers of each type
@@ -214,6 +214,47 @@ class _CostModelContext:
             raise ValueError("Context handle is none in context!!!")
         return self._context_handle.get_costmodel_communi_bias()
 
+    def set_costmodel_profile(self, profile_file):
+        """
+        Set the file of the costs measured by the calibration mode. With a profile, the strategy-searching algorithms
+        compare the strategies by the measured times, and costmodel_alpha and costmodel_beta are set to 1.
+
+        Args:
+            profile_file (str): The profile saved by calibrate_cost_model. An empty string stops using the profile.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        self._context_handle.set_costmodel_profile(profile_file)
+
+    def get_costmodel_profile(self):
+        """
+        Get the file of the costs measured by the calibration mode.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        return self._context_handle.get_costmodel_profile()
+
+    def calibrate_cost_model(self, profile_file):
+        """
+        Measure the time of computation on the CPU and the time of AllGather among all the processes with MPI, save
+        them to the profile and use it. All the processes have to calibrate at the same time.
+
+        Args:
+            profile_file (str): The file to save the profile to.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        self._context_handle.calibrate_cost_model(profile_file)
+
     def set_multi_subgraphs(self, multi_subgraph):
         """
         Set the flag of ANF graph containing multiple subgraphs.
@@ -504,6 +545,7 @@ set_cost_model_context_func_map = {
     "costmodel_communi_threshold": cost_model_context().set_costmodel_communi_threshold,
     "costmodel_communi_const": cost_model_context().set_costmodel_communi_const,
     "costmodel_communi_bias": cost_model_context().set_costmodel_communi_bias,
+    "costmodel_profile": cost_model_context().set_costmodel_profile,
     "run_phase": cost_model_context().set_run_phase,
     "costmodel_allreduce_fusion_algorithm": cost_model_context().set_costmodel_allreduce_fusion_algorithm,
     "costmodel_allreduce_fusion_times": cost_model_context().set_costmodel_allreduce_fusion_times,
@@ -525,6 +567,7 @@ get_cost_model_context_func_map = {
     "costmodel_communi_threshold": cost_model_context().get_costmodel_communi_threshold,
     "costmodel_communi_const": cost_model_context().get_costmodel_communi_const,
     "costmodel_communi_bias": cost_model_context().get_costmodel_communi_bias,
+    "costmodel_profile": cost_model_context().get_costmodel_profile,
     "run_phase": cost_model_context().get_run_phase,
     "costmodel_allreduce_fusion_algorithm": cost_model_context().get_costmodel_allreduce_fusion_algorithm,
     "costmodel_allreduce_fusion_times": cost_model_context().get_costmodel_allreduce_fusion_times,
@@ -540,7 +583,7 @@ get_cost_model_context_func_map = {
 
 @args_type_check(device_memory_capacity=float, costmodel_alpha=float, costmodel_beta=float, costmodel_gamma=float,
                  costmodel_communi_threshold=float, costmodel_communi_const=float, costmodel_communi_bias=float,
-                 multi_subgraphs=bool, run_phase=int,
+                 costmodel_profile=str, multi_subgraphs=bool, run_phase=int,
                  costmodel_allreduce_fusion_algorithm=int, costmodel_allreduce_fusion_times=int,
                  costmodel_allreduce_fusion_tail_percent=float, costmodel_allreduce_fusion_tail_time=float,
                  costmodel_allreduce_fusion_allreduce_inherent_time=float,
@@ -561,11 +604,15 @@ def set_cost_model_context(**kwargs):
         costmodel_communi_threshold (float): A parameter used in adjusting communication calculation for practice.
         costmodel_communi_const (float): A parameter used in adjusting communication calculation for practice.
         costmodel_communi_bias (float): A parameter used in adjusting communication calculation for practice.
+        costmodel_profile (str): The file of the costs measured by calibrate_cost_model. With a profile, the costs of
+            computation and communication are the measured times, instead of being adjusted by the parameters above.
         run_phase (int): A parameter indicating which phase is running: training (0) or inference (1). Default: 0.
         costmodel_allreduce_fusion_algorithm (int): The allreduce fusion algorithm.
             0: bypass allreduce fusion;
             1: only use backward computation time to group allreduce;
-            2: use backward computation time and parameter gradient allreduce time to group allreduce.
+            2: use backward computation time and parameter gradient allreduce time to group allreduce;
+            3: fill buckets of parameter gradients in the order they become ready in backward computation, with the
+            bucket size simulated to hide the most allreduce time. The simulated overlap is logged at INFO level.
         costmodel_allreduce_fusion_times (int): The AllReduce fusion times of parameter gradients.
         costmodel_allreduce_fusion_tail_percent (float): A parameter used in allreduce fusion algorithm. The percentage
             of backward computing time corresponding to the last parameter gradients AllReduce in the whole backward
@@ -575,9 +622,10 @@ def set_cost_model_context(**kwargs):
         costmodel_allreduce_fusion_allreduce_inherent_time (float): A parameter used in allreduce fusion algorithm. The
             inherent cost time of AllReduce.
         costmodel_allreduce_fusion_allreduce_bandwidth (float): A parameter used in allreduce fusion algorithm. The
-            bandwidth of AllReduce.
+            bandwidth of AllReduce. In algorithm 3, it is the time of AllReduce for each byte.
         costmodel_allreduce_fusion_computation_time_parameter (float): A parameter used in allreduce fusion algorithm.
-            The parameter used to compute backward computation time.
+            The parameter used to compute backward computation time. In algorithm 3, the times of computation and
+            AllReduce are taken from costmodel_profile instead of these parameters if it is set.
 
 
 
@@ -610,6 +658,16 @@ def get_cost_model_context(attr_key):
     return get_func()
 
 
+def calibrate_cost_model(profile_file):
+    """
+    Measure the costs on this machine, save them to the profile and use it in the strategy-searching algorithms.
+
+    Args:
+        profile_file (str): The file to save the profile to.
+    """
+    cost_model_context().calibrate_cost_model(profile_file)
+
+
 def reset_cost_model_context():
     """Reset cost model context attributes."""
     cost_model_context().reset_cost_model()
@@ -73,7 +73,10 @@ _set_ps_context_func_map = {
     "dp_eps": ps_context().set_dp_eps,
     "dp_delta": ps_context().set_dp_delta,
     "dp_norm_clip": ps_context().set_dp_norm_clip,
-    "encrypt_type": ps_context().set_encrypt_type
+    "encrypt_type": ps_context().set_encrypt_type,
+    "grad_compression": ps_context().set_grad_compression,
+    "grad_compression_ratio": ps_context().set_grad_compression_ratio,
+    "embedding_storage_path": ps_context().set_embedding_storage_path
 }
 
 _get_ps_context_func_map = {
@@ -102,7 +105,10 @@ _get_ps_context_func_map = {
     "worker_step_num_per_iteration": ps_context().worker_step_num_per_iteration,
     "enable_ps_ssl": ps_context().enable_ssl,
     "scheduler_manage_port": ps_context().scheduler_manage_port,
-    "config_file_path": ps_context().config_file_path
+    "config_file_path": ps_context().config_file_path,
+    "grad_compression": ps_context().grad_compression,
+    "grad_compression_ratio": ps_context().grad_compression_ratio,
+    "embedding_storage_path": ps_context().embedding_storage_path
 }
 
 
@@ -175,6 +175,33 @@ class _AlgoParameterConfig():
         self.check_config_handle()
         return self._config_handle.get_dp_algo_approxi_epsilon()
 
+    def set_dp_algo_time_limit(self, time_limit):
+        """
+        Set the time limit of the DP algorithm in seconds. Out of the time limit, the DP algorithm keeps the cheapest
+        cost only for each strategy, and finishes with the best strategies found so far.
+        Default: 0, no limit.
+
+        Args:
+            time_limit (int): The time limit in seconds.
+
+        Raises:
+            ValueError: If time_limit is negative.
+        """
+        self.check_config_handle()
+        if time_limit < 0:
+            raise ValueError('Time_limit must be non-negative, but got {}'.format(time_limit))
+        self._config_handle.set_dp_algo_time_limit(time_limit)
+
+    def get_dp_algo_time_limit(self):
+        """
+        Get the time limit of the DP algorithm in seconds.
+
+        Returns:
+            The time limit.
+        """
+        self.check_config_handle()
+        return self._config_handle.get_dp_algo_time_limit()
+
     def reset_algo_parameters(self):
         """
         Reset algorithm parameter attributes.
@@ -205,7 +232,8 @@ set_algo_parameters_config_func_map = {
     "tensor_slice_align_enable": _algo_parameter_config().set_tensor_slice_align_enable,
     "tensor_slice_align_size": _algo_parameter_config().set_tensor_slice_align_size,
     "enable_algo_approxi": _algo_parameter_config().set_dp_algo_enable_approxi,
-    "algo_approxi_epsilon": _algo_parameter_config().set_dp_algo_approxi_epsilon}
+    "algo_approxi_epsilon": _algo_parameter_config().set_dp_algo_approxi_epsilon,
+    "algo_time_limit": _algo_parameter_config().set_dp_algo_time_limit}
 
 
 get_algo_parameters_config_func_map = {
@@ -214,12 +242,13 @@ get_algo_parameters_config_func_map = {
     "tensor_slice_align_enable": _algo_parameter_config().get_tensor_slice_align_enable,
     "tensor_slice_align_size": _algo_parameter_config().get_tensor_slice_align_size,
     "enable_algo_approxi": _algo_parameter_config().get_dp_algo_enable_approxi,
-    "algo_approxi_epsilon": _algo_parameter_config().get_dp_algo_approxi_epsilon}
+    "algo_approxi_epsilon": _algo_parameter_config().get_dp_algo_approxi_epsilon,
+    "algo_time_limit": _algo_parameter_config().get_dp_algo_time_limit}
 
 
 @args_type_check(tensor_slice_align_enable=bool, tensor_slice_align_size=int,
                  fully_use_devices=bool, elementwise_op_strategy_follow=bool,
-                 enable_algo_approxi=bool, algo_approxi_epsilon=float)
+                 enable_algo_approxi=bool, algo_approxi_epsilon=float, algo_time_limit=int)
 def set_algo_parameters(**kwargs):
     """
     Set algo parameter config.
@@ -237,6 +266,9 @@ def set_algo_parameters(**kwargs):
             subsequent operators. Default: False
         enable_algo_approxi (bool): Whether to enable the approximation in the DP algorithms. Default: False.
         algo_approxi_epsilon (float): The epsilon value used in the approximation DP algorithm. Default: 0.1.
+        algo_time_limit (int): The time limit of the DP algorithm in seconds. Out of the time limit, the DP algorithm
+            keeps the cheapest cost only for each strategy, and finishes with the best strategies found so far.
+            Default: 0, no limit.
 
     Raises:
         ValueError: If context keyword is not recognized.
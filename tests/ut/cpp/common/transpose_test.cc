@@ -0,0 +1,106 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <functional>
+#include <numeric>
+#include <vector>
+#include "common/common_test.h"
+#include "common/transpose.h"
+
+namespace mindspore {
+namespace common {
+class TransposePlanTest : public UT::Common {
+ public:
+  TransposePlanTest() = default;
+
+  template <typename T>
+  void CheckWithNaiveTranspose(const std::vector<size_t> &shape, const std::vector<size_t> &perm) {
+    size_t rank = shape.size();
+    size_t size = std::accumulate(shape.begin(), shape.end(), size_t(1), std::multiplies<size_t>());
+    std::vector<T> input(size);
+    for (size_t i = 0; i < size; ++i) {
+      input[i] = static_cast<T>(i * 7 + 3);
+    }
+    std::vector<size_t> strides(rank, 1);
+    for (size_t i = rank; i > 1; --i) {
+      strides[i - 2] = strides[i - 1] * shape[i - 1];
+    }
+    std::vector<T> expect(size);
+    std::vector<size_t> pos(rank, 0);
+    for (size_t i = 0; i < size; ++i) {
+      size_t input_pos = 0;
+      for (size_t j = 0; j < rank; ++j) {
+        input_pos += pos[j] * strides[perm[j]];
+      }
+      expect[i] = input[input_pos];
+      for (size_t j = rank; j > 0; --j) {
+        if (++pos[j - 1] < shape[perm[j - 1]]) {
+          break;
+        }
+        pos[j - 1] = 0;
+      }
+    }
+
+    std::vector<T> output(size);
+    TransposePlan plan(shape, perm, sizeof(T));
+    plan.Run(input.data(), output.data());
+    EXPECT_EQ(output, expect);
+  }
+};
+
+// axes that stay adjacent are merged and size 1 axes are dropped
+TEST_F(TransposePlanTest, test_simplify) {
+  TransposePlan plan({2, 3, 4, 5}, {0, 2, 3, 1}, sizeof(float));
+  EXPECT_EQ(plan.shape(), std::vector<size_t>({2, 3, 20}));
+  EXPECT_EQ(plan.perm(), std::vector<size_t>({0, 2, 1}));
+  TransposePlan identity({2, 1, 3, 4}, {0, 1, 2, 3}, sizeof(float));
+  EXPECT_EQ(identity.shape(), std::vector<size_t>({24}));
+  TransposePlan squeeze({6, 1, 7}, {1, 0, 2}, sizeof(float));
+  EXPECT_EQ(squeeze.shape(), std::vector<size_t>({42}));
+}
+
+// nchw and nhwc conversions use the tiled path with full and partial tiles
+TEST_F(TransposePlanTest, test_layout_transform) {
+  CheckWithNaiveTranspose<float>({2, 16, 8, 8}, {0, 2, 3, 1});
+  CheckWithNaiveTranspose<float>({2, 8, 8, 16}, {0, 3, 1, 2});
+  CheckWithNaiveTranspose<float>({3, 19, 5, 13}, {0, 2, 3, 1});
+  CheckWithNaiveTranspose<uint16_t>({2, 17, 9, 3}, {0, 2, 3, 1});
+  CheckWithNaiveTranspose<int8_t>({4, 33, 6, 7}, {2, 3, 1, 0});
+  CheckWithNaiveTranspose<double>({64, 130}, {1, 0});
+}
+
+// the innermost axis keeps its place and rows are copied
+TEST_F(TransposePlanTest, test_row_copy) {
+  CheckWithNaiveTranspose<float>({4, 5, 6, 7}, {2, 0, 1, 3});
+  CheckWithNaiveTranspose<int64_t>({3, 1, 4, 9}, {1, 2, 0, 3});
+  CheckWithNaiveTranspose<float>({}, {});
+}
+
+// large transposes are split over the thread pool
+TEST_F(TransposePlanTest, test_parallel) {
+  CheckWithNaiveTranspose<float>({8, 64, 33, 35}, {0, 2, 3, 1});
+  CheckWithNaiveTranspose<float>({3, 40, 50, 7, 9}, {4, 2, 0, 3, 1});
+  CheckWithNaiveTranspose<uint8_t>({257, 513}, {1, 0});
+}
+
+// invalid permutations are rejected
+TEST_F(TransposePlanTest, test_invalid_perm) {
+  EXPECT_ANY_THROW(TransposePlan({2, 3}, {0, 0}, sizeof(float)));
+  EXPECT_ANY_THROW(TransposePlan({2, 3}, {1, 0, 2}, sizeof(float)));
+  EXPECT_ANY_THROW(TransposePlan({2, 3}, {1, 0}, 3));
+}
+}  // namespace common
+}  // namespace mindspore
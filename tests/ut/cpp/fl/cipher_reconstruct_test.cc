@@ -0,0 +1,205 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/nnacl/fp32/add_fp32.h"
+#include "fl/armour/secure_protocol/random.h"
+#include "fl/armour/secure_protocol/key_agreement.h"
+#define private public
+#include "fl/armour/cipher/cipher_reconstruct.h"
+#undef private
+
+namespace mindspore {
+namespace armour {
+namespace {
+// Larger than the key stream block of AddRandomAESCTR and not a multiple of the vector lanes.
+constexpr size_t kFeatureMap = 10003;
+constexpr size_t kClientNum = 4;
+constexpr size_t kShareNum = 3;
+constexpr size_t kSecretsMinNum = 2;
+constexpr size_t kThreadNum = 4;
+constexpr float kSumTolerance = 1e-6;
+}  // namespace
+
+class TestCipherReconstruct : public UT::Common {
+ public:
+  TestCipherReconstruct() = default;
+  virtual ~TestCipherReconstruct() = default;
+
+  void SetUp() override {
+    // The prime is read as PRIME_MAX_LEN bytes, so it must not start with a zero byte.
+    mpz_t prime;
+    mpz_init(prime);
+    do {
+      ASSERT_EQ(GetRandomPrime(prime), 0);
+    } while (mpz_sizeinbase(prime, 256) != PRIME_MAX_LEN);
+    size_t prime_len = 0;
+    CipherInit &cipher_init = CipherInit::GetInstance();
+    mpz_export(cipher_init.publicparam_.prime, &prime_len, 1, 1, 0, 0, prime);
+    cipher_init.secrets_minnums_ = kSecretsMinNum;
+    cipher_init.featuremap_ = kFeatureMap;
+
+    SecretSharing sharing(prime);
+    for (size_t i = 0; i < kClientNum; ++i) {
+      std::string fl_id = "client" + std::to_string(i);
+      clients_.push_back(fl_id);
+      // The secret is the private key of the client, the combined secret drops its leading zero bytes.
+      std::vector<unsigned char> secret(SECRET_MAX_LEN, 0);
+      std::vector<unsigned char> public_key(SECRET_MAX_LEN, 0);
+      do {
+        std::unique_ptr<PrivateKey> private_key(KeyAgreement::GeneratePrivKey());
+        ASSERT_NE(private_key, nullptr);
+        size_t len = SECRET_MAX_LEN;
+        ASSERT_EQ(private_key->GetPrivateBytes(&len, secret.data()), 0);
+        len = SECRET_MAX_LEN;
+        ASSERT_EQ(private_key->GetPublicBytes(&len, public_key.data()), 0);
+      } while (secret[0] == 0);
+      secrets_.push_back(secret);
+      public_keys_[fl_id] = {public_key, public_key};
+
+      std::vector<Share> shares(kShareNum);
+      std::vector<Share *> share_ptrs;
+      for (auto &share : shares) {
+        share.data = nullptr;
+        share_ptrs.push_back(&share);
+      }
+      ASSERT_EQ(sharing.Split(kShareNum, kSecretsMinNum, reinterpret_cast<const char *>(secret.data()),
+                              SECRET_MAX_LEN, share_ptrs),
+                0);
+      for (const auto &share : shares) {
+        shares_[fl_id].push_back({fl_id, std::vector<unsigned char>(share.data, share.data + share.len),
+                                  static_cast<int>(share.index)});
+      }
+    }
+    mpz_clear(prime);
+  }
+  void TearDown() override {}
+
+ protected:
+  // The sum of the masks of the clients in the client list and of the keys the others share with their peers,
+  // expanded and added one by one.
+  std::vector<float> ExpectedNoise(const std::vector<std::string> &client_list) {
+    std::vector<float> noise(kFeatureMap, 0.0);
+    for (size_t i = 0; i < kClientNum; ++i) {
+      std::vector<unsigned char> secret = secrets_[i];
+      std::vector<std::pair<std::vector<unsigned char>, float>> seeds;
+      if (std::find(client_list.begin(), client_list.end(), clients_[i]) != client_list.end()) {
+        seeds.emplace_back(secret, -1.0f);
+      } else {
+        for (const auto &peer : clients_) {
+          if (peer == clients_[i]) {
+            continue;
+          }
+          std::vector<unsigned char> shared_key(SECRET_MAX_LEN, 0);
+          EXPECT_TRUE(CipherReconStruct::GetInstance().GetSharedKey(secret.data(), public_keys_[peer][1],
+                                                                    shared_key.data()));
+          seeds.emplace_back(shared_key, clients_[i] > peer ? 1.0f : -1.0f);
+        }
+      }
+      for (const auto &seed : seeds) {
+        std::vector<float> mask;
+        EXPECT_EQ(Random::RandomAESCTR(&mask, kFeatureMap, seed.first.data(), SECRET_MAX_LEN), 0);
+        for (size_t j = 0; j < kFeatureMap; ++j) {
+          noise[j] += seed.second * mask[j];
+        }
+      }
+    }
+    return noise;
+  }
+
+  std::vector<std::string> clients_;
+  std::vector<std::vector<unsigned char>> secrets_;
+  std::map<std::string, std::vector<std::vector<unsigned char>>> public_keys_;
+  std::map<std::string, std::vector<clientshare_str>> shares_;
+};
+
+// Feature: secure aggregation.
+// Description: expand a seed into a mask added to a buffer, across several key stream blocks.
+// Expectation: the buffer is increased by the mask of RandomAESCTR times the scale, exactly.
+TEST_F(TestCipherReconstruct, test_add_random_aes_ctr) {
+  std::vector<float> expect;
+  ASSERT_EQ(Random::RandomAESCTR(&expect, kFeatureMap, secrets_[0].data(), SECRET_MAX_LEN), 0);
+  std::vector<float> noise(kFeatureMap, 0.0);
+  ASSERT_EQ(Random::AddRandomAESCTR(1.0, secrets_[0].data(), SECRET_MAX_LEN, kFeatureMap, noise.data()), 0);
+  EXPECT_EQ(noise, expect);
+  ASSERT_EQ(Random::AddRandomAESCTR(-1.0, secrets_[0].data(), SECRET_MAX_LEN, kFeatureMap, noise.data()), 0);
+  EXPECT_EQ(noise, std::vector<float>(kFeatureMap, 0.0));
+}
+
+// Feature: secure aggregation.
+// Description: add the noise divided by the data size to the weights, as the unmask does.
+// Expectation: the vectorized result is the same as the scalar one.
+TEST_F(TestCipherReconstruct, test_element_add_div_scalar) {
+  std::vector<float> weight(kFeatureMap);
+  std::vector<float> noise(kFeatureMap);
+  for (size_t i = 0; i < kFeatureMap; ++i) {
+    weight[i] = static_cast<float>(i % 97) / 7;
+    noise[i] = static_cast<float>(i % 89) - 44;
+  }
+  const float data_size = 3;
+  std::vector<float> out(kFeatureMap);
+  ASSERT_EQ(ElementAddDivScalar(weight.data(), noise.data(), data_size, out.data(), kFeatureMap), 0);
+  for (size_t i = 0; i < kFeatureMap; ++i) {
+    EXPECT_EQ(out[i], weight[i] + noise[i] / data_size);
+  }
+}
+
+// Feature: secure aggregation.
+// Description: reconstruct the secrets of the clients from their shares on one thread and on several threads.
+// Expectation: both are the secrets the shares were split from.
+TEST_F(TestCipherReconstruct, test_combine_secrets_threaded) {
+  std::vector<const std::vector<clientshare_str> *> client_shares;
+  for (const auto &fl_id : clients_) {
+    client_shares.push_back(&shares_[fl_id]);
+  }
+  for (size_t thread_num : {static_cast<size_t>(1), kThreadNum}) {
+    std::vector<std::vector<char>> secrets;
+    ASSERT_TRUE(CipherReconStruct::GetInstance().CombineSecrets(client_shares, thread_num, &secrets));
+    ASSERT_EQ(secrets.size(), kClientNum);
+    for (size_t i = 0; i < kClientNum; ++i) {
+      EXPECT_EQ(std::vector<unsigned char>(secrets[i].begin(), secrets[i].end()), secrets_[i]);
+    }
+  }
+}
+
+// Feature: secure aggregation.
+// Description: combine the masks of two uploading clients and two dropped ones on one thread and on several threads.
+// Expectation: one thread sums the masks in order like the serial expansion, several threads only reorder the sum.
+TEST_F(TestCipherReconstruct, test_combine_mask_threaded) {
+  std::vector<std::string> client_list = {clients_[0], clients_[2]};
+  std::vector<float> expect = ExpectedNoise(client_list);
+
+  std::vector<float> serial_noise;
+  ASSERT_TRUE(
+    CipherReconStruct::GetInstance().CombineMask(clients_, public_keys_, shares_, client_list, 1, &serial_noise));
+  EXPECT_EQ(serial_noise, expect);
+
+  std::vector<float> threaded_noise;
+  ASSERT_TRUE(CipherReconStruct::GetInstance().CombineMask(clients_, public_keys_, shares_, client_list, kThreadNum,
+                                                           &threaded_noise));
+  ASSERT_EQ(threaded_noise.size(), kFeatureMap);
+  for (size_t i = 0; i < kFeatureMap; ++i) {
+    EXPECT_NEAR(threaded_noise[i], expect[i], kSumTolerance);
+  }
+}
+}  // namespace armour
+}  // namespace mindspore
@@ -0,0 +1,99 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <map>
+#include <string>
+
+#include "common/common_test.h"
+#include "fl/server/consistent_hash_ring.h"
+
+namespace mindspore {
+namespace fl {
+namespace server {
+class TestConsistentHashRing : public UT::Common {
+ public:
+  TestConsistentHashRing() = default;
+  virtual ~TestConsistentHashRing() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+TEST_F(TestConsistentHashRing, InsertFindErase) {
+  ConsistentHashRing ring(32);
+  for (uint32_t rank = 0; rank < 4; rank++) {
+    EXPECT_TRUE(ring.Insert(rank));
+  }
+  std::map<uint32_t, size_t> key_nums;
+  for (size_t i = 0; i < 1000; i++) {
+    key_nums[ring.Find("key" + std::to_string(i))]++;
+  }
+  EXPECT_EQ(key_nums.size(), 4);
+
+  // Only the keys of the erased server move.
+  uint32_t rank = ring.Find("key0");
+  EXPECT_TRUE(ring.Erase(rank));
+  EXPECT_NE(ring.Find("key0"), rank);
+  for (size_t i = 0; i < 1000; i++) {
+    EXPECT_NE(ring.Find("key" + std::to_string(i)), rank);
+  }
+}
+
+TEST_F(TestConsistentHashRing, RebalanceHotKeys) {
+  std::map<std::string, uint64_t> key_loads;
+  for (size_t i = 0; i < 64; i++) {
+    key_loads["counter" + std::to_string(i)] = (i % 8 == 0) ? 1000 : 10;
+  }
+  uint64_t total_load = 0;
+  for (const auto &key_load : key_loads) {
+    total_load += key_load.second;
+  }
+
+  ConsistentHashRing ring(32);
+  ConsistentHashRing same_ring(32);
+  for (uint32_t rank = 0; rank < 4; rank++) {
+    ring.Insert(rank);
+    same_ring.Insert(rank);
+  }
+  std::map<uint32_t, uint64_t> before;
+  for (const auto &key_load : key_loads) {
+    before[ring.Find(key_load.first)] += key_load.second;
+  }
+  std::map<uint32_t, uint64_t> after = ring.Rebalance(key_loads);
+  uint64_t max_before = 0;
+  uint64_t max_after = 0;
+  uint64_t sum_after = 0;
+  for (uint32_t rank = 0; rank < 4; rank++) {
+    max_before = std::max(max_before, before[rank]);
+    max_after = std::max(max_after, after[rank]);
+    sum_after += after[rank];
+  }
+  EXPECT_EQ(sum_after, total_load);
+  EXPECT_LE(max_after, max_before);
+
+  // The returned loads are the ones of the rebalanced ring, and the same loads build the same ring.
+  (void)same_ring.Rebalance(key_loads);
+  std::map<uint32_t, uint64_t> found;
+  for (const auto &key_load : key_loads) {
+    found[ring.Find(key_load.first)] += key_load.second;
+    EXPECT_EQ(ring.Find(key_load.first), same_ring.Find(key_load.first));
+  }
+  for (uint32_t rank = 0; rank < 4; rank++) {
+    EXPECT_EQ(found[rank], after[rank]);
+  }
+}
+}  // namespace server
+}  // namespace fl
+}  // namespace mindspore
@@ -0,0 +1,120 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+#define private public
+#define protected public
+#include "fl/server/kernel/fed_avg_kernel.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace fl {
+namespace server {
+namespace kernel {
+namespace {
+// Several chunks and a partial one at the end.
+constexpr size_t kWeightNum = 3 * kFedAvgChunkSize + 100;
+constexpr size_t kClientNum = 8;
+constexpr size_t kRoundNum = 3;
+}  // namespace
+
+class TestFedAvgKernel : public UT::Common {
+ public:
+  TestFedAvgKernel() = default;
+  virtual ~TestFedAvgKernel() = default;
+
+  void SetUp() override {
+    weight_.assign(kWeightNum, 0);
+    kernel_.name_ = "FedAvgTest.weight";
+    kernel_.chunk_num_ = (kWeightNum + kFedAvgChunkSize - 1) / kFedAvgChunkSize;
+    kernel_.chunk_mutexes_ = std::make_unique<std::mutex[]>(kernel_.chunk_num_);
+    weight_addr_ = CreateKernelAddress(weight_.data(), weight_.size() * sizeof(float));
+    data_size_addr_ = CreateKernelAddress(&data_size_, sizeof(size_t));
+    kernel_.SetParameterAddress({weight_addr_, data_size_addr_, nullptr, nullptr}, {}, {});
+  }
+  void TearDown() override {}
+
+ protected:
+  AddressPtr CreateKernelAddress(void *addr, size_t size) {
+    auto kernel_addr = std::make_shared<Address>();
+    kernel_addr->addr = addr;
+    kernel_addr->size = size;
+    return kernel_addr;
+  }
+
+  FedAvgKernel<float, size_t> kernel_;
+  std::vector<float> weight_;
+  size_t data_size_ = 0;
+  AddressPtr weight_addr_;
+  AddressPtr data_size_addr_;
+};
+
+// Feature: federated learning server.
+// Description: launch the federated average for the updates of several clients at the same time, for several rounds.
+// Expectation: the weight divided by the total data size is exactly the weighted average of the clients' weights.
+TEST_F(TestFedAvgKernel, test_concurrent_launch) {
+  for (size_t round = 0; round < kRoundNum; ++round) {
+    // The clients upload their weights multiplied by their data sizes. The values are small integers, so the sums are
+    // exact whatever order the updates are added in.
+    std::vector<size_t> data_sizes(kClientNum);
+    std::vector<std::vector<float>> new_weights(kClientNum, std::vector<float>(kWeightNum));
+    for (size_t client = 0; client < kClientNum; ++client) {
+      data_sizes[client] = client + round + 1;
+      for (size_t i = 0; i < kWeightNum; ++i) {
+        float value = static_cast<float>((i + client * 3 + round) % 11) - 5;
+        new_weights[client][i] = value * data_sizes[client];
+      }
+    }
+
+    std::vector<std::thread> threads;
+    for (size_t client = 0; client < kClientNum; ++client) {
+      threads.emplace_back([&, client]() {
+        std::vector<AddressPtr> inputs = {
+          weight_addr_, data_size_addr_,
+          CreateKernelAddress(new_weights[client].data(), new_weights[client].size() * sizeof(float)),
+          CreateKernelAddress(&data_sizes[client], sizeof(size_t))};
+        // The counter ring is not built in the test, so only the accumulation of the launch is checked.
+        (void)kernel_.Launch(inputs, {}, {});
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+
+    size_t total_data_size = 0;
+    std::vector<float> expect(kWeightNum, 0);
+    for (size_t client = 0; client < kClientNum; ++client) {
+      total_data_size += data_sizes[client];
+      for (size_t i = 0; i < kWeightNum; ++i) {
+        expect[i] += new_weights[client][i];
+      }
+    }
+    EXPECT_EQ(kernel_.accum_count_, kClientNum);
+    ASSERT_EQ(data_size_, total_data_size);
+    for (size_t i = 0; i < kWeightNum; ++i) {
+      ASSERT_EQ(weight_[i] / data_size_, expect[i] / total_data_size) << "index " << i << " of round " << round;
+    }
+    kernel_.Reset();
+  }
+}
+}  // namespace kernel
+}  // namespace server
+}  // namespace fl
+}  // namespace mindspore
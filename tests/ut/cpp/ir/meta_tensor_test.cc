@@ -374,5 +374,61 @@ TEST_F(TestTensor, TensorPyCast) {
   ASSERT_EQ(shape, shape3);
 }
 
+TEST_F(TestTensor, PendingTensorFlushTest) {
+  auto tensor = std::make_shared<Tensor>(kNumberTypeFloat32, std::vector<int64_t>{2});
+  int flush_count = 0;
+  tensor->SetPending([&tensor, &flush_count]() {
+    ++flush_count;
+    auto data = static_cast<float *>(tensor->data_c());
+    data[0] = 1.0;
+    data[1] = 2.0;
+    tensor->SetNeedWait(false);
+  });
+  ASSERT_TRUE(tensor->NeedWait());
+  tensor->data_sync(false);
+  ASSERT_EQ(flush_count, 1);
+  ASSERT_FALSE(tensor->NeedWait());
+  tensor->Wait();
+  ASSERT_EQ(flush_count, 1);
+  ASSERT_EQ(static_cast<float *>(tensor->data_c())[1], 2.0);
+}
+
+// The pending tensor of a failed flush keeps waiting, and every read raises the failure instead of returning the
+// data that is never written.
+TEST_F(TestTensor, PendingTensorFailureTest) {
+  auto tensor = std::make_shared<Tensor>(kNumberTypeFloat32, std::vector<int64_t>{2});
+  int flush_count = 0;
+  tensor->SetPending([&tensor, &flush_count]() {
+    ++flush_count;
+    try {
+      MS_LOG(EXCEPTION) << "Run the recorded ops failed";
+    } catch (const std::exception &) {
+      tensor->SetException(std::current_exception());
+      throw;
+    }
+  });
+  ASSERT_ANY_THROW(tensor->data_sync(false));
+  ASSERT_EQ(flush_count, 1);
+  ASSERT_TRUE(tensor->NeedWait());
+  ASSERT_ANY_THROW(tensor->Wait());
+  ASSERT_ANY_THROW(tensor->data_sync(false));
+  ASSERT_EQ(flush_count, 1);
+}
+
+// The in place write calls the hook before the data of the tensor is replaced.
+TEST_F(TestTensor, AssignValueHookTest) {
+  auto tensor = std::make_shared<Tensor>(kNumberTypeFloat32, std::vector<int64_t>{2});
+  auto value = std::make_shared<Tensor>(kNumberTypeFloat32, std::vector<int64_t>{2});
+  static_cast<float *>(value->data_c())[0] = 3.0;
+  float data_before_write = -1.0;
+  Tensor::set_inplace_write_hook(
+    [&tensor, &data_before_write]() { data_before_write = static_cast<float *>(tensor->data_c())[0]; });
+  static_cast<float *>(tensor->data_c())[0] = 1.0;
+  tensor->AssignValue(*value);
+  Tensor::set_inplace_write_hook(nullptr);
+  ASSERT_EQ(data_before_write, 1.0);
+  ASSERT_EQ(static_cast<float *>(tensor->data_c())[0], 3.0);
+}
+
 }  // namespace tensor
 }  // namespace mindspore
@@ -0,0 +1,123 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "backend/kernel_compiler/cpu/elementwise_broadcast_impl.h"
+
+namespace mindspore {
+namespace kernel {
+class ElementwiseBroadcastTest : public UT::Common {
+ public:
+  ElementwiseBroadcastTest() = default;
+
+  template <typename T, typename Op>
+  void CheckWithBroadcastIterator(const std::vector<size_t> &shape_a, const std::vector<size_t> &shape_b,
+                                  const std::vector<size_t> &output_shape, const Op &op) {
+    size_t size_a = std::accumulate(shape_a.begin(), shape_a.end(), size_t(1), std::multiplies<size_t>());
+    size_t size_b = std::accumulate(shape_b.begin(), shape_b.end(), size_t(1), std::multiplies<size_t>());
+    size_t output_size =
+      std::accumulate(output_shape.begin(), output_shape.end(), size_t(1), std::multiplies<size_t>());
+    std::vector<T> input_a(size_a);
+    std::vector<T> input_b(size_b);
+    for (size_t i = 0; i < size_a; ++i) {
+      input_a[i] = static_cast<T>(i % 13 + 1);
+    }
+    for (size_t i = 0; i < size_b; ++i) {
+      input_b[i] = static_cast<T>(i % 7 + 2);
+    }
+
+    std::vector<T> expect(output_size);
+    BroadcastIterator iter(shape_a, shape_b, output_shape);
+    iter.SetPos(0);
+    for (size_t i = 0; i < output_size; ++i) {
+      expect[i] = op(input_a[iter.GetInputPosA()], input_b[iter.GetInputPosB()]);
+      iter.GenNextPos();
+    }
+
+    std::vector<T> output(output_size);
+    BroadcastRowPlan plan(shape_a, shape_b, output_shape);
+    EXPECT_EQ(plan.output_size(), output_size);
+    BroadcastElementwise(plan, input_a.data(), input_b.data(), output.data(), op);
+    EXPECT_EQ(output, expect);
+  }
+};
+
+// same shape inputs collapse into a single contiguous row
+TEST_F(ElementwiseBroadcastTest, test_same_shape) {
+  BroadcastRowPlan plan({4, 8, 16}, {4, 8, 16}, {4, 8, 16});
+  EXPECT_EQ(plan.row_size(), 512);
+  EXPECT_EQ(plan.row_step_a(), 1);
+  EXPECT_EQ(plan.row_step_b(), 1);
+  CheckWithBroadcastIterator<float>({4, 8, 16}, {4, 8, 16}, {4, 8, 16}, AddFunc());
+  CheckWithBroadcastIterator<int>({4, 8, 16}, {4, 8, 16}, {4, 8, 16}, SubFunc());
+  CheckWithBroadcastIterator<int64_t>({4, 8, 16}, {4, 8, 16}, {4, 8, 16}, MulFunc());
+}
+
+// a scalar input is repeated along the only row
+TEST_F(ElementwiseBroadcastTest, test_scalar_broadcast) {
+  BroadcastRowPlan plan({1}, {3, 300}, {3, 300});
+  EXPECT_EQ(plan.row_size(), 900);
+  EXPECT_EQ(plan.row_step_a(), 0);
+  EXPECT_EQ(plan.row_step_b(), 1);
+  CheckWithBroadcastIterator<float>({1}, {3, 300}, {3, 300}, SubFunc());
+  CheckWithBroadcastIterator<float>({3, 300}, {}, {3, 300}, MulFunc());
+  CheckWithBroadcastIterator<int>({1, 1}, {3, 300}, {3, 300}, SubFunc());
+}
+
+// row broadcast reads the smaller input contiguously from the same position for every row
+TEST_F(ElementwiseBroadcastTest, test_row_broadcast) {
+  BroadcastRowPlan plan({64, 1, 32}, {32}, {64, 1, 32});
+  EXPECT_EQ(plan.row_size(), 32);
+  EXPECT_EQ(plan.row_step_a(), 1);
+  EXPECT_EQ(plan.row_step_b(), 1);
+  CheckWithBroadcastIterator<float>({64, 1, 32}, {32}, {64, 1, 32}, AddFunc());
+  CheckWithBroadcastIterator<float>({1, 33}, {129, 33}, {129, 33}, SubFunc());
+}
+
+// column broadcast repeats one element of the smaller input in every row
+TEST_F(ElementwiseBroadcastTest, test_column_broadcast) {
+  BroadcastRowPlan plan({65, 1}, {65, 40}, {65, 40});
+  EXPECT_EQ(plan.row_size(), 40);
+  EXPECT_EQ(plan.row_step_a(), 0);
+  EXPECT_EQ(plan.row_step_b(), 1);
+  CheckWithBroadcastIterator<float>({65, 1}, {65, 40}, {65, 40}, MulFunc());
+  CheckWithBroadcastIterator<int>({65, 40}, {65, 1}, {65, 40}, AddFunc());
+}
+
+// general broadcast with both inputs broadcast on different axes
+TEST_F(ElementwiseBroadcastTest, test_general_broadcast) {
+  auto op = [](const float &x, const float &y) { return x * y - y; };
+  CheckWithBroadcastIterator<float>({5, 1, 7, 1}, {1, 6, 1, 3}, {5, 6, 7, 3}, op);
+  CheckWithBroadcastIterator<float>({2, 3, 1, 5}, {3, 4, 1}, {2, 3, 4, 5}, AddFunc());
+  CheckWithBroadcastIterator<int>({1, 200}, {300, 1}, {300, 200}, SubFunc());
+}
+
+// comparison ops write bool outputs through the same rows
+TEST_F(ElementwiseBroadcastTest, test_bool_output) {
+  std::vector<float> input_a{1, 5, 3, 7};
+  std::vector<float> input_b{4};
+  bool output[4];
+  BroadcastRowPlan plan({2, 2}, {1}, {2, 2});
+  BroadcastElementwise(plan, input_a.data(), input_b.data(), output,
+                       [](const float &x, const float &y) -> bool { return x < y; });
+  EXPECT_TRUE(output[0]);
+  EXPECT_FALSE(output[1]);
+  EXPECT_TRUE(output[2]);
+  EXPECT_FALSE(output[3]);
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -0,0 +1,126 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <vector>
+#include "common/common_test.h"
+#define private public
+#define protected public
+#include "backend/kernel_compiler/cpu/fused_elementwise_cpu_kernel.h"
+#undef private
+#undef protected
+
+namespace mindspore {
+namespace kernel {
+class FusedElementwiseCpuKernelTest : public UT::Common {
+ public:
+  FusedElementwiseCpuKernelTest() : fused_(std::make_shared<FusedElementwiseCPUKernel>()) {}
+
+  void SetUp() override {
+    inputs_.clear();
+    workspace_.clear();
+    outputs_.clear();
+  }
+
+  AddressPtr CreateKernelAddress(void *addr) {
+    auto kernel_addr = std::make_shared<Address>();
+    kernel_addr->addr = addr;
+    return kernel_addr;
+  }
+
+  std::shared_ptr<FusedElementwiseCPUKernel> fused_;
+  std::vector<AddressPtr> inputs_;
+  std::vector<AddressPtr> workspace_;
+  std::vector<AddressPtr> outputs_;
+};
+
+// a chain of binary and unary ops spanning several blocks matches the unfused computation
+TEST_F(FusedElementwiseCpuKernelTest, test_fused_chain) {
+  const size_t size = 3000;
+  std::vector<float> x(size);
+  std::vector<float> y(size);
+  for (size_t i = 0; i < size; ++i) {
+    x[i] = static_cast<float>(i % 17) * 0.1f - 0.8f;
+    y[i] = static_cast<float>(i % 5) + 1.0f;
+  }
+  // out = Tanh(Mul(Add(x, y), x)) - y
+  fused_->scalar_inputs_ = {false, false};
+  fused_->output_size_ = size;
+  fused_->InitFusedOps({"Add", "Mul", "Tanh", "Sub"}, {0, 1, -1, 0, -2, -3, 1}, 2);
+  std::vector<float> output(size);
+  inputs_.push_back(CreateKernelAddress(x.data()));
+  inputs_.push_back(CreateKernelAddress(y.data()));
+  outputs_.push_back(CreateKernelAddress(output.data()));
+  fused_->Launch(inputs_, workspace_, outputs_);
+  for (size_t i = 0; i < size; ++i) {
+    float expect = std::tanh((x[i] + y[i]) * x[i]) - y[i];
+    EXPECT_FLOAT_EQ(output[i], expect);
+  }
+}
+
+// scalar inputs are repeated for every element
+TEST_F(FusedElementwiseCpuKernelTest, test_scalar_input) {
+  const size_t size = 700;
+  std::vector<float> x(size);
+  for (size_t i = 0; i < size; ++i) {
+    x[i] = static_cast<float>(i) - 350.0f;
+  }
+  float scale = 0.5f;
+  // out = Maximum(Relu(x), Mul(scale, x))
+  fused_->scalar_inputs_ = {false, true};
+  fused_->output_size_ = size;
+  fused_->InitFusedOps({"ReLU", "Mul", "Maximum"}, {0, 1, 0, -1, -2}, 2);
+  std::vector<float> output(size);
+  inputs_.push_back(CreateKernelAddress(x.data()));
+  inputs_.push_back(CreateKernelAddress(&scale));
+  outputs_.push_back(CreateKernelAddress(output.data()));
+  fused_->Launch(inputs_, workspace_, outputs_);
+  for (size_t i = 0; i < size; ++i) {
+    float expect = std::max(std::max(x[i], 0.0f), scale * x[i]);
+    EXPECT_FLOAT_EQ(output[i], expect);
+  }
+}
+
+// dividing by zero gives nan for zero and signed infinity otherwise, as the unfused RealDiv and Div kernels
+TEST_F(FusedElementwiseCpuKernelTest, test_divide_by_zero) {
+  std::vector<float> x = {1.0f, -2.0f, 0.0f, 3.0f, -0.0f, 6.0f};
+  std::vector<float> y = {0.0f, 0.0f, 0.0f, -0.0f, 2.0f, 3.0f};
+  const size_t size = x.size();
+  for (const auto &op_name : {"RealDiv", "Div"}) {
+    // out = Neg(Div(x, y))
+    fused_->scalar_inputs_ = {false, false};
+    fused_->output_size_ = size;
+    fused_->InitFusedOps({op_name, "Neg"}, {0, 1, -1}, 2);
+    std::vector<float> output(size);
+    inputs_ = {CreateKernelAddress(x.data()), CreateKernelAddress(y.data())};
+    outputs_ = {CreateKernelAddress(output.data())};
+    fused_->Launch(inputs_, workspace_, outputs_);
+    EXPECT_TRUE(std::isinf(output[0]) && output[0] < 0);
+    EXPECT_TRUE(std::isinf(output[1]) && output[1] > 0);
+    EXPECT_TRUE(std::isnan(output[2]));
+    EXPECT_TRUE(std::isinf(output[3]) && output[3] < 0);
+    EXPECT_FLOAT_EQ(output[4], 0.0f);
+    EXPECT_FLOAT_EQ(output[5], -2.0f);
+  }
+}
+
+// op inputs referring to later ops are rejected
+TEST_F(FusedElementwiseCpuKernelTest, test_invalid_op_inputs) {
+  EXPECT_ANY_THROW(fused_->InitFusedOps({"Neg", "Exp"}, {-2, -1}, 1));
+  EXPECT_ANY_THROW(fused_->InitFusedOps({"Add"}, {0}, 1));
+}
+}  // namespace kernel
+}  // namespace mindspore
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <map>
 #include <vector>
 #include "common/common_test.h"
 #include "backend/kernel_compiler/cpu/sparse_optimizer_cpu_kernel.h"
@@ -130,5 +131,58 @@ TEST_F(CommonUtilTest, BucketReduceSparseGradient2) {
     EXPECT_EQ(unique_grad.value_[i], expect_value[i]);
   }
 }
+
+TEST_F(CommonUtilTest, BucketReduceSparseGradient3) {
+  // Reduce the same gradient twice with each method, the second launches reuse the workspaces of the first ones.
+  const size_t indices_size = 1000;
+  const size_t stride = 5;
+  const size_t max_index = 97;
+  std::vector<int> indices(indices_size);
+  std::vector<float> grad(indices_size * stride);
+  std::map<int, std::vector<float>> expect;
+  for (size_t i = 0; i < indices_size; ++i) {
+    // Some indices are out of range and must be dropped.
+    indices[i] = static_cast<int>((i * 37) % (max_index + 3));
+    auto &expect_row = expect[indices[i]];
+    expect_row.resize(stride, 0);
+    for (size_t j = 0; j < stride; ++j) {
+      grad[i * stride + j] = static_cast<float>((i + j) % 7);
+      expect_row[j] += grad[i * stride + j];
+    }
+  }
+  expect.erase(expect.lower_bound(max_index), expect.end());
+
+  for (bool use_sort_reduce : {false, true, false, true}) {
+    std::vector<int> unique_indices(indices_size);
+    std::vector<float> summed_grad(indices_size * stride);
+    std::vector<int> tmp_indices(indices_size);
+    std::vector<float> tmp_grad(indices_size * stride);
+    SparseGradient<int> unique_grad({summed_grad.data(), unique_indices.data(), indices_size});
+    SparseGradient<int> workspace_grad({tmp_grad.data(), tmp_indices.data(), indices_size});
+    SparseGradient<int> input_grad({grad.data(), indices.data(), indices_size});
+
+    ReduceSparseGradientParam<int> param;
+    param.input_grad_ = &input_grad;
+    param.workspace_grad_ = &workspace_grad;
+    param.output_grad_ = &unique_grad;
+    param.max_index_ = max_index;
+    param.value_stride_ = stride;
+    param.use_sort_reduce_ = use_sort_reduce;
+    SparseOptimizerCPUKernel::BucketReduceSparseGradient(param);
+
+    EXPECT_EQ(unique_grad.indices_size_, expect.size());
+    std::map<int, size_t> seen;
+    for (size_t i = 0; i < unique_grad.indices_size_; ++i) {
+      int index = unique_grad.indices_[i];
+      EXPECT_EQ(seen.count(index), 0);
+      seen[index] = i;
+      auto iter = expect.find(index);
+      ASSERT_TRUE(iter != expect.end());
+      for (size_t j = 0; j < stride; ++j) {
+        EXPECT_EQ(unique_grad.value_[i * stride + j], iter->second[j]);
+      }
+    }
+  }
+}
 }  // namespace kernel
 }  // namespace mindspore
@@ -77,6 +77,35 @@ class TestOptOpt : public UT::Common {
     AnfNodePtr v_{nullptr};
   };
 
+  // Fuses Mul(Add(x, y), z) to P(x, y, z) when x is a parameter.
+  class MulAddFuser : public OptimizerCaller {
+   public:
+    AnfNodePtr operator()(const OptimizerPtr &, const AnfNodePtr &node) override {
+      auto mul = node->cast<CNodePtr>();
+      if (mul == nullptr || mul->inputs().size() != 3 || !IsPrimitiveCNode(mul->input(1), prim::kPrimAdd)) {
+        return nullptr;
+      }
+      auto add = mul->input(1)->cast<CNodePtr>();
+      if (add->inputs().size() != 3 || !add->input(1)->isa<Parameter>()) {
+        return nullptr;
+      }
+      return node->func_graph()->NewCNode({NewValueNode(P), add->input(1), add->input(2), mul->input(2)});
+    }
+  };
+
+  // Replaces Neg(Neg(x)) with x.
+  class NegNegEliminater : public OptimizerCaller {
+   public:
+    AnfNodePtr operator()(const OptimizerPtr &, const AnfNodePtr &node) override {
+      auto neg = node->cast<CNodePtr>();
+      if (neg == nullptr || neg->inputs().size() != 2 || !IsPrimitiveCNode(neg->input(1), prim::kPrimNeg)) {
+        return nullptr;
+      }
+      auto inner_neg = neg->input(1)->cast<CNodePtr>();
+      return inner_neg->inputs().size() == 2 ? inner_neg->input(1) : nullptr;
+    }
+  };
+
   void SetUp() {
     elim_Z = MakeSubstitution(std::make_shared<irpass::ArithmeticSimplify>(), "elim_Z", prim::kPrimScalarAdd);
     elim_R = MakeSubstitution(std::make_shared<irpass::PrimEliminater>(R), "elim_R", R);
@@ -177,6 +206,72 @@ TEST_F(TestOptOpt, ConstantVariable) {
   ASSERT_TRUE(CheckOpt(before, after, std::vector<SubstitutionPtr>({Qct_to_P})));
 }
 
+TEST_F(TestOptOpt, SubstitutionCandidates) {
+  auto any_node = MakeSubstitution(std::make_shared<QctToP>(), "any_node", [](const AnfNodePtr &) { return true; });
+  SubstitutionList list(std::vector<SubstitutionPtr>({elim_R, any_node, idempotent_P}));
+
+  FuncGraphPtr fg = std::make_shared<FuncGraph>();
+  auto x = fg->add_parameter();
+  auto p_node = fg->NewCNode({NewValueNode(P), x});
+  auto q_node = fg->NewCNode({NewValueNode(Q), x});
+  ASSERT_EQ(list.GetCandidates(p_node), std::vector<size_t>({1, 2}));
+  ASSERT_EQ(list.GetCandidates(q_node), std::vector<size_t>({1}));
+  ASSERT_EQ(list.GetCandidates(x), std::vector<size_t>({1}));
+}
+
+TEST_F(TestOptOpt, SubstitutionsToIRRounds) {
+  FuncGraphPtr fg = std::make_shared<FuncGraph>();
+  auto x = fg->add_parameter();
+  auto p1 = fg->NewCNode({NewValueNode(P), x});
+  auto p2 = fg->NewCNode({NewValueNode(P), p1});
+  auto p3 = fg->NewCNode({NewValueNode(P), p2});
+  auto p4 = fg->NewCNode({NewValueNode(P), p3});
+  fg->set_output(p4);
+
+  // Without traversing nodes first, each substitution sweeps the graph and the later rounds visit the changed nodes.
+  OptimizerPtr optimizer = std::make_shared<Optimizer>("ut_test", std::make_shared<pipeline::Resource>(), false);
+  SubstitutionList list(std::vector<SubstitutionPtr>({idempotent_P}));
+  ASSERT_TRUE(list(fg, optimizer));
+  ASSERT_TRUE(IsPrimitiveCNode(fg->output(), P));
+  ASSERT_EQ(fg->output()->cast<CNodePtr>()->input(1), x);
+}
+
+TEST_F(TestOptOpt, SubstitutionsToIRNestedPattern) {
+  // out = Mul(Add(Neg(Neg(x)), y), z)
+  auto make_graph = []() {
+    FuncGraphPtr fg = std::make_shared<FuncGraph>();
+    auto x = fg->add_parameter();
+    auto y = fg->add_parameter();
+    auto z = fg->add_parameter();
+    auto neg = fg->NewCNode({NewValueNode(prim::kPrimNeg), fg->NewCNode({NewValueNode(prim::kPrimNeg), x})});
+    auto add = fg->NewCNode({NewValueNode(prim::kPrimAdd), neg, y});
+    fg->set_output(fg->NewCNode({NewValueNode(prim::kPrimMul), add, z}));
+    return fg;
+  };
+  auto fuse_mul_add = MakeSubstitution(std::make_shared<MulAddFuser>(), "fuse_mul_add", prim::kPrimMul);
+  auto elim_neg_neg = MakeSubstitution(std::make_shared<NegNegEliminater>(), "elim_neg_neg", prim::kPrimNeg);
+  std::vector<SubstitutionPtr> substitutions({fuse_mul_add, elim_neg_neg});
+
+  // Removing Neg(Neg(x)) in the first round makes the Mul two levels above it match in the second round, as in a
+  // global sensitive list which sweeps the whole graph in every round.
+  FuncGraphPtr fg = make_graph();
+  OptimizerPtr optimizer = std::make_shared<Optimizer>("ut_test", std::make_shared<pipeline::Resource>(), false);
+  ASSERT_TRUE(SubstitutionList(substitutions)(fg, optimizer));
+  FuncGraphPtr full_sweep_fg = make_graph();
+  OptimizerPtr full_sweep_optimizer =
+    std::make_shared<Optimizer>("ut_test", std::make_shared<pipeline::Resource>(), false);
+  ASSERT_TRUE(SubstitutionList(substitutions, false, true)(full_sweep_fg, full_sweep_optimizer));
+
+  ASSERT_TRUE(IsPrimitiveCNode(fg->output(), P));
+  auto &fused_inputs = fg->output()->cast<CNodePtr>()->inputs();
+  ASSERT_EQ(fused_inputs.size(), 4);
+  ASSERT_EQ(fused_inputs[1], fg->parameters()[0]);
+  ASSERT_EQ(fused_inputs[3], fg->parameters()[2]);
+  equiv_node.clear();
+  equiv_graph.clear();
+  ASSERT_TRUE(Isomorphic(fg, full_sweep_fg, &equiv_graph, &equiv_node));
+}
+
 TEST_F(TestOptOpt, CSE) {
   // test a simple cse testcase test_f1
   FuncGraphPtr test_graph1 = getPyFun.CallAndParseRet("test_cse", "test_f1");
@@ -0,0 +1,116 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "abstract/abstract_value.h"
+#include "base/core_ops.h"
+#include "frontend/optimizer/recompute.h"
+#include "ir/func_graph.h"
+#include "ir/manager.h"
+#include "utils/ms_context.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+// Each activation holds 1024 float32, i.e. 4KB.
+constexpr float kActivationSize = 4096.0;
+constexpr float kGBToByte = 1024.0 * 1024.0 * 1024.0;
+}  // namespace
+
+class TestRecompute : public UT::Common {
+ public:
+  TestRecompute() {}
+  void SetUp();
+  void TearDown();
+
+  CNodePtr NewNode(const std::string &op, const std::vector<AnfNodePtr> &inputs, bool is_bprop = false) {
+    std::vector<AnfNodePtr> node_inputs{NewValueNode(std::make_shared<Primitive>(op))};
+    node_inputs.insert(node_inputs.end(), inputs.begin(), inputs.end());
+    auto node = graph_->NewCNode(node_inputs);
+    node->set_abstract(abstract_);
+    if (is_bprop) {
+      node->set_fullname_with_scope("Gradients/" + op + "-op" + std::to_string(node_inputs.size()));
+    }
+    return node;
+  }
+
+ public:
+  FuncGraphPtr graph_;
+  FuncGraphManagerPtr manager_;
+  AbstractBasePtr abstract_;
+  CNodePtr a_;
+  CNodePtr b_;
+  CNodePtr c_;
+};
+
+// The forward pass a = ReLU(x), b = Exp(a), c = Neg(b), out = Neg(c) keeps a, b and c for the backward pass, which
+// uses them in the reverse order. The estimated peak memory is 5 activations when the backward pass begins.
+void TestRecompute::SetUp() {
+  graph_ = std::make_shared<FuncGraph>();
+  abstract_ = std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{1024});
+  auto x = graph_->add_parameter();
+  x->set_abstract(abstract_);
+  auto dout = graph_->add_parameter();
+  dout->set_abstract(abstract_);
+  a_ = NewNode("ReLU", {x});
+  b_ = NewNode("Exp", {a_});
+  c_ = NewNode("Neg", {b_});
+  auto out = NewNode("Neg", {c_});
+  auto grad_c = NewNode("Mul", {c_, dout}, true);
+  auto grad_b = NewNode("Mul", {b_, grad_c}, true);
+  auto grad_a = NewNode("Mul", {a_, grad_b}, true);
+  auto output = graph_->NewCNode({NewValueNode(prim::kPrimMakeTuple), out, grad_a});
+  graph_->set_output(output);
+  manager_ = Manage(graph_, true);
+}
+
+void TestRecompute::TearDown() {
+  MsContext::GetInstance()->set_param<float>(MS_CTX_RECOMPUTE_MEMORY_BUDGET, 0);
+}
+
+// The estimated peak memory is within the budget, so no node is recomputed.
+TEST_F(TestRecompute, test_budget_not_exceeded) {
+  MsContext::GetInstance()->set_param<float>(MS_CTX_RECOMPUTE_MEMORY_BUDGET, 5 * kActivationSize / kGBToByte);
+  InsertRecomputedNodes(graph_);
+  ASSERT_EQ(a_->GetAttr(kAttrRecompute), nullptr);
+  ASSERT_EQ(b_->GetAttr(kAttrRecompute), nullptr);
+  ASSERT_EQ(c_->GetAttr(kAttrRecompute), nullptr);
+}
+
+// Recomputing a releases it through the backward pass of c and b, which fits the budget. c is used right after the
+// forward pass, so it is always kept.
+TEST_F(TestRecompute, test_recompute_within_budget) {
+  MsContext::GetInstance()->set_param<float>(MS_CTX_RECOMPUTE_MEMORY_BUDGET, 4 * kActivationSize / kGBToByte);
+  InsertRecomputedNodes(graph_);
+  ASSERT_NE(a_->GetAttr(kAttrRecompute), nullptr);
+  ASSERT_TRUE(GetValue<bool>(a_->GetAttr(kAttrRecompute)));
+  ASSERT_EQ(b_->GetAttr(kAttrRecompute), nullptr);
+  ASSERT_EQ(c_->GetAttr(kAttrRecompute), nullptr);
+}
+
+// The budget is below what recomputation can reach, so b is recomputed from the recomputed a as well.
+TEST_F(TestRecompute, test_recompute_chain) {
+  MsContext::GetInstance()->set_param<float>(MS_CTX_RECOMPUTE_MEMORY_BUDGET, 3 * kActivationSize / kGBToByte);
+  InsertRecomputedNodes(graph_);
+  ASSERT_NE(a_->GetAttr(kAttrRecompute), nullptr);
+  ASSERT_NE(b_->GetAttr(kAttrRecompute), nullptr);
+  ASSERT_EQ(c_->GetAttr(kAttrRecompute), nullptr);
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,77 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include "common/common_test.h"
+#include "frontend/parallel/allreduce_fusion/allreduce_bucket.h"
+
+namespace mindspore {
+namespace parallel {
+class TestAllreduceBucket : public UT::Common {
+ public:
+  TestAllreduceBucket() {}
+};
+
+namespace {
+// AllReduce takes 10 for the latency and 1 for each byte.
+double AllreduceTime(double size) { return 10.0 + size; }
+}  // namespace
+
+TEST_F(TestAllreduceBucket, test_Plan) {
+  AllreduceBucketPlanner planner(AllreduceTime);
+  // Listed out of the ready order.
+  std::vector<GradientReadiness> grads = {{30.0, 10.0}, {10.0, 10.0}, {20.0, 10.0}, {40.0, 10.0}};
+  auto buckets = planner.Plan(grads, 20.0);
+  std::vector<std::vector<size_t>> expect = {{1, 2}, {0, 3}};
+  ASSERT_EQ(buckets, expect);
+  buckets = planner.Plan(grads, 25.0);
+  expect = {{1, 2, 0}, {3}};
+  ASSERT_EQ(buckets, expect);
+}
+
+TEST_F(TestAllreduceBucket, test_Simulate) {
+  AllreduceBucketPlanner planner(AllreduceTime);
+  std::vector<GradientReadiness> grads = {{10.0, 10.0}, {20.0, 10.0}, {100.0, 10.0}};
+  // The first AllReduce runs in [20, 50], the second one in [100, 120].
+  auto simulation = planner.Simulate(grads, {{0, 1}, {2}});
+  ASSERT_DOUBLE_EQ(simulation.backward_time, 100.0);
+  ASSERT_DOUBLE_EQ(simulation.communication_time, 50.0);
+  ASSERT_DOUBLE_EQ(simulation.finish_time, 120.0);
+  ASSERT_DOUBLE_EQ(simulation.exposed_time(), 20.0);
+  ASSERT_DOUBLE_EQ(simulation.overlap_time(), 30.0);
+}
+
+TEST_F(TestAllreduceBucket, test_PlanBest) {
+  AllreduceBucketPlanner planner(AllreduceTime);
+  // The gradients are ready evenly through the backward pass, so buckets overlap the communication with it.
+  std::vector<GradientReadiness> grads;
+  for (size_t i = 1; i <= 8; ++i) {
+    grads.push_back({100.0 * i, 40.0});
+  }
+  BucketSimulation simulation;
+  auto buckets = planner.PlanBest(grads, 40.0, &simulation);
+  ASSERT_EQ(buckets.size(), 8);
+  ASSERT_DOUBLE_EQ(simulation.finish_time, 850.0);
+
+  // With a high latency, one bucket finishes earliest.
+  AllreduceBucketPlanner slow_planner([](double size) { return 1000.0 + size; });
+  buckets = slow_planner.PlanBest(grads, 40.0, &simulation);
+  ASSERT_EQ(buckets.size(), 1);
+  ASSERT_DOUBLE_EQ(simulation.finish_time, 2120.0);
+  ASSERT_DOUBLE_EQ(simulation.exposed_time(), 1320.0);
+}
+}  // namespace parallel
+}  // namespace mindspore
@@ -0,0 +1,92 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <common/common_test.h>
+#include "frontend/parallel/auto_parallel/cost_profile.h"
+#include "frontend/parallel/auto_parallel/costmodel.h"
+#include "frontend/parallel/costmodel_context.h"
+
+namespace mindspore {
+namespace parallel {
+namespace {
+constexpr auto kProfileFile = "./cost_profile_test.json";
+}  // namespace
+
+class TestCostProfile : public UT::Common {
+ public:
+  TestCostProfile() {}
+  void SetUp() {}
+  void TearDown() {
+    CostModelContext::GetInstance()->ResetCostModel();
+    (void)std::remove(kProfileFile);
+  }
+};
+
+TEST_F(TestCostProfile, test_CostCurve) {
+  CostCurve curve({{2000.0, 30.0}, {1000.0, 10.0}});
+  ASSERT_DOUBLE_EQ(curve.Evaluate(0), 0);
+  // From the origin below the first point.
+  ASSERT_DOUBLE_EQ(curve.Evaluate(500.0), 5.0);
+  // Between the points.
+  ASSERT_DOUBLE_EQ(curve.Evaluate(1500.0), 20.0);
+  // Along the last segment beyond the last point.
+  ASSERT_DOUBLE_EQ(curve.Evaluate(3000.0), 50.0);
+}
+
+TEST_F(TestCostProfile, test_SaveAndLoad) {
+  CostProfile profile(CostCurve({{1000.0, 1.0}}), CostCurve({{4.0, 20.0}, {4096.0, 40.0}}));
+  profile.Save(kProfileFile);
+  auto loaded = CostProfile::Load(kProfileFile);
+  ASSERT_EQ(loaded->computation().points(), profile.computation().points());
+  ASSERT_EQ(loaded->communication().points(), profile.communication().points());
+
+  std::ofstream fout(kProfileFile);
+  fout << "{\"computation\": [[1000, 1]]}";
+  fout.close();
+  EXPECT_ANY_THROW(CostProfile::Load(kProfileFile));
+}
+
+TEST_F(TestCostProfile, test_RefineForPracticalCost) {
+  CostProfile profile(CostCurve({{1000.0, 1.0}}), CostCurve({{4.0, 20.0}, {4096.0, 40.0}}));
+  profile.Save(kProfileFile);
+  auto context = CostModelContext::GetInstance();
+  context->set_costmodel_gamma(0.5);
+  context->set_costmodel_profile(kProfileFile);
+  ASSERT_DOUBLE_EQ(context->costmodel_alpha(), 1.0);
+  ASSERT_DOUBLE_EQ(context->costmodel_beta(), 1.0);
+
+  auto cost = std::make_shared<Cost>(2000.0, 8192.0);
+  cost->communication_without_parameter_ = 4096.0;
+  RefineForPracticalCost(cost, false);
+  ASSERT_DOUBLE_EQ(cost->computation_cost_, 2.0);
+  ASSERT_DOUBLE_EQ(cost->communication_without_parameter_, 40.0);
+  ASSERT_DOUBLE_EQ(cost->communication_cost_, 80.0);
+  ASSERT_DOUBLE_EQ(cost->communication_with_partial_para_, 60.0);
+
+  auto redis_cost = std::make_shared<Cost>(0.0, 0.0);
+  redis_cost->communication_redis_forward_ = 4.0;
+  redis_cost->communication_redis_backward_ = 0.0;
+  RefineForPracticalCost(redis_cost, true);
+  ASSERT_DOUBLE_EQ(redis_cost->communication_cost_, 20.0);
+  ASSERT_DOUBLE_EQ(redis_cost->communication_with_partial_para_, 20.0);
+
+  context->set_costmodel_profile("");
+  ASSERT_EQ(context->costmodel_profile(), nullptr);
+}
+}  // namespace parallel
+}  // namespace mindspore
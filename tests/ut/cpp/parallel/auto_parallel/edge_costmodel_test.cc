@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <set>
 #include "common/common_test.h"
 #include "ir/dtype/number.h"
 #include "frontend/parallel/device_manager.h"
@@ -115,6 +116,34 @@ TEST_F(TestEdgeCostModel, test_InitEdgeCost) {
   ASSERT_EQ(edge_m1_m2->InitEdgeCost(), SUCCESS);
 }
 
+TEST_F(TestEdgeCostModel, test_InitEdgeCost_SharedLayouts) {
+  std::string edge_name = "MatMul-MatMul";
+  std::shared_ptr<Edge> edge_m1_m2 = std::make_shared<Edge>(edge_name, matmul1, matmul2, 0, 0, false);
+  matmul1->GenerateStrategies(0);
+  matmul2->GenerateStrategies(0);
+  matmul1->AddSuccEdge(edge_m1_m2);
+  matmul2->AddPrevEdge(edge_m1_m2);
+  ASSERT_EQ(edge_m1_m2->InitEdgeCost(), SUCCESS);
+
+  std::set<Cost *> costs;
+  for (auto &output : edge_m1_m2->prev_op_output()) {
+    for (auto &input : edge_m1_m2->next_op_input()) {
+      auto cost_list = edge_m1_m2->GetCostList(output.first, input.first);
+      ASSERT_EQ(cost_list.size(), 1);
+      CostPtr expected;
+      ASSERT_EQ(edge_m1_m2->GetRedistributionCost(output.second[0].tensor_layout(), input.second[0].tensor_layout(),
+                                                  4, kFloat32, &expected),
+                SUCCESS);
+      RefineForPracticalCost(expected, true);
+      ASSERT_DOUBLE_EQ(cost_list[0]->computation_cost_, expected->computation_cost_);
+      ASSERT_DOUBLE_EQ(cost_list[0]->communication_cost_, expected->communication_cost_);
+      ASSERT_DOUBLE_EQ(cost_list[0]->communication_forward_, expected->communication_redis_forward_);
+      // Each pair of strategies owns its cost, even if the layouts are shared with other pairs.
+      ASSERT_TRUE(costs.insert(cost_list[0].get()).second);
+    }
+  }
+}
+
 TEST_F(TestEdgeCostModel, test_OpEliminationSetNewCost) {
   std::string edge_name = "MatMul-MatMul";
   std::shared_ptr<Edge> edge_m1_m2 = std::make_shared<Edge>(edge_name, matmul1, matmul2, 0, 0, false);
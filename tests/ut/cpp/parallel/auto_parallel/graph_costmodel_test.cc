@@ -445,5 +445,34 @@ TEST_F(TestCostGraph, test_SearchStrategyV2) {
   matmul1->SetSelectedStrategyAndCost(decision->merged_op_strategy_, decision->merged_op_cost_);
   edge_m1_m2->set_selected_cost(decision->edge_cost_);
 }
+
+TEST_F(TestCostGraph, test_SelectStrategiesByHash) {
+  std::string edge_name = "MatMul-MatMul";
+  std::shared_ptr<Edge> edge_m1_m2 = std::make_shared<Edge>(edge_name, matmul1, matmul2, 0, 0, false);
+  matmul1->GenerateStrategies(0);
+  matmul2->GenerateStrategies(0);
+  cost_graph.AddOperator(matmul1);
+  cost_graph.AddOperator(matmul2);
+
+  matmul1->AddSuccEdge(edge_m1_m2);
+  matmul2->AddPrevEdge(edge_m1_m2);
+  ASSERT_EQ(edge_m1_m2->InitEdgeCost(), SUCCESS);
+  cost_graph.AddEdge(matmul1, matmul2, edge_m1_m2);
+
+  auto graph_hash = cost_graph.HashOfStrategyCosts();
+  ASSERT_EQ(graph_hash, cost_graph.HashOfStrategyCosts());
+  auto last_stra_cost = matmul2->GetStrategyCost().back();
+  std::vector<StrategyPtr> strategies = {matmul1->GetStrategyCost()[0]->strategy_ptr,
+                                         NewStrategy(0, last_stra_cost->strategy_ptr->GetInputDim())};
+  ASSERT_TRUE(cost_graph.SelectStrategies(strategies));
+  ASSERT_EQ(matmul1->selected_strategy(), matmul1->GetStrategyCost()[0]->strategy_ptr);
+  ASSERT_EQ(matmul2->selected_strategy(), last_stra_cost->strategy_ptr);
+
+  strategies.pop_back();
+  ASSERT_FALSE(cost_graph.SelectStrategies(strategies));
+  strategies.push_back(NewStrategy(0, {{3, 1}, {1, 1}}));
+  ASSERT_FALSE(cost_graph.SelectStrategies(strategies));
+  ASSERT_EQ(matmul2->selected_strategy(), last_stra_cost->strategy_ptr);
+}
 }  // namespace parallel
 }  // namespace mindspore
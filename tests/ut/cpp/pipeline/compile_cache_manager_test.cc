@@ -0,0 +1,154 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "abstract/abstract_value.h"
+#include "base/core_ops.h"
+#include "ir/func_graph.h"
+#include "ir/manager.h"
+#include "pipeline/jit/compile_cache_manager.h"
+
+namespace mindspore {
+namespace pipeline {
+namespace {
+constexpr char kPhase[] = "0train.1625000000000000000.140000000000000";
+}  // namespace
+
+class TestCompileCacheManager : public UT::Common {
+ public:
+  TestCompileCacheManager() = default;
+  void SetUp() override;
+  void TearDown() override;
+
+  void WriteDepFile(const std::string &content) {
+    std::ofstream ofs(dep_file_, std::ios::trunc);
+    ofs << content;
+  }
+
+  std::string GetCompileKey(const std::vector<std::string> &net_info) {
+    CompileCacheManager manager(cache_dir_, "1.3.0", {dep_file_}, net_info);
+    manager.InitCompileKey(kPhase, args_spec_);
+    return manager.compile_key();
+  }
+
+  // The graph of the network out = Add(x, w).
+  FuncGraphPtr MakeFuncGraph() {
+    auto func_graph = std::make_shared<FuncGraph>();
+    auto abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{2, 3});
+    auto x = func_graph->add_parameter();
+    x->set_name("x");
+    x->set_abstract(abstract);
+    auto w = func_graph->add_parameter();
+    w->set_name("w");
+    w->set_abstract(abstract);
+    auto add = func_graph->NewCNode({NewValueNode(prim::kPrimAdd), x, w});
+    add->set_abstract(abstract);
+    func_graph->set_output(add);
+    return func_graph;
+  }
+
+  std::string work_dir_;
+  std::string cache_dir_;
+  std::string dep_file_;
+  abstract::AbstractBasePtrList args_spec_;
+  std::vector<std::string> net_info_{"param:w:(2, 3):Float32:True", "attr:.keep_prob:0.9"};
+};
+
+void TestCompileCacheManager::SetUp() {
+  work_dir_ = "/tmp/compile_cache_manager_test_" + std::to_string(getpid());
+  cache_dir_ = work_dir_ + "/cache";
+  dep_file_ = work_dir_ + "/net.py";
+  (void)mkdir(work_dir_.c_str(), S_IRWXU);
+  (void)mkdir(cache_dir_.c_str(), S_IRWXU);
+  WriteDepFile("class Net(nn.Cell):\n    pass\n");
+  args_spec_ = {std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{2, 3})};
+}
+
+void TestCompileCacheManager::TearDown() {
+  (void)system(("rm -rf " + work_dir_).c_str());
+}
+
+// The key is stable for the same network, and changes with the parameters, the hyperparameters, the source files
+// and the inputs of the network.
+TEST_F(TestCompileCacheManager, test_compile_key) {
+  auto key = GetCompileKey(net_info_);
+  ASSERT_FALSE(key.empty());
+  ASSERT_EQ(GetCompileKey(net_info_), key);
+
+  ASSERT_NE(GetCompileKey({"param:w:(3, 3):Float32:True", "attr:.keep_prob:0.9"}), key);
+  ASSERT_NE(GetCompileKey({"param:w:(2, 3):Float16:True", "attr:.keep_prob:0.9"}), key);
+  ASSERT_NE(GetCompileKey({"param:v:(2, 3):Float32:True", "attr:.keep_prob:0.9"}), key);
+  ASSERT_NE(GetCompileKey({"param:w:(2, 3):Float32:True", "attr:.keep_prob:0.5"}), key);
+  ASSERT_NE(GetCompileKey({"param:w:(2, 3):Float32:True"}), key);
+
+  args_spec_ = {std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{4, 3})};
+  ASSERT_NE(GetCompileKey(net_info_), key);
+  args_spec_ = {std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{2, 3})};
+  ASSERT_EQ(GetCompileKey(net_info_), key);
+
+  WriteDepFile("class Net(nn.Cell):\n    pass\n\n");
+  ASSERT_NE(GetCompileKey(net_info_), key);
+  (void)remove(dep_file_.c_str());
+  ASSERT_TRUE(GetCompileKey(net_info_).empty());
+}
+
+// The key does not depend on the addresses of the values held by the abstracts of the inputs, which differ from one
+// process to the next, but depends on the values of the inputs that are not broadened.
+TEST_F(TestCompileCacheManager, test_compile_key_of_another_process) {
+  auto key = GetCompileKey(net_info_);
+  auto arg = std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{2, 3});
+  arg->set_value(std::make_shared<AnyValue>());
+  args_spec_ = {arg};
+  ASSERT_EQ(GetCompileKey(net_info_), key);
+
+  args_spec_ = {std::make_shared<abstract::AbstractScalar>(static_cast<int64_t>(1))};
+  key = GetCompileKey(net_info_);
+  args_spec_ = {std::make_shared<abstract::AbstractScalar>(static_cast<int64_t>(2))};
+  ASSERT_NE(GetCompileKey(net_info_), key);
+  args_spec_ = {std::make_shared<abstract::AbstractScalar>(kInt64)};
+  ASSERT_NE(GetCompileKey(net_info_), key);
+}
+
+// The saved graph is loaded by the same key, and is not loaded after the parameters of the network change.
+TEST_F(TestCompileCacheManager, test_save_then_load) {
+  CompileCacheManager save_manager(cache_dir_, "1.3.0", {dep_file_}, net_info_);
+  save_manager.InitCompileKey(kPhase, args_spec_);
+  auto load_graph = save_manager.LoadFuncGraph(Manage(std::make_shared<FuncGraph>(), true));
+  ASSERT_EQ(load_graph, nullptr);
+  save_manager.SaveFuncGraph(MakeFuncGraph());
+
+  // The compile key index and the creation time in the phase differ from run to run.
+  CompileCacheManager load_manager(cache_dir_, "1.3.0", {dep_file_}, net_info_);
+  load_manager.InitCompileKey("1train.1625000000000000001.140000000000001", args_spec_);
+  ASSERT_EQ(load_manager.compile_key(), save_manager.compile_key());
+  load_graph = load_manager.LoadFuncGraph(Manage(std::make_shared<FuncGraph>(), true));
+  ASSERT_NE(load_graph, nullptr);
+  ASSERT_EQ(load_graph->parameters().size(), 2);
+  ASSERT_NE(load_graph->output(), nullptr);
+  ASSERT_TRUE(IsPrimitiveCNode(load_graph->output(), prim::kPrimAdd));
+
+  CompileCacheManager changed_manager(cache_dir_, "1.3.0", {dep_file_}, {"param:w:(3, 3):Float32:True"});
+  changed_manager.InitCompileKey(kPhase, args_spec_);
+  ASSERT_EQ(changed_manager.LoadFuncGraph(Manage(std::make_shared<FuncGraph>(), true)), nullptr);
+}
+}  // namespace pipeline
+}  // namespace mindspore
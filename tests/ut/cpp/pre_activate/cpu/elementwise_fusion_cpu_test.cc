@@ -0,0 +1,121 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <string>
+#include <vector>
+#include "common/backend_common_test.h"
+#include "common/py_func_graph_fetcher.h"
+#include "backend/kernel_compiler/kernel_build_info.h"
+#include "backend/optimizer/common/optimizer.h"
+#include "backend/optimizer/common/pass_manager.h"
+#include "backend/optimizer/cpu/elementwise_fusion_cpu.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "runtime/device/kernel_info.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace opt {
+class TestHWElementwiseFusionCPU : public BackendCommon {
+ public:
+  TestHWElementwiseFusionCPU() : get_py_fun_("gtest_input.pre_activate.elementwise_fusion_cpu_test", true) {}
+  ~TestHWElementwiseFusionCPU() override = default;
+
+  // Selects the float32 kernels of the default format for the graph built from the python function, then runs the
+  // fusion pass on it.
+  FuncGraphPtr RunFusion(const std::string &tag, const AbstractBasePtrList &args_spec_list) {
+    FuncGraphPtr g = get_py_fun_.CallAndParseRet("test_elementwise_fusion_cpu", tag);
+    EXPECT_NE(g, nullptr);
+    auto kernel_graph = GetKernelGraph(g, args_spec_list);
+    EXPECT_NE(kernel_graph, nullptr);
+    for (const auto &node : TopoSort(kernel_graph->get_return())) {
+      size_t input_num = 0;
+      if (AnfAlgo::IsRealCNodeKernel(node)) {
+        input_num = AnfAlgo::GetInputTensorNum(node);
+      } else if (!node->isa<Parameter>()) {
+        continue;
+      }
+      kernel::KernelBuildInfo::KernelBuildInfoBuilder builder;
+      builder.SetInputsFormat(std::vector<std::string>(input_num, kOpFormat_DEFAULT));
+      builder.SetInputsDeviceType(std::vector<TypeId>(input_num, kNumberTypeFloat32));
+      builder.SetOutputsFormat({kOpFormat_DEFAULT});
+      builder.SetOutputsDeviceType({kNumberTypeFloat32});
+      node->set_kernel_info(std::make_shared<device::KernelInfo>());
+      AnfAlgo::SetSelectKernelBuildInfo(builder.Build(), node.get());
+    }
+
+    auto optimizer = std::make_shared<opt::GraphOptimizer>();
+    auto pm = std::make_shared<opt::PassManager>();
+    pm->AddPass(std::make_shared<opt::ElementwiseFusionCPU>("elementwise_fusion_cpu"));
+    optimizer->AddPassManager(pm);
+    return optimizer->Optimize(kernel_graph);
+  }
+
+  // The op names of every fused node, and the names of the real kernels left out of the fused nodes.
+  static void GetKernels(const FuncGraphPtr &graph, std::vector<std::vector<std::string>> *fused_ops,
+                         std::vector<std::string> *unfused_ops) {
+    for (const auto &node : TopoSort(graph->get_return())) {
+      if (!AnfAlgo::IsRealCNodeKernel(node)) {
+        continue;
+      }
+      auto op_name = AnfAlgo::GetCNodeName(node);
+      if (op_name == kFusedElementwiseOpName) {
+        fused_ops->push_back(AnfAlgo::GetNodeAttr<std::vector<std::string>>(node, kAttrFusedOpNames));
+      } else {
+        unfused_ops->push_back(op_name);
+      }
+    }
+  }
+
+  UT::PyFuncGraphFetcher get_py_fun_;
+};
+
+// The chain out = ReLU(Add(Mul(x, y), x)) is fused into a single node, in the topological order of the ops.
+TEST_F(TestHWElementwiseFusionCPU, test_fuse_chain) {
+  auto x_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{4, 3});
+  auto new_graph = RunFusion("chain", {x_abstract, x_abstract});
+  std::vector<std::vector<std::string>> fused_ops;
+  std::vector<std::string> unfused_ops;
+  GetKernels(new_graph, &fused_ops, &unfused_ops);
+  ASSERT_EQ(fused_ops.size(), 1);
+  EXPECT_EQ(fused_ops[0], std::vector<std::string>({"Mul", "Add", "ReLU"}));
+  EXPECT_TRUE(unfused_ops.empty());
+}
+
+// The Mul is also an output of the graph, so its result must be kept and only the ReLU and the Add are fused.
+TEST_F(TestHWElementwiseFusionCPU, test_not_fuse_multi_user) {
+  auto x_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{4, 3});
+  auto new_graph = RunFusion("multi_user", {x_abstract, x_abstract});
+  std::vector<std::vector<std::string>> fused_ops;
+  std::vector<std::string> unfused_ops;
+  GetKernels(new_graph, &fused_ops, &unfused_ops);
+  ASSERT_EQ(fused_ops.size(), 1);
+  EXPECT_EQ(fused_ops[0], std::vector<std::string>({"ReLU", "Add"}));
+  EXPECT_EQ(unfused_ops, std::vector<std::string>({"Mul"}));
+}
+
+// The Add broadcasts y of shape (3,) to (4, 3), so it is not fused and only the ReLU and the Neg are fused.
+TEST_F(TestHWElementwiseFusionCPU, test_not_fuse_broadcast) {
+  auto x_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{4, 3});
+  auto y_abstract = std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{3});
+  auto new_graph = RunFusion("broadcast", {x_abstract, y_abstract});
+  std::vector<std::vector<std::string>> fused_ops;
+  std::vector<std::string> unfused_ops;
+  GetKernels(new_graph, &fused_ops, &unfused_ops);
+  ASSERT_EQ(fused_ops.size(), 1);
+  EXPECT_EQ(fused_ops[0], std::vector<std::string>({"ReLU", "Neg"}));
+  EXPECT_EQ(unfused_ops, std::vector<std::string>({"Add"}));
+}
+}  // namespace opt
+}  // namespace mindspore
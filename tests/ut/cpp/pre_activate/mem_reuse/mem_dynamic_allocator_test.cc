@@ -0,0 +1,234 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <condition_variable>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "backend/optimizer/mem_reuse/mem_dynamic_allocator.h"
+#include "common/common_test.h"
+
+namespace mindspore {
+namespace device {
+namespace {
+constexpr size_t kTestMemUnitSize = 1 << 20;
+constexpr size_t kTestTotalMemSize = 64 << 20;
+
+class TestMemPool : public DynamicMemPoolBestFit {
+ public:
+  explicit TestMemPool(bool enable_thread_mem_cache, size_t total_mem_size = kTestTotalMemSize)
+      : total_mem_size_(total_mem_size) {
+    set_enable_thread_mem_cache(enable_thread_mem_cache);
+    set_mem_alloc_unit_size(kTestMemUnitSize);
+  }
+  ~TestMemPool() override { ReleaseDeviceRes(); }
+
+  size_t AllocDeviceMem(size_t size, DeviceMemPtr *addr) override {
+    *addr = malloc(size);
+    if (*addr == nullptr) {
+      return 0;
+    }
+    alloc_size_ += size;
+    return size;
+  }
+  bool FreeDeviceMem(const DeviceMemPtr &addr) override {
+    free(addr);
+    return true;
+  }
+  size_t free_mem_size() override { return total_mem_size_ - alloc_size_; }
+  size_t total_mem_size() override { return total_mem_size_; }
+
+ private:
+  size_t total_mem_size_;
+  size_t alloc_size_{0};
+};
+}  // namespace
+
+class TestDynamicMemPool : public UT::Common {
+ public:
+  TestDynamicMemPool() {}
+};
+
+// Alloc and free memory without the thread memory cache, the memory buf is combined immediately.
+TEST_F(TestDynamicMemPool, test_alloc_free_without_thread_cache) {
+  TestMemPool mem_pool(false);
+  auto addr1 = mem_pool.AllocTensorMem(1000);
+  auto addr2 = mem_pool.AllocTensorMem(512);
+  ASSERT_NE(addr1, nullptr);
+  ASSERT_NE(addr2, nullptr);
+  ASSERT_EQ(mem_pool.used_mem_statistics(), 1536);
+  mem_pool.FreeTensorMem(addr1);
+  mem_pool.FreeTensorMem(addr2);
+  ASSERT_EQ(mem_pool.used_mem_statistics(), 0);
+  ASSERT_EQ(mem_pool.used_mem_peak_statistics(), 1536);
+  auto fragment_info = mem_pool.fragment_mem_statistics();
+  ASSERT_EQ(fragment_info.idle_mem_buf_count_, 1);
+  ASSERT_EQ(fragment_info.largest_idle_mem_buf_size_, kTestMemUnitSize);
+  ASSERT_EQ(fragment_info.fragmentation_ratio_, 0);
+}
+
+// Free the small memory buf to the thread memory cache and alloc the same size again.
+TEST_F(TestDynamicMemPool, test_thread_cache_reuse) {
+  TestMemPool mem_pool(true);
+  auto addr1 = mem_pool.AllocTensorMem(1024);
+  ASSERT_NE(addr1, nullptr);
+  mem_pool.FreeTensorMem(addr1);
+  ASSERT_EQ(mem_pool.used_mem_statistics(), 0);
+  ASSERT_EQ(mem_pool.thread_cached_mem_statistics(), 1024);
+  auto addr2 = mem_pool.AllocTensorMem(1000);
+  ASSERT_EQ(addr1, addr2);
+  ASSERT_EQ(mem_pool.used_mem_statistics(), 1024);
+  ASSERT_EQ(mem_pool.thread_cached_mem_statistics(), 0);
+  mem_pool.FreeTensorMem(addr2);
+}
+
+// Free more memory bufs than the bin capacity.
+TEST_F(TestDynamicMemPool, test_thread_cache_overflow) {
+  TestMemPool mem_pool(true);
+  std::vector<DeviceMemPtr> addrs;
+  for (size_t i = 0; i <= THREAD_MEM_CACHE_BIN_CAPACITY; ++i) {
+    addrs.emplace_back(mem_pool.AllocTensorMem(DYNAMIC_MEM_ALIGN_SIZE));
+  }
+  for (auto &addr : addrs) {
+    mem_pool.FreeTensorMem(addr);
+  }
+  ASSERT_EQ(mem_pool.used_mem_statistics(), 0);
+  ASSERT_LE(mem_pool.thread_cached_mem_statistics(), THREAD_MEM_CACHE_BIN_CAPACITY * DYNAMIC_MEM_ALIGN_SIZE);
+  ASSERT_GT(mem_pool.thread_cached_mem_statistics(), 0);
+}
+
+// Alloc and free memory concurrently from multiple threads.
+TEST_F(TestDynamicMemPool, test_thread_cache_multi_thread) {
+  TestMemPool mem_pool(true);
+  constexpr size_t kThreadNum = 4;
+  constexpr size_t kLoopNum = 1000;
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < kThreadNum; ++t) {
+    threads.emplace_back([&mem_pool, t]() {
+      for (size_t i = 0; i < kLoopNum; ++i) {
+        size_t size = ((i + t) % 8 + 1) * DYNAMIC_MEM_ALIGN_SIZE;
+        auto addr = mem_pool.AllocTensorMem(size);
+        ASSERT_NE(addr, nullptr);
+        mem_pool.FreeTensorMem(addr);
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(mem_pool.used_mem_statistics(), 0);
+  auto fragment_info = mem_pool.fragment_mem_statistics();
+  ASSERT_EQ(fragment_info.idle_mem_size_ + fragment_info.thread_cached_mem_size_, mem_pool.total_mem_statistics());
+}
+
+// The thread memory cache is returned to the memory pool when its thread exits.
+TEST_F(TestDynamicMemPool, test_thread_cache_reclaimed_on_thread_exit) {
+  TestMemPool mem_pool(true);
+  std::thread thread([&mem_pool]() {
+    auto addr = mem_pool.AllocTensorMem(1024);
+    ASSERT_NE(addr, nullptr);
+    mem_pool.FreeTensorMem(addr);
+    ASSERT_EQ(mem_pool.thread_cached_mem_statistics(), 1024);
+  });
+  thread.join();
+  ASSERT_EQ(mem_pool.thread_cached_mem_statistics(), 0);
+  auto fragment_info = mem_pool.fragment_mem_statistics();
+  ASSERT_EQ(fragment_info.idle_mem_buf_count_, 1);
+  ASSERT_EQ(fragment_info.idle_mem_size_, mem_pool.total_mem_statistics());
+}
+
+// The thread outlives the memory pool which it has cached memory bufs of.
+TEST_F(TestDynamicMemPool, test_thread_exit_after_pool_destroyed) {
+  auto mem_pool = std::make_unique<TestMemPool>(true);
+  std::mutex mutex;
+  std::condition_variable cond;
+  bool pool_destroyed = false;
+  std::thread thread([&]() {
+    mem_pool->FreeTensorMem(mem_pool->AllocTensorMem(1024));
+    std::unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, [&pool_destroyed]() { return pool_destroyed; });
+  });
+  while (mem_pool->thread_cached_mem_statistics() == 0) {
+    std::this_thread::yield();
+  }
+  mem_pool.reset();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    pool_destroyed = true;
+  }
+  cond.notify_one();
+  thread.join();
+}
+
+// The size record is shared by all the threads, and the erased slot is reused.
+TEST_F(TestDynamicMemPool, test_thread_cache_record) {
+  ThreadMemCacheRecord record;
+  std::vector<char> buf(DYNAMIC_MEM_ALIGN_SIZE * 4);
+  ASSERT_TRUE(record.Insert(buf.data(), DYNAMIC_MEM_ALIGN_SIZE));
+  ASSERT_TRUE(record.Insert(buf.data() + DYNAMIC_MEM_ALIGN_SIZE, DYNAMIC_MEM_ALIGN_SIZE * 2));
+  ASSERT_EQ(record.Find(buf.data()), DYNAMIC_MEM_ALIGN_SIZE);
+  ASSERT_EQ(record.Find(buf.data() + DYNAMIC_MEM_ALIGN_SIZE), DYNAMIC_MEM_ALIGN_SIZE * 2);
+  ASSERT_EQ(record.Find(buf.data() + DYNAMIC_MEM_ALIGN_SIZE * 3), 0);
+  record.Erase(buf.data());
+  ASSERT_EQ(record.Find(buf.data()), 0);
+  ASSERT_EQ(record.Find(buf.data() + DYNAMIC_MEM_ALIGN_SIZE), DYNAMIC_MEM_ALIGN_SIZE * 2);
+  ASSERT_TRUE(record.Insert(buf.data(), DYNAMIC_MEM_ALIGN_SIZE * 3));
+  ASSERT_EQ(record.Find(buf.data()), DYNAMIC_MEM_ALIGN_SIZE * 3);
+  record.Clear();
+  ASSERT_EQ(record.Find(buf.data() + DYNAMIC_MEM_ALIGN_SIZE), 0);
+}
+
+// The memory bufs freed by another thread go to the cache of that thread, and are reclaimed when out of memory.
+TEST_F(TestDynamicMemPool, test_thread_cache_cross_thread_free_and_reclaim) {
+  // Only one memory block can be alloced.
+  TestMemPool mem_pool(true, kTestMemUnitSize);
+  std::vector<DeviceMemPtr> addrs;
+  for (size_t i = 0; i < 4; ++i) {
+    addrs.emplace_back(mem_pool.AllocTensorMem(THREAD_MEM_CACHE_MAX_BUF_SIZE));
+  }
+  std::mutex mutex;
+  std::condition_variable cond;
+  bool done = false;
+  std::thread thread([&]() {
+    for (auto &addr : addrs) {
+      mem_pool.FreeTensorMem(addr);
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, [&done]() { return done; });
+  });
+  while (mem_pool.thread_cached_mem_statistics() != 4 * THREAD_MEM_CACHE_MAX_BUF_SIZE) {
+    std::this_thread::yield();
+  }
+  // The whole memory block is needed, which reclaims the cache of the other thread.
+  auto fragment_info = mem_pool.fragment_mem_statistics();
+  ASSERT_EQ(fragment_info.thread_cached_mem_size_, 4 * THREAD_MEM_CACHE_MAX_BUF_SIZE);
+  auto addr = mem_pool.AllocTensorMem(kTestMemUnitSize);
+  ASSERT_NE(addr, nullptr);
+  ASSERT_EQ(mem_pool.thread_cached_mem_statistics(), 0);
+  ASSERT_EQ(mem_pool.total_mem_statistics(), kTestMemUnitSize);
+  mem_pool.FreeTensorMem(addr);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    done = true;
+  }
+  cond.notify_one();
+  thread.join();
+}
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,97 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <random>
+#include <unordered_map>
+
+#include "common/common_test.h"
+#include "ps/ps_cache/embedding_hash_map.h"
+#include "ps/ps_cache/embedding_id_map.h"
+
+namespace mindspore {
+namespace ps {
+class TestEmbeddingIdMap : public UT::Common {
+ public:
+  TestEmbeddingIdMap() = default;
+  virtual ~TestEmbeddingIdMap() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+TEST_F(TestEmbeddingIdMap, MatchUnorderedMap) {
+  const size_t capacity = 1000;
+  EmbeddingIdMap id_map(capacity);
+  std::unordered_map<int64_t, int> expected;
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<int64_t> dist(-3000, 3000);
+  for (int i = 0; i < 100000; ++i) {
+    int64_t id = dist(gen);
+    if (i % 3 == 0 || expected.size() == capacity) {
+      EXPECT_EQ(id_map.Erase(id), expected.erase(id) != 0);
+    } else {
+      id_map.Insert(id, i);
+      expected[id] = i;
+    }
+  }
+  EXPECT_EQ(id_map.size(), expected.size());
+  for (int64_t id = -3000; id <= 3000; ++id) {
+    auto iter = expected.find(id);
+    EXPECT_EQ(id_map.Find(id), iter == expected.end() ? INVALID_INDEX_VALUE : iter->second);
+  }
+  size_t count = 0;
+  id_map.ForEach([&expected, &count](int64_t id, int index) {
+    EXPECT_EQ(expected[id], index);
+    ++count;
+  });
+  EXPECT_EQ(count, expected.size());
+
+  id_map.Clear();
+  EXPECT_TRUE(id_map.empty());
+  EXPECT_EQ(id_map.Find(expected.begin()->first), INVALID_INDEX_VALUE);
+}
+
+TEST_F(TestEmbeddingIdMap, RejectInsertWhenFull) {
+  EmbeddingIdMap id_map(2);
+  id_map.Insert(int64_t(1) << 40, 0);
+  id_map.Insert(7, 1);
+  id_map.Insert(7, 2);
+  EXPECT_EQ(id_map.Find(7), 2);
+  EXPECT_EQ(id_map.Find(int64_t(1) << 40), 0);
+  EXPECT_ANY_THROW(id_map.Insert(8, 3));
+}
+
+TEST_F(TestEmbeddingIdMap, SwapOutExpiredIds) {
+  const size_t capacity = 4;
+  int swap_out_index[capacity];
+  int swap_out_ids[capacity];
+  size_t swap_out_size = 0;
+  bool need_wait_graph = false;
+  EmbeddingHashMap hash_map(0, capacity);
+  // The first and the last positions are reserved, so two ids fit into the map.
+  EXPECT_EQ(hash_map.ParseData(10, swap_out_index, swap_out_ids, 1, 0, &swap_out_size, &need_wait_graph), 1);
+  EXPECT_EQ(hash_map.ParseData(11, swap_out_index, swap_out_ids, 1, 0, &swap_out_size, &need_wait_graph), 2);
+  EXPECT_EQ(swap_out_size, 0);
+
+  hash_map.Reset();
+  EXPECT_EQ(hash_map.ParseData(12, swap_out_index, swap_out_ids, 2, 1, &swap_out_size, &need_wait_graph), 1);
+  ASSERT_EQ(swap_out_size, 1);
+  EXPECT_EQ(swap_out_ids[0], 10);
+  EXPECT_EQ(hash_map.hash_id_to_index().Find(10), INVALID_INDEX_VALUE);
+  EXPECT_EQ(hash_map.hash_id_to_index().Find(12), 1);
+  EXPECT_EQ(hash_map.hash_id_to_index().Find(11), 2);
+}
+}  // namespace ps
+}  // namespace mindspore
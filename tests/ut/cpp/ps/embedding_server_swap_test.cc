@@ -0,0 +1,173 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_test.h"
+#include "ps/ps_cache/embedding_server_swap.h"
+
+namespace mindspore {
+namespace ps {
+namespace {
+constexpr size_t kEmbeddingSize = 2;
+}  // namespace
+
+class TestEmbeddingServerSwap : public UT::Common {
+ public:
+  TestEmbeddingServerSwap() = default;
+  virtual ~TestEmbeddingServerSwap() = default;
+
+  // The servers keep a row per key and id, the update is slow so that it overlaps with the caller.
+  void UpdateServer(uint64_t key, const std::vector<int> &ids, const std::vector<float> &data) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    if (fail_update_) {
+      throw std::runtime_error("update failed");
+    }
+    std::lock_guard<std::mutex> locker(mutex_);
+    request_threads_.insert(std::this_thread::get_id());
+    for (size_t i = 0; i < ids.size(); ++i) {
+      server_rows_[{key, ids[i]}].assign(data.begin() + i * kEmbeddingSize, data.begin() + (i + 1) * kEmbeddingSize);
+    }
+  }
+
+  void LookUpServer(uint64_t key, const std::vector<int> &ids, std::vector<float> *data) {
+    if (fail_lookup_) {
+      throw std::runtime_error("lookup failed");
+    }
+    std::lock_guard<std::mutex> locker(mutex_);
+    request_threads_.insert(std::this_thread::get_id());
+    data->clear();
+    for (int id : ids) {
+      lookup_ids_.push_back(id);
+      auto iter = server_rows_.find({key, id});
+      if (iter == server_rows_.end()) {
+        data->insert(data->end(), kEmbeddingSize, 0);
+      } else {
+        data->insert(data->end(), iter->second.begin(), iter->second.end());
+      }
+    }
+  }
+
+  EmbeddingServerSwap NewServerSwap() {
+    return EmbeddingServerSwap(
+      [this](uint64_t key, const std::vector<int> &ids, const std::vector<float> &data) {
+        UpdateServer(key, ids, data);
+      },
+      [this](uint64_t key, const std::vector<int> &ids, std::vector<float> *data) { LookUpServer(key, ids, data); });
+  }
+
+  // The lookups keep the references to the evicted rows, the tables without evicted rows use these.
+  const std::unordered_map<int, size_t> no_evicted_ids_;
+  const std::vector<float> no_evicted_data_;
+  std::mutex mutex_;
+  std::map<std::pair<uint64_t, int>, std::vector<float>> server_rows_;
+  std::vector<int> lookup_ids_;
+  std::set<std::thread::id> request_threads_;
+  bool fail_update_{false};
+  bool fail_lookup_{false};
+};
+
+// The rows evicted in a step are served from the evicted data within the step, and from the servers in the next
+// step after the updates are waited for. The lookups of two tables run concurrently.
+TEST_F(TestEmbeddingServerSwap, test_update_then_look_up) {
+  auto server_swap = NewServerSwap();
+  std::vector<int> evicted = {1, 2};
+  std::vector<float> evicted_data = {1.0, 1.5, 2.0, 2.5};
+  server_swap.Update(0, evicted, evicted_data);
+  server_swap.Update(1, evicted, {3.0, 3.5, 4.0, 4.5});
+
+  std::unordered_map<int, size_t> evicted_ids = {{1, 0}, {2, 1}};
+  std::vector<int> ids = {2, 3};
+  std::vector<float> result0;
+  std::vector<float> result1;
+  server_swap.StartLookUp(0, ids.data(), ids.size(), kEmbeddingSize, evicted_ids, evicted_data, &result0);
+  server_swap.StartLookUp(1, ids.data(), ids.size(), kEmbeddingSize, no_evicted_ids_, no_evicted_data_, &result1);
+  ASSERT_TRUE(server_swap.WaitLookUps());
+  ASSERT_EQ(result0, std::vector<float>({2.0, 2.5, 0, 0}));
+  ASSERT_EQ(lookup_ids_.size(), 3);
+  ASSERT_EQ(lookup_ids_[0] + lookup_ids_[1] + lookup_ids_[2], 8);
+
+  server_swap.WaitUpdates();
+  server_swap.StartLookUp(0, ids.data(), ids.size(), kEmbeddingSize, no_evicted_ids_, no_evicted_data_, &result0);
+  server_swap.StartLookUp(1, ids.data(), ids.size(), kEmbeddingSize, no_evicted_ids_, no_evicted_data_, &result1);
+  ASSERT_TRUE(server_swap.WaitLookUps());
+  ASSERT_EQ(result0, std::vector<float>({2.0, 2.5, 0, 0}));
+  ASSERT_EQ(result1, std::vector<float>({4.0, 4.5, 0, 0}));
+}
+
+// The failure of a background update is rethrown by the next wait, and is not rethrown again after it.
+TEST_F(TestEmbeddingServerSwap, test_update_failure) {
+  auto server_swap = NewServerSwap();
+  fail_update_ = true;
+  server_swap.Update(0, {1}, {1.0, 1.5});
+  ASSERT_THROW(server_swap.WaitUpdates(), std::runtime_error);
+  server_swap.WaitUpdates();
+  fail_update_ = false;
+  server_swap.Update(0, {1}, {1.0, 1.5});
+  server_swap.WaitUpdates();
+  ASSERT_EQ(server_rows_.size(), 1);
+}
+
+// The failure of a lookup is rethrown by the join of the lookups, and a row out of the evicted data fails the lookup.
+TEST_F(TestEmbeddingServerSwap, test_look_up_failure) {
+  auto server_swap = NewServerSwap();
+  std::vector<int> ids = {1, 2};
+  std::vector<float> result;
+  fail_lookup_ = true;
+  server_swap.StartLookUp(0, ids.data(), ids.size(), kEmbeddingSize, no_evicted_ids_, no_evicted_data_, &result);
+  ASSERT_THROW(server_swap.WaitLookUps(), std::runtime_error);
+
+  fail_lookup_ = false;
+  std::unordered_map<int, size_t> evicted_ids = {{1, 3}};
+  std::vector<float> evicted_data = {1.0, 1.5};
+  server_swap.StartLookUp(0, ids.data(), ids.size(), kEmbeddingSize, evicted_ids, evicted_data, &result);
+  ASSERT_FALSE(server_swap.WaitLookUps());
+  server_swap.StartLookUp(0, ids.data(), ids.size(), kEmbeddingSize, no_evicted_ids_, no_evicted_data_, &result);
+  ASSERT_TRUE(server_swap.WaitLookUps());
+}
+
+// The requests of many steps run on the threads started with the swap, instead of a thread per request.
+TEST_F(TestEmbeddingServerSwap, test_requests_reuse_threads) {
+  auto server_swap = NewServerSwap();
+  const int step_num = 10;
+  const int table_num = 3;
+  std::vector<int> ids = {1, 2};
+  std::vector<std::vector<float>> results(table_num);
+  for (int step = 0; step < step_num; ++step) {
+    server_swap.WaitUpdates();
+    for (int key = 0; key < table_num; ++key) {
+      float value = static_cast<float>(step * table_num + key);
+      server_swap.Update(key, {step}, {value, value});
+    }
+    for (int key = 0; key < table_num; ++key) {
+      server_swap.StartLookUp(key, ids.data(), ids.size(), kEmbeddingSize, no_evicted_ids_, no_evicted_data_,
+                              &results[key]);
+    }
+    ASSERT_TRUE(server_swap.WaitLookUps());
+  }
+  server_swap.WaitUpdates();
+  ASSERT_EQ(server_rows_.size(), step_num * table_num);
+  ASSERT_EQ(results[1], std::vector<float>({4.0, 4.0, 7.0, 7.0}));
+  ASSERT_LE(request_threads_.size(), 4);
+}
+}  // namespace ps
+}  // namespace mindspore
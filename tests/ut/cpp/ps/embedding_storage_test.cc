@@ -0,0 +1,121 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <sys/mman.h>
+#include <unistd.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+#include "ps/constants.h"
+#include "ps/embedding_storage.h"
+
+namespace mindspore {
+namespace ps {
+class TestEmbeddingStorage : public UT::Common {
+ public:
+  TestEmbeddingStorage() = default;
+  virtual ~TestEmbeddingStorage() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+TEST_F(TestEmbeddingStorage, WeightInTableFile) {
+  const size_t row_num = 1000;
+  const size_t row_size = 3;
+  const int64_t first_id = 500;
+  auto table_file = std::make_shared<EmbeddingTableFile>("/tmp", row_num, row_size, first_id);
+  Weight table(row_num * row_size, 0, WeightAllocator<float>(table_file));
+  EXPECT_EQ(table.data(), table_file->data());
+  for (size_t i = 0; i < table.size(); ++i) {
+    table[i] = static_cast<float>(i);
+  }
+
+  // Ids out of the local shard are skipped.
+  std::vector<Key> ids = {0, 500, 501, 1499, 1500, 2000};
+  table_file->PrefetchRows(ids.data(), ids.size(), table_file->first_id());
+  std::vector<int> rows = {999, 0, -1, 3};
+  table_file->PrefetchRows(rows.data(), rows.size(), 0);
+  table_file->WriteBackAsync();
+  for (size_t i = 0; i < table.size(); ++i) {
+    EXPECT_EQ(table_file->data()[i], static_cast<float>(i));
+  }
+
+  // A copy lives on the heap.
+  Weight copy = table;
+  EXPECT_NE(copy.data(), table.data());
+  EXPECT_EQ(copy.get_allocator().file(), nullptr);
+  copy[0] = -1;
+  EXPECT_EQ(table[0], 0);
+}
+
+// A zero weight in a file is not filled, it reads the zero pages of the new file without bringing them into memory.
+TEST_F(TestEmbeddingStorage, ZeroWeightInTableFile) {
+  auto table_file = std::make_shared<EmbeddingTableFile>("/tmp", 4096, 4, 0);
+  Weight table(table_file->size(), WeightAllocator<float>(table_file));
+  size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  size_t table_size = table.size() * sizeof(float);
+  std::vector<unsigned char> resident((table_size + page_size - 1) / page_size, 1);
+  ASSERT_EQ(mincore(table.data(), table_size, resident.data()), 0);
+  for (auto page : resident) {
+    EXPECT_EQ(page & 1, 0);
+  }
+  for (size_t i = 0; i < table.size(); ++i) {
+    EXPECT_EQ(table[i], 0);
+  }
+
+  Weight heap_weight(table.size());
+  for (size_t i = 0; i < heap_weight.size(); ++i) {
+    EXPECT_EQ(heap_weight[i], 0);
+  }
+}
+
+// The write backs are requested by the threads updating the table and served by the thread of the file, which is
+// stopped with requests pending when the file is destroyed.
+TEST_F(TestEmbeddingStorage, WriteBackWhileUpdating) {
+  const size_t row_num = 4096;
+  const size_t row_size = 8;
+  auto table_file = std::make_shared<EmbeddingTableFile>("/tmp", row_num, row_size, 0);
+  const size_t thread_num = 4;
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < thread_num; ++t) {
+    threads.emplace_back([&table_file, t]() {
+      for (size_t row = t; row < row_num; row += thread_num) {
+        for (size_t i = 0; i < row_size; ++i) {
+          table_file->data()[row * row_size + i] = static_cast<float>(row);
+        }
+        table_file->WriteBackAsync();
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (size_t i = 0; i < table_file->size(); ++i) {
+    EXPECT_EQ(table_file->data()[i], static_cast<float>(i / row_size));
+  }
+  table_file->WriteBackAsync();
+  table_file = nullptr;
+}
+
+TEST_F(TestEmbeddingStorage, WeightLargerThanFile) {
+  auto table_file = std::make_shared<EmbeddingTableFile>("/tmp", 10, 2, 0);
+  EXPECT_ANY_THROW(Weight(21, 0, WeightAllocator<float>(table_file)));
+  EXPECT_ANY_THROW(EmbeddingTableFile("/nonexistent_embedding_storage_dir", 10, 2, 0));
+}
+}  // namespace ps
+}  // namespace mindspore
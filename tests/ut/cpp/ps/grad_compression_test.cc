@@ -0,0 +1,123 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "common/common_test.h"
+#include "ps/grad_compression.h"
+#include "ps/kv_payload.h"
+
+namespace mindspore {
+namespace ps {
+class TestGradCompression : public UT::Common {
+ public:
+  TestGradCompression() = default;
+  virtual ~TestGradCompression() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+Values RandomGradient(size_t count) {
+  Values grad(count);
+  for (size_t i = 0; i < count; ++i) {
+    grad[i] = std::sin(static_cast<float>(i) * 0.37f) * (i % 7 + 1);
+  }
+  return grad;
+}
+
+Values Roundtrip(GradCodec codec, const Values &grad, float ratio, Values *residual, size_t *encoded_size) {
+  std::vector<unsigned char> encoded;
+  EncodeGradient(codec, grad.data(), grad.size(), ratio, residual, &encoded);
+  *encoded_size = encoded.size();
+  Values decoded(grad.size());
+  size_t consumed = 0;
+  EXPECT_TRUE(DecodeGradient(codec, encoded.data(), encoded.size(), grad.size(), decoded.data(), &consumed));
+  EXPECT_EQ(consumed, encoded.size());
+  return decoded;
+}
+
+TEST_F(TestGradCompression, QuantizeWithinTolerance) {
+  auto grad = RandomGradient(1000);
+  size_t encoded_size = 0;
+  auto fp16 = Roundtrip(GradCodec::kFP16, grad, 0, nullptr, &encoded_size);
+  EXPECT_EQ(encoded_size, grad.size() * 2);
+  for (size_t i = 0; i < grad.size(); ++i) {
+    EXPECT_NEAR(fp16[i], grad[i], 1e-2);
+  }
+
+  auto int8 = Roundtrip(GradCodec::kInt8, grad, 0, nullptr, &encoded_size);
+  EXPECT_EQ(encoded_size, grad.size() + 4 * sizeof(float));
+  for (size_t i = 0; i < grad.size(); ++i) {
+    EXPECT_NEAR(int8[i], grad[i], 7.0 / 127);
+  }
+}
+
+TEST_F(TestGradCompression, TopKKeepsResidual) {
+  Values grad = {0.1, -5.0, 0.2, 3.0, -0.3, 0.05, 1.0, 0.0};
+  Values residual;
+  size_t encoded_size = 0;
+  auto first = Roundtrip(GradCodec::kTopK, grad, 0.25, &residual, &encoded_size);
+  EXPECT_EQ(first, Values({0, -5.0, 0, 3.0, 0, 0, 0, 0}));
+  EXPECT_EQ(residual[1], 0);
+  EXPECT_FLOAT_EQ(residual[6], 1.0);
+
+  // The unsent values grow with each push until they are selected.
+  Values next = {0, 0, 0, 0, 0, 0, 1.0, 0};
+  auto second = Roundtrip(GradCodec::kTopK, next, 0.25, &residual, &encoded_size);
+  EXPECT_FLOAT_EQ(second[6], 2.0);
+  EXPECT_FLOAT_EQ(second[4], -0.3);
+  EXPECT_FLOAT_EQ(second[1], 0);
+  EXPECT_FLOAT_EQ(residual[6], 0);
+  EXPECT_FLOAT_EQ(residual[2], 0.2);
+}
+
+TEST_F(TestGradCompression, ParseEncodedPayload) {
+  auto vals = std::make_shared<Values>(Values{1, 2, 3, 4, 5, 6});
+  auto encoded = std::make_shared<std::vector<unsigned char>>();
+  EncodeGradient(GradCodec::kFP16, vals->data() + 2, 4, 0, nullptr, encoded.get());
+  KVPayload payload(vals);
+  payload.AddKey(1);
+  payload.AddValues(vals->data(), 2);
+  payload.AddLength(2);
+  payload.AddEncodedValues(GradCodec::kFP16, encoded);
+  payload.AddLength(4);
+  std::vector<unsigned char> buffer;
+  for (const auto &slice : payload.Slices()) {
+    auto data = reinterpret_cast<const unsigned char *>(slice.data);
+    buffer.insert(buffer.end(), data, data + slice.size);
+  }
+
+  KVMessage meta;
+  Values values;
+  ASSERT_TRUE(ParseKVPayload(buffer.data(), buffer.size(), &meta, &values));
+  EXPECT_EQ(values, *vals);
+  EXPECT_FALSE(ParseKVPayload(buffer.data(), buffer.size() - 1, &meta, &values));
+}
+
+TEST_F(TestGradCompression, RejectInvalidData) {
+  Values output(4);
+  size_t consumed = 0;
+  std::vector<unsigned char> topk(sizeof(uint32_t) * 2 + sizeof(float));
+  uint32_t header[2] = {1, 9};
+  memcpy(topk.data(), header, sizeof(header));
+  EXPECT_FALSE(DecodeGradient(GradCodec::kTopK, topk.data(), topk.size(), output.size(), output.data(), &consumed));
+  EXPECT_FALSE(DecodeGradient(GradCodec::kFP16, topk.data(), 6, output.size(), output.data(), &consumed));
+  EXPECT_ANY_THROW(GradCodecFromName("INT4"));
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,120 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "common/common_test.h"
+#include "ps/kv_payload.h"
+
+namespace mindspore {
+namespace ps {
+class TestKVPayload : public UT::Common {
+ public:
+  TestKVPayload() = default;
+  virtual ~TestKVPayload() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+};
+
+std::vector<unsigned char> Gather(const std::vector<core::MessageSlice> &slices) {
+  std::vector<unsigned char> buffer;
+  for (const auto &slice : slices) {
+    auto data = reinterpret_cast<const unsigned char *>(slice.data);
+    buffer.insert(buffer.end(), data, data + slice.size);
+  }
+  return buffer;
+}
+
+TEST_F(TestKVPayload, SendValuesByReference) {
+  auto vals = std::make_shared<Values>(Values{1.0, 2.0, 3.0, 4.0, 5.0, 6.0});
+  KVPayload payload(vals);
+  payload.AddKey(3);
+  payload.AddValues(vals->data(), 2);
+  payload.AddLength(2);
+  payload.AddKey(7);
+  payload.AddValues(vals->data() + 2, 4);
+  payload.AddLength(4);
+  auto slices = payload.Slices();
+  // The header, the metadata and one slice covering the adjacent values of both keys.
+  ASSERT_EQ(slices.size(), 3);
+  EXPECT_EQ(slices[2].data, vals->data());
+  EXPECT_EQ(slices[2].size, vals->size() * sizeof(float));
+
+  auto buffer = Gather(slices);
+  EXPECT_EQ(buffer.size(), core::SlicesSize(slices));
+  KVMessage meta;
+  Values values;
+  ASSERT_TRUE(ParseKVPayload(buffer.data(), buffer.size(), &meta, &values));
+  EXPECT_EQ(meta.keys_size(), 2);
+  EXPECT_EQ(meta.keys(1), 7);
+  EXPECT_EQ(meta.len(0), 2);
+  EXPECT_EQ(meta.values_size(), 0);
+  EXPECT_EQ(values, *vals);
+}
+
+TEST_F(TestKVPayload, ConvertKVMessage) {
+  auto message = std::make_shared<KVMessage>();
+  message->add_keys(1);
+  message->add_values(0.5);
+  message->add_values(-0.5);
+  message->add_len(2);
+  KVPayload payload(*message, message);
+  auto buffer = Gather(payload.Slices());
+  KVMessage meta;
+  Values values;
+  ASSERT_TRUE(ParseKVPayload(buffer.data(), buffer.size(), &meta, &values));
+  EXPECT_EQ(meta.keys(0), 1);
+  EXPECT_EQ(meta.len(0), 2);
+  EXPECT_EQ(values, Values({0.5, -0.5}));
+}
+
+TEST_F(TestKVPayload, RejectTruncatedPayload) {
+  KVPayload payload;
+  payload.AddKey(1);
+  auto buffer = Gather(payload.Slices());
+  KVMessage meta;
+  Values values;
+  EXPECT_TRUE(ParseKVPayload(buffer.data(), buffer.size(), &meta, &values));
+  EXPECT_TRUE(values.empty());
+  EXPECT_FALSE(ParseKVPayload(buffer.data(), buffer.size() - 1, &meta, &values));
+  EXPECT_FALSE(ParseKVPayload(buffer.data(), sizeof(KVPayloadHeader) - 1, &meta, &values));
+}
+
+TEST_F(TestKVPayload, RejectInvalidLengths) {
+  auto build_payload = [](const std::vector<uint64_t> &lengths) {
+    KVPayload payload;
+    payload.AddKey(1);
+    for (auto length : lengths) {
+      payload.AddEncodedValues(GradCodec::kNone, std::make_shared<std::vector<unsigned char>>());
+      payload.AddLength(length);
+    }
+    return Gather(payload.Slices());
+  };
+  KVMessage meta;
+  Values values;
+  auto buffer = build_payload({0, 0});
+  EXPECT_TRUE(ParseKVPayload(buffer.data(), buffer.size(), &meta, &values));
+  // A negative length, and lengths whose sum exceeds the values a KVMessage holds, are rejected before the values
+  // are allocated.
+  buffer = build_payload({static_cast<uint64_t>(-1)});
+  EXPECT_FALSE(ParseKVPayload(buffer.data(), buffer.size(), &meta, &values));
+  buffer = build_payload({static_cast<uint64_t>(INT32_MAX), 1});
+  EXPECT_FALSE(ParseKVPayload(buffer.data(), buffer.size(), &meta, &values));
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,107 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "common/common_test.h"
+#include "ps/parallel_runner.h"
+
+namespace mindspore {
+namespace ps {
+class TestParallelRunner : public UT::Common {
+ public:
+  TestParallelRunner() = default;
+  virtual ~TestParallelRunner() = default;
+
+  void SetUp() override {}
+  void TearDown() override {}
+
+  // The weights and the momentum accumulations of the keys, the weight of key i has (i + 1) * 1000 values.
+  struct Model {
+    std::vector<std::vector<float>> weights;
+    std::vector<std::vector<float>> accums;
+  };
+
+  static Model MakeModel(size_t key_num) {
+    Model model;
+    for (size_t i = 0; i < key_num; i++) {
+      model.weights.emplace_back((i + 1) * 1000, 1.0f);
+      model.accums.emplace_back((i + 1) * 1000, 0.0f);
+    }
+    return model;
+  }
+
+  // Applies a momentum optimizer to the weight of key with the gradient of the step.
+  static void ApplyMomentum(Model *model, size_t key, size_t step) {
+    const float lr = 0.01f;
+    const float momentum = 0.9f;
+    auto &weight = model->weights[key];
+    auto &accum = model->accums[key];
+    for (size_t j = 0; j < weight.size(); j++) {
+      float grad = static_cast<float>((j + key + step) % 7) - 3.0f;
+      accum[j] = accum[j] * momentum + grad;
+      weight[j] -= lr * accum[j];
+    }
+  }
+};
+
+// The optimizers applied to the keys in parallel give the same weights as applying them one after another.
+TEST_F(TestParallelRunner, ParallelApplyMatchesSerialApply) {
+  const size_t key_num = 13;
+  const size_t step_num = 20;
+  Model serial_model = MakeModel(key_num);
+  Model parallel_model = MakeModel(key_num);
+  ParallelRunner runner(4);
+  EXPECT_EQ(runner.thread_num(), 4);
+  for (size_t step = 0; step < step_num; step++) {
+    for (size_t key = 0; key < key_num; key++) {
+      ApplyMomentum(&serial_model, key, step);
+    }
+    runner.Run(key_num, [&parallel_model, step](size_t key) { ApplyMomentum(&parallel_model, key, step); });
+  }
+  EXPECT_EQ(parallel_model.weights, serial_model.weights);
+  EXPECT_EQ(parallel_model.accums, serial_model.accums);
+}
+
+// Every task of a batch runs once, and a batch without tasks or threads runs on the calling thread.
+TEST_F(TestParallelRunner, RunEveryTaskOnce) {
+  for (size_t thread_num : {1, 2, 8}) {
+    ParallelRunner runner(thread_num);
+    for (size_t task_num : {0, 1, 3, 100}) {
+      std::vector<int> counts(task_num, 0);
+      runner.Run(task_num, [&counts](size_t i) { counts[i]++; });
+      EXPECT_EQ(counts, std::vector<int>(task_num, 1));
+    }
+  }
+}
+
+// The exception of a task is rethrown by Run, and the runner keeps running the next batches.
+TEST_F(TestParallelRunner, RethrowTaskException) {
+  ParallelRunner runner(3);
+  EXPECT_THROW(runner.Run(10,
+                          [](size_t i) {
+                            if (i == 5) {
+                              throw std::runtime_error("apply failed");
+                            }
+                          }),
+               std::runtime_error);
+  std::vector<int> counts(10, 0);
+  runner.Run(counts.size(), [&counts](size_t i) { counts[i]++; });
+  EXPECT_EQ(counts, std::vector<int>(10, 1));
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,53 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+from mindspore.ops import Primitive
+from mindspore.ops import operations as P
+
+add = P.Add()
+mul = P.Mul()
+neg = P.Neg()
+relu = P.ReLU()
+make_tuple = Primitive('MakeTuple')
+
+
+class FnDict:
+    def __init__(self):
+        self.fnDict = {}
+
+    def __call__(self, fn):
+        self.fnDict[fn.__name__] = fn
+
+    def __getitem__(self, name):
+        return self.fnDict[name]
+
+
+def test_elementwise_fusion_cpu(tag):
+    fns = FnDict()
+
+    @fns
+    def chain(x, y):
+        return relu(add(mul(x, y), x))
+
+    @fns
+    def multi_user(x, y):
+        res = mul(x, y)
+        return make_tuple(add(relu(res), y), res)
+
+    @fns
+    def broadcast(x, y):
+        return neg(relu(add(x, y)))
+
+    return fns[tag]
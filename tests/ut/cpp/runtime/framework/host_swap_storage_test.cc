@@ -0,0 +1,120 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <random>
+#include <vector>
+#include "common/common_test.h"
+#include "runtime/framework/host_swap_storage.h"
+
+namespace mindspore {
+namespace runtime {
+class TestHostSwapStorage : public UT::Common {
+ public:
+  TestHostSwapStorage() = default;
+
+  // Fill the data with the nonzero bytes, and the byte is zero in the probability of zero_ratio.
+  static std::vector<uint8_t> GenerateData(size_t size, double zero_ratio) {
+    std::mt19937 generator(size);
+    std::uniform_real_distribution<double> ratio_distribution(0, 1);
+    std::uniform_int_distribution<int> byte_distribution(1, UINT8_MAX);
+    std::vector<uint8_t> data(size);
+    for (auto &byte : data) {
+      byte = (ratio_distribution(generator) < zero_ratio) ? 0 : static_cast<uint8_t>(byte_distribution(generator));
+    }
+    return data;
+  }
+
+  static void CheckRoundTrip(const std::vector<uint8_t> &data) {
+    std::vector<uint32_t> encoded;
+    CompressedHostSwapStorage::Compress(data.data(), data.size(), &encoded);
+    std::vector<uint8_t> decoded(data.size(), 1);
+    ASSERT_TRUE(CompressedHostSwapStorage::Decompress(encoded, decoded.data(), decoded.size()));
+    ASSERT_EQ(decoded, data);
+  }
+};
+
+// The dense data is kept in the raw format, which is never larger than the data by more than two words.
+TEST_F(TestHostSwapStorage, test_dense_round_trip) {
+  for (size_t size : {1, 3, 4, 7, 64, 1001, 4096}) {
+    auto data = GenerateData(size, 0);
+    CheckRoundTrip(data);
+    std::vector<uint32_t> encoded;
+    CompressedHostSwapStorage::Compress(data.data(), data.size(), &encoded);
+    ASSERT_LE(encoded.size() * sizeof(uint32_t), size + 2 * sizeof(uint32_t));
+  }
+}
+
+// The all-zero data is compressed to a few words, and the sparse data is round tripped.
+TEST_F(TestHostSwapStorage, test_sparse_round_trip) {
+  for (size_t size : {4, 5, 4096, 1 << 20}) {
+    std::vector<uint8_t> data(size, 0);
+    CheckRoundTrip(data);
+    std::vector<uint32_t> encoded;
+    CompressedHostSwapStorage::Compress(data.data(), data.size(), &encoded);
+    ASSERT_LE(encoded.size(), 4);
+  }
+  for (double zero_ratio : {0.5, 0.9, 0.99}) {
+    CheckRoundTrip(GenerateData(4099, zero_ratio));
+  }
+}
+
+// The truncated, extended and broken streams fail to decompress instead of writing out of the data buffer.
+TEST_F(TestHostSwapStorage, test_corrupt_input) {
+  std::vector<uint8_t> data(4096, 0);
+  data[100] = 1;
+  std::vector<uint32_t> encoded;
+  CompressedHostSwapStorage::Compress(data.data(), data.size(), &encoded);
+  std::vector<uint8_t> decoded(data.size());
+
+  ASSERT_FALSE(CompressedHostSwapStorage::Decompress({}, decoded.data(), decoded.size()));
+  auto truncated = encoded;
+  truncated.pop_back();
+  ASSERT_FALSE(CompressedHostSwapStorage::Decompress(truncated, decoded.data(), decoded.size()));
+  auto extended = encoded;
+  extended.emplace_back(0);
+  ASSERT_FALSE(CompressedHostSwapStorage::Decompress(extended, decoded.data(), decoded.size()));
+  auto overflowed = encoded;
+  overflowed[2] = UINT32_MAX;
+  ASSERT_FALSE(CompressedHostSwapStorage::Decompress(overflowed, decoded.data(), decoded.size()));
+  auto unknown_format = encoded;
+  unknown_format[0] = UINT32_MAX;
+  ASSERT_FALSE(CompressedHostSwapStorage::Decompress(unknown_format, decoded.data(), decoded.size()));
+  ASSERT_FALSE(CompressedHostSwapStorage::Decompress(encoded, decoded.data(), decoded.size() / 2));
+
+  auto dense = GenerateData(4096, 0);
+  CompressedHostSwapStorage::Compress(dense.data(), dense.size(), &encoded);
+  ASSERT_FALSE(CompressedHostSwapStorage::Decompress(encoded, decoded.data(), decoded.size() - sizeof(uint32_t)));
+  encoded.pop_back();
+  ASSERT_FALSE(CompressedHostSwapStorage::Decompress(encoded, decoded.data(), decoded.size()));
+}
+
+// Put, get and remove the data in the compressed host memory and the swap files.
+TEST_F(TestHostSwapStorage, test_put_get_remove) {
+  auto data = GenerateData(4097, 0.5);
+  std::vector<HostSwapStoragePtr> storages = {std::make_shared<CompressedHostSwapStorage>(),
+                                              std::make_shared<FileSwapStorage>("/tmp")};
+  for (auto &storage : storages) {
+    ASSERT_TRUE(storage->Put(&data, data.data(), data.size()));
+    ASSERT_GT(storage->stored_size(), 0);
+    std::vector<uint8_t> loaded(data.size());
+    ASSERT_TRUE(storage->Get(&data, loaded.data(), loaded.size()));
+    ASSERT_EQ(loaded, data);
+    storage->Remove(&data);
+    ASSERT_EQ(storage->stored_size(), 0);
+    ASSERT_FALSE(storage->Get(&data, loaded.data(), loaded.size()));
+  }
+}
+}  // namespace runtime
+}  // namespace mindspore
@@ -0,0 +1,228 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "backend/session/kernel_graph.h"
+#include "runtime/framework/mem_swap_scheduler.h"
+
+namespace mindspore {
+namespace runtime {
+using device::DeviceAddress;
+using device::DeviceAddressPtr;
+using device::DeviceAddressType;
+using device::DeviceContextKey;
+using kernel::AddressPtr;
+using session::KernelGraph;
+
+namespace {
+constexpr size_t kSwapTensorSize = 4 << 20;
+constexpr size_t kChainKernelNum = 40;
+constexpr size_t kWaitTimeoutMs = 10000;
+
+class TestDeviceAddress : public DeviceAddress {
+ public:
+  TestDeviceAddress(void *ptr, size_t size) : DeviceAddress(ptr, size) {}
+  ~TestDeviceAddress() override { free(ptr_); }
+  bool SyncDeviceToHost(const ShapeVector &, size_t, TypeId, void *) const override { return true; }
+  bool SyncHostToDevice(const ShapeVector &, size_t, TypeId, const void *, const std::string &) const override {
+    return true;
+  }
+  void ClearDeviceMemory() override {}
+  DeviceAddressType DeviceType() const override { return DeviceAddressType::kCPU; }
+  void set_device_ptr(void *ptr) { ptr_ = ptr; }
+};
+
+class TestDeviceContext : public device::DeviceContext {
+ public:
+  TestDeviceContext() : DeviceContext(DeviceContextKey{"CPU", 0}) {}
+  bool Initialize() override { return true; }
+  bool AllocateMemory(DeviceAddress *const &address, size_t size) const override {
+    static_cast<TestDeviceAddress *>(address)->set_device_ptr(malloc(size));
+    return address->GetPtr() != nullptr;
+  }
+  void FreeMemory(DeviceAddress *const &address) const override {
+    free(address->GetMutablePtr());
+    static_cast<TestDeviceAddress *>(address)->set_device_ptr(nullptr);
+  }
+  DeviceAddressPtr CreateDeviceAddress(void *device_ptr, size_t device_size, const string &, TypeId) const override {
+    return std::make_shared<TestDeviceAddress>(device_ptr, device_size);
+  }
+  DeviceAddressType GetDeviceAddressType() const override { return DeviceAddressType::kCPU; }
+  void SetOperatorInfo(const std::vector<CNodePtr> &) const override {}
+  void CreateKernel(const std::vector<CNodePtr> &) const override {}
+  bool LaunchKernel(const CNodePtr &, const std::vector<AddressPtr> &, const std::vector<AddressPtr> &,
+                    const std::vector<AddressPtr> &, bool) const override {
+    return true;
+  }
+};
+}  // namespace
+
+class TestMemSwapScheduler : public UT::Common {
+ public:
+  TestMemSwapScheduler() = default;
+  void SetUp() override;
+  void TearDown() override { MemSwapScheduler::GetInstance().Clear(); }
+
+  CNodePtr NewKernel(const std::vector<AnfNodePtr> &inputs, size_t output_size) {
+    std::vector<AnfNodePtr> kernel_inputs{NewValueNode(std::make_shared<Primitive>("Test"))};
+    kernel_inputs.insert(kernel_inputs.end(), inputs.begin(), inputs.end());
+    auto kernel = graph_->NewCNode(kernel_inputs);
+    kernel->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{1}));
+    auto device_tensor = device_context_.CreateDeviceAddress(nullptr, output_size, "", kNumberTypeFloat32);
+    AnfAlgo::SetOutputAddr(device_tensor, 0, kernel.get());
+    return kernel;
+  }
+
+  DeviceTensor *GetDeviceTensor(const CNodePtr &kernel) const {
+    return AnfAlgo::GetMutableOutputAddr(kernel, 0, false).get();
+  }
+
+  // Run the swap part of the kernel launch, and wait the swap in callback as the kernel actor does.
+  bool LaunchKernel(const CNodePtr &kernel) {
+    auto &scheduler = MemSwapScheduler::GetInstance();
+    auto kernel_swap_info = scheduler.FetchKernelSwapInfo(kernel.get());
+    if (kernel_swap_info == nullptr) {
+      return true;
+    }
+    std::atomic<size_t> callback_count{0};
+    std::promise<void> swap_in_promise;
+    auto swap_in_future = swap_in_promise.get_future();
+    auto swap_in_callback = [&callback_count, &swap_in_promise]() {
+      ++callback_count;
+      swap_in_promise.set_value();
+    };
+    bool is_resident = scheduler.PreLaunchKernel(kernel_swap_info, swap_in_callback);
+    if (!is_resident &&
+        (swap_in_future.wait_for(std::chrono::milliseconds(kWaitTimeoutMs)) != std::future_status::ready)) {
+      return false;
+    }
+    // The callback is invoked only when the swap in is still in progress at the return of PreLaunchKernel.
+    if ((callback_count != (is_resident ? 0 : 1)) || !scheduler.CheckInputsResident(kernel_swap_info)) {
+      return false;
+    }
+    scheduler.PostLaunchKernel(kernel_swap_info);
+    return true;
+  }
+
+  bool WaitSwappedOut(const DeviceTensor *device_tensor) {
+    for (size_t i = 0; i < kWaitTimeoutMs; ++i) {
+      if (device_tensor->GetPtr() == nullptr) {
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+  }
+
+  void FillData(const DeviceTensor *device_tensor, uint8_t value) {
+    auto data = static_cast<uint8_t *>(device_tensor->GetMutablePtr());
+    for (size_t i = 0; i < device_tensor->GetSize(); i += 4096) {
+      data[i] = value;
+    }
+  }
+
+  bool CheckData(const DeviceTensor *device_tensor, uint8_t value) {
+    auto data = static_cast<const uint8_t *>(device_tensor->GetPtr());
+    for (size_t i = 0; i < device_tensor->GetSize(); ++i) {
+      if (data[i] != ((i % 4096 == 0) ? value : 0)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  TestDeviceContext device_context_;
+  KernelGraphPtr graph_;
+  // The large output of the producer is used again by the consumer after a long chain of kernels.
+  CNodePtr producer_;
+  std::vector<CNodePtr> chain_;
+  CNodePtr consumer_;
+};
+
+void TestMemSwapScheduler::SetUp() {
+  (void)setenv("MS_MEM_SWAP_ENABLE", "1", 1);
+  ASSERT_TRUE(MemSwapScheduler::GetInstance().enable());
+  graph_ = std::make_shared<KernelGraph>();
+  auto input = graph_->NewParameter();
+  input->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, std::vector<int64_t>{1}));
+  AnfAlgo::SetOutputAddr(device_context_.CreateDeviceAddress(nullptr, sizeof(float), "", kNumberTypeFloat32), 0,
+                         input.get());
+
+  producer_ = NewKernel({input}, kSwapTensorSize);
+  std::vector<CNodePtr> execution_order{producer_};
+  AnfNodePtr prev_kernel = producer_;
+  for (size_t i = 0; i < kChainKernelNum; ++i) {
+    prev_kernel = NewKernel({i == 0 ? input : prev_kernel}, sizeof(float));
+    chain_.emplace_back(prev_kernel->cast<CNodePtr>());
+    execution_order.emplace_back(chain_.back());
+  }
+  consumer_ = NewKernel({prev_kernel, producer_}, sizeof(float));
+  execution_order.emplace_back(consumer_);
+  graph_->set_output(consumer_);
+  graph_->set_execution_order(execution_order);
+
+  MemSwapScheduler::GetInstance().BuildSwapPlan(graph_, &device_context_);
+  auto device_tensor = GetDeviceTensor(producer_);
+  ASSERT_TRUE(device_context_.AllocateMemory(device_tensor, device_tensor->GetSize()));
+  memset(device_tensor->GetMutablePtr(), 0, device_tensor->GetSize());
+}
+
+// The output of producer is swapped out after the launch, and prefetched before the consumer.
+TEST_F(TestMemSwapScheduler, test_swap_out_and_prefetch) {
+  auto device_tensor = GetDeviceTensor(producer_);
+  FillData(device_tensor, 1);
+  ASSERT_TRUE(LaunchKernel(producer_));
+  ASSERT_TRUE(WaitSwappedOut(device_tensor));
+  for (auto &kernel : chain_) {
+    ASSERT_TRUE(LaunchKernel(kernel));
+  }
+  ASSERT_TRUE(LaunchKernel(consumer_));
+  ASSERT_NE(device_tensor->GetPtr(), nullptr);
+  ASSERT_TRUE(CheckData(device_tensor, 1));
+}
+
+// The consumer is launched before the prefetch, which requests the swap in and is resumed by the callback.
+TEST_F(TestMemSwapScheduler, test_swap_in_on_demand) {
+  auto device_tensor = GetDeviceTensor(producer_);
+  FillData(device_tensor, 2);
+  ASSERT_TRUE(LaunchKernel(producer_));
+  ASSERT_TRUE(WaitSwappedOut(device_tensor));
+  ASSERT_TRUE(LaunchKernel(consumer_));
+  ASSERT_TRUE(CheckData(device_tensor, 2));
+}
+
+// The swapped out tensor holds the memory again before the swap in, which keeps the newer data in the memory.
+TEST_F(TestMemSwapScheduler, test_swap_in_live_memory) {
+  auto device_tensor = GetDeviceTensor(producer_);
+  FillData(device_tensor, 3);
+  ASSERT_TRUE(LaunchKernel(producer_));
+  ASSERT_TRUE(WaitSwappedOut(device_tensor));
+  ASSERT_TRUE(device_context_.AllocateMemory(device_tensor, device_tensor->GetSize()));
+  memset(device_tensor->GetMutablePtr(), 0, device_tensor->GetSize());
+  FillData(device_tensor, 4);
+  ASSERT_TRUE(LaunchKernel(consumer_));
+  ASSERT_TRUE(CheckData(device_tensor, 4));
+}
+}  // namespace runtime
+}  // namespace mindspore
@@ -0,0 +1,112 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "abstract/abstract_value.h"
+#include "backend/session/cpu_session.h"
+#include "frontend/operator/ops.h"
+#include "runtime/device/cpu/cpu_device_address.h"
+#include "utils/ms_context.h"
+#include "utils/utils.h"
+
+namespace mindspore {
+namespace session {
+namespace {
+const std::vector<int64_t> kShape = {2, 3};
+constexpr size_t kElementNum = 6;
+
+class RunOpCPUSession : public CPUSession {
+ public:
+  using CPUSession::RunOpImpl;
+};
+}  // namespace
+
+class TestCPUSession : public UT::Common {
+ public:
+  TestCPUSession() = default;
+  void SetUp() override {
+    MsContext::GetInstance()->set_param<int>(MS_CTX_EXECUTION_MODE, kPynativeMode);
+    MsContext::GetInstance()->set_param<std::string>(MS_CTX_DEVICE_TARGET, kCPUDevice);
+    session_ = std::make_shared<RunOpCPUSession>();
+    session_->Init(0);
+  }
+  void TearDown() override { MsContext::GetInstance()->set_param<int>(MS_CTX_EXECUTION_MODE, kGraphMode); }
+
+  static tensor::TensorPtr NewTensor(float start) {
+    auto tensor = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, kShape);
+    auto data = static_cast<float *>(tensor->data_c());
+    for (size_t i = 0; i < kElementNum; ++i) {
+      data[i] = start + i;
+    }
+    return tensor;
+  }
+
+  tensor::TensorPtr RunAdd(const tensor::TensorPtr &x, const tensor::TensorPtr &y) {
+    OpRunInfo op_run_info = {"Add", prim::kPrimAdd, std::make_shared<abstract::AbstractTensor>(kFloat32, kShape)};
+    std::vector<tensor::TensorPtr> input_tensors = {x, y};
+    VectorRef outputs;
+    session_->RunOpImpl("Add_Float32_2_3_Float32_2_3", &op_run_info, &input_tensors, &outputs,
+                        {kParameterDataTensorMask, kParameterDataTensorMask});
+    EXPECT_EQ(outputs.size(), 1);
+    return utils::cast<tensor::TensorPtr>(outputs[0]);
+  }
+
+  static std::vector<float> GetData(const tensor::TensorPtr &tensor) {
+    tensor->data_sync();
+    auto data = static_cast<float *>(tensor->data_c());
+    return std::vector<float>(data, data + kElementNum);
+  }
+
+  std::shared_ptr<RunOpCPUSession> session_;
+};
+
+// The cached launch writes the same results as the runtime path, which runs instead when the data of an input is
+// held by a device address of other memory, or is not synced to the host yet.
+TEST_F(TestCPUSession, test_cached_launch_matches_runtime) {
+  auto x = NewTensor(1.0);
+  auto y = NewTensor(10.0);
+  std::vector<float> expected;
+  for (size_t i = 0; i < kElementNum; ++i) {
+    expected.push_back(11.0 + 2 * i);
+  }
+
+  // The first run builds the op graph and caches the launch of its kernel, which the runs of the op use.
+  ASSERT_EQ(GetData(RunAdd(x, y)), expected);
+  auto cached_output = RunAdd(x, y);
+  ASSERT_EQ(cached_output->device_address(), nullptr);
+  ASSERT_EQ(GetData(cached_output), expected);
+
+  std::vector<float> other_memory(kElementNum, 0);
+  x->set_device_address(std::make_shared<device::cpu::CPUDeviceAddress>(
+    other_memory.data(), kElementNum * sizeof(float), kOpFormat_DEFAULT, kNumberTypeFloat32));
+  auto runtime_output = RunAdd(x, y);
+  ASSERT_NE(runtime_output->device_address(), nullptr);
+  ASSERT_EQ(GetData(runtime_output), GetData(cached_output));
+
+  // The runtime path binds the input to the memory of its data, so it is launched from the cache again.
+  auto rebound_output = RunAdd(x, y);
+  ASSERT_EQ(rebound_output->device_address(), nullptr);
+  ASSERT_EQ(GetData(rebound_output), expected);
+
+  x->set_sync_status(kNeedSyncDeviceToHost);
+  auto pending_output = RunAdd(x, y);
+  ASSERT_NE(pending_output->device_address(), nullptr);
+  ASSERT_EQ(GetData(pending_output), expected);
+}
+}  // namespace session
+}  // namespace mindspore
@@ -0,0 +1,108 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+""" test the dependencies and the entries of the frontend compile cache """
+import os
+import subprocess
+import sys
+import numpy as np
+
+import mindspore.nn as nn
+from mindspore import Tensor
+from mindspore.common import dtype as mstype
+from mindspore.common.api import _get_compile_cache_dep_files, _get_compile_cache_net_info
+from mindspore.ops import operations as P
+
+
+class Net(nn.Cell):
+    def __init__(self, in_channels=3, out_channels=4, keep_prob=0.9, keep_dims=False):
+        super(Net, self).__init__()
+        self.dense = nn.Dense(in_channels, out_channels)
+        self.dropout = nn.Dropout(keep_prob)
+        self.reduce_mean = P.ReduceMean(keep_dims=keep_dims)
+        self.scale = Tensor(np.ones([out_channels]), mstype.float32)
+
+    def construct(self, x):
+        x = self.dropout(self.dense(x))
+        return self.reduce_mean(x * self.scale, 0)
+
+
+def test_dep_files():
+    """ the source files of the network and its sub cells are dependencies """
+    dep_files = _get_compile_cache_dep_files(Net())
+    assert os.path.realpath(__file__) in dep_files
+    assert any(path.endswith(os.path.join('nn', 'layer', 'basic.py')) for path in dep_files)
+    assert dep_files == sorted(dep_files)
+
+
+def test_net_info_contains_parameters():
+    """ every parameter of the network is in the net info with its name, shape and dtype """
+    net_info = _get_compile_cache_net_info(Net())
+    param_info = [info for info in net_info if info.startswith('param:')]
+    assert len(param_info) == 2
+    assert any(info.startswith('param:dense.weight:(4, 3):') and 'Float32' in info for info in param_info)
+    assert any(info.startswith('param:dense.bias:(4,):') for info in param_info)
+
+
+def test_net_info_changes_with_network():
+    """ the net info is stable for the same network and changes with the parameters and the hyperparameters """
+    net_info = _get_compile_cache_net_info(Net())
+    assert _get_compile_cache_net_info(Net()) == net_info
+    assert _get_compile_cache_net_info(Net(in_channels=5)) != net_info
+    assert _get_compile_cache_net_info(Net(keep_prob=0.5)) != net_info
+    assert _get_compile_cache_net_info(Net(keep_dims=True)) != net_info
+
+    net = Net()
+    net.scale = Tensor(np.full([4], 2), mstype.float32)
+    assert _get_compile_cache_net_info(net) != net_info
+
+    net = Net()
+    net.dense.weight.requires_grad = False
+    assert _get_compile_cache_net_info(net) != net_info
+
+
+COMPILE_SCRIPT = '''
+import numpy as np
+import mindspore.nn as nn
+from mindspore import context, Tensor
+from mindspore.common import dtype as mstype
+from mindspore.common.api import _executor
+from mindspore.ops import operations as P
+
+
+class CacheNet(nn.Cell):
+    def __init__(self):
+        super(CacheNet, self).__init__()
+        self.relu = P.ReLU()
+
+    def construct(self, x):
+        return self.relu(x) + x
+
+
+context.set_context(mode=context.GRAPH_MODE, save_compile_cache=True, load_compile_cache=True,
+                    compile_cache_path={cache_path!r})
+_executor.compile(CacheNet(), Tensor(np.ones([2, 3]), mstype.float32), phase='train')
+'''
+
+
+def test_load_in_another_process(tmp_path):
+    """ the cache saved by a process is loaded by a relaunched process instead of saving another entry """
+    cache_path = str(tmp_path / 'cache')
+    script = tmp_path / 'cache_net.py'
+    script.write_text(COMPILE_SCRIPT.format(cache_path=cache_path))
+    subprocess.run([sys.executable, str(script)], check=True)
+    entries = sorted(os.listdir(cache_path))
+    assert len(entries) == 1 and entries[0].endswith('.mindir')
+    subprocess.run([sys.executable, str(script)], check=True)
+    assert sorted(os.listdir(cache_path)) == entries
@@ -0,0 +1,107 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+""" test the incremental compile of a network for inputs of other shapes """
+import numpy as np
+
+import mindspore.nn as nn
+from mindspore import context, Tensor, Parameter
+from mindspore.common import dtype as mstype
+from mindspore.common.api import _executor
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE)
+
+
+class Net(nn.Cell):
+    def __init__(self):
+        super(Net, self).__init__()
+        self.relu = P.ReLU()
+        self.weight = Parameter(Tensor(np.array([1.0, -2.0, 3.0]), mstype.float32), name='weight')
+
+    def construct(self, x, y):
+        return self.relu(x) * self.weight + y
+
+
+class ShapeNet(nn.Cell):
+    def __init__(self):
+        super(ShapeNet, self).__init__()
+        self.shape = P.Shape()
+        self.reshape = P.Reshape()
+
+    def construct(self, x):
+        shape = self.shape(x)
+        return self.reshape(x, (shape[0] * shape[1],))
+
+
+class LenNet(nn.Cell):
+    def construct(self, x):
+        return x * len(x)
+
+
+def compile_and_run(net, *inputs):
+    phase, _ = _executor.compile(net, *inputs, phase=net.phase)
+    return phase, _executor(net, *inputs, phase=net.phase)
+
+
+def gen_inputs(batch_size):
+    x = np.arange(batch_size * 3).reshape(batch_size, 3) - batch_size
+    return Tensor(x, mstype.float32), Tensor(np.ones([batch_size, 3]), mstype.float32)
+
+
+def test_reuse_graph_for_other_shapes():
+    """ the net compiled again for inputs of other shapes is specialized from the graph compiled before """
+    context.set_context(enable_incremental_compile=True)
+    try:
+        net = Net()
+        phase, _ = compile_and_run(net, *gen_inputs(2))
+        assert not _executor.is_incremental_compiled(phase)
+        phase, out = compile_and_run(net, *gen_inputs(4))
+        assert _executor.is_incremental_compiled(phase)
+    finally:
+        context.set_context(enable_incremental_compile=False)
+
+    # The output of the incremental compile is the same as the one of the net compiled from scratch.
+    fresh_net = Net()
+    phase, expect = compile_and_run(fresh_net, *gen_inputs(4))
+    assert not _executor.is_incremental_compiled(phase)
+    assert out.shape == expect.shape == (4, 3)
+    assert np.allclose(out.asnumpy(), expect.asnumpy())
+
+
+def test_recompile_for_other_ranks():
+    """ the inputs changing their ranks are compiled from scratch """
+    context.set_context(enable_incremental_compile=True)
+    try:
+        net = Net()
+        x, y = gen_inputs(2)
+        phase, _ = compile_and_run(net, x, y)
+        phase, _ = compile_and_run(net, x, Tensor(np.ones([3]), mstype.float32))
+        assert not _executor.is_incremental_compiled(phase)
+    finally:
+        context.set_context(enable_incremental_compile=False)
+
+
+def test_recompile_net_reading_shape():
+    """ the nets reading the shapes of their inputs as values are compiled from scratch for other shapes """
+    context.set_context(enable_incremental_compile=True)
+    try:
+        for net in [ShapeNet(), LenNet()]:
+            phase, _ = compile_and_run(net, Tensor(np.ones([2, 3]), mstype.float32))
+            assert not _executor.is_incremental_compiled(phase)
+            phase, out = compile_and_run(net, Tensor(np.ones([4, 3]), mstype.float32))
+            assert not _executor.is_incremental_compiled(phase)
+            assert out.shape == ((12,) if isinstance(net, ShapeNet) else (4, 3))
+    finally:
+        context.set_context(enable_incremental_compile=False)
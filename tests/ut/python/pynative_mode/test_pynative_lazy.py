@@ -0,0 +1,119 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+""" test the ops recorded in pynative lazy mode against the ops run one by one """
+import numpy as np
+
+import mindspore.nn as nn
+from mindspore import context, Tensor, Parameter
+from mindspore.common import dtype as mstype
+from mindspore.ops import operations as P
+
+
+def setup_module():
+    context.set_context(mode=context.PYNATIVE_MODE)
+
+
+def teardown_module():
+    context.set_context(mode=context.GRAPH_MODE, pynative_lazy_op_num=0)
+
+
+class Net(nn.Cell):
+    def __init__(self):
+        super(Net, self).__init__()
+        self.relu = P.ReLU()
+        self.mul = P.Mul()
+        self.add = P.Add()
+        self.reduce_sum = P.ReduceSum()
+        self.split = P.Split(0, 2)
+
+    def construct(self, x, y):
+        # The intermediate outputs are dropped, only the returned ones are read.
+        a = self.relu(x)
+        b = self.mul(a, y)
+        c = self.add(b, a)
+        first, second = self.split(c)
+        return self.reduce_sum(first, 1), second * 2
+
+
+def run(op_num, func, *inputs):
+    context.set_context(pynative_lazy_op_num=op_num)
+    try:
+        outputs = func(*inputs)
+        outputs = outputs if isinstance(outputs, tuple) else (outputs,)
+        return [output.asnumpy() for output in outputs]
+    finally:
+        context.set_context(pynative_lazy_op_num=0)
+
+
+def gen_inputs():
+    x = Tensor(np.arange(12).reshape(4, 3) - 6, mstype.float32)
+    y = Tensor(np.arange(12).reshape(4, 3) / 4, mstype.float32)
+    return x, y
+
+
+def assert_same(lazy_outputs, eager_outputs):
+    assert len(lazy_outputs) == len(eager_outputs)
+    for lazy, eager in zip(lazy_outputs, eager_outputs):
+        assert lazy.shape == eager.shape
+        assert lazy.dtype == eager.dtype
+        assert np.allclose(lazy, eager)
+
+
+def test_lazy_net_same_as_eager():
+    """ the outputs of the recorded ops are the same as the ones of the ops run one by one """
+    net = Net()
+    expect = run(0, net, *gen_inputs())
+    # The ops are flushed when the outputs are read, by the op num limit in the middle of the net, and the second run
+    # takes the graph from the cache.
+    for op_num in [100, 100, 3, 1]:
+        assert_same(run(op_num, net, *gen_inputs()), expect)
+
+
+def test_lazy_outputs_read_by_later_ops():
+    """ the outputs of a flush are read by the ops recorded after it """
+    def func(x, y):
+        a = x * y
+        a_value = a.asnumpy()
+        b = a + x
+        return Tensor(a_value), b - y, a
+
+    expect = run(0, func, *gen_inputs())
+    assert_same(run(100, func, *gen_inputs()), expect)
+
+
+def test_lazy_intermediate_kept_by_python():
+    """ the intermediate outputs kept by python are filled, whether they are read before or after the others """
+    def func(x, y):
+        outputs = []
+        a = x + y
+        for _ in range(3):
+            a = a * y + x
+            outputs.append(a)
+        return tuple(outputs)
+
+    expect = run(0, func, *gen_inputs())
+    assert_same(run(100, func, *gen_inputs()), expect)
+
+
+def test_lazy_read_before_inplace_write():
+    """ the recorded ops read their inputs as they were before an in-place write """
+    def func(x, y):
+        weight = Parameter(Tensor(np.ones([4, 3]), mstype.float32), name='weight')
+        out = weight * x + y
+        weight.set_data(Tensor(np.full([4, 3], 2), mstype.float32))
+        return out, weight * x
+
+    expect = run(0, func, *gen_inputs())
+    assert_same(run(100, func, *gen_inputs()), expect)